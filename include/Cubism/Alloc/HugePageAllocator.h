@@ -0,0 +1,87 @@
+// File       : HugePageAllocator.h
+// Created    : Thu Oct 15 2026 04:21:36 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Transparent huge page block allocator
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef HUGEPAGEALLOCATOR_H_G5VJ2QXA
+#define HUGEPAGEALLOCATOR_H_G5VJ2QXA
+
+#include "Cubism/Common.h"
+#include <cassert>
+#include <cstdlib>
+#include <sys/mman.h>
+
+NAMESPACE_BEGIN(Cubism)
+
+/**
+ * @brief Block allocator backed by transparent huge pages
+ * @tparam T Data type of single block element
+ *
+ * @rst
+ * Allocations of at least ``HugePageSize`` bytes are aligned at a huge page
+ * boundary, their size is rounded up to an integer multiple of the huge page
+ * size and the kernel is advised to back the memory with transparent huge
+ * pages (``madvise(MADV_HUGEPAGE)``).  This reduces TLB misses for large grid
+ * allocations.  Smaller requests are handled like in
+ * ``AlignedBlockAllocator``.  The allocator can be used with the ``Alloc``
+ * template parameter of grids and fields.
+ * @endrst
+ */
+template <typename T>
+class HugePageAllocator
+{
+public:
+    using DataType = T;
+    static constexpr size_t Alignment = CUBISM_ALIGNMENT;
+    static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+    /**
+     * @brief Allocate block memory
+     * @param bytes Minimum number of bytes
+     * @return Pointer to first block element
+     *
+     * The actual allocated memory may be larger than the requested number of
+     * bytes.
+     */
+    DataType *allocate(size_t &bytes) const
+    {
+        void *block = nullptr;
+        size_t alignment = CUBISM_ALIGNMENT;
+        if (bytes >= HugePageSize) {
+            alignment = HugePageSize;
+        }
+        bytes = ((bytes + alignment - 1) / alignment) * alignment;
+        int ret = posix_memalign(&block, alignment, bytes);
+        assert(ret == 0 && block != nullptr &&
+               "posix_memalign returned NULL address");
+        (void)ret;
+#ifdef MADV_HUGEPAGE
+        if (alignment == HugePageSize) {
+            // advisory only, ignore failure if THP is not available
+            madvise(block, bytes, MADV_HUGEPAGE);
+        }
+#endif /* MADV_HUGEPAGE */
+        return static_cast<DataType *>(block);
+    }
+
+    /**
+     * @brief Deallocate block memory
+     * @param block Pointer to first block element
+     */
+    void deallocate(DataType *block) const
+    {
+        if (block != nullptr) {
+            free(block);
+        }
+    }
+};
+
+template <typename T>
+constexpr size_t HugePageAllocator<T>::Alignment;
+
+template <typename T>
+constexpr size_t HugePageAllocator<T>::HugePageSize;
+
+NAMESPACE_END(Cubism)
+
+#endif /* HUGEPAGEALLOCATOR_H_G5VJ2QXA */
@@ -0,0 +1,298 @@
+// File       : PoolAllocator.h
+// Created    : Thu Oct 15 2026 04:48:03 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Size-class pooled block allocator
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef POOLALLOCATOR_H_W8DK3ZPT
+#define POOLALLOCATOR_H_W8DK3ZPT
+
+#include "Cubism/Common.h"
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+NAMESPACE_BEGIN(Cubism)
+
+/**
+ * @brief Process-wide pool of aligned memory blocks
+ *
+ * @rst
+ * Released memory blocks are kept in a free list for their size class and are
+ * handed out again for subsequent requests of the same class.  Size classes
+ * are spaced at one eighth of the leading power of two of the requested
+ * number of bytes (at least ``CUBISM_ALIGNMENT``), which bounds the internal
+ * fragmentation to 12.5%.  The size class of a block is stored in a header of
+ * ``CUBISM_ALIGNMENT`` bytes preceding the returned address.  The pool is
+ * thread-safe, each size class has its own free list and lock such that
+ * threads working on different size classes do not contend.
+ *
+ * The number of cached bytes is bounded by ``getCapacity()`` (unbounded by
+ * default).  Blocks released while the pool is at capacity are returned to
+ * the system immediately.  ``trim()`` returns cached blocks to the system
+ * until the number of cached bytes drops to a given limit.
+ * @endrst
+ */
+class BlockPool
+{
+public:
+    /** @brief Alignment of memory blocks */
+    static constexpr size_t Alignment = CUBISM_ALIGNMENT;
+
+    BlockPool(const BlockPool &c) = delete;
+    BlockPool(BlockPool &&c) = delete;
+    BlockPool &operator=(const BlockPool &c) = delete;
+    BlockPool &operator=(BlockPool &&c) = delete;
+
+    ~BlockPool() { clear(); }
+
+    /**
+     * @brief Pool instance
+     * @return Reference to the process-wide pool
+     */
+    static BlockPool &instance()
+    {
+        static BlockPool pool;
+        return pool;
+    }
+
+    /**
+     * @brief Size class of a request
+     * @param bytes Number of requested bytes
+     * @return Number of bytes of the size class
+     */
+    static size_t getSizeClass(const size_t bytes)
+    {
+        if (bytes <= Alignment) {
+            return Alignment;
+        }
+        size_t lead = 1;
+        while (lead <= bytes / 2) {
+            lead *= 2;
+        }
+        const size_t step = (lead / 8 > Alignment) ? lead / 8 : Alignment;
+        return ((bytes + step - 1) / step) * step;
+    }
+
+    /**
+     * @brief Acquire a memory block
+     * @param bytes Minimum number of bytes, set to the size class on return
+     * @return Pointer to aligned memory block
+     */
+    void *acquire(size_t &bytes)
+    {
+        bytes = getSizeClass(bytes);
+        Bin &bin = bins_[getBin_(bytes)];
+        {
+            std::lock_guard<std::mutex> lock(bin.mutex);
+            if (!bin.blocks.empty()) {
+                void *block = bin.blocks.back();
+                bin.blocks.pop_back();
+                cached_bytes_ -= bytes;
+                return block;
+            }
+        }
+        void *base = nullptr;
+        int ret = posix_memalign(&base, Alignment, bytes + Header);
+        assert(ret == 0 && base != nullptr &&
+               "posix_memalign returned NULL address");
+        (void)ret;
+        *static_cast<size_t *>(base) = bytes;
+        return static_cast<char *>(base) + Header;
+    }
+
+    /**
+     * @brief Release a memory block back to the pool
+     * @param block Pointer obtained from ``acquire()``
+     *
+     * The block is returned to the system if caching it would exceed the
+     * capacity of the pool.
+     */
+    void release(void *block)
+    {
+        if (block == nullptr) {
+            return;
+        }
+        const size_t bytes = getBytes_(block);
+        if (cached_bytes_.fetch_add(bytes) + bytes > capacity_) {
+            cached_bytes_ -= bytes;
+            free_(block);
+            return;
+        }
+        Bin &bin = bins_[getBin_(bytes)];
+        std::lock_guard<std::mutex> lock(bin.mutex);
+        bin.blocks.push_back(block);
+    }
+
+    /**
+     * @brief Return cached memory blocks to the system
+     * @param bytes Upper limit for the number of cached bytes on return
+     * @return Number of bytes returned to the system
+     *
+     * Largest size classes are released first.
+     */
+    size_t trim(const size_t bytes = 0)
+    {
+        size_t released = 0;
+        for (size_t i = NBins; i > 0 && cached_bytes_ > bytes; --i) {
+            Bin &bin = bins_[i - 1];
+            std::lock_guard<std::mutex> lock(bin.mutex);
+            while (!bin.blocks.empty() && cached_bytes_ > bytes) {
+                void *block = bin.blocks.back();
+                bin.blocks.pop_back();
+                const size_t b = getBytes_(block);
+                cached_bytes_ -= b;
+                released += b;
+                free_(block);
+            }
+        }
+        return released;
+    }
+
+    /**
+     * @brief Return all cached memory blocks to the system
+     */
+    void clear() { trim(0); }
+
+    /**
+     * @brief Number of cached bytes
+     * @return Total number of bytes held in free lists
+     */
+    size_t getCachedBytes() const { return cached_bytes_; }
+
+    /**
+     * @brief Maximum number of cached bytes
+     * @return Capacity of the pool in bytes
+     */
+    size_t getCapacity() const { return capacity_; }
+
+    /**
+     * @brief Set the maximum number of cached bytes
+     * @param bytes Capacity of the pool in bytes
+     *
+     * Cached blocks exceeding the new capacity are returned to the system.
+     */
+    void setCapacity(const size_t bytes)
+    {
+        capacity_ = bytes;
+        trim(bytes);
+    }
+
+private:
+    static constexpr size_t Header = Alignment;
+    static_assert(Header >= sizeof(size_t),
+                  "CUBISM_ALIGNMENT too small for pool block header");
+    // one bin for the smallest class and at most 8 classes per power of two
+    static constexpr size_t NBins = 8 * 8 * sizeof(size_t) + 1;
+
+    struct Bin {
+        std::mutex mutex;
+        std::vector<void *> blocks;
+    };
+
+    Bin bins_[NBins];
+    std::atomic<size_t> cached_bytes_;
+    std::atomic<size_t> capacity_;
+
+    BlockPool()
+        : cached_bytes_(0), capacity_(std::numeric_limits<size_t>::max())
+    {
+    }
+
+    static size_t getBytes_(void *block)
+    {
+        return *reinterpret_cast<size_t *>(static_cast<char *>(block) -
+                                           Header);
+    }
+
+    static void free_(void *block)
+    {
+        free(static_cast<char *>(block) - Header);
+    }
+
+    // unique bin of size class bytes: classes in (lead, 2 * lead] map to
+    // 8 * log2(lead) + [1, 8]
+    static size_t getBin_(const size_t bytes)
+    {
+        if (bytes <= Alignment) {
+            return 0;
+        }
+        size_t lead = 1;
+        size_t k = 0;
+        while (2 * lead < bytes) {
+            lead *= 2;
+            ++k;
+        }
+        const size_t step = (lead / 8 > Alignment) ? lead / 8 : Alignment;
+        const size_t bin = 8 * k + (bytes - lead) / step;
+        assert(bin > 0 && bin < NBins);
+        return bin;
+    }
+};
+
+/**
+ * @brief Pooled aligned memory block allocator
+ * @tparam T Data type of single block element
+ *
+ * @rst
+ * Allocates memory from the process-wide ``BlockPool``.  Deallocated blocks
+ * are not returned to the system but are recycled for later allocations of
+ * the same size class.  This avoids expensive system allocations (and page
+ * faults on first touch) for data that is repeatedly created and destroyed,
+ * e.g. temporary grids or field labs in a time loop.  The allocator can be
+ * used with the ``Alloc`` template parameter of grids and fields.
+ * @endrst
+ */
+template <typename T>
+class PoolAllocator
+{
+public:
+    using DataType = T;
+    static constexpr size_t Alignment = CUBISM_ALIGNMENT;
+
+    /**
+     * @brief Allocate block memory
+     * @param bytes Minimum number of bytes
+     * @return Pointer to first block element
+     *
+     * The actual allocated memory may be larger than the requested number of
+     * bytes.
+     */
+    DataType *allocate(size_t &bytes) const
+    {
+        return static_cast<DataType *>(BlockPool::instance().acquire(bytes));
+    }
+
+    /**
+     * @brief Deallocate block memory
+     * @param block Pointer to first block element
+     */
+    void deallocate(DataType *block) const
+    {
+        BlockPool::instance().release(block);
+    }
+
+    /**
+     * @brief Return all cached memory blocks of the pool to the system
+     */
+    static void clear() { BlockPool::instance().clear(); }
+
+    /**
+     * @brief Return cached memory blocks of the pool to the system
+     * @param bytes Upper limit for the number of cached bytes on return
+     * @return Number of bytes returned to the system
+     */
+    static size_t trim(const size_t bytes = 0)
+    {
+        return BlockPool::instance().trim(bytes);
+    }
+};
+
+template <typename T>
+constexpr size_t PoolAllocator<T>::Alignment;
+
+NAMESPACE_END(Cubism)
+
+#endif /* POOLALLOCATOR_H_W8DK3ZPT */
@@ -7,7 +7,7 @@
 #define ABSORBING_H_YUEH2NIZ
 
 #include "Cubism/BC/Base.h"
-#include <cassert>
+#include <algorithm>
 
 NAMESPACE_BEGIN(Cubism)
 NAMESPACE_BEGIN(BC)
@@ -27,6 +27,8 @@ class Absorbing : public BC::Base<Lab>
     using BaseType::binfo_;
 
 public:
+    using typename BaseType::SlabType;
+
     /**
      * @brief Main constructor
      * @param dir Direction in which to apply the boundary
@@ -41,7 +43,19 @@ public:
      * @brief Apply boundary condition
      * @param lab Lab on which the boundary is applied
      */
-    void operator()(Lab &lab) override { apply_(lab); }
+    void operator()(Lab &lab) override
+    {
+        apply_(lab,
+               this->getSlab(lab.getActiveStencil(),
+                             lab.getActiveRange().getExtent()));
+    }
+
+    /**
+     * @brief Apply boundary condition to a precomputed slab
+     * @param lab Lab on which the boundary is applied
+     * @param slab Boundary slab
+     */
+    void apply(Lab &lab, const SlabType &slab) override { apply_(lab, slab); }
 
     /**
      * @brief Name of boundary condition
@@ -57,48 +71,28 @@ private:
     using IndexRangeType = typename Lab::IndexRangeType;
     using MultiIndex = typename Lab::MultiIndex;
     using Index = typename MultiIndex::DataType;
-    using Stencil = typename Lab::StencilType;
 
-    void apply_(Lab &lab) const
+    void apply_(Lab &lab, const SlabType &slab) const
     {
-        assert(binfo_.dir < IndexRangeType::Dim);
-        assert(0 == binfo_.side || 1 == binfo_.side);
-
-        const Stencil &stencil = lab.getActiveStencil();
-        if (!this->isValidStencil_(stencil)) {
+        if (slab.isEmpty()) {
             return; // nothing to do; zero stencil width for binfo_.dir
         }
-        const MultiIndex extent = lab.getActiveRange().getExtent();
-        const MultiIndex src = (0 == binfo_.side)
-                                   ? MultiIndex::getUnitVector(binfo_.dir)
-                                   : -MultiIndex::getUnitVector(binfo_.dir);
-        const Index sdir = (0 == binfo_.side) ? -1 : 1;
-
-        MultiIndex slice;
-        MultiIndex begin(0);
-        Index end;
-        if (stencil.isTensorial()) {
-            slice = lab.getActiveLabRange().getExtent();
-            begin = stencil.getBegin();
-        } else {
-            slice = lab.getActiveRange().getExtent();
-        }
-        if (0 == binfo_.side) {
-            begin[binfo_.dir] = -1;
-            end = -stencil.getBegin()[binfo_.dir];
-        } else {
-            begin[binfo_.dir] = extent[binfo_.dir];
-            end = stencil.getEnd()[binfo_.dir] - 1;
-        }
-        slice[binfo_.dir] = 1;
-        const IndexRangeType srange(slice);
-        for (const auto &p : srange) {
-            MultiIndex q = p + begin;
-            const DataType val = lab[q + src];
-            lab[q] = val;
-            for (Index i = 1; i < end; ++i) {
-                q[binfo_.dir] += sdir;
-                lab[q] = val;
+        const size_t dir = slab.dir;
+        // inner boundary adjacent index along dir
+        const Index src = (0 == slab.side) ? 0 : slab.inner - 1;
+        MultiIndex rows = slab.extent;
+        rows[0] = 1;
+        const Index n = slab.extent[0];
+        for (const auto &p : IndexRangeType(rows)) {
+            MultiIndex q = p + slab.begin;
+            DataType *dst = &lab[q];
+            if (0 == dir) {
+                q[0] = src;
+                std::fill(dst, dst + n, lab[q]);
+            } else {
+                q[dir] = src;
+                const DataType *row = &lab[q];
+                std::copy(row, row + n, dst);
             }
         }
     }
@@ -7,6 +7,8 @@
 #define BASE_H_EJIAASP9
 
 #include "Cubism/Common.h"
+#include "Cubism/Core/Index.h"
+#include "Cubism/Core/Stencil.h"
 #include <cassert>
 #include <string>
 
@@ -27,6 +29,90 @@ struct BoundaryInfo {
     bool is_periodic;
 };
 
+/**
+ * @brief Boundary slab descriptor
+ * @tparam DIM Dimension
+ *
+ * @rst
+ * Describes the ghost region of a lab to which a boundary condition is
+ * applied.  Indices are local lab indices relative to the first inner element.
+ * The slab is empty if the stencil has zero width along ``dir``.
+ * @endrst
+ */
+template <size_t DIM>
+struct BoundarySlab {
+    /** @brief Type for higher dimensional index */
+    using MultiIndex = typename Core::IndexRange<DIM>::MultiIndex;
+    /** @brief First ghost index of the slab */
+    MultiIndex begin;
+    /** @brief Extent of the slab */
+    MultiIndex extent;
+    /** @brief Number of inner elements along ``dir`` */
+    typename MultiIndex::DataType inner;
+    /** @brief Boundary direction index */
+    size_t dir;
+    /** @brief Side index along direction ``dir`` */
+    size_t side;
+
+    /**
+     * @brief Check for empty slab
+     * @return True if there are no ghosts to be set
+     */
+    bool isEmpty() const { return 0 == extent.prod(); }
+};
+
+/**
+ * @brief Compute the boundary slab for a boundary
+ * @tparam DIM Dimension
+ * @param info Boundary information
+ * @param s Active stencil
+ * @param inner Extent of the active (inner) range of the lab
+ * @return Boundary slab descriptor
+ *
+ * @rst
+ * For tensorial stencils the slab spans the full lab along the tangential
+ * directions, otherwise it spans the inner range only.
+ * @endrst
+ */
+template <size_t DIM>
+BoundarySlab<DIM>
+getBoundarySlab(const BoundaryInfo &info,
+                const Core::Stencil<DIM> &s,
+                const typename BoundarySlab<DIM>::MultiIndex &inner)
+{
+    using MultiIndex = typename BoundarySlab<DIM>::MultiIndex;
+    assert(info.dir < DIM);
+    assert(0 == info.side || 1 == info.side);
+
+    BoundarySlab<DIM> slab;
+    slab.dir = info.dir;
+    slab.side = info.side;
+    slab.inner = inner[info.dir];
+    const MultiIndex sbegin = s.getBegin();
+    const MultiIndex send = s.getEnd();
+    if ((0 == sbegin[info.dir]) || (1 == send[info.dir])) {
+        // zero stencil width for info.dir
+        slab.begin = MultiIndex(0);
+        slab.extent = MultiIndex(0);
+        return slab;
+    }
+    if (s.isTensorial()) {
+        slab.begin = sbegin;
+        slab.extent = inner + send - sbegin - 1;
+    } else {
+        slab.begin = MultiIndex(0);
+        slab.extent = inner;
+    }
+    if (0 == info.side) {
+        slab.begin[info.dir] = sbegin[info.dir];
+        slab.extent[info.dir] = -sbegin[info.dir];
+    } else {
+        slab.begin[info.dir] = inner[info.dir];
+        slab.extent[info.dir] = send[info.dir] - 1;
+    }
+    return slab;
+}
+
 /**
  * @brief Boundary condition base class
  * @tparam Lab Type of ``FieldLab``
@@ -40,8 +126,12 @@ template <typename Lab>
 class Base
 {
     using StencilType = typename Lab::StencilType;
+    using MultiIndex = typename Lab::MultiIndex;
 
 public:
+    /** @brief Boundary slab type */
+    using SlabType = BoundarySlab<Lab::IndexRangeType::Dim>;
+
     Base(const size_t dir, const size_t side)
     {
         binfo_.dir = dir;
@@ -61,6 +151,30 @@ public:
      */
     virtual void operator()(Lab & /* lab */) {}
 
+    /**
+     * @brief Apply boundary condition to a precomputed slab
+     * @param lab Lab on which the boundary is applied
+     * @param slab Boundary slab obtained from ``getSlab()``
+     *
+     * @rst
+     * Used by ``BC::Engine`` and ``BC::TypedList`` to apply the boundary
+     * condition without recomputing the slab geometry.  The default
+     * implementation ignores ``slab`` and calls ``operator()``.
+     * @endrst
+     */
+    virtual void apply(Lab &lab, const SlabType & /* slab */) { (*this)(lab); }
+
+    /**
+     * @brief Boundary slab for this boundary
+     * @param s Active stencil
+     * @param inner Extent of the active (inner) range of the lab
+     * @return Boundary slab descriptor
+     */
+    SlabType getSlab(const StencilType &s, const MultiIndex &inner) const
+    {
+        return getBoundarySlab(binfo_, s, inner);
+    }
+
     /**
      * @brief Name of boundary condition
      * @return Name string
@@ -76,6 +190,79 @@ protected:
         return !((0 == s.getBegin()[binfo_.dir]) ||
                  (1 == s.getEnd()[binfo_.dir]));
     }
+
+    /**
+     * @brief Set ghosts from the inner values next to the boundary
+     * @tparam NInner Number of inner values used by the kernel (1 to 3)
+     * @tparam Kernel Ghost value kernel type
+     * @param lab Lab on which the boundary is applied
+     * @param slab Boundary slab
+     * @param kernel Ghost value kernel
+     *
+     * @rst
+     * Calls ``kernel(k, u0, u1, u2)`` for every ghost in ``slab``, where ``k
+     * >= 1`` is the distance of the ghost from the boundary adjacent inner
+     * element and ``u0``, ``u1``, ``u2`` are the first three inner values
+     * normal to the boundary, starting at the boundary.  Only the first
+     * ``NInner`` values are read from the lab, the remaining arguments are
+     * passed as ``u0``.  The slab is processed in contiguous rows such that
+     * the kernel can be inlined and vectorized.  Requires at least ``NInner``
+     * inner elements along ``dir``.
+     * @endrst
+     */
+    template <size_t NInner, typename Kernel>
+    static void
+    applyKernel_(Lab &lab, const SlabType &slab, const Kernel &kernel)
+    {
+        static_assert(NInner >= 1 && NInner <= 3,
+                      "BC::Base: kernel may use 1 to 3 inner values");
+        using DataType = typename Lab::DataType;
+        using IndexRangeType = typename Lab::IndexRangeType;
+        using Index = typename MultiIndex::DataType;
+
+        if (slab.isEmpty()) {
+            return; // nothing to do; zero stencil width for dir
+        }
+        assert(slab.inner >= static_cast<Index>(NInner));
+        const size_t dir = slab.dir;
+        const Index sdir = (0 == slab.side) ? 1 : -1; // inward
+        const Index b = (0 == slab.side) ? 0 : slab.inner - 1;
+        MultiIndex rows = slab.extent;
+        rows[0] = 1;
+        const Index n = slab.extent[0];
+        for (const auto &p : IndexRangeType(rows)) {
+            MultiIndex q = p + slab.begin;
+            DataType *dst = &lab[q];
+            if (0 == dir) {
+                q[0] = b;
+                const DataType *u = &lab[q];
+                const DataType u0 = u[0];
+                const DataType u1 = (NInner > 1) ? u[sdir] : u0;
+                const DataType u2 = (NInner > 2) ? u[2 * sdir] : u0;
+                const Index k0 = sdir * (b - slab.begin[0]);
+                for (Index i = 0; i < n; ++i) {
+                    dst[i] = kernel(k0 - sdir * i, u0, u1, u2);
+                }
+            } else {
+                const Index k = sdir * (b - q[dir]);
+                q[dir] = b;
+                const DataType *r0 = &lab[q];
+                const DataType *r1 = r0;
+                const DataType *r2 = r0;
+                if (NInner > 1) {
+                    q[dir] += sdir;
+                    r1 = &lab[q];
+                }
+                if (NInner > 2) {
+                    q[dir] += sdir;
+                    r2 = &lab[q];
+                }
+                for (Index i = 0; i < n; ++i) {
+                    dst[i] = kernel(k, r0[i], r1[i], r2[i]);
+                }
+            }
+        }
+    }
 };
 
 NAMESPACE_END(BC)
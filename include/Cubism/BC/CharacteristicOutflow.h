@@ -0,0 +1,371 @@
+// File       : CharacteristicOutflow.h
+// Created    : Sat Oct 17 2026 02:26:51 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Characteristic outflow boundary for multi-component labs
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef CHARACTERISTICOUTFLOW_H_QW3NZ8KE
+#define CHARACTERISTICOUTFLOW_H_QW3NZ8KE
+
+#include "Cubism/BC/Base.h"
+#include "Cubism/Block/TensorFieldLab.h"
+#include "Cubism/Common.h"
+#include "Cubism/Core/Index.h"
+#include "Cubism/Core/Vector.h"
+#include <cassert>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(BC)
+
+/**
+ * @brief Characteristic wave decomposition at a boundary
+ * @tparam T Data type
+ * @tparam N Number of scalar components (waves)
+ *
+ * @rst
+ * Decomposition of the linearized system :math:`\partial_t u + A\,\partial_n u
+ * = 0` normal to the boundary, with :math:`A = R\,\Lambda\,L` and :math:`L =
+ * R^{-1}`.  The characteristic amplitudes are :math:`w = L u`.
+ * @endrst
+ */
+template <typename T, size_t N>
+struct CharacteristicWaves {
+    /** @brief Vector type of component values */
+    using VectorType = Core::Vector<T, N>;
+    /** @brief Wave speeds :math:`\lambda_m` in the positive direction */
+    VectorType speed;
+    /** @brief Rows of the left eigenvector matrix :math:`L` */
+    VectorType left[N];
+    /** @brief Rows of the right eigenvector matrix :math:`R` */
+    VectorType right[N];
+    /** @brief Far-field state :math:`u_\infty` */
+    VectorType target;
+};
+
+/**
+ * @brief Characteristic (NSCBC-style) outflow BC
+ * @tparam TLab Type of ``Block::TensorFieldLab`` with ``LabLayout::SoA``
+ *
+ * @rst
+ * Non-reflecting outflow boundary condition for systems of hyperbolic
+ * equations.  The ghosts of all components are set together: the inner state
+ * next to the boundary is decomposed into characteristic amplitudes
+ * :math:`w = L u` and each wave is treated according to its speed
+ * :math:`\lambda_m` in the outward direction:
+ *
+ * outgoing (:math:`\lambda_m \ge 0` outward)
+ *    The amplitude is extrapolated linearly, :math:`w_k = w_0 + k(w_0 - w_1)`,
+ *    such that the wave leaves the domain without reflection.
+ *
+ * incoming (:math:`\lambda_m < 0` outward)
+ *    The amplitude is relaxed towards the far-field :math:`w_\infty = L
+ *    u_\infty` by the distance the wave travels in one time step,
+ *    :math:`w_k = w_0 + \min(1, k\nu_m)(w_\infty - w_0)` with the wave Courant
+ *    number :math:`\nu_m = |\lambda_m|\Delta t / h`.
+ *
+ * where :math:`k` is the ghost distance from the inner value :math:`w_0` next
+ * to the boundary.  The ghost state is :math:`u_k = R\,w_k`.  The wave speeds
+ * and the eigenvectors are frozen for a boundary slab, they are given as
+ * constant ``CharacteristicWaves`` or by a callback which is evaluated once per
+ * slab (e.g. linearized about the far-field or the mean boundary state).  The
+ * time step is passed explicitly when the boundary is applied, ``h`` is the
+ * mesh spacing normal to the boundary.
+ *
+ * The boundary condition acts on all scalar components of a
+ * ``TensorFieldLab`` and is therefore applied after the lab has been loaded.
+ * To exclude the boundary side from the periodic halo exchange, the component
+ * markers returned by ``getComponentBC()`` must be added to the boundary
+ * conditions of the respective scalar components.  The markers do not set any
+ * ghosts on their own:
+ *
+ * .. code-block:: cpp
+ *
+ *    using Lab = Block::TensorFieldLab<Grid::BaseType>;
+ *    BC::CharacteristicOutflow<Lab> outflow(0, 1, waves, h);
+ *    for (size_t c = 0; c < Lab::NComponents; ++c) {
+ *        field[c].getBC().push_back(&outflow.getComponentBC(c));
+ *    }
+ *    grid.loadLab(field, lab);
+ *    outflow(lab, dt);
+ *
+ * Face containers are not supported since the components of different face
+ * directions are not collocated.
+ * @endrst
+ * */
+template <typename TLab>
+class CharacteristicOutflow
+{
+public:
+    /** @brief Number of scalar components */
+    static constexpr size_t N = TLab::NScalars;
+
+    using DataType = typename TLab::DataType;
+    /** @brief Scalar component lab type */
+    using ComponentLab = typename TLab::LabType;
+    /** @brief Wave decomposition type */
+    using WaveType = CharacteristicWaves<DataType, N>;
+    /** @brief Callback type for time-dependent wave decompositions */
+    using WaveFunction = std::function<WaveType()>;
+
+    static_assert(1 == TLab::NGroups,
+                  "CharacteristicOutflow: face containers are not supported");
+
+    /**
+     * @brief Component boundary marker
+     *
+     * @rst
+     * Non-periodic boundary without ghost treatment.  Excludes the boundary
+     * side from the halo exchange of a scalar component.
+     * @endrst
+     */
+    class ComponentBC : public BC::Base<ComponentLab>
+    {
+    public:
+        ComponentBC() : BC::Base<ComponentLab>(0, 0) {}
+
+        /**
+         * @brief Set boundary location
+         * @param dir Direction of the boundary
+         * @param side Side along direction ``dir``
+         */
+        void setBoundary(const size_t dir, const size_t side)
+        {
+            this->binfo_.dir = dir;
+            this->binfo_.side = side;
+            this->binfo_.is_periodic = false;
+        }
+
+        /**
+         * @brief Name of boundary condition
+         * @return Name string
+         */
+        std::string name() const override
+        {
+            return std::string("Characteristic Outflow");
+        }
+    };
+
+    /**
+     * @brief Main constructor
+     * @param dir Direction in which to apply the boundary
+     * @param side On which side along direction ``dir``
+     * @param waves Wave decomposition at the boundary
+     * @param h Mesh spacing normal to the boundary
+     */
+    CharacteristicOutflow(const size_t dir,
+                          const size_t side,
+                          const WaveType &waves,
+                          const DataType h)
+        : waves_(waves), h_(h)
+    {
+        init_(dir, side);
+    }
+
+    /**
+     * @brief Constructor for time-dependent wave decompositions
+     * @param dir Direction in which to apply the boundary
+     * @param side On which side along direction ``dir``
+     * @param waves Callback that returns the wave decomposition
+     * @param h Mesh spacing normal to the boundary
+     */
+    CharacteristicOutflow(const size_t dir,
+                          const size_t side,
+                          const WaveFunction &waves,
+                          const DataType h)
+        : waves_(), h_(h), func_(waves)
+    {
+        init_(dir, side);
+    }
+
+    CharacteristicOutflow(const CharacteristicOutflow &c) = delete;
+    CharacteristicOutflow &operator=(const CharacteristicOutflow &c) = delete;
+
+    /**
+     * @brief Apply boundary condition
+     * @param lab Loaded multi-component lab
+     * @param dt Time step
+     */
+    void operator()(TLab &lab, const DataType dt)
+    {
+        for (size_t s = 1; s < N; ++s) {
+            if (!(lab.getActiveRange(s).getExtent() ==
+                  lab.getActiveRange(0).getExtent())) {
+                throw std::runtime_error(
+                    "CharacteristicOutflow: components must have the same "
+                    "index range");
+            }
+        }
+        apply_(lab,
+               getBoundarySlab(binfo_,
+                               lab.getActiveStencil(),
+                               lab.getActiveRange(0).getExtent()),
+               dt);
+    }
+
+    /**
+     * @brief Component boundary marker
+     * @param c Component index
+     * @return Reference to the marker of component ``c``
+     */
+    ComponentBC &getComponentBC(const size_t c)
+    {
+        assert(c < N);
+        return markers_[c];
+    }
+
+    /**
+     * @brief Get boundary information
+     * @return ``BoundaryInfo`` structure
+     */
+    const BoundaryInfo &getBoundaryInfo() const { return binfo_; }
+
+    /**
+     * @brief Get wave decomposition
+     * @return Current wave decomposition (evaluates the callback if set)
+     */
+    WaveType getWaves() const { return func_ ? func_() : waves_; }
+
+    /**
+     * @brief Name of boundary condition
+     * @return Name string
+     */
+    std::string name() const { return std::string("Characteristic Outflow"); }
+
+private:
+    using MultiIndex = typename TLab::MultiIndex;
+    using IndexRangeType = typename TLab::IndexRangeType;
+    using Index = typename MultiIndex::DataType;
+    using VectorType = typename WaveType::VectorType;
+
+    BoundaryInfo binfo_;
+    ComponentBC markers_[N];
+    const WaveType waves_;
+    const DataType h_;
+    const WaveFunction func_;
+
+    void init_(const size_t dir, const size_t side)
+    {
+        binfo_.dir = dir;
+        binfo_.side = side;
+        binfo_.is_periodic = false;
+        for (size_t c = 0; c < N; ++c) {
+            markers_[c].setBoundary(dir, side);
+        }
+    }
+
+    // characteristic state of ghost k from inner states u0 and u1
+    struct Kernel {
+        bool outgoing[N];
+        DataType nu[N];     // wave Courant numbers
+        VectorType w_inf;   // far-field amplitudes
+        VectorType left[N]; // L
+        VectorType right[N];
+
+        VectorType operator()(const Index k,
+                              const VectorType &u0,
+                              const VectorType &u1) const
+        {
+            VectorType wk;
+            for (size_t m = 0; m < N; ++m) {
+                const DataType w0 = left[m].dot(u0);
+                if (outgoing[m]) {
+                    wk[m] = w0 + static_cast<DataType>(k) *
+                                     (w0 - left[m].dot(u1));
+                } else {
+                    DataType a = static_cast<DataType>(k) * nu[m];
+                    a = (a < 1) ? a : 1;
+                    wk[m] = w0 + a * (w_inf[m] - w0);
+                }
+            }
+            VectorType uk;
+            for (size_t s = 0; s < N; ++s) {
+                uk[s] = right[s].dot(wk);
+            }
+            return uk;
+        }
+    };
+
+    void apply_(TLab &lab,
+                const BoundarySlab<IndexRangeType::Dim> &slab,
+                const DataType dt) const
+    {
+        if (slab.isEmpty()) {
+            return;
+        }
+        assert(slab.inner >= 2);
+        const WaveType waves = getWaves(); // once per slab
+        const DataType outward = (0 == slab.side) ? -1 : 1;
+        Kernel kernel;
+        for (size_t m = 0; m < N; ++m) {
+            const DataType lambda = outward * waves.speed[m];
+            kernel.outgoing[m] = !(lambda < 0);
+            kernel.nu[m] = (kernel.outgoing[m] ? lambda : -lambda) * dt / h_;
+            kernel.left[m] = waves.left[m];
+            kernel.right[m] = waves.right[m];
+            kernel.w_inf[m] = waves.left[m].dot(waves.target);
+        }
+
+        // see BC::Base::applyKernel_()
+        const size_t dir = slab.dir;
+        const Index sdir = (0 == slab.side) ? 1 : -1; // inward
+        const Index b = (0 == slab.side) ? 0 : slab.inner - 1;
+        MultiIndex rows = slab.extent;
+        rows[0] = 1;
+        const Index n = slab.extent[0];
+        DataType *dst[N];
+        const DataType *r0[N];
+        const DataType *r1[N];
+        VectorType u0, u1, uk;
+        for (const auto &p : IndexRangeType(rows)) {
+            MultiIndex q = p + slab.begin;
+            for (size_t s = 0; s < N; ++s) {
+                dst[s] = &lab.getLab(s)[q];
+            }
+            if (0 == dir) {
+                q[0] = b;
+                for (size_t s = 0; s < N; ++s) {
+                    const DataType *u = &lab.getLab(s)[q];
+                    u0[s] = u[0];
+                    u1[s] = u[sdir];
+                }
+                const Index k0 = sdir * (b - slab.begin[0]);
+                for (Index i = 0; i < n; ++i) {
+                    uk = kernel(k0 - sdir * i, u0, u1);
+                    for (size_t s = 0; s < N; ++s) {
+                        dst[s][i] = uk[s];
+                    }
+                }
+            } else {
+                const Index k = sdir * (b - q[dir]);
+                q[dir] = b;
+                for (size_t s = 0; s < N; ++s) {
+                    r0[s] = &lab.getLab(s)[q];
+                }
+                q[dir] += sdir;
+                for (size_t s = 0; s < N; ++s) {
+                    r1[s] = &lab.getLab(s)[q];
+                }
+                for (Index i = 0; i < n; ++i) {
+                    for (size_t s = 0; s < N; ++s) {
+                        u0[s] = r0[s][i];
+                        u1[s] = r1[s][i];
+                    }
+                    uk = kernel(k, u0, u1);
+                    for (size_t s = 0; s < N; ++s) {
+                        dst[s][i] = uk[s];
+                    }
+                }
+            }
+        }
+    }
+};
+
+template <typename TLab>
+constexpr size_t CharacteristicOutflow<TLab>::N;
+
+NAMESPACE_END(BC)
+NAMESPACE_END(Cubism)
+
+#endif /* CHARACTERISTICOUTFLOW_H_QW3NZ8KE */
@@ -7,7 +7,8 @@
 #define DIRICHLET_H_OIZZ1SS4
 
 #include "Cubism/BC/Base.h"
-#include <cassert>
+#include <algorithm>
+#include <functional>
 
 NAMESPACE_BEGIN(Cubism)
 NAMESPACE_BEGIN(BC)
@@ -17,7 +18,8 @@ NAMESPACE_BEGIN(BC)
  * @tparam Lab Type of ``FieldLab``
  *
  * @rst
- * Constant value Dirichlet boundary condition
+ * Constant value Dirichlet boundary condition.  A time-dependent value can be
+ * specified with a callback which is evaluated once per slab.
  * @endrst
  * */
 template <typename Lab>
@@ -29,6 +31,10 @@ class Dirichlet : public BC::Base<Lab>
     using DataType = typename Lab::DataType;
 
 public:
+    using typename BaseType::SlabType;
+    /** @brief Callback type for time-dependent boundary values */
+    using ValueFunction = std::function<DataType()>;
+
     /**
      * @brief Main constructor
      * @param dir Direction in which to apply the boundary
@@ -41,11 +47,35 @@ public:
         binfo_.is_periodic = false;
     }
 
+    /**
+     * @brief Constructor for a time-dependent boundary value
+     * @param dir Direction in which to apply the boundary
+     * @param side On which side along direction ``dir``
+     * @param val Callback that returns the boundary value
+     */
+    Dirichlet(const size_t dir, const size_t side, const ValueFunction &val)
+        : BaseType(dir, side), value_(0), func_(val)
+    {
+        binfo_.is_periodic = false;
+    }
+
     /**
      * @brief Apply boundary condition
      * @param lab Lab on which the boundary is applied
      */
-    void operator()(Lab &lab) override { apply_(lab); }
+    void operator()(Lab &lab) override
+    {
+        apply_(lab,
+               this->getSlab(lab.getActiveStencil(),
+                             lab.getActiveRange().getExtent()));
+    }
+
+    /**
+     * @brief Apply boundary condition to a precomputed slab
+     * @param lab Lab on which the boundary is applied
+     * @param slab Boundary slab
+     */
+    void apply(Lab &lab, const SlabType &slab) override { apply_(lab, slab); }
 
     /**
      * @brief Name of boundary condition
@@ -56,6 +86,10 @@ public:
     /**
      * @brief Get boundary value
      * @return Reference to ``DataType``
+     *
+     * @rst
+     * The constant value is not used if a callback is specified.
+     * @endrst
      */
     DataType &getValue() { return value_; }
     /**
@@ -68,47 +102,22 @@ private:
     using IndexRangeType = typename Lab::IndexRangeType;
     using MultiIndex = typename Lab::MultiIndex;
     using Index = typename MultiIndex::DataType;
-    using Stencil = typename Lab::StencilType;
 
     DataType value_;
+    const ValueFunction func_;
 
-    void apply_(Lab &lab) const
+    void apply_(Lab &lab, const SlabType &slab) const
     {
-        assert(binfo_.dir < IndexRangeType::Dim);
-        assert(0 == binfo_.side || 1 == binfo_.side);
-
-        const Stencil &stencil = lab.getActiveStencil();
-        if (!this->isValidStencil_(stencil)) {
+        if (slab.isEmpty()) {
             return; // nothing to do; zero stencil width for binfo_.dir
         }
-
-        MultiIndex extent;
-        if (stencil.isTensorial()) {
-            extent = lab.getActiveLabRange().getExtent();
-        } else {
-            extent = lab.getActiveRange().getExtent();
-        }
-
-        const MultiIndex sbegin = stencil.getBegin();
-        const MultiIndex send = stencil.getEnd();
-        MultiIndex start(0);
-        if (0 == binfo_.side) {
-            extent[binfo_.dir] = -sbegin[binfo_.dir];
-            if (stencil.isTensorial()) {
-                start = sbegin;
-            } else {
-                start[binfo_.dir] = sbegin[binfo_.dir];
-            }
-        } else {
-            extent[binfo_.dir] = send[binfo_.dir] - 1;
-            if (stencil.isTensorial()) {
-                start = sbegin;
-            }
-            start[binfo_.dir] = lab.getActiveRange().getExtent()[binfo_.dir];
-        }
-        const IndexRangeType slab(extent);
-        for (const auto &p : slab) {
-            lab[p + start] = value_;
+        const DataType value = func_ ? func_() : value_;
+        MultiIndex rows = slab.extent;
+        rows[0] = 1;
+        const Index n = slab.extent[0];
+        for (const auto &p : IndexRangeType(rows)) {
+            DataType *dst = &lab[p + slab.begin];
+            std::fill(dst, dst + n, value);
         }
     }
 };
@@ -0,0 +1,224 @@
+// File       : Engine.h
+// Created    : Fri Oct 16 2026 11:48:12 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Batched application of boundary conditions
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef ENGINE_H_R4TQ8BLW
+#define ENGINE_H_R4TQ8BLW
+
+#include "Cubism/BC/Base.h"
+#include "Cubism/Common.h"
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(BC)
+
+/**
+ * @brief Batched boundary condition engine
+ * @tparam DIM Dimension
+ *
+ * @rst
+ * Applies all boundary conditions of a block in one pass.  The boundary slab
+ * descriptors are computed once for a stencil and a lab extent and reused for
+ * subsequent blocks with the same geometry and boundary layout.  Each
+ * boundary condition is then applied with a single (virtual) call that fills
+ * its slab row by row.  The engine is used by ``Block::FieldLab`` for
+ * ``BCVector`` boundaries.
+ * @endrst
+ */
+template <size_t DIM>
+class Engine
+{
+public:
+    /** @brief Boundary slab type */
+    using SlabType = BoundarySlab<DIM>;
+    /** @brief Type for higher dimensional index */
+    using MultiIndex = typename SlabType::MultiIndex;
+    /** @brief Stencil type */
+    using StencilType = Core::Stencil<DIM>;
+
+    /** @brief Main constructor */
+    Engine() : inner_(0) {}
+
+    /**
+     * @brief Apply boundary conditions
+     * @tparam Lab Type of ``FieldLab``
+     * @param lab Loaded lab on which the boundaries are applied
+     * @param bcs Vector of boundary conditions for ``lab``
+     *
+     * @rst
+     * Boundary conditions are applied in the order of ``bcs``.
+     * @endrst
+     */
+    template <typename Lab>
+    void apply(Lab &lab, const std::vector<BC::Base<Lab> *> &bcs)
+    {
+        const StencilType &s = lab.getActiveStencil();
+        const MultiIndex inner = lab.getActiveRange().getExtent();
+        if (!isCached_(bcs, s, inner)) {
+            stencil_ = s;
+            inner_ = inner;
+            slabs_.clear();
+            for (const auto bc : bcs) {
+                slabs_.push_back(
+                    getBoundarySlab(bc->getBoundaryInfo(), s, inner));
+            }
+        }
+        for (size_t i = 0; i < bcs.size(); ++i) {
+            bcs[i]->apply(lab, slabs_[i]);
+        }
+    }
+
+    /**
+     * @brief Get cached boundary slabs
+     * @return Vector of slabs of the last application
+     */
+    const std::vector<SlabType> &getSlabs() const { return slabs_; }
+
+    /** @brief Clear cached boundary slabs */
+    void clear() { slabs_.clear(); }
+
+private:
+    StencilType stencil_;
+    MultiIndex inner_;
+    std::vector<SlabType> slabs_;
+
+    template <typename BCVector>
+    bool isCached_(const BCVector &bcs,
+                   const StencilType &s,
+                   const MultiIndex &inner) const
+    {
+        if (bcs.size() != slabs_.size() || !(s == stencil_) ||
+            inner != inner_) {
+            return false;
+        }
+        for (size_t i = 0; i < bcs.size(); ++i) {
+            const BoundaryInfo &info = bcs[i]->getBoundaryInfo();
+            if (info.dir != slabs_[i].dir || info.side != slabs_[i].side) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Compile-time list of boundary conditions
+ * @tparam Lab Type of ``FieldLab``
+ * @tparam BCs Boundary condition types
+ *
+ * @rst
+ * Alternative to a ``BCVector`` of base class pointers.  The boundary
+ * conditions are stored by value and applied with non-virtual calls, such
+ * that the compiler can inline the slab kernels.  Slabs are cached like in
+ * ``BC::Engine``.
+ *
+ * .. code-block:: cpp
+ *
+ *    using Lab = Block::FieldLab<Field>;
+ *    BC::TypedList<Lab, BC::Dirichlet<Lab>, BC::Symmetry<Lab>> bcs(
+ *        BC::Dirichlet<Lab>(1, 0, 0.0), BC::Symmetry<Lab>(1, 1));
+ *    lab.loadData(fid, fields, bcs);
+ * @endrst
+ */
+template <typename Lab, typename... BCs>
+class TypedList
+{
+public:
+    /** @brief Number of boundary conditions */
+    static constexpr size_t NBoundaries = sizeof...(BCs);
+    /** @brief Boundary slab type */
+    using SlabType = BoundarySlab<Lab::IndexRangeType::Dim>;
+    using MultiIndex = typename SlabType::MultiIndex;
+    using StencilType = typename Lab::StencilType;
+    using InfoArray = std::array<BoundaryInfo, NBoundaries>;
+
+    /**
+     * @brief Main constructor
+     * @param bcs Boundary conditions
+     */
+    TypedList(const BCs &... bcs) : bcs_(bcs...), inner_(0)
+    {
+        setInfo_<0>();
+    }
+
+    /**
+     * @brief Access boundary condition
+     * @tparam I Index in list
+     * @return Reference to boundary condition
+     */
+    template <size_t I>
+    typename std::tuple_element<I, std::tuple<BCs...>>::type &get()
+    {
+        return std::get<I>(bcs_);
+    }
+
+    /**
+     * @brief Boundary information of all boundaries
+     * @return Array of ``BoundaryInfo``
+     */
+    const InfoArray &getBoundaryInfo() const { return info_; }
+
+    /**
+     * @brief Apply boundary conditions
+     * @param lab Loaded lab on which the boundaries are applied
+     */
+    void apply(Lab &lab)
+    {
+        const StencilType &s = lab.getActiveStencil();
+        const MultiIndex inner = lab.getActiveRange().getExtent();
+        if (!(s == stencil_) || inner != inner_) {
+            stencil_ = s;
+            inner_ = inner;
+            for (size_t i = 0; i < NBoundaries; ++i) {
+                slabs_[i] = getBoundarySlab(info_[i], s, inner);
+            }
+        }
+        apply_<0>(lab);
+    }
+
+private:
+    std::tuple<BCs...> bcs_;
+    InfoArray info_;
+    StencilType stencil_;
+    MultiIndex inner_;
+    std::array<SlabType, NBoundaries> slabs_;
+
+    template <size_t I>
+    typename std::enable_if<(I < NBoundaries)>::type setInfo_()
+    {
+        info_[I] = std::get<I>(bcs_).getBoundaryInfo();
+        setInfo_<I + 1>();
+    }
+
+    template <size_t I>
+    typename std::enable_if<(I == NBoundaries)>::type setInfo_()
+    {
+    }
+
+    template <size_t I>
+    typename std::enable_if<(I < NBoundaries)>::type apply_(Lab &lab)
+    {
+        using BCType = typename std::tuple_element<I, std::tuple<BCs...>>::type;
+        // qualified call: no virtual dispatch
+        std::get<I>(bcs_).BCType::apply(lab, slabs_[I]);
+        apply_<I + 1>(lab);
+    }
+
+    template <size_t I>
+    typename std::enable_if<(I == NBoundaries)>::type apply_(Lab &)
+    {
+    }
+};
+
+template <typename Lab, typename... BCs>
+constexpr size_t TypedList<Lab, BCs...>::NBoundaries;
+
+NAMESPACE_END(BC)
+NAMESPACE_END(Cubism)
+
+#endif /* ENGINE_H_R4TQ8BLW */
@@ -0,0 +1,127 @@
+// File       : Extrapolation.h
+// Created    : Sat Oct 17 2026 01:05:27 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Polynomial extrapolation boundary condition
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef EXTRAPOLATION_H_3MZQ7VGE
+#define EXTRAPOLATION_H_3MZQ7VGE
+
+#include "Cubism/BC/Base.h"
+#include <stdexcept>
+#include <string>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(BC)
+
+/**
+ * @brief Extrapolation BC
+ * @tparam Lab Type of ``FieldLab``
+ *
+ * @rst
+ * Polynomial extrapolation of the inner values normal to the boundary into
+ * the ghosts.  The extrapolation order is 0 (constant), 1 (linear) or 2
+ * (quadratic) and uses the first ``order + 1`` inner values next to the
+ * boundary.  Order 0 is equivalent to ``Absorbing``.
+ * @endrst
+ * */
+template <typename Lab>
+class Extrapolation : public BC::Base<Lab>
+{
+    using BaseType = BC::Base<Lab>;
+    using BaseType::binfo_;
+
+    using DataType = typename Lab::DataType;
+
+public:
+    using typename BaseType::SlabType;
+
+    /**
+     * @brief Main constructor
+     * @param dir Direction in which to apply the boundary
+     * @param side On which side along direction ``dir``
+     * @param order Extrapolation order
+     */
+    Extrapolation(const size_t dir, const size_t side, const size_t order = 1)
+        : BaseType(dir, side), order_(order)
+    {
+        if (order_ > 2) {
+            throw std::runtime_error(
+                "Extrapolation: order must be 0, 1 or 2");
+        }
+        binfo_.is_periodic = false;
+    }
+
+    /**
+     * @brief Apply boundary condition
+     * @param lab Lab on which the boundary is applied
+     */
+    void operator()(Lab &lab) override
+    {
+        apply_(lab,
+               this->getSlab(lab.getActiveStencil(),
+                             lab.getActiveRange().getExtent()));
+    }
+
+    /**
+     * @brief Apply boundary condition to a precomputed slab
+     * @param lab Lab on which the boundary is applied
+     * @param slab Boundary slab
+     */
+    void apply(Lab &lab, const SlabType &slab) override { apply_(lab, slab); }
+
+    /**
+     * @brief Name of boundary condition
+     * @return Name string
+     */
+    std::string name() const override
+    {
+        if (0 == order_) {
+            return std::string("Zeroth-Order Extrapolation");
+        } else if (1 == order_) {
+            return std::string("Linear Extrapolation");
+        }
+        return std::string("Quadratic Extrapolation");
+    }
+
+    /**
+     * @brief Get extrapolation order
+     * @return Order
+     */
+    size_t getOrder() const { return order_; }
+
+private:
+    using Index = typename Lab::MultiIndex::DataType;
+
+    const size_t order_;
+
+    void apply_(Lab &lab, const SlabType &slab) const
+    {
+        if (0 == order_) {
+            BaseType::template applyKernel_<1>(
+                lab, slab, [](Index, DataType u0, DataType, DataType) {
+                    return u0;
+                });
+        } else if (1 == order_) {
+            BaseType::template applyKernel_<2>(
+                lab, slab, [](Index k, DataType u0, DataType u1, DataType) {
+                    return u0 + static_cast<DataType>(k) * (u0 - u1);
+                });
+        } else {
+            // Lagrange polynomial through u0, u1, u2 evaluated at distance k
+            BaseType::template applyKernel_<3>(
+                lab,
+                slab,
+                [](Index k, DataType u0, DataType u1, DataType u2) {
+                    const DataType a = static_cast<DataType>(k);
+                    return ((a + 1) * (a + 2) * u0 - 2 * a * (a + 2) * u1 +
+                            a * (a + 1) * u2) /
+                           2;
+                });
+        }
+    }
+};
+
+NAMESPACE_END(BC)
+NAMESPACE_END(Cubism)
+
+#endif /* EXTRAPOLATION_H_3MZQ7VGE */
@@ -0,0 +1,130 @@
+// File       : Neumann.h
+// Created    : Sat Oct 17 2026 01:22:48 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Neumann boundary condition
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef NEUMANN_H_Q8D2WHNC
+#define NEUMANN_H_Q8D2WHNC
+
+#include "Cubism/BC/Base.h"
+#include <functional>
+#include <string>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(BC)
+
+/**
+ * @brief Neumann BC
+ * @tparam Lab Type of ``FieldLab``
+ *
+ * @rst
+ * Prescribed gradient boundary condition.  The gradient is the derivative
+ * along the positive coordinate direction ``dir`` (independent of ``side``)
+ * and ``spacing`` is the mesh spacing along ``dir``.  Ghost values are
+ * obtained from the inner value next to the boundary with the prescribed
+ * gradient.  A time-dependent gradient can be specified with a callback which
+ * is evaluated once per slab.
+ * @endrst
+ * */
+template <typename Lab>
+class Neumann : public BC::Base<Lab>
+{
+    using BaseType = BC::Base<Lab>;
+    using BaseType::binfo_;
+
+    using DataType = typename Lab::DataType;
+
+public:
+    using typename BaseType::SlabType;
+    /** @brief Callback type for time-dependent gradients */
+    using ValueFunction = std::function<DataType()>;
+
+    /**
+     * @brief Main constructor
+     * @param dir Direction in which to apply the boundary
+     * @param side On which side along direction ``dir``
+     * @param gradient Boundary gradient
+     * @param spacing Mesh spacing along ``dir``
+     */
+    Neumann(const size_t dir,
+            const size_t side,
+            const DataType &gradient,
+            const DataType &spacing = 1)
+        : BaseType(dir, side), gradient_(gradient), spacing_(spacing)
+    {
+        binfo_.is_periodic = false;
+    }
+
+    /**
+     * @brief Constructor for a time-dependent gradient
+     * @param dir Direction in which to apply the boundary
+     * @param side On which side along direction ``dir``
+     * @param gradient Callback that returns the boundary gradient
+     * @param spacing Mesh spacing along ``dir``
+     */
+    Neumann(const size_t dir,
+            const size_t side,
+            const ValueFunction &gradient,
+            const DataType &spacing = 1)
+        : BaseType(dir, side), gradient_(0), spacing_(spacing),
+          func_(gradient)
+    {
+        binfo_.is_periodic = false;
+    }
+
+    /**
+     * @brief Apply boundary condition
+     * @param lab Lab on which the boundary is applied
+     */
+    void operator()(Lab &lab) override
+    {
+        apply_(lab,
+               this->getSlab(lab.getActiveStencil(),
+                             lab.getActiveRange().getExtent()));
+    }
+
+    /**
+     * @brief Apply boundary condition to a precomputed slab
+     * @param lab Lab on which the boundary is applied
+     * @param slab Boundary slab
+     */
+    void apply(Lab &lab, const SlabType &slab) override { apply_(lab, slab); }
+
+    /**
+     * @brief Name of boundary condition
+     * @return Name string
+     */
+    std::string name() const override { return std::string("Neumann"); }
+
+    /**
+     * @brief Get boundary gradient
+     * @return Current gradient (evaluates the callback if set)
+     */
+    DataType getGradient() const { return func_ ? func_() : gradient_; }
+
+private:
+    using Index = typename Lab::MultiIndex::DataType;
+
+    const DataType gradient_;
+    const DataType spacing_;
+    const ValueFunction func_;
+
+    void apply_(Lab &lab, const SlabType &slab) const
+    {
+        if (slab.isEmpty()) {
+            return;
+        }
+        // increment per ghost away from the boundary
+        const DataType du = ((0 == slab.side) ? -1 : 1) * getGradient() *
+                            spacing_;
+        BaseType::template applyKernel_<1>(
+            lab, slab, [du](Index k, DataType u0, DataType, DataType) {
+                return u0 + static_cast<DataType>(k) * du;
+            });
+    }
+};
+
+NAMESPACE_END(BC)
+NAMESPACE_END(Cubism)
+
+#endif /* NEUMANN_H_Q8D2WHNC */
@@ -0,0 +1,152 @@
+// File       : RelaxedExtrapolation.h
+// Created    : Sat Oct 17 2026 01:41:09 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Linear extrapolation relaxed towards a target value
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef RELAXEDEXTRAPOLATION_H_J6VNX1RA
+#define RELAXEDEXTRAPOLATION_H_J6VNX1RA
+
+#include "Cubism/BC/Base.h"
+#include <functional>
+#include <string>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(BC)
+
+/**
+ * @brief Relaxed extrapolation BC
+ * @tparam Lab Type of ``FieldLab``
+ *
+ * @rst
+ * Outflow boundary condition for a scalar quantity.  The inner values are
+ * extrapolated linearly into the ghosts and relaxed towards the far-field
+ * ``target`` value with the dimensionless coefficient ``sigma``:
+ *
+ * .. math::
+ *
+ *    u_k = u_0 + k\left[(u_0 - u_1) - \sigma (u_0 - u_\infty)\right]
+ *
+ * where :math:`k` is the ghost distance from the inner value :math:`u_0` next
+ * to the boundary.  ``sigma = 0`` is linear extrapolation, which may let the
+ * boundary state drift, larger values keep the boundary state close to the
+ * target.  A time-dependent target can be specified with a callback which is
+ * evaluated once per slab.
+ *
+ * This is not a characteristic (non-reflecting) boundary condition.  The
+ * relaxation does not depend on wave speeds or the time step and outgoing
+ * waves are partially reflected for any ``sigma``.  See
+ * ``CharacteristicOutflow`` for systems with a known wave decomposition.
+ * @endrst
+ * */
+template <typename Lab>
+class RelaxedExtrapolation : public BC::Base<Lab>
+{
+    using BaseType = BC::Base<Lab>;
+    using BaseType::binfo_;
+
+    using DataType = typename Lab::DataType;
+
+public:
+    using typename BaseType::SlabType;
+    /** @brief Callback type for time-dependent target values */
+    using ValueFunction = std::function<DataType()>;
+
+    /**
+     * @brief Main constructor
+     * @param dir Direction in which to apply the boundary
+     * @param side On which side along direction ``dir``
+     * @param target Far-field target value
+     * @param sigma Dimensionless relaxation coefficient
+     */
+    RelaxedExtrapolation(const size_t dir,
+                         const size_t side,
+                         const DataType &target,
+                         const DataType &sigma)
+        : BaseType(dir, side), target_(target), sigma_(sigma)
+    {
+        binfo_.is_periodic = false;
+    }
+
+    /**
+     * @brief Constructor for a time-dependent target value
+     * @param dir Direction in which to apply the boundary
+     * @param side On which side along direction ``dir``
+     * @param target Callback that returns the far-field target value
+     * @param sigma Dimensionless relaxation coefficient
+     */
+    RelaxedExtrapolation(const size_t dir,
+                         const size_t side,
+                         const ValueFunction &target,
+                         const DataType &sigma)
+        : BaseType(dir, side), target_(0), sigma_(sigma), func_(target)
+    {
+        binfo_.is_periodic = false;
+    }
+
+    /**
+     * @brief Apply boundary condition
+     * @param lab Lab on which the boundary is applied
+     */
+    void operator()(Lab &lab) override
+    {
+        apply_(lab,
+               this->getSlab(lab.getActiveStencil(),
+                             lab.getActiveRange().getExtent()));
+    }
+
+    /**
+     * @brief Apply boundary condition to a precomputed slab
+     * @param lab Lab on which the boundary is applied
+     * @param slab Boundary slab
+     */
+    void apply(Lab &lab, const SlabType &slab) override { apply_(lab, slab); }
+
+    /**
+     * @brief Name of boundary condition
+     * @return Name string
+     */
+    std::string name() const override
+    {
+        return std::string("Relaxed Extrapolation");
+    }
+
+    /**
+     * @brief Get far-field target value
+     * @return Current target value (evaluates the callback if set)
+     */
+    DataType getTarget() const { return func_ ? func_() : target_; }
+
+    /**
+     * @brief Get relaxation coefficient
+     * @return Dimensionless relaxation coefficient
+     */
+    DataType getSigma() const { return sigma_; }
+
+private:
+    using Index = typename Lab::MultiIndex::DataType;
+
+    const DataType target_;
+    const DataType sigma_;
+    const ValueFunction func_;
+
+    void apply_(Lab &lab, const SlabType &slab) const
+    {
+        if (slab.isEmpty()) {
+            return;
+        }
+        const DataType target = getTarget();
+        const DataType sigma = sigma_;
+        BaseType::template applyKernel_<2>(
+            lab,
+            slab,
+            [target, sigma](Index k, DataType u0, DataType u1, DataType) {
+                return u0 + static_cast<DataType>(k) *
+                                ((u0 - u1) - sigma * (u0 - target));
+            });
+    }
+};
+
+NAMESPACE_END(BC)
+NAMESPACE_END(Cubism)
+
+#endif /* RELAXEDEXTRAPOLATION_H_J6VNX1RA */
@@ -7,7 +7,6 @@
 #define SYMMETRY_H_8HROEJBQ
 
 #include "Cubism/BC/Base.h"
-#include <cassert>
 
 NAMESPACE_BEGIN(Cubism)
 NAMESPACE_BEGIN(BC)
@@ -29,6 +28,8 @@ class Symmetry : public BC::Base<Lab>
     using DataType = typename Lab::DataType;
 
 public:
+    using typename BaseType::SlabType;
+
     /**
      * @brief Main constructor
      * @param dir Direction in which to apply the boundary
@@ -50,7 +51,19 @@ public:
      * @brief Apply boundary condition
      * @param lab Lab on which the boundary is applied
      */
-    void operator()(Lab &lab) override { apply_(lab); }
+    void operator()(Lab &lab) override
+    {
+        apply_(lab,
+               this->getSlab(lab.getActiveStencil(),
+                             lab.getActiveRange().getExtent()));
+    }
+
+    /**
+     * @brief Apply boundary condition to a precomputed slab
+     * @param lab Lab on which the boundary is applied
+     * @param slab Boundary slab
+     */
+    void apply(Lab &lab, const SlabType &slab) override { apply_(lab, slab); }
 
     /**
      * @brief Name of boundary condition
@@ -62,54 +75,36 @@ private:
     using IndexRangeType = typename Lab::IndexRangeType;
     using MultiIndex = typename Lab::MultiIndex;
     using Index = typename MultiIndex::DataType;
-    using Stencil = typename Lab::StencilType;
 
     const DataType sign_;
 
-    void apply_(Lab &lab) const
+    void apply_(Lab &lab, const SlabType &slab) const
     {
-        assert(binfo_.dir < IndexRangeType::Dim);
-        assert(0 == binfo_.side || 1 == binfo_.side);
-
-        const Stencil &stencil = lab.getActiveStencil();
-        if (!this->isValidStencil_(stencil)) {
+        if (slab.isEmpty()) {
             return; // zero stencil width for binfo_.dir
         }
-
-        MultiIndex extent;
-        if (stencil.isTensorial()) {
-            extent = lab.getActiveLabRange().getExtent();
-        } else {
-            extent = lab.getActiveRange().getExtent();
-        }
-
-        const MultiIndex sbegin = stencil.getBegin();
-        const MultiIndex send = stencil.getEnd();
-        MultiIndex start(0);
-        Index roffset = 0;
-        if (0 == binfo_.side) {
-            extent[binfo_.dir] = -sbegin[binfo_.dir];
-            roffset = -1;
-            if (stencil.isTensorial()) {
-                start = sbegin;
+        const size_t dir = slab.dir;
+        // reflection r = roffset - q along dir
+        const Index roffset = (0 == slab.side) ? -1 : 2 * slab.inner - 1;
+        MultiIndex rows = slab.extent;
+        rows[0] = 1;
+        const Index n = slab.extent[0];
+        for (const auto &p : IndexRangeType(rows)) {
+            MultiIndex q = p + slab.begin;
+            DataType *dst = &lab[q];
+            if (0 == dir) {
+                // mirrored copy within the row
+                const DataType *src = dst + (roffset - 2 * q[0]);
+                for (Index i = 0; i < n; ++i) {
+                    dst[i] = sign_ * src[-i];
+                }
             } else {
-                start[binfo_.dir] = sbegin[binfo_.dir];
-            }
-        } else {
-            extent[binfo_.dir] = send[binfo_.dir] - 1;
-            const MultiIndex N = lab.getActiveRange().getExtent();
-            roffset = 2 * N[binfo_.dir] - 1;
-            if (stencil.isTensorial()) {
-                start = sbegin;
+                q[dir] = roffset - q[dir];
+                const DataType *src = &lab[q];
+                for (Index i = 0; i < n; ++i) {
+                    dst[i] = sign_ * src[i];
+                }
             }
-            start[binfo_.dir] = N[binfo_.dir];
-        }
-        const IndexRangeType slab(extent);
-        for (const auto &p : slab) {
-            const MultiIndex q = p + start;
-            MultiIndex r(q);
-            r[binfo_.dir] = roffset - r[binfo_.dir];
-            lab[q] = sign_ * lab[r];
         }
     }
 };
@@ -0,0 +1,260 @@
+// File       : CellMask.h
+// Created    : Sat Oct 17 2026 03:42:18 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Compact per-block cell mask for immersed boundaries
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef CELLMASK_H_K8VQ2NXD
+#define CELLMASK_H_K8VQ2NXD
+
+#include "Cubism/Common.h"
+#include "Cubism/Core/Index.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Block)
+
+/**
+ * @brief Classification of a masked block
+ *
+ * @rst
+ * Fluid
+ *    No cell of the block is solid.
+ *
+ * Solid
+ *    All cells of the block are solid.
+ *
+ * Mixed
+ *    The block contains fluid and solid cells.
+ * @endrst
+ */
+enum class MaskState { Fluid = 0, Solid, Mixed };
+
+/**
+ * @brief Cell mask of a block
+ * @tparam DIM Dimension
+ *
+ * @rst
+ * Stores one bit per cell of a block, a set bit marks a solid cell.  Bits are
+ * stored in the same (flat) order as the cell data of a block field, such
+ * that bit ``i`` corresponds to the data element ``i`` of a cell field.  The
+ * number of solid cells is maintained with each update, the classification
+ * ``getState()`` is therefore available at no cost.  Runs of fluid cells are
+ * extracted word-wise with ``forEachFluidRun()``.
+ * @endrst
+ */
+template <size_t DIM>
+class CellMask
+{
+public:
+    /** @brief Index range type */
+    using IndexRangeType = Core::IndexRange<DIM>;
+    /** @brief Type for higher dimensional index */
+    using MultiIndex = typename IndexRangeType::MultiIndex;
+    /** @brief Storage word type */
+    using WordType = uint64_t;
+
+    /** @brief Number of bits per storage word */
+    static constexpr size_t WordBits = 64;
+
+    /** @brief Default constructor (empty mask) */
+    CellMask() : range_(0), nsolid_(0) {}
+
+    /**
+     * @brief Main constructor
+     * @param r Cell index range of the block
+     * @param solid Initial state of all cells
+     */
+    CellMask(const IndexRangeType &r, const bool solid = false)
+        : range_(r), nsolid_(0)
+    {
+        words_.resize((range_.size() + WordBits - 1) / WordBits);
+        fill(solid);
+    }
+
+    /**
+     * @brief Number of cells
+     * @return Number of cells covered by the mask
+     */
+    size_t size() const { return range_.size(); }
+
+    /**
+     * @brief Cell index range
+     * @return Index range of the mask
+     */
+    const IndexRangeType &getIndexRange() const { return range_; }
+
+    /**
+     * @brief Set all cells
+     * @param solid New state of all cells
+     */
+    void fill(const bool solid)
+    {
+        const size_t n = size();
+        for (auto &w : words_) {
+            w = solid ? ~static_cast<WordType>(0) : 0;
+        }
+        if (solid && (n % WordBits) > 0) {
+            // keep bits beyond the last cell cleared
+            words_.back() = (static_cast<WordType>(1) << (n % WordBits)) - 1;
+        }
+        nsolid_ = solid ? n : 0;
+    }
+
+    /**
+     * @brief Set the state of a cell
+     * @param i Flat cell index
+     * @param solid New state of the cell
+     */
+    void set(const size_t i, const bool solid)
+    {
+        assert(i < size());
+        WordType &w = words_[i / WordBits];
+        const WordType bit = static_cast<WordType>(1) << (i % WordBits);
+        if (solid && !(w & bit)) {
+            w |= bit;
+            ++nsolid_;
+        } else if (!solid && (w & bit)) {
+            w &= ~bit;
+            --nsolid_;
+        }
+    }
+
+    /**
+     * @brief Set the state of a cell
+     * @param p Local multi-dimensional cell index
+     * @param solid New state of the cell
+     */
+    void set(const MultiIndex &p, const bool solid)
+    {
+        set(range_.getFlatIndex(p), solid);
+    }
+
+    /**
+     * @brief Test if a cell is solid
+     * @param i Flat cell index
+     * @return True if the cell is solid
+     */
+    bool isSolid(const size_t i) const
+    {
+        assert(i < size());
+        return (words_[i / WordBits] >> (i % WordBits)) & 1;
+    }
+
+    /**
+     * @brief Test if a cell is solid
+     * @param p Local multi-dimensional cell index
+     * @return True if the cell is solid
+     */
+    bool isSolid(const MultiIndex &p) const
+    {
+        return isSolid(range_.getFlatIndex(p));
+    }
+
+    /**
+     * @brief Number of solid cells
+     * @return Number of cells with a set mask bit
+     */
+    size_t getSolidCount() const { return nsolid_; }
+
+    /**
+     * @brief Block classification
+     * @return ``MaskState`` of the block
+     */
+    MaskState getState() const
+    {
+        if (0 == nsolid_) {
+            return MaskState::Fluid;
+        } else if (size() == nsolid_) {
+            return MaskState::Solid;
+        }
+        return MaskState::Mixed;
+    }
+
+    /**
+     * @brief Visit contiguous runs of fluid cells
+     * @tparam Func Callable type
+     * @param f Functor ``f(begin, n)`` called for ``n`` fluid cells starting
+     * at flat index ``begin``
+     *
+     * @rst
+     * Runs are visited in increasing order of the flat index and are maximal,
+     * i.e. two runs are separated by at least one solid cell.  Words without
+     * solid cells and words with only solid cells are handled with a single
+     * comparison, the bits of mixed words are visited one by one.
+     * @endrst
+     */
+    template <typename Func>
+    void forEachFluidRun(Func &&f) const
+    {
+        const size_t n = size();
+        if (0 == nsolid_) {
+            if (n > 0) {
+                f(static_cast<size_t>(0), n);
+            }
+            return;
+        }
+        size_t begin = 0; // begin of current run
+        size_t len = 0;   // length of current run
+        for (size_t k = 0; k < words_.size(); ++k) {
+            const size_t base = k * WordBits;
+            const size_t nbits = (base + WordBits <= n) ? WordBits : n - base;
+            const WordType w = words_[k];
+            if (0 == w) {
+                if (0 == len) {
+                    begin = base;
+                }
+                len += nbits;
+                continue;
+            }
+            // bits beyond the last cell are cleared
+            const WordType full = (WordBits == nbits)
+                                      ? ~static_cast<WordType>(0)
+                                      : (static_cast<WordType>(1) << nbits) - 1;
+            if (full == w) {
+                if (len > 0) {
+                    f(begin, len);
+                    len = 0;
+                }
+                continue;
+            }
+            for (size_t b = 0; b < nbits; ++b) {
+                if ((w >> b) & 1) {
+                    if (len > 0) {
+                        f(begin, len);
+                        len = 0;
+                    }
+                } else {
+                    if (0 == len) {
+                        begin = base + b;
+                    }
+                    ++len;
+                }
+            }
+        }
+        if (len > 0) {
+            f(begin, len);
+        }
+    }
+
+    /**
+     * @brief Mask data
+     * @return ``const`` reference to storage words
+     */
+    const std::vector<WordType> &getWords() const { return words_; }
+
+private:
+    IndexRangeType range_;
+    size_t nsolid_;
+    std::vector<WordType> words_;
+};
+
+template <size_t DIM>
+constexpr size_t CellMask<DIM>::WordBits;
+
+NAMESPACE_END(Block)
+NAMESPACE_END(Cubism)
+
+#endif /* CELLMASK_H_K8VQ2NXD */
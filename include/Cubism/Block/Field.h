@@ -9,6 +9,7 @@
 #include "Cubism/Alloc/AlignedBlockAllocator.h"
 #include "Cubism/BC/Base.h"
 #include "Cubism/Block/Data.h"
+#include "Cubism/Block/FieldExpression.h"
 #include "Cubism/Block/FieldLab.h"
 #include "Cubism/Block/FieldOperator.h"
 #include "Cubism/Common.h"
@@ -295,6 +296,25 @@ public:
         copyState_(c);
     }
 
+    /**
+     * @brief Construct from a field expression
+     * @tparam E Expression type
+     * @param e Field expression
+     *
+     * @rst
+     * Allocates a new field with state and boundary conditions of the first
+     * field operand in ``e`` and evaluates the expression into it.
+     * @endrst
+     */
+    template <typename E>
+    Field(const FieldExpression<E> &e)
+        : Field(e.derived().getField().getIndexRange(),
+                e.derived().getField().getState())
+    {
+        bc_ = e.derived().getField().getBC();
+        fieldEvaluate<FieldOpAssign>(block_, e.derived(), range_.size());
+    }
+
     /**
      * @brief Standard move constructor
      * @param c Field to move from
@@ -441,18 +461,6 @@ public:
      */
     const BCVector &getBC() const { return bc_; }
 
-    Field operator-() const
-    {
-        Field f(*this);
-        // TODO: [fabianw@mavt.ethz.ch; 2020-01-02] bit-flip might be better
-        for (size_t i = 0; i < range_.size(); ++i) {
-            f[i] = -f[i];
-        }
-        return f;
-    }
-
-    // TODO: [fabianw@mavt.ethz.ch; 2020-01-02] Field FMA
-
     // TODO: [fabianw@mavt.ethz.ch; 2020-01-17] document these members
     Field &operator+=(const Field &rhs)
     {
@@ -477,15 +485,6 @@ public:
         return *this;
     }
 
-    // The following use RVO on non-const lhs
-    friend Field operator+(Field lhs, const Field &rhs) { return (lhs += rhs); }
-
-    friend Field operator-(Field lhs, const Field &rhs) { return (lhs -= rhs); }
-
-    friend Field operator*(Field lhs, const Field &rhs) { return (lhs *= rhs); }
-
-    friend Field operator/(Field lhs, const Field &rhs) { return (lhs /= rhs); }
-
     // Scalar rhs
     Field &operator+=(const DataType rhs)
     {
@@ -511,39 +510,57 @@ public:
         return *this;
     }
 
-    friend Field operator+(Field lhs, const DataType rhs)
-    {
-        return (lhs += rhs);
-    }
-
-    friend Field operator-(Field lhs, const DataType rhs)
-    {
-        return (lhs -= rhs);
-    }
-
-    friend Field operator*(Field lhs, const DataType rhs)
+    /**
+     * @brief Assign a field expression
+     * @tparam E Expression type
+     * @param e Field expression
+     * @return This field with data evaluated from ``e``
+     *
+     * @rst
+     * Binary operators on fields (``+``, ``-``, ``*``, ``/`` and unary
+     * negation) return lazy expressions, see ``FieldExpression``.  The
+     * expression is evaluated in a single loop without temporary fields.  Only
+     * field data is assigned, not state.
+     * @endrst
+     */
+    template <typename E>
+    Field &operator=(const FieldExpression<E> &e)
     {
-        return (lhs *= rhs);
+        assert(range_.size() == e.derived().size());
+        fieldEvaluate<FieldOpAssign>(block_, e.derived(), range_.size());
+        return *this;
     }
 
-    friend Field operator/(Field lhs, const DataType rhs)
+    template <typename E>
+    Field &operator+=(const FieldExpression<E> &e)
     {
-        return (lhs /= rhs);
+        assert(range_.size() == e.derived().size());
+        fieldEvaluate<FieldOpAdd>(block_, e.derived(), range_.size());
+        return *this;
     }
 
-    friend Field operator+(const DataType lhs, Field rhs)
+    template <typename E>
+    Field &operator-=(const FieldExpression<E> &e)
     {
-        return (rhs += lhs);
+        assert(range_.size() == e.derived().size());
+        fieldEvaluate<FieldOpSub>(block_, e.derived(), range_.size());
+        return *this;
     }
 
-    friend Field operator-(const DataType lhs, Field rhs)
+    template <typename E>
+    Field &operator*=(const FieldExpression<E> &e)
     {
-        return -(rhs -= lhs);
+        assert(range_.size() == e.derived().size());
+        fieldEvaluate<FieldOpMul>(block_, e.derived(), range_.size());
+        return *this;
     }
 
-    friend Field operator*(const DataType lhs, Field rhs)
+    template <typename E>
+    Field &operator/=(const FieldExpression<E> &e)
     {
-        return (rhs *= lhs);
+        assert(range_.size() == e.derived().size());
+        fieldEvaluate<FieldOpDiv>(block_, e.derived(), range_.size());
+        return *this;
     }
 
     // TODO: [fabianw@mavt.ethz.ch; 2020-01-02] reciprocal() should not perform
@@ -555,6 +572,76 @@ public:
         return;
     }
 
+    /**
+     * @brief Fused update ``this = a * x + this``
+     * @param a Scalar factor
+     * @param x Field to be scaled and added
+     * @return This field
+     *
+     * @rst
+     * Performs the update in a single pass over the block data.  Compared to
+     * a sequence of compound assignments, ``x`` and this field are read only
+     * once.
+     * @endrst
+     */
+    Field &axpy(const DataType a, const Field &x)
+    {
+        assert(range_.size() == x.range_.size());
+        fieldAxpy(a, x.block_, block_, range_.size());
+        return *this;
+    }
+
+    /**
+     * @brief Fused update ``this = a * x + b * this``
+     * @param a Scalar factor for ``x``
+     * @param x Source field
+     * @param b Scalar factor for this field
+     * @return This field
+     */
+    Field &axpby(const DataType a, const Field &x, const DataType b)
+    {
+        assert(range_.size() == x.range_.size());
+        fieldAxpby(a, x.block_, b, block_, range_.size());
+        return *this;
+    }
+
+    /**
+     * @brief Fused update ``this = a * u0 + b * u1 + c * rhs``
+     * @param a Scalar factor for ``u0``
+     * @param u0 First source field
+     * @param b Scalar factor for ``u1``
+     * @param u1 Second source field
+     * @param c Scalar factor for ``rhs``
+     * @param rhs Third source field
+     * @return This field
+     *
+     * @rst
+     * Three-operand linear combination as used in low-storage and SSP
+     * Runge-Kutta stages, where ``c`` includes the time step (``c * dt``).
+     * Any of the source fields may be this field.
+     * @endrst
+     */
+    Field &linComb(const DataType a,
+                   const Field &u0,
+                   const DataType b,
+                   const Field &u1,
+                   const DataType c,
+                   const Field &rhs)
+    {
+        assert(range_.size() == u0.range_.size());
+        assert(range_.size() == u1.range_.size());
+        assert(range_.size() == rhs.range_.size());
+        fieldLinComb(a,
+                     u0.block_,
+                     b,
+                     u1.block_,
+                     c,
+                     rhs.block_,
+                     block_,
+                     range_.size());
+        return *this;
+    }
+
 private:
     const bool is_subfield_; // Indicates whether this field is a sub-field of a
                              // rank > 0 tensor.
@@ -724,6 +811,22 @@ public:
         }
     }
 
+    /**
+     * @brief Construct from a field container expression
+     * @tparam E Expression type
+     * @param e Container expression
+     */
+    template <typename E>
+    FieldContainer(const FieldContainerExpression<E> &e)
+        : components_(e.derived().size(), nullptr)
+    {
+        for (size_t i = 0; i < components_.size(); ++i) {
+            if (e.derived().hasComponent(i)) {
+                components_[i] = new BaseType(e.derived().component(i));
+            }
+        }
+    }
+
     /**
      * @brief Standard move constructor
      * @param c Field container to move from
@@ -1022,20 +1125,6 @@ public:
     }
 
     // TODO: [fabianw@mavt.ethz.ch; 2020-01-17] document these methods
-    FieldContainer operator-() const
-    {
-        FieldContainer fc(*this);
-        for (size_t i = 0; i < fc.components_.size(); ++i) {
-            BaseType *comp = fc.components_[i];
-            if (comp) {
-                // FIXME: [fabianw@mavt.ethz.ch; 2019-12-31] this is
-                // inefficient
-                *comp = -(*comp);
-            }
-        }
-        return fc;
-    }
-
     FieldContainer &operator+=(const FieldContainer &rhs)
     {
         FIELD_CONTAINER_OP_FIELD(+=);
@@ -1057,31 +1146,6 @@ public:
         return *this;
     }
 
-    // The following use RVO on non-const lhs
-    friend FieldContainer operator+(FieldContainer lhs,
-                                    const FieldContainer &rhs)
-    {
-        return (lhs += rhs);
-    }
-
-    friend FieldContainer operator-(FieldContainer lhs,
-                                    const FieldContainer &rhs)
-    {
-        return (lhs -= rhs);
-    }
-
-    friend FieldContainer operator*(FieldContainer lhs,
-                                    const FieldContainer &rhs)
-    {
-        return (lhs *= rhs);
-    }
-
-    friend FieldContainer operator/(FieldContainer lhs,
-                                    const FieldContainer &rhs)
-    {
-        return (lhs /= rhs);
-    }
-
     // Scalar rhs
     FieldContainer &operator+=(const DataType rhs)
     {
@@ -1107,56 +1171,158 @@ public:
         return *this;
     }
 
-    friend FieldContainer operator+(FieldContainer lhs, const DataType rhs)
+    /**
+     * @brief Assign a field container expression
+     * @tparam E Expression type
+     * @param e Container expression
+     * @return This container with data evaluated from ``e``
+     *
+     * @rst
+     * Each component is evaluated in a single fused loop, see
+     * ``FieldContainerExpression``.  Components that are ``nullptr`` are
+     * skipped.
+     * @endrst
+     */
+    template <typename E>
+    FieldContainer &operator=(const FieldContainerExpression<E> &e)
     {
-        return (lhs += rhs);
+        applyExpression_<FieldOpAssign>(e.derived());
+        return *this;
     }
 
-    friend FieldContainer operator-(FieldContainer lhs, const DataType rhs)
+    template <typename E>
+    FieldContainer &operator+=(const FieldContainerExpression<E> &e)
     {
-        return (lhs -= rhs);
+        applyExpression_<FieldOpAdd>(e.derived());
+        return *this;
     }
 
-    friend FieldContainer operator*(FieldContainer lhs, const DataType rhs)
+    template <typename E>
+    FieldContainer &operator-=(const FieldContainerExpression<E> &e)
     {
-        return (lhs *= rhs);
+        applyExpression_<FieldOpSub>(e.derived());
+        return *this;
     }
 
-    friend FieldContainer operator/(FieldContainer lhs, const DataType rhs)
+    template <typename E>
+    FieldContainer &operator*=(const FieldContainerExpression<E> &e)
     {
-        return (lhs /= rhs);
+        applyExpression_<FieldOpMul>(e.derived());
+        return *this;
     }
 
-    friend FieldContainer operator+(const DataType lhs, FieldContainer rhs)
+    template <typename E>
+    FieldContainer &operator/=(const FieldContainerExpression<E> &e)
     {
-        return (rhs += lhs);
+        applyExpression_<FieldOpDiv>(e.derived());
+        return *this;
     }
 
-    friend FieldContainer operator-(const DataType lhs, FieldContainer rhs)
+    void reciprocal(const DataType c = 1)
     {
-        return -(rhs -= lhs);
+        for (size_t i = 0; i < components_.size(); ++i) {
+            BaseType *comp = components_[i];
+            if (comp) {
+                comp->reciprocal(c);
+            }
+        }
+        return;
     }
 
-    friend FieldContainer operator*(const DataType lhs, FieldContainer rhs)
+    /**
+     * @brief Component-wise fused update ``this = a * x + this``
+     * @param a Scalar factor
+     * @param x Container to be scaled and added
+     * @return This container
+     */
+    FieldContainer &axpy(const DataType a, const FieldContainer &x)
     {
-        return (rhs *= lhs);
+        assert(components_.size() == x.components_.size());
+        for (size_t i = 0; i < components_.size(); ++i) {
+            BaseType *comp = components_[i];
+            const BaseType *src = x.components_[i];
+            if (comp && src) {
+                comp->axpy(a, *src);
+            }
+        }
+        return *this;
     }
 
-    void reciprocal(const DataType c = 1)
+    /**
+     * @brief Component-wise fused update ``this = a * x + b * this``
+     * @param a Scalar factor for ``x``
+     * @param x Source container
+     * @param b Scalar factor for this container
+     * @return This container
+     */
+    FieldContainer &
+    axpby(const DataType a, const FieldContainer &x, const DataType b)
     {
+        assert(components_.size() == x.components_.size());
         for (size_t i = 0; i < components_.size(); ++i) {
             BaseType *comp = components_[i];
-            if (comp) {
-                comp->reciprocal(c);
+            const BaseType *src = x.components_[i];
+            if (comp && src) {
+                comp->axpby(a, *src, b);
             }
         }
-        return;
+        return *this;
+    }
+
+    /**
+     * @brief Component-wise fused update ``this = a * u0 + b * u1 + c * rhs``
+     * @param a Scalar factor for ``u0``
+     * @param u0 First source container
+     * @param b Scalar factor for ``u1``
+     * @param u1 Second source container
+     * @param c Scalar factor for ``rhs``
+     * @param rhs Third source container
+     * @return This container
+     */
+    FieldContainer &linComb(const DataType a,
+                            const FieldContainer &u0,
+                            const DataType b,
+                            const FieldContainer &u1,
+                            const DataType c,
+                            const FieldContainer &rhs)
+    {
+        assert(components_.size() == u0.components_.size());
+        assert(components_.size() == u1.components_.size());
+        assert(components_.size() == rhs.components_.size());
+        for (size_t i = 0; i < components_.size(); ++i) {
+            BaseType *comp = components_[i];
+            const BaseType *s0 = u0.components_[i];
+            const BaseType *s1 = u1.components_[i];
+            const BaseType *s2 = rhs.components_[i];
+            if (comp && s0 && s1 && s2) {
+                comp->linComb(a, *s0, b, *s1, c, *s2);
+            }
+        }
+        return *this;
     }
 
 protected:
     ContainerType components_;
 
 private:
+    /**
+     * @brief Apply a container expression component-wise
+     * @tparam Op Assignment operation
+     * @tparam E Expression type
+     * @param e Container expression
+     */
+    template <typename Op, typename E>
+    void applyExpression_(const E &e)
+    {
+        assert(components_.size() == e.size());
+        for (size_t i = 0; i < components_.size(); ++i) {
+            BaseType *comp = components_[i];
+            if (comp && e.hasComponent(i)) {
+                Op::assign(*comp, e.component(i));
+            }
+        }
+    }
+
     /**
      * @brief Return a component
      * @param i Component ID
@@ -1395,11 +1561,42 @@ public:
         }
     }
 
+    /**
+     * @brief Construct from a field container expression
+     * @tparam E Expression type
+     * @param e Container expression with ``NComponents`` components
+     */
+    template <typename E>
+    TensorField(const FieldContainerExpression<E> &e)
+        : TensorField(e.derived().component(0).getField().getIndexRange(),
+                      e.derived().component(0).getField().getState())
+    {
+        assert(e.derived().size() == NComponents);
+        for (size_t i = 0; i < NComponents; ++i) {
+            const auto ci = e.derived().component(i);
+            components_[i]->getBC() = ci.getField().getBC();
+            *components_[i] = ci;
+        }
+    }
+
     TensorField(TensorField &&c) = default;
     TensorField &operator=(const TensorField &rhs) = default;
     TensorField &operator=(TensorField &&c) = default;
     ~TensorField() = default;
 
+    /**
+     * @brief Assign a field container expression
+     * @tparam E Expression type
+     * @param e Container expression
+     * @return This tensor field with data evaluated from ``e``
+     */
+    template <typename E>
+    TensorField &operator=(const FieldContainerExpression<E> &e)
+    {
+        BaseType::operator=(e);
+        return *this;
+    }
+
     /**
      * @brief Get index range
      * @return Index range spanned by the data
@@ -0,0 +1,791 @@
+// File       : FieldExpression.h
+// Created    : Thu Oct 15 2026 07:05:12 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Lazy expression templates for block field arithmetic
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef FIELDEXPRESSION_H_M4TQ8ZKE
+#define FIELDEXPRESSION_H_M4TQ8ZKE
+
+#include "Cubism/Common.h"
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Block)
+
+template <typename TField>
+class FieldContainer;
+
+/** @brief Element-wise assignment */
+struct FieldOpAssign {
+    template <typename T>
+    static T apply(const T, const T b)
+    {
+        return b;
+    }
+    template <typename L, typename R>
+    static void assign(L &l, const R &r)
+    {
+        l = r;
+    }
+};
+
+/** @brief Element-wise addition */
+struct FieldOpAdd {
+    template <typename T>
+    static T apply(const T a, const T b)
+    {
+        return a + b;
+    }
+    template <typename L, typename R>
+    static void assign(L &l, const R &r)
+    {
+        l += r;
+    }
+};
+
+/** @brief Element-wise subtraction */
+struct FieldOpSub {
+    template <typename T>
+    static T apply(const T a, const T b)
+    {
+        return a - b;
+    }
+    template <typename L, typename R>
+    static void assign(L &l, const R &r)
+    {
+        l -= r;
+    }
+};
+
+/** @brief Element-wise multiplication */
+struct FieldOpMul {
+    template <typename T>
+    static T apply(const T a, const T b)
+    {
+        return a * b;
+    }
+    template <typename L, typename R>
+    static void assign(L &l, const R &r)
+    {
+        l *= r;
+    }
+};
+
+/** @brief Element-wise division */
+struct FieldOpDiv {
+    template <typename T>
+    static T apply(const T a, const T b)
+    {
+        return a / b;
+    }
+    template <typename L, typename R>
+    static void assign(L &l, const R &r)
+    {
+        l /= r;
+    }
+};
+
+/** @brief Element-wise negation */
+struct FieldOpNeg {
+    template <typename T>
+    static T apply(const T a)
+    {
+        return -a;
+    }
+};
+
+template <typename E>
+class FieldExpressionIterator;
+
+template <typename E>
+class FieldContainerExpressionIterator;
+
+/**
+ * @brief Base class of scalar field expressions
+ * @tparam E Derived expression type
+ *
+ * @rst
+ * Expressions are lazy: they hold references to their field operands and are
+ * evaluated element by element in a single loop when assigned to a field.
+ * Arithmetic on block fields therefore does not create temporary fields:
+ *
+ * .. code-block:: cpp
+ *
+ *    a = b + 2.0 * c;  // one fused loop, no temporaries
+ *    a += dt * (b - c);
+ *    Field d = a * b;  // allocates d only
+ *
+ * Because operands are referenced, an expression stored with ``auto`` must
+ * not outlive its operands and reflects changes to them until evaluated.
+ * Temporary fields used as operands are moved into the expression.
+ * @endrst
+ */
+template <typename E>
+class FieldExpression
+{
+public:
+    /**
+     * @brief Derived expression
+     * @return ``const`` reference to derived expression
+     */
+    const E &derived() const { return static_cast<const E &>(*this); }
+
+    /**
+     * @brief Begin of evaluated expression
+     * @return Iterator
+     */
+    FieldExpressionIterator<E> begin() const
+    {
+        return FieldExpressionIterator<E>(&derived(), 0);
+    }
+
+    /**
+     * @brief End of evaluated expression
+     * @return Iterator
+     */
+    FieldExpressionIterator<E> end() const
+    {
+        return FieldExpressionIterator<E>(&derived(), derived().size());
+    }
+};
+
+/**
+ * @brief Base class of field container expressions
+ * @tparam E Derived expression type
+ *
+ * @rst
+ * Component-wise expression for ``FieldContainer`` types (e.g.
+ * ``TensorField``).  Each component of the container expression is a field
+ * expression that is evaluated in its own fused loop.
+ * @endrst
+ */
+template <typename E>
+class FieldContainerExpression
+{
+public:
+    /**
+     * @brief Derived expression
+     * @return ``const`` reference to derived expression
+     */
+    const E &derived() const { return static_cast<const E &>(*this); }
+
+    /**
+     * @brief Begin of component expressions
+     * @return Iterator
+     */
+    FieldContainerExpressionIterator<E> begin() const
+    {
+        return FieldContainerExpressionIterator<E>(&derived(), 0);
+    }
+
+    /**
+     * @brief End of component expressions
+     * @return Iterator
+     */
+    FieldContainerExpressionIterator<E> end() const
+    {
+        return FieldContainerExpressionIterator<E>(&derived(),
+                                                   derived().size());
+    }
+};
+
+/**
+ * @brief Read-only iterator over the values of a field expression
+ * @tparam E Expression type
+ */
+template <typename E>
+class FieldExpressionIterator
+{
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = typename E::DataType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = value_type;
+
+    FieldExpressionIterator(const E *e, const size_t i) : e_(e), i_(i) {}
+
+    reference operator*() const { return (*e_)[i_]; }
+    FieldExpressionIterator &operator++()
+    {
+        ++i_;
+        return *this;
+    }
+    FieldExpressionIterator operator++(int)
+    {
+        FieldExpressionIterator tmp(*this);
+        ++i_;
+        return tmp;
+    }
+    bool operator==(const FieldExpressionIterator &rhs) const
+    {
+        return i_ == rhs.i_;
+    }
+    bool operator!=(const FieldExpressionIterator &rhs) const
+    {
+        return i_ != rhs.i_;
+    }
+
+private:
+    const E *e_;
+    size_t i_;
+};
+
+/**
+ * @brief Read-only iterator over the components of a container expression
+ * @tparam E Expression type
+ *
+ * @rst
+ * Dereferencing yields a pointer-like proxy to the component expression, such
+ * that iteration follows the pointer semantics of ``FieldContainer``.
+ * @endrst
+ */
+template <typename E>
+class FieldContainerExpressionIterator
+{
+public:
+    using ComponentType = typename E::ComponentType;
+
+    /** @brief Pointer-like handle to a component expression */
+    class Proxy
+    {
+    public:
+        explicit Proxy(ComponentType &&c) : c_(std::move(c)) {}
+        const ComponentType &operator*() const { return c_; }
+        const ComponentType *operator->() const { return &c_; }
+
+    private:
+        ComponentType c_;
+    };
+
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Proxy;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Proxy *;
+    using reference = Proxy;
+
+    FieldContainerExpressionIterator(const E *e, const size_t i)
+        : e_(e), i_(i)
+    {
+    }
+
+    reference operator*() const { return Proxy(e_->component(i_)); }
+    FieldContainerExpressionIterator &operator++()
+    {
+        ++i_;
+        return *this;
+    }
+    FieldContainerExpressionIterator operator++(int)
+    {
+        FieldContainerExpressionIterator tmp(*this);
+        ++i_;
+        return tmp;
+    }
+    bool operator==(const FieldContainerExpressionIterator &rhs) const
+    {
+        return i_ == rhs.i_;
+    }
+    bool operator!=(const FieldContainerExpressionIterator &rhs) const
+    {
+        return i_ != rhs.i_;
+    }
+
+private:
+    const E *e_;
+    size_t i_;
+};
+
+/**
+ * @brief Fused evaluation of a field expression
+ * @tparam Op Element-wise operation applied to destination and expression
+ * @tparam T Destination data type
+ * @tparam E Expression type
+ * @param dst Destination data
+ * @param e Expression
+ * @param n Number of elements
+ *
+ * @rst
+ * Element ``i`` of the expression only depends on element ``i`` of its
+ * operands, hence ``dst`` may alias any of the operands.
+ * @endrst
+ */
+template <typename Op, typename T, typename E>
+inline void fieldEvaluate(T *dst, const E &e, const size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = Op::apply(dst[i], static_cast<T>(e[i]));
+    }
+}
+
+/** @brief Scalar operand */
+template <typename T>
+class FieldScalarExpr
+{
+public:
+    using DataType = T;
+
+    explicit FieldScalarExpr(const T v) : v_(v) {}
+    DataType operator[](const size_t) const { return v_; }
+
+private:
+    T v_;
+};
+
+/** @brief Scalar field operand (by reference) */
+template <typename TField>
+class FieldRefExpr : public FieldExpression<FieldRefExpr<TField>>
+{
+public:
+    using FieldType = typename TField::FieldType;
+    using DataType = typename FieldType::DataType;
+
+    explicit FieldRefExpr(const TField &f) : f_(f), data_(f.getData()) {}
+    DataType operator[](const size_t i) const { return data_[i]; }
+    size_t size() const { return f_.size(); }
+    const FieldType &getField() const { return f_; }
+
+private:
+    const FieldType &f_;
+    const DataType *data_;
+};
+
+/** @brief Scalar field operand (owned temporary) */
+template <typename TField>
+class FieldValueExpr : public FieldExpression<FieldValueExpr<TField>>
+{
+public:
+    using FieldType = typename TField::FieldType;
+    using DataType = typename FieldType::DataType;
+
+    explicit FieldValueExpr(TField &&f) : f_(std::move_if_noexcept(f)) {}
+    DataType operator[](const size_t i) const { return f_.getData()[i]; }
+    size_t size() const { return f_.size(); }
+    const FieldType &getField() const { return f_; }
+
+private:
+    TField f_;
+};
+
+template <typename Op, typename L, typename R>
+class FieldBinaryExpr;
+
+template <typename Op, typename L, typename R>
+class FieldContainerBinaryExpr;
+
+template <typename Op, typename E>
+class FieldUnaryExpr;
+
+template <typename Op, typename E>
+class FieldContainerUnaryExpr;
+
+/** @brief Operand classification for expression templates */
+enum class FieldOperandKind {
+    None = 0,
+    Scalar,
+    Field,
+    Container,
+    FieldNode,
+    ContainerNode
+};
+
+template <typename... Ts>
+struct FieldVoid {
+    using type = void;
+};
+
+/** @brief Test for scalar field types (``Field`` or ``FieldView<Field>``) */
+template <typename T, typename = void>
+struct IsScalarFieldType : std::false_type {
+};
+
+template <typename T>
+struct IsScalarFieldType<T, typename FieldVoid<typename T::FieldType>::type>
+    : std::integral_constant<bool,
+                             std::is_base_of<typename T::FieldType, T>::value> {
+};
+
+/** @brief Test for field container types and their component type */
+template <typename T>
+struct IsFieldContainerType {
+    template <typename U>
+    static std::true_type test_(const FieldContainer<U> *);
+    static std::false_type test_(...);
+    template <typename U>
+    static U *component_(const FieldContainer<U> *);
+    static void *component_(...);
+
+    static constexpr bool value =
+        decltype(test_(static_cast<T *>(nullptr)))::value;
+    using ComponentType = typename std::remove_pointer<decltype(
+        component_(static_cast<T *>(nullptr)))>::type;
+};
+
+/** @brief Operand kind of type ``D`` */
+template <typename D>
+struct FieldOperandKindOf {
+    static constexpr FieldOperandKind value =
+        std::is_base_of<FieldExpression<D>, D>::value
+            ? FieldOperandKind::FieldNode
+            : std::is_base_of<FieldContainerExpression<D>, D>::value
+                  ? FieldOperandKind::ContainerNode
+                  : IsScalarFieldType<D>::value
+                        ? FieldOperandKind::Field
+                        : IsFieldContainerType<D>::value
+                              ? FieldOperandKind::Container
+                              : std::is_arithmetic<D>::value
+                                    ? FieldOperandKind::Scalar
+                                    : FieldOperandKind::None;
+};
+
+/**
+ * @brief Maps an operand of type ``T`` to its expression node type
+ * @tparam T Operand type (as deduced for a forwarding reference)
+ */
+template <typename T,
+          FieldOperandKind K =
+              FieldOperandKindOf<typename std::decay<T>::type>::value>
+struct FieldOperand {
+    static constexpr bool Valid = false;
+    static constexpr bool IsNode = false;
+};
+
+template <typename T>
+struct FieldOperand<T, FieldOperandKind::Scalar> {
+    static constexpr bool Valid = true;
+    static constexpr bool IsNode = false;
+    using type = FieldScalarExpr<typename std::decay<T>::type>;
+    static type make(T &&t) { return type(t); }
+};
+
+template <typename T>
+struct FieldOperand<T, FieldOperandKind::Field> {
+    static constexpr bool Valid = true;
+    static constexpr bool IsNode = true;
+    using D = typename std::decay<T>::type;
+    using type = typename std::conditional<std::is_lvalue_reference<T>::value,
+                                           FieldRefExpr<D>,
+                                           FieldValueExpr<D>>::type;
+    static type make(T &&t) { return type(std::forward<T>(t)); }
+};
+
+template <typename T>
+struct FieldOperand<T, FieldOperandKind::FieldNode> {
+    static constexpr bool Valid = true;
+    static constexpr bool IsNode = true;
+    using type = typename std::decay<T>::type;
+    static type make(T &&t) { return std::forward<T>(t); }
+};
+
+template <typename TContainer>
+class FieldContainerRefExpr;
+
+template <typename TContainer>
+class FieldContainerValueExpr;
+
+template <typename T>
+struct FieldOperand<T, FieldOperandKind::Container> {
+    static constexpr bool Valid = true;
+    static constexpr bool IsNode = true;
+    using D = typename std::decay<T>::type;
+    using type = typename std::conditional<std::is_lvalue_reference<T>::value,
+                                           FieldContainerRefExpr<D>,
+                                           FieldContainerValueExpr<D>>::type;
+    static type make(T &&t) { return type(std::forward<T>(t)); }
+};
+
+template <typename T>
+struct FieldOperand<T, FieldOperandKind::ContainerNode> {
+    static constexpr bool Valid = true;
+    static constexpr bool IsNode = true;
+    using type = typename std::decay<T>::type;
+    static type make(T &&t) { return std::forward<T>(t); }
+};
+
+/** @brief Test for container expression nodes */
+template <typename E>
+struct IsFieldContainerExpr
+    : std::integral_constant<
+          bool,
+          std::is_base_of<FieldContainerExpression<E>, E>::value> {
+};
+
+/** @brief Test for scalar operand nodes */
+template <typename E>
+struct IsFieldScalarExpr : std::false_type {
+};
+
+template <typename T>
+struct IsFieldScalarExpr<FieldScalarExpr<T>> : std::true_type {
+};
+
+/** @brief Binary expression node type for node operands */
+template <typename Op, typename L, typename R>
+struct FieldBinaryType {
+    using type = typename std::conditional<
+        IsFieldContainerExpr<L>::value || IsFieldContainerExpr<R>::value,
+        FieldContainerBinaryExpr<Op, L, R>,
+        FieldBinaryExpr<Op, L, R>>::type;
+};
+
+/** @brief Unary expression node type for a node operand */
+template <typename Op, typename E>
+struct FieldUnaryType {
+    using type =
+        typename std::conditional<IsFieldContainerExpr<E>::value,
+                                  FieldContainerUnaryExpr<Op, E>,
+                                  FieldUnaryExpr<Op, E>>::type;
+};
+
+/** @brief Component access of container nodes (identity otherwise) */
+template <typename E, bool = IsFieldContainerExpr<E>::value>
+struct FieldComponent {
+    using type = E;
+    static const E &get(const E &e, const size_t) { return e; }
+    static bool has(const E &, const size_t) { return true; }
+};
+
+template <typename E>
+struct FieldComponent<E, true> {
+    using type = typename E::ComponentType;
+    static type get(const E &e, const size_t c) { return e.component(c); }
+    static bool has(const E &e, const size_t c) { return e.hasComponent(c); }
+};
+
+/** @brief Binary scalar field expression */
+template <typename Op, typename L, typename R>
+class FieldBinaryExpr : public FieldExpression<FieldBinaryExpr<Op, L, R>>
+{
+    static constexpr bool LScalar = IsFieldScalarExpr<L>::value;
+    using Proto = typename std::conditional<LScalar, R, L>::type;
+
+public:
+    using FieldType = typename Proto::FieldType;
+    using DataType = typename FieldType::DataType;
+
+    FieldBinaryExpr(L &&l, R &&r) : l_(std::move(l)), r_(std::move(r)) {}
+    FieldBinaryExpr(const L &l, const R &r) : l_(l), r_(r) {}
+
+    DataType operator[](const size_t i) const
+    {
+        return Op::apply(static_cast<DataType>(l_[i]),
+                         static_cast<DataType>(r_[i]));
+    }
+    size_t size() const { return getField().size(); }
+    const FieldType &getField() const
+    {
+        return getField_(std::integral_constant<bool, LScalar>());
+    }
+
+private:
+    L l_;
+    R r_;
+
+    const FieldType &getField_(std::false_type) const { return l_.getField(); }
+    const FieldType &getField_(std::true_type) const { return r_.getField(); }
+};
+
+/** @brief Unary scalar field expression */
+template <typename Op, typename E>
+class FieldUnaryExpr : public FieldExpression<FieldUnaryExpr<Op, E>>
+{
+public:
+    using FieldType = typename E::FieldType;
+    using DataType = typename FieldType::DataType;
+
+    explicit FieldUnaryExpr(E &&e) : e_(std::move(e)) {}
+    explicit FieldUnaryExpr(const E &e) : e_(e) {}
+
+    DataType operator[](const size_t i) const { return Op::apply(e_[i]); }
+    size_t size() const { return e_.size(); }
+    const FieldType &getField() const { return e_.getField(); }
+
+private:
+    E e_;
+};
+
+/** @brief Field container operand (by reference) */
+template <typename TContainer>
+class FieldContainerRefExpr
+    : public FieldContainerExpression<FieldContainerRefExpr<TContainer>>
+{
+    using BaseType = typename IsFieldContainerType<TContainer>::ComponentType;
+
+public:
+    using ComponentType = typename FieldOperand<const BaseType &>::type;
+    using DataType = typename BaseType::DataType;
+
+    explicit FieldContainerRefExpr(const TContainer &c) : c_(c) {}
+
+    size_t size() const { return c_.size(); }
+    bool hasComponent(const size_t i) const
+    {
+        return nullptr != c_.getContainer()[i];
+    }
+    ComponentType component(const size_t i) const
+    {
+        return ComponentType(*c_.getContainer()[i]);
+    }
+
+private:
+    const TContainer &c_;
+};
+
+/** @brief Field container operand (owned temporary) */
+template <typename TContainer>
+class FieldContainerValueExpr
+    : public FieldContainerExpression<FieldContainerValueExpr<TContainer>>
+{
+    using BaseType = typename IsFieldContainerType<TContainer>::ComponentType;
+
+public:
+    using ComponentType = typename FieldOperand<const BaseType &>::type;
+    using DataType = typename BaseType::DataType;
+
+    explicit FieldContainerValueExpr(TContainer &&c)
+        : c_(std::move_if_noexcept(c))
+    {
+    }
+
+    size_t size() const { return c_.size(); }
+    bool hasComponent(const size_t i) const
+    {
+        return nullptr != c_.getContainer()[i];
+    }
+    ComponentType component(const size_t i) const
+    {
+        return ComponentType(*c_.getContainer()[i]);
+    }
+
+private:
+    TContainer c_;
+};
+
+/** @brief Binary field container expression */
+template <typename Op, typename L, typename R>
+class FieldContainerBinaryExpr
+    : public FieldContainerExpression<FieldContainerBinaryExpr<Op, L, R>>
+{
+    using LComp = FieldComponent<L>;
+    using RComp = FieldComponent<R>;
+
+public:
+    using ComponentType = typename FieldBinaryType<Op,
+                                                   typename LComp::type,
+                                                   typename RComp::type>::type;
+    using DataType = typename ComponentType::DataType;
+
+    FieldContainerBinaryExpr(L &&l, R &&r) : l_(std::move(l)), r_(std::move(r))
+    {
+    }
+    FieldContainerBinaryExpr(const L &l, const R &r) : l_(l), r_(r) {}
+
+    size_t size() const
+    {
+        return size_(std::integral_constant<bool,
+                                            IsFieldContainerExpr<L>::value>());
+    }
+    bool hasComponent(const size_t c) const
+    {
+        return LComp::has(l_, c) && RComp::has(r_, c);
+    }
+    ComponentType component(const size_t c) const
+    {
+        return ComponentType(LComp::get(l_, c), RComp::get(r_, c));
+    }
+
+private:
+    L l_;
+    R r_;
+
+    size_t size_(std::true_type) const { return l_.size(); }
+    size_t size_(std::false_type) const { return r_.size(); }
+};
+
+/** @brief Unary field container expression */
+template <typename Op, typename E>
+class FieldContainerUnaryExpr
+    : public FieldContainerExpression<FieldContainerUnaryExpr<Op, E>>
+{
+public:
+    using ComponentType =
+        typename FieldUnaryType<Op, typename E::ComponentType>::type;
+    using DataType = typename ComponentType::DataType;
+
+    explicit FieldContainerUnaryExpr(E &&e) : e_(std::move(e)) {}
+    explicit FieldContainerUnaryExpr(const E &e) : e_(e) {}
+
+    size_t size() const { return e_.size(); }
+    bool hasComponent(const size_t c) const { return e_.hasComponent(c); }
+    ComponentType component(const size_t c) const
+    {
+        return ComponentType(e_.component(c));
+    }
+
+private:
+    E e_;
+};
+
+/** @brief Result type of a binary operator (SFINAE) */
+template <typename Op,
+          typename L,
+          typename R,
+          bool = FieldOperand<L>::Valid &&FieldOperand<R>::Valid &&
+              (FieldOperand<L>::IsNode || FieldOperand<R>::IsNode)>
+struct FieldBinaryResult {
+};
+
+template <typename Op, typename L, typename R>
+struct FieldBinaryResult<Op, L, R, true> {
+    using type = typename FieldBinaryType<Op,
+                                          typename FieldOperand<L>::type,
+                                          typename FieldOperand<R>::type>::type;
+    static type make(L &&l, R &&r)
+    {
+        return type(FieldOperand<L>::make(std::forward<L>(l)),
+                    FieldOperand<R>::make(std::forward<R>(r)));
+    }
+};
+
+/** @brief Result type of a unary operator (SFINAE) */
+template <typename Op, typename E, bool = FieldOperand<E>::IsNode>
+struct FieldUnaryResult {
+};
+
+template <typename Op, typename E>
+struct FieldUnaryResult<Op, E, true> {
+    using type =
+        typename FieldUnaryType<Op, typename FieldOperand<E>::type>::type;
+    static type make(E &&e)
+    {
+        return type(FieldOperand<E>::make(std::forward<E>(e)));
+    }
+};
+
+#define FIELD_BINARY_OPERATOR(OP, NAME)                                        \
+    template <typename L, typename R>                                          \
+    typename FieldBinaryResult<NAME, L, R>::type operator OP(L &&l, R &&r)     \
+    {                                                                          \
+        return FieldBinaryResult<NAME, L, R>::make(std::forward<L>(l),         \
+                                                   std::forward<R>(r));        \
+    }
+
+FIELD_BINARY_OPERATOR(+, FieldOpAdd)
+FIELD_BINARY_OPERATOR(-, FieldOpSub)
+FIELD_BINARY_OPERATOR(*, FieldOpMul)
+FIELD_BINARY_OPERATOR(/, FieldOpDiv)
+
+#undef FIELD_BINARY_OPERATOR
+
+template <typename E>
+typename FieldUnaryResult<FieldOpNeg, E>::type operator-(E &&e)
+{
+    return FieldUnaryResult<FieldOpNeg, E>::make(std::forward<E>(e));
+}
+
+NAMESPACE_END(Block)
+NAMESPACE_END(Cubism)
+
+#endif /* FIELDEXPRESSION_H_M4TQ8ZKE */
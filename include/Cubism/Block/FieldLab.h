@@ -6,12 +6,16 @@
 #ifndef FIELDLAB_H_8PPKFFY4
 #define FIELDLAB_H_8PPKFFY4
 
+#include "Cubism/BC/Base.h"
+#include "Cubism/BC/Engine.h"
 #include "Cubism/Block/Data.h"
 #include "Cubism/Block/FieldLabLoader.h"
 #include "Cubism/Common.h"
 #include <cassert>
 #include <cstring>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 NAMESPACE_BEGIN(Cubism)
 NAMESPACE_BEGIN(Block)
@@ -19,35 +23,42 @@ NAMESPACE_BEGIN(Block)
 /**
  * @brief Field laboratory
  * @tparam TField Field type to map to the lab
+ * @tparam TCompute Data type of the lab (compute precision)
  *
  * @rst
  * A ``FieldLab`` is an extended data structure to include ghost cells for a
  * given stencil. Loading a lab takes care of loading the ghost cells from
  * neighboring block fields and applies boundary conditions if present.  The
  * default is periodic if no boundary conditions are specified otherwise.
+ *
+ * The lab data type ``TCompute`` may differ from the data type of the field,
+ * e.g. for ``float`` storage and ``double`` arithmetic.  Values are converted
+ * when the lab is loaded and can be written back with ``storeInner()``.  The
+ * boundary conditions attached to a field are defined for a lab with the
+ * field data type.  If the types differ, boundary conditions for the compute
+ * precision lab must be passed explicitly to ``loadData()``.
  * @endrst
  * */
-template <typename TField>
+template <typename TField, typename TCompute = typename TField::DataType>
 class FieldLab
     // Alternatively inheritance could be from TField::BlockDataType which would
     // not allow to use a different data allocator.  The inheritance below
     // allows to change Cubism::AlignedBlockAllocator for a FieldLab if needed
     // at some point.
-    : public Data<typename TField::DataType,
+    : public Data<TCompute,
                   TField::EntityType,
                   TField::IndexRangeType::Dim,
-                  Cubism::AlignedBlockAllocator<typename TField::DataType>>
+                  Cubism::AlignedBlockAllocator<TCompute>>
 {
-    using BaseType =
-        Data<typename TField::DataType,
-             TField::EntityType,
-             TField::IndexRangeType::Dim,
-             Cubism::AlignedBlockAllocator<typename TField::DataType>>;
-    using BCVector = typename TField::BCVector;
+    using BaseType = Data<TCompute,
+                          TField::EntityType,
+                          TField::IndexRangeType::Dim,
+                          Cubism::AlignedBlockAllocator<TCompute>>;
     using LabLoader =
-        Block::FieldLabLoader<TField, BaseType::IndexRangeType::Dim>;
-    using BoolVec = typename LabLoader::BoolVec;
+        Block::FieldLabLoader<TField, BaseType::IndexRangeType::Dim, TCompute>;
     using STDFunction = typename LabLoader::STDFunction;
+    // lab data type is identical to field data type
+    using IsNative = std::is_same<TCompute, typename TField::DataType>;
 
     using BaseType::blk_alloc_;
     using BaseType::block_;
@@ -63,10 +74,14 @@ public:
     using Index = typename MultiIndex::DataType;
     using StencilType = typename LabLoader::StencilType;
     using FieldType = TField;
+    /** @brief Boundary condition type for this lab */
+    using BCType = BC::Base<FieldLab>;
+    /** @brief Vector of boundary conditions for this lab */
+    using BCVector = std::vector<BCType *>;
 
     /** @brief Main constructor */
     FieldLab()
-        : BaseType(IndexRangeType()), is_allocated_(false),
+        : BaseType(IndexRangeType()), is_allocated_(false), is_view_(false),
           block_data_(nullptr), field_(nullptr), lab_begin_(0)
     {
     }
@@ -75,7 +90,13 @@ public:
     FieldLab(FieldLab &&c) = delete;
     FieldLab &operator=(const FieldLab &c) = delete;
     FieldLab &operator=(FieldLab &&c) = delete;
-    ~FieldLab() override = default;
+    ~FieldLab() override
+    {
+        if (is_view_) {
+            // external memory is not released by the base destructor
+            this->setNull_();
+        }
+    }
 
     using iterator = Core::MultiIndexIterator<IndexRangeType::Dim>;
     iterator begin() noexcept { return iterator(loader_.curr_range, 0); }
@@ -105,35 +126,88 @@ public:
                   const IndexRangeType &max_request_range,
                   const bool force = false)
     {
-        // TODO: [fabianw@mavt.ethz.ch; 2020-02-11] Should offsets be const? any
-        // runtime difference?
-
-        // 1. Assign new stencil
-        // 2. Compute full lab extent (incl. halos)
-        // 3. Clear existing allocation and allocate aligned lab block
+        // 1. Assign new stencil and compute full lab extent (incl. halos)
+        // 2. Clear existing allocation and allocate aligned lab block
 
         // 1.
-        loader_.curr_stencil = s;
+        const bool can_reuse = setGeometry_(s, max_request_range);
+        if (is_view_) {
+            // previous memory was external
+            this->setNull_();
+            is_view_ = false;
+            is_allocated_ = false;
+        }
+
+        // if there is an existing allocation and no forced re-allocation
+        // needed, exit here
+        if (!force && is_allocated_ && can_reuse) {
+            block_data_ = block_ + range_.getFlatIndex(lab_begin_);
+            return;
+        }
 
         // 2.
+        BaseType::deallocBlock_();
+        BaseType::allocBlock_();
+        block_data_ = block_ + range_.getFlatIndex(lab_begin_);
+        is_allocated_ = true;
+    }
+
+    /**
+     * @brief Map data lab to external memory for a given stencil
+     * @param s Target stencil
+     * @param max_request_range Maximum index range to be processed in the lab
+     * @param ptr External memory of at least ``getLabExtent().prod()``
+     * elements aligned at ``CUBISM_ALIGNMENT``
+     *
+     * @rst
+     * The lab does not take ownership of ``ptr``.  This is used to place the
+     * labs of multiple field components in a single allocation, see
+     * ``TensorFieldLab``.
+     * @endrst
+     */
+    void allocate(const StencilType &s,
+                  const IndexRangeType &max_request_range,
+                  DataType *ptr)
+    {
+        assert(ptr != nullptr);
+        setGeometry_(s, max_request_range);
+        if (!is_view_) {
+            BaseType::deallocBlock_();
+        }
+        block_ = ptr;
+        bytes_ = range_.size() * sizeof(DataType);
+        block_data_ = block_ + range_.getFlatIndex(lab_begin_);
+        is_allocated_ = true;
+        is_view_ = true;
+    }
+
+    /**
+     * @brief Lab memory extent for a given stencil
+     * @param s Target stencil
+     * @param max_request_range Maximum index range to be processed in the lab
+     * @param lab_begin Offset of the inner domain in lab memory (output)
+     * @return Extent of lab memory including ghosts and alignment padding
+     */
+    static MultiIndex getLabExtent(const StencilType &s,
+                                   const IndexRangeType &max_request_range,
+                                   MultiIndex &lab_begin)
+    {
         // add two extra memory locations in each direction for equal treatment
         // of block fields in a grid topology which may differ by one cell for
         // boundary adjacent blocks (depends on Cubism::EntityType).
         MultiIndex max_extent = max_request_range.getExtent() + 2;
-        // maximum range that can be handled by this lab allocation
-        max_range_ = IndexRangeType(max_extent);
 
         // memory alignment adjustment
         const typename MultiIndex::DataType n_per_align =
             CUBISM_ALIGNMENT / sizeof(DataType);
 
         // number of extra computational elements needed due to stencil
-        lab_begin_ = -loader_.curr_stencil.getBegin();
-        const MultiIndex lab_end = loader_.curr_stencil.getEnd() - 1;
+        lab_begin = -s.getBegin();
+        const MultiIndex lab_end = s.getEnd() - 1;
 
         // adjust fastest moving index to alignment requirement
-        lab_begin_[0] =
-            ((lab_begin_[0] + n_per_align - 1) / n_per_align) * n_per_align;
+        lab_begin[0] =
+            ((lab_begin[0] + n_per_align - 1) / n_per_align) * n_per_align;
 
         // expand the maximum range extent by additional ghost cells on the far
         // end and adjust the fastest moving index to alignment requirement
@@ -142,26 +216,26 @@ public:
             ((max_extent[0] + n_per_align - 1) / n_per_align) * n_per_align;
 
         // total lab extent including ghost cells and alignment requirements
-        const MultiIndex lab_extent = lab_begin_ + max_extent;
-
-        // if this is a subsequent call, can we recycle the current allocation?
-        const bool can_reuse = lab_extent <= range_.getExtent();
-
-        // this is the new lab extent for this allocation call
-        range_ = IndexRangeType(lab_extent);
-
-        // if there is an existing allocation and no forced re-allocation
-        // needed, exit here
-        if (!force && is_allocated_ && can_reuse) {
-            block_data_ = block_ + range_.getFlatIndex(lab_begin_);
-            return;
-        }
+        return lab_begin + max_extent;
+    }
 
-        // 3.
-        BaseType::deallocBlock_();
-        BaseType::allocBlock_();
-        block_data_ = block_ + range_.getFlatIndex(lab_begin_);
-        is_allocated_ = true;
+    /**
+     * @brief Set the active field without loading data
+     * @param f Field that is mapped to the lab
+     *
+     * @rst
+     * Low-level method for batched loaders that fill the lab memory directly,
+     * see ``TensorFieldLab``.  Sets the active range and lab range for
+     * ``f``.
+     * @endrst
+     */
+    void setActiveField(FieldType &f)
+    {
+        field_ = &f;
+        loader_.curr_range = f.getIndexRange();
+        loader_.curr_labrange = IndexRangeType(
+            loader_.curr_stencil.getBegin(),
+            loader_.curr_range.getExtent() + loader_.curr_stencil.getEnd() - 1);
     }
 
     /**
@@ -191,36 +265,49 @@ public:
         }
 
         // 1. load the block field data
-        // 2. load the halos
-        // 3. apply boundary conditions
+        // 2. load the halos and apply boundary conditions
 
         // 1.
-        field_ = &(id2field(fid));
-        loader_.curr_range = field_->getIndexRange();
-        loader_.curr_labrange = IndexRangeType(
-            loader_.curr_stencil.getBegin(),
-            loader_.curr_range.getExtent() + loader_.curr_stencil.getEnd() - 1);
+        setActiveField(id2field(fid));
         loader_.loadInner(*field_, block_, range_, lab_begin_);
 
         // 2.
-        const BCVector &bcs = (extern_bc) ? *extern_bc : field_->getBC();
-        BoolVec periodic(true);
-        MultiIndex skip(1);
-        for (const auto bc : bcs) {
-            const auto info = bc->getBoundaryInfo();
-            assert(info.dir < IndexRangeType::Dim);
-            periodic[info.dir] = info.is_periodic;
-            skip[info.dir] = (info.side == 0) ? -1 : 1;
-        }
-        loader_.loadGhosts(
-            fid, id2field, block_, range_, lab_begin_, periodic, skip);
+        loadHalo_(fid, id2field, apply_bc, extern_bc);
+    }
 
-        // 3.
-        if (apply_bc) {
-            for (const auto bc : bcs) {
-                (*bc)(*this);
-            }
+    /**
+     * @brief Refresh ghost cells only
+     * @param fid Multi-dimensional index of target block field
+     * @param id2field Index mapping function for block fields
+     * @param apply_bc Flag whether to apply boundary conditions
+     * @param extern_bc Pointer to external boundary conditions
+     *
+     * @rst
+     * Reloads the halo region from the neighboring block fields and applies
+     * boundary conditions while the inner domain of the lab is kept as is.
+     * This is useful for multi-stage kernels that update the inner lab data
+     * in place, where only the ghost cells become stale between stages.  The
+     * block field with index ``fid`` must be the currently active field (see
+     * ``loadData()`` or ``setActiveField()``).
+     * @endrst
+     */
+    template <typename Functor = STDFunction>
+    void refreshGhosts(const MultiIndex &fid,
+                       Functor &id2field,
+                       const bool apply_bc = true,
+                       const BCVector *extern_bc = nullptr)
+    {
+        static_assert(FieldType::Class == Cubism::FieldClass::Scalar,
+                      "FieldLab: field class must be scalar.");
+        if (!is_allocated_) {
+            throw std::runtime_error(
+                "FieldLab: can not load lab data when not allocated first");
+        }
+        if (field_ != &(id2field(fid))) {
+            throw std::runtime_error(
+                "FieldLab: ghost refresh requires the active field");
         }
+        loadHalo_(fid, id2field, apply_bc, extern_bc);
     }
 
     /**
@@ -247,6 +334,44 @@ public:
         loadData(fid, id2field, apply_bc, &boundaries);
     }
 
+    /**
+     * @brief Lab data loader
+     * @param fid Multi-dimensional index of target block field
+     * @param id2field Index mapping function for block fields
+     * @param boundaries Compile-time list of boundary conditions
+     * @param apply_bc Flag whether to apply boundary conditions
+     *
+     * @rst
+     * Same as the loader above for a ``BC::TypedList`` of boundary
+     * conditions, which are applied without virtual dispatch.
+     * @endrst
+     */
+    template <typename Functor, typename... BCs>
+    void loadData(const MultiIndex &fid,
+                  Functor &id2field,
+                  BC::TypedList<FieldLab, BCs...> &boundaries,
+                  const bool apply_bc = true)
+    {
+        static_assert(FieldType::Class == Cubism::FieldClass::Scalar,
+                      "FieldLab: field class must be scalar.");
+        if (!is_allocated_) {
+            throw std::runtime_error(
+                "FieldLab: can not load lab data when not allocated first");
+        }
+        setActiveField(id2field(fid));
+        loader_.loadInner(*field_, block_, range_, lab_begin_);
+
+        MultiIndex skip(0);
+        for (const auto &info : boundaries.getBoundaryInfo()) {
+            setBoundaryInfo_(info, skip);
+        }
+        loader_.loadGhosts(
+            fid, id2field, block_, range_, lab_begin_, skip);
+        if (apply_bc) {
+            boundaries.apply(*this);
+        }
+    }
+
     /**
      * @brief Linear data access
      * @param p Local multi-dimensional index
@@ -396,6 +521,32 @@ public:
      */
     const DataType *getInnerData() const { return block_data_; }
 
+    /**
+     * @brief Write inner lab data back to a field
+     * @param f Destination field
+     *
+     * @rst
+     * Copies the inner domain of the lab (without ghosts) into ``f`` and
+     * converts to the field data type.  The index range of ``f`` must have the
+     * extent of the active range.
+     * @endrst
+     */
+    void storeInner(FieldType &f) const
+    {
+        const MultiIndex extent = loader_.curr_range.getExtent();
+        assert(f.getIndexRange().getExtent() == extent);
+        MultiIndex row_extent = extent;
+        row_extent[0] = 1;
+        const IndexRangeType rows(row_extent);
+        typename FieldType::DataType *pdst = f.getData();
+        const auto rows_end = rows.end();
+        for (auto it = rows.begin(); it != rows_end; ++it) {
+            labCopy(pdst + it.getFlatIndex() * extent[0],
+                    block_ + range_.getFlatIndex(*it + lab_begin_),
+                    static_cast<size_t>(extent[0]));
+        }
+    }
+
     /**
      * @brief Get currently active (loaded) stencil
      * @return ``const`` reference to ``StencilType``
@@ -482,13 +633,104 @@ protected:
 
 private:
     bool is_allocated_;
+    bool is_view_; // lab memory is external
     IndexRangeType max_range_;
     LabLoader loader_;
+    BC::Engine<IndexRangeType::Dim> bc_engine_;
     DataType *block_data_; // start of block data
     FieldType *field_;     // currently loaded field
 
     // offset helper
     MultiIndex lab_begin_;
+
+    /**
+     * @brief Load ghost cells and apply boundary conditions
+     * @param fid Multi-dimensional index of target block field
+     * @param id2field Index mapping function for block fields
+     * @param apply_bc Flag whether to apply boundary conditions
+     * @param extern_bc Pointer to external boundary conditions
+     */
+    template <typename Functor>
+    void loadHalo_(const MultiIndex &fid,
+                   Functor &id2field,
+                   const bool apply_bc,
+                   const BCVector *extern_bc)
+    {
+        // 1. load the halos
+        // 2. apply boundary conditions
+
+        // 1.
+        const BCVector *bcs = (extern_bc) ? extern_bc : getFieldBC_(IsNative());
+        MultiIndex skip(0); // non-periodic sides (see skipSideBit())
+        if (bcs) {
+            setBoundaryInfo_(*bcs, skip);
+        } else {
+            setBoundaryInfo_(field_->getBC(), skip);
+        }
+        loader_.loadGhosts(
+            fid, id2field, block_, range_, lab_begin_, skip);
+
+        // 2.
+        if (apply_bc) {
+            if (!bcs) {
+                for (size_t i = 0; i < IndexRangeType::Dim; ++i) {
+                    if (0 != skip[i]) {
+                        throw std::runtime_error(
+                            "FieldLab: boundary conditions for the lab data "
+                            "type must be passed explicitly");
+                    }
+                }
+                return;
+            }
+            bc_engine_.apply(*this, *bcs);
+        }
+    }
+
+    const BCVector *getFieldBC_(std::true_type) const
+    {
+        return &field_->getBC();
+    }
+
+    const BCVector *getFieldBC_(std::false_type) const { return nullptr; }
+
+    template <typename Vector>
+    static void setBoundaryInfo_(const Vector &bcs, MultiIndex &skip)
+    {
+        for (const auto bc : bcs) {
+            setBoundaryInfo_(bc->getBoundaryInfo(), skip);
+        }
+    }
+
+    static void setBoundaryInfo_(const BC::BoundaryInfo &info, MultiIndex &skip)
+    {
+        assert(info.dir < IndexRangeType::Dim);
+        if (!info.is_periodic) {
+            skip[info.dir] |= skipSideBit(info.side);
+        }
+    }
+
+    /**
+     * @brief Assign stencil and compute lab geometry
+     * @param s Target stencil
+     * @param max_request_range Maximum index range to be processed in the lab
+     * @return True if the current memory block is large enough
+     */
+    bool setGeometry_(const StencilType &s,
+                      const IndexRangeType &max_request_range)
+    {
+        loader_.curr_stencil = s;
+        // maximum range that can be handled by this lab allocation
+        max_range_ = IndexRangeType(max_request_range.getExtent() + 2);
+        const MultiIndex lab_extent =
+            getLabExtent(s, max_request_range, lab_begin_);
+
+        // if this is a subsequent call, can we recycle the current allocation?
+        const bool can_reuse = lab_extent <= range_.getExtent();
+
+        // this is the new lab extent for this allocation call
+        range_ = IndexRangeType(lab_extent);
+        return can_reuse;
+    }
 };
 
 NAMESPACE_END(Block)
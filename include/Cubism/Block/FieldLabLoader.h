@@ -17,16 +17,110 @@
 NAMESPACE_BEGIN(Cubism)
 NAMESPACE_BEGIN(Block)
 
+/**
+ * @brief Copy and convert a contiguous sequence of lab data
+ * @tparam TDst Destination data type
+ * @tparam TSrc Source data type
+ * @param dst Destination address
+ * @param src Source address
+ * @param n Number of elements
+ *
+ * @rst
+ * Values are converted with ``static_cast``.  The loop is vectorized by the
+ * compiler (e.g. widening of ``float`` to ``double``).
+ * @endrst
+ */
+template <typename TDst, typename TSrc>
+inline void labCopy(TDst *dst, const TSrc *src, const size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = static_cast<TDst>(src[i]);
+    }
+}
+
+/**
+ * @brief Copy a contiguous sequence of lab data
+ * @tparam T Data type
+ * @param dst Destination address
+ * @param src Source address
+ * @param n Number of elements
+ */
+template <typename T>
+inline void labCopy(T *dst, const T *src, const size_t n)
+{
+    std::memcpy(dst, src, n * sizeof(T));
+}
+
+/**
+ * @brief Test if a neighbor block may be across the domain boundary
+ * @tparam Functor Index functor type
+ * @tparam MultiIndex Block index type
+ * @param f Index functor
+ * @param p Block index of the neighbor
+ * @return True if the neighbor of ``p`` may be across the domain boundary
+ *
+ * @rst
+ * Index functors that know the boundary markers of the neighbors (e.g.
+ * ``Grid::NeighborFunctor``) implement ``isBoundary(p)``.  The loaders only
+ * test neighbors marked as boundary for a non-periodic boundary condition.
+ * @endrst
+ */
+template <typename Functor, typename MultiIndex>
+inline auto isBoundaryNeighbor(const Functor &f, const MultiIndex &p, int)
+    -> decltype(f.isBoundary(p))
+{
+    return f.isBoundary(p);
+}
+
+/**
+ * @brief Test if a neighbor block may be across the domain boundary
+ * @tparam Functor Index functor type
+ * @tparam MultiIndex Block index type
+ * @return Always true for index functors without boundary markers
+ */
+template <typename Functor, typename MultiIndex>
+inline bool isBoundaryNeighbor(const Functor &, const MultiIndex &, long)
+{
+    return true;
+}
+
+/**
+ * @brief Boundary side bit for the ``skip`` mask of the lab loaders
+ * @param side Boundary side (0 for the lower, 1 for the upper side)
+ * @return Bit 0 for the lower side, bit 1 for the upper side
+ */
+inline int skipSideBit(const size_t side) { return (0 == side) ? 1 : 2; }
+
+/**
+ * @brief Test if a neighbor side is skipped by the lab loaders
+ * @tparam Index Index type
+ * @param skip Bit mask of sides with a non-periodic boundary condition
+ * @param bi Neighbor offset along the direction (-1, 0 or 1)
+ * @return True if ghosts from neighbor offset ``bi`` are not loaded
+ *
+ * @rst
+ * Both sides of a direction may carry a non-periodic boundary condition,
+ * the sides are therefore tracked independently (see ``skipSideBit()``).
+ * @endrst
+ */
+template <typename Index>
+inline bool isSkippedSide(const Index skip, const Index bi)
+{
+    return (bi < 0 && (skip & 1)) || (bi > 0 && (skip & 2));
+}
+
 // TODO: [fabianw@mavt.ethz.ch; 2021-03-24] Documentation
 
-template <typename FieldType, size_t DIM = CUBISM_DIMENSION>
+template <typename FieldType,
+          size_t DIM = CUBISM_DIMENSION,
+          typename TCompute = typename FieldType::DataType>
 struct FieldLabLoader {
-    using DataType = typename FieldType::DataType;
+    using DataType = TCompute; // lab data type
+    using SourceType = typename FieldType::DataType;
     using StencilType = Core::Stencil<DIM>;
     using IndexRangeType = typename Core::IndexRange<DIM>;
     using MultiIndex = typename IndexRangeType::MultiIndex;
     using STDFunction = std::function<FieldType &(const MultiIndex &)>;
-    using BoolVec = Core::Vector<bool, DIM>;
 
     StencilType curr_stencil;
     IndexRangeType curr_range;
@@ -37,10 +131,18 @@ struct FieldLabLoader {
                    const IndexRangeType &rmemory,
                    const MultiIndex &offset)
     {
-        const auto range_end = curr_range.end();
-        for (auto it = curr_range.begin(); it != range_end; ++it) {
-            *(dst + rmemory.getFlatIndex(*it + offset)) =
-                src[it.getFlatIndex()];
+        // copy contiguous rows of the fastest moving index
+        const MultiIndex extent = curr_range.getExtent();
+        MultiIndex row_extent = extent;
+        row_extent[0] = 1;
+        const IndexRangeType rows(row_extent);
+        const SourceType *psrc = src.getData();
+        const size_t nx = extent[0];
+        const auto rows_end = rows.end();
+        for (auto it = rows.begin(); it != rows_end; ++it) {
+            labCopy(dst + rmemory.getFlatIndex(*it + offset),
+                    psrc + it.getFlatIndex() * extent[0],
+                    nx);
         }
     }
 
@@ -50,7 +152,6 @@ struct FieldLabLoader {
                     DataType *dst,
                     const IndexRangeType &rmemory,
                     const MultiIndex &offset,
-                    const BoolVec &periodic,
                     const MultiIndex &skip)
     {
         const IndexRangeType nbr_range(0, 3);
@@ -59,6 +160,10 @@ struct FieldLabLoader {
         const MultiIndex curr_extent = curr_range.getExtent();
         const MultiIndex halo_extent = curr_extent + curr_stencil.getEnd() - 1;
         const MultiIndex stencil_begin = curr_stencil.getBegin();
+        bool all_periodic = true;
+        for (size_t j = 0; j < IndexRangeType::Dim; ++j) {
+            all_periodic = all_periodic && (0 == skip[j]);
+        }
         for (size_t i = 0; i < neighbors; ++i) {
             if (i == me) {
                 continue;
@@ -66,20 +171,24 @@ struct FieldLabLoader {
             const MultiIndex bi = nbr_range.getMultiIndex(i) - 1;
 
             typename MultiIndex::DataType isum = 0;
-            bool skip_current = false;
             for (size_t j = 0; j < IndexRangeType::Dim; ++j) {
-                if (!periodic[j] && bi[j] == skip[j]) {
-                    skip_current = true;
-                    break;
-                }
                 isum += Cubism::myAbs(bi[j]);
             }
-            if (skip_current) {
-                continue;
-            }
             if (!curr_stencil.isTensorial() && isum > 1) {
                 continue;
             }
+            if (!all_periodic && isBoundaryNeighbor(i2f, i0 + bi, 0)) {
+                bool skip_current = false;
+                for (size_t j = 0; j < IndexRangeType::Dim; ++j) {
+                    if (isSkippedSide(skip[j], bi[j])) {
+                        skip_current = true;
+                        break;
+                    }
+                }
+                if (skip_current) {
+                    continue;
+                }
+            }
 
             const auto &f = i2f(i0 + bi); // neighbor block field
             const MultiIndex nbr_extent = f.getIndexRange().getExtent();
@@ -101,26 +210,203 @@ struct FieldLabLoader {
                     end[j] = halo_extent[j];
                 }
             }
-            const IndexRangeType halo_range(begin, end);
+            MultiIndex row_extent = end - begin;
+            const size_t nx = row_extent[0];
+            if (0 == nx) {
+                continue;
+            }
+            row_extent[0] = 1;
+            const IndexRangeType rows(row_extent);
+            const IndexRangeType &nbr_memory = f.getIndexRange();
+            const SourceType *psrc = f.getData();
             const MultiIndex lab_begin = begin + offset;
             const MultiIndex nbr_begin = begin - bi * curr_extent + shift;
-            for (auto &p : halo_range) {
-                *(dst + rmemory.getFlatIndex(p + lab_begin)) = f[p + nbr_begin];
+            for (auto &p : rows) {
+                labCopy(dst + rmemory.getFlatIndex(p + lab_begin),
+                        psrc + nbr_memory.getFlatIndex(p + nbr_begin),
+                        nx);
+            }
+        }
+    }
+};
+
+// specialization for 1D
+template <typename FieldType, typename TCompute>
+struct FieldLabLoader<FieldType, 1, TCompute> {
+    using DataType = TCompute; // lab data type
+    using SourceType = typename FieldType::DataType;
+    using StencilType = Core::Stencil<1>;
+    using IndexRangeType = typename Core::IndexRange<1>;
+    using MultiIndex = typename IndexRangeType::MultiIndex;
+    using Index = typename MultiIndex::DataType;
+    using STDFunction = std::function<FieldType &(const MultiIndex &)>;
+
+    StencilType curr_stencil;
+    IndexRangeType curr_range;
+    IndexRangeType curr_labrange;
+
+    void loadInner(const FieldType &src,
+                   DataType *dst,
+                   const IndexRangeType &,
+                   const MultiIndex &offset)
+    {
+        labCopy(dst + offset[0], src.getData(), curr_range.getExtent()[0]);
+    }
+
+    template <typename Functor = STDFunction>
+    void loadGhosts(const MultiIndex &i0,
+                    Functor &i2f,
+                    DataType *dst,
+                    const IndexRangeType &,
+                    const MultiIndex &offset,
+                    const MultiIndex &skip)
+    {
+        const Index extent = curr_range.getExtent()[0];
+        const Index sbegin = curr_stencil.getBegin()[0];
+        const Index send = curr_stencil.getEnd()[0] - 1;
+        for (Index bi = -1; bi < 2; bi += 2) {
+            if (isSkippedSide(skip[0], bi) &&
+                isBoundaryNeighbor(i2f, i0 + MultiIndex(bi), 0)) {
+                continue;
+            }
+            const Index nghosts = (bi < 0) ? -sbegin : send;
+            if (0 == nghosts) {
+                continue;
+            }
+            const auto &f = i2f(i0 + MultiIndex(bi));
+            const Index nbr_extent = f.getIndexRange().getExtent()[0];
+            // left: last cells of neighbor, right: first cells of neighbor
+            const Index begin = (bi < 0) ? sbegin : extent;
+            const Index nbr_begin = (bi < 0) ? nbr_extent + sbegin : 0;
+            labCopy(dst + offset[0] + begin, f.getData() + nbr_begin, nghosts);
+        }
+    }
+};
+
+// specialization for 2D
+template <typename FieldType, typename TCompute>
+struct FieldLabLoader<FieldType, 2, TCompute> {
+    using DataType = TCompute; // lab data type
+    using SourceType = typename FieldType::DataType;
+    using StencilType = Core::Stencil<2>;
+    using IndexRangeType = typename Core::IndexRange<2>;
+    using MultiIndex = typename IndexRangeType::MultiIndex;
+    using Index = typename MultiIndex::DataType;
+    using STDFunction = std::function<FieldType &(const MultiIndex &)>;
+
+    StencilType curr_stencil;
+    IndexRangeType curr_range;
+    IndexRangeType curr_labrange;
+
+    void loadInner(const FieldType &src,
+                   DataType *dst,
+                   const IndexRangeType &rmemory,
+                   const MultiIndex &offset)
+    {
+        const MultiIndex extent = curr_range.getExtent();
+        const Index lstridex = rmemory.getExtent()[0]; // lab stride x
+        const Index bstridex = extent[0];              // block stride x
+        const size_t nx = bstridex;
+        const Index ey = (extent[1] / 4) * 4;
+
+        DataType *pdst = dst + rmemory.getFlatIndex(offset);
+        const SourceType *psrc = src.getData();
+        for (Index iy = 0; iy < ey; iy += 4) {
+            DataType *dst0 = pdst + (iy + 0) * lstridex;
+            DataType *dst1 = pdst + (iy + 1) * lstridex;
+            DataType *dst2 = pdst + (iy + 2) * lstridex;
+            DataType *dst3 = pdst + (iy + 3) * lstridex;
+            labCopy(dst0, psrc + 0 * bstridex, nx);
+            labCopy(dst1, psrc + 1 * bstridex, nx);
+            labCopy(dst2, psrc + 2 * bstridex, nx);
+            labCopy(dst3, psrc + 3 * bstridex, nx);
+            psrc += 4 * bstridex;
+        }
+        for (Index iy = ey; iy < extent[1]; ++iy) {
+            labCopy(pdst + iy * lstridex, psrc, nx);
+            psrc += bstridex;
+        }
+    }
+
+    template <typename Functor = STDFunction>
+    void loadGhosts(const MultiIndex &i0,
+                    Functor &i2f,
+                    DataType *dst,
+                    const IndexRangeType &rmemory,
+                    const MultiIndex &offset,
+                    const MultiIndex &skip)
+    {
+        const size_t neighbors = 9;
+        const size_t me = neighbors / 2;
+        const MultiIndex extent = curr_range.getExtent();
+        const MultiIndex halo_extent = extent + curr_stencil.getEnd() - 1;
+        const MultiIndex stencil_begin = curr_stencil.getBegin();
+        const Index lstridex = rmemory.getExtent()[0]; // lab stride x
+        DataType *pdst = dst + rmemory.getFlatIndex(offset);
+        for (size_t i = 0; i < neighbors; ++i) {
+            if (i == me) {
+                continue;
+            }
+            const MultiIndex bi{i % 3 - 1, i / 3 - 1};
+
+            if (!curr_stencil.isTensorial() &&
+                (myAbs(bi[0]) + myAbs(bi[1]) > 1)) {
+                continue;
+            }
+            if ((isSkippedSide(skip[0], bi[0]) ||
+                 isSkippedSide(skip[1], bi[1])) &&
+                isBoundaryNeighbor(i2f, i0 + bi, 0)) {
+                continue;
+            }
+
+            const MultiIndex begin{
+                bi[0] < 1 ? (bi[0] < 0 ? stencil_begin[0] : 0) : extent[0],
+                bi[1] < 1 ? (bi[1] < 0 ? stencil_begin[1] : 0) : extent[1]};
+            const MultiIndex end{
+                bi[0] < 1 ? (bi[0] < 0 ? 0 : extent[0]) : halo_extent[0],
+                bi[1] < 1 ? (bi[1] < 0 ? 0 : extent[1]) : halo_extent[1]};
+            const size_t nx = (end[0] - begin[0]);
+            if (0 == nx || end[1] == begin[1]) {
+                continue;
+            }
+
+            const auto &f = i2f(i0 + bi);
+            const MultiIndex nbr_extent = f.getIndexRange().getExtent();
+            const MultiIndex shift{bi[0] < 0 ? nbr_extent[0] - extent[0] : 0,
+                                   bi[1] < 0 ? nbr_extent[1] - extent[1] : 0};
+            const Index nstridex = nbr_extent[0]; // neighbor stride x
+            DataType *dst0 = pdst + begin[0] + begin[1] * lstridex;
+            const SourceType *src0 =
+                f.getData() + begin[0] - bi[0] * extent[0] + shift[0] +
+                nstridex * (begin[1] - bi[1] * extent[1] + shift[1]);
+            const Index ny = end[1] - begin[1];
+            const Index ey = (ny / 4) * 4;
+            for (Index iy = 0; iy < ey; iy += 4) {
+                // unrolled copies
+                DataType *d = dst0 + iy * lstridex;
+                const SourceType *s = src0 + iy * nstridex;
+                labCopy(d + 0 * lstridex, s + 0 * nstridex, nx);
+                labCopy(d + 1 * lstridex, s + 1 * nstridex, nx);
+                labCopy(d + 2 * lstridex, s + 2 * nstridex, nx);
+                labCopy(d + 3 * lstridex, s + 3 * nstridex, nx);
+            }
+            for (Index iy = ey; iy < ny; ++iy) {
+                labCopy(dst0 + iy * lstridex, src0 + iy * nstridex, nx);
             }
         }
     }
 };
 
 // specialization for 3D
-template <typename FieldType>
-struct FieldLabLoader<FieldType, 3> {
-    using DataType = typename FieldType::DataType;
+template <typename FieldType, typename TCompute>
+struct FieldLabLoader<FieldType, 3, TCompute> {
+    using DataType = TCompute; // lab data type
+    using SourceType = typename FieldType::DataType;
     using StencilType = Core::Stencil<3>;
     using IndexRangeType = typename Core::IndexRange<3>;
     using MultiIndex = typename IndexRangeType::MultiIndex;
     using Index = typename MultiIndex::DataType;
     using STDFunction = std::function<FieldType &(const MultiIndex &)>;
-    using BoolVec = Core::Vector<bool, 3>;
 
     StencilType curr_stencil;
     IndexRangeType curr_range;
@@ -146,9 +432,9 @@ struct FieldLabLoader<FieldType, 3> {
         const Index lslicexy = lextent[0] * lextent[1]; // lab slice xy
 
         DataType *pdst = dst + rmemory.getFlatIndex(offset + sstart);
-        const DataType *psrc = src.getData();
+        const SourceType *psrc = src.getData();
         const Index bstridex = extent[0]; // block stride x
-        const size_t bytesx = sizeof(DataType) * bstridex;
+        const size_t nx = bstridex;
         for (Index iz = sz; iz < ez; ++iz) {
             const Index szx = iz * lslicexy + sx;
             for (Index iy = sy; iy < ey; iy += 4) {
@@ -156,16 +442,16 @@ struct FieldLabLoader<FieldType, 3> {
                 DataType *dst1 = pdst + szx + (iy + 1) * lstridex;
                 DataType *dst2 = pdst + szx + (iy + 2) * lstridex;
                 DataType *dst3 = pdst + szx + (iy + 3) * lstridex;
-                std::memcpy(dst0, psrc + 0 * bstridex, bytesx);
-                std::memcpy(dst1, psrc + 1 * bstridex, bytesx);
-                std::memcpy(dst2, psrc + 2 * bstridex, bytesx);
-                std::memcpy(dst3, psrc + 3 * bstridex, bytesx);
+                labCopy(dst0, psrc + 0 * bstridex, nx);
+                labCopy(dst1, psrc + 1 * bstridex, nx);
+                labCopy(dst2, psrc + 2 * bstridex, nx);
+                labCopy(dst3, psrc + 3 * bstridex, nx);
                 psrc += 4 * bstridex;
             }
             if (ry > 0) {
                 for (Index iy = ey; iy < ey + ry; ++iy) {
                     DataType *dst0 = pdst + szx + iy * lstridex;
-                    std::memcpy(dst0, psrc, bytesx);
+                    labCopy(dst0, psrc, nx);
                     psrc += bstridex;
                 }
             }
@@ -178,7 +464,6 @@ struct FieldLabLoader<FieldType, 3> {
                     DataType *dst,
                     const IndexRangeType &rmemory,
                     const MultiIndex &offset,
-                    const BoolVec &periodic,
                     const MultiIndex &skip)
     {
         const IndexRangeType nbr_range(0, 3);
@@ -194,15 +479,16 @@ struct FieldLabLoader<FieldType, 3> {
             }
             const MultiIndex bi{i % 3 - 1, (i / 3) % 3 - 1, (i / 9) - 1};
 
-            if ((!periodic[0] && bi[0] == skip[0]) ||
-                (!periodic[1] && bi[1] == skip[1]) ||
-                (!periodic[2] && bi[2] == skip[2])) {
-                continue;
-            }
             if (!curr_stencil.isTensorial() &&
                 (myAbs(bi[0]) + myAbs(bi[1]) + myAbs(bi[2]) > 1)) {
                 continue;
             }
+            if ((isSkippedSide(skip[0], bi[0]) ||
+                 isSkippedSide(skip[1], bi[1]) ||
+                 isSkippedSide(skip[2], bi[2])) &&
+                isBoundaryNeighbor(i2f, i0 + bi, 0)) {
+                continue;
+            }
 
             const auto &f = i2f(i0 + bi);
             const MultiIndex nbr_extent = f.getIndexRange().getExtent();
@@ -221,11 +507,11 @@ struct FieldLabLoader<FieldType, 3> {
             const Index lstridex = lextent[0];              // lab stride x
             const Index lslicexy = lextent[0] * lextent[1]; // lab slice xy
             const Index sx = begin[0] - stencil_begin[0];
-            const size_t bytesx = sizeof(DataType) * (end[0] - begin[0]);
-            if (0 == bytesx) {
+            const size_t nx = (end[0] - begin[0]);
+            if (0 == nx) {
                 continue;
             }
-            const DataType *psrc = f.getData();
+            const SourceType *psrc = f.getData();
             for (Index iz = begin[2]; iz < end[2]; ++iz) {
                 const Index szx = (iz - stencil_begin[2]) * lslicexy + sx;
                 if ((end[1] - begin[1]) % 4 != 0) {
@@ -233,13 +519,13 @@ struct FieldLabLoader<FieldType, 3> {
                     for (Index iy = begin[1]; iy < end[1]; ++iy) {
                         DataType *dst0 =
                             pdst + szx + (iy - stencil_begin[1]) * lstridex;
-                        const DataType *src0 =
+                        const SourceType *src0 =
                             psrc + begin[0] - bi[0] * extent[0] + shift[0] +
                             nbr_extent[0] *
                                 (iy - bi[1] * extent[1] + shift[1] +
                                  nbr_extent[1] *
                                      (iz - bi[2] * extent[2] + shift[2]));
-                        std::memcpy(dst0, src0, bytesx);
+                        labCopy(dst0, src0, nx);
                     }
                 } else {
                     // unrolled copies
@@ -252,34 +538,34 @@ struct FieldLabLoader<FieldType, 3> {
                             pdst + szx + (iy + 2 - stencil_begin[1]) * lstridex;
                         DataType *dst3 =
                             pdst + szx + (iy + 3 - stencil_begin[1]) * lstridex;
-                        const DataType *src0 =
+                        const SourceType *src0 =
                             psrc + begin[0] - bi[0] * extent[0] + shift[0] +
                             nbr_extent[0] *
                                 (iy + 0 - bi[1] * extent[1] + shift[1] +
                                  nbr_extent[1] *
                                      (iz - bi[2] * extent[2] + shift[2]));
-                        const DataType *src1 =
+                        const SourceType *src1 =
                             psrc + begin[0] - bi[0] * extent[0] + shift[0] +
                             nbr_extent[0] *
                                 (iy + 1 - bi[1] * extent[1] + shift[1] +
                                  nbr_extent[1] *
                                      (iz - bi[2] * extent[2] + shift[2]));
-                        const DataType *src2 =
+                        const SourceType *src2 =
                             psrc + begin[0] - bi[0] * extent[0] + shift[0] +
                             nbr_extent[0] *
                                 (iy + 2 - bi[1] * extent[1] + shift[1] +
                                  nbr_extent[1] *
                                      (iz - bi[2] * extent[2] + shift[2]));
-                        const DataType *src3 =
+                        const SourceType *src3 =
                             psrc + begin[0] - bi[0] * extent[0] + shift[0] +
                             nbr_extent[0] *
                                 (iy + 3 - bi[1] * extent[1] + shift[1] +
                                  nbr_extent[1] *
                                      (iz - bi[2] * extent[2] + shift[2]));
-                        std::memcpy(dst0, src0, bytesx);
-                        std::memcpy(dst1, src1, bytesx);
-                        std::memcpy(dst2, src2, bytesx);
-                        std::memcpy(dst3, src3, bytesx);
+                        labCopy(dst0, src0, nx);
+                        labCopy(dst1, src1, nx);
+                        labCopy(dst2, src2, nx);
+                        labCopy(dst3, src3, nx);
                     }
                 }
             }
@@ -374,9 +660,10 @@ public:
     PeriodicIndexFunctor(FContainer &fields,
                          const IndexRangeType &range,
                          const size_t comp = 0,
-                         const size_t fdir = 0)
+                         const size_t fdir = 0,
+                         const size_t *map = nullptr)
         : fields_(fields), range_(range), extent_(range_.getExtent()),
-          comp_(comp), face_dir_(fdir)
+          comp_(comp), face_dir_(fdir), map_(map)
     {
     }
     PeriodicIndexFunctor() = delete;
@@ -387,12 +674,12 @@ public:
 
     ScalarField &operator()(const MultiIndex &p)
     {
-        return fields_(range_.getFlatIndex(periodic_(p)), comp_, face_dir_);
+        return fields_(container_(p), comp_, face_dir_);
     }
 
     const ScalarField &operator()(const MultiIndex &p) const
     {
-        return fields_(range_.getFlatIndex(periodic_(p)), comp_, face_dir_);
+        return fields_(container_(p), comp_, face_dir_);
     }
 
 private:
@@ -401,14 +688,32 @@ private:
     const MultiIndex extent_;
     const size_t comp_;     // component
     const size_t face_dir_; // face direction
+    const size_t *map_;     // block index to container index (optional)
 
     MultiIndex periodic_(MultiIndex p) const
     {
+        // lab loaders request direct neighbors only, which are wrapped with a
+        // single compare.  The modulo is required for indices further away.
         for (size_t i = 0; i < IndexRangeType::Dim; ++i) {
-            p[i] = (p[i] + extent_[i]) % extent_[i];
+            if (p[i] < 0) {
+                p[i] += extent_[i];
+            } else if (p[i] >= extent_[i]) {
+                p[i] -= extent_[i];
+            } else {
+                continue;
+            }
+            if (p[i] < 0 || p[i] >= extent_[i]) {
+                p[i] = (p[i] % extent_[i] + extent_[i]) % extent_[i];
+            }
         }
         return p;
     }
+
+    size_t container_(const MultiIndex &p) const
+    {
+        const size_t i = range_.getFlatIndex(periodic_(p));
+        return map_ ? map_[i] : i;
+    }
 };
 
 NAMESPACE_END(Block)
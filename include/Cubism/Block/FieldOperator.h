@@ -6,7 +6,9 @@
 #ifndef FIELDOPERATOR_H_0XUYE2ZQ
 #define FIELDOPERATOR_H_0XUYE2ZQ
 
+#include "Cubism/Config.h"
 #include <cassert>
+#include <cstddef>
 
 #define OP_FIELD(A, B, C, N, OP)                                               \
     do {                                                                       \
@@ -141,12 +143,96 @@ void fieldRcp(const DataType *src0,
     return;
 }
 
+/**
+ * @brief Fused multiply-add of a scaled field
+ * @param a Scalar factor
+ * @param x Source field data
+ * @param y Destination field data
+ * @param n Number of elements
+ *
+ * Computes ``y = a * x + y`` in a single pass.
+ */
+template <typename DataType>
+void fieldAxpy(const DataType a,
+               const DataType *x,
+               DataType *y,
+               const size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        y[i] += a * x[i];
+    }
+    return;
+}
+
+/**
+ * @brief Fused linear combination of two fields
+ * @param a Scalar factor for ``x``
+ * @param x Source field data
+ * @param b Scalar factor for ``y``
+ * @param y Destination field data
+ * @param n Number of elements
+ *
+ * Computes ``y = a * x + b * y`` in a single pass.
+ */
+template <typename DataType>
+void fieldAxpby(const DataType a,
+                const DataType *x,
+                const DataType b,
+                DataType *y,
+                const size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        y[i] = a * x[i] + b * y[i];
+    }
+    return;
+}
+
+/**
+ * @brief Fused linear combination of three fields
+ * @param a Scalar factor for ``src0``
+ * @param src0 First source field data
+ * @param b Scalar factor for ``src1``
+ * @param src1 Second source field data
+ * @param c Scalar factor for ``src2``
+ * @param src2 Third source field data
+ * @param dst Destination field data
+ * @param n Number of elements
+ *
+ * Computes ``dst = a * src0 + b * src1 + c * src2`` in a single pass.  The
+ * destination may alias any of the sources.
+ */
+template <typename DataType>
+void fieldLinComb(const DataType a,
+                  const DataType *src0,
+                  const DataType b,
+                  const DataType *src1,
+                  const DataType c,
+                  const DataType *src2,
+                  DataType *dst,
+                  const size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = a * src0[i] + b * src1[i] + c * src2[i];
+    }
+    return;
+}
+
 #undef OP_FIELD
 #undef OP_SCALAR
 #undef RCP
 #undef CHECK_PTR
 
 #ifdef CUBISM_OPTIMIZED_FIELD_OP
+// Optimized kernels for float and double types are implemented in the
+// CubismKernels library (meson option CUBISM_OPTIMIZED_KERNELS).  The
+// instruction set (SSE2, AVX2 or AVX-512) is selected at runtime.
+
+/**
+ * @brief Instruction set used by the optimized field operators
+ * @return Name of the instruction set (scalar, sse2, avx2, avx512)
+ */
+extern "C" const char *fieldOperatorISA();
+
 #define TARGET_NAME(OP, TYPE) field##OP##2_##TYPE
 #define CALLER_NAME(OP) field##OP
 
@@ -154,7 +240,7 @@ void fieldRcp(const DataType *src0,
     extern "C" void TARGET_NAME(OP, TYPE)(                                     \
         const TYPE *, const TYPE *, TYPE *, const size_t);                     \
     template <>                                                                \
-    void CALLER_NAME(OP)(                                                      \
+    inline void CALLER_NAME(OP)(                                               \
         const TYPE *src0, const TYPE *src1, TYPE *dst, const size_t n)         \
     {                                                                          \
         TARGET_NAME(OP, TYPE)(src0, src1, dst, n);                             \
@@ -183,7 +269,7 @@ OPTIMIZED_FIELD(Div, float)
     extern "C" void TARGET_NAME(OP, TYPE)(                                     \
         const TYPE *, const TYPE, TYPE *, const size_t);                       \
     template <>                                                                \
-    void CALLER_NAME(OP)(                                                      \
+    inline void CALLER_NAME(OP)(                                               \
         const TYPE *src0, const TYPE src1, TYPE *dst, const size_t n)          \
     {                                                                          \
         TARGET_NAME(OP, TYPE)(src0, src1, dst, n);                             \
@@ -213,7 +299,7 @@ OPTIMIZED_SCALAR(Div, float)
     extern "C" void TARGET_NAME(TYPE)(                                         \
         const TYPE *, const TYPE, TYPE *, const size_t);                       \
     template <>                                                                \
-    void fieldRcp(                                                             \
+    inline void fieldRcp(                                                      \
         const TYPE *src0, const TYPE src1, TYPE *dst, const size_t n)          \
     {                                                                          \
         TARGET_NAME(TYPE)(src0, src1, dst, n);                                 \
@@ -224,6 +310,51 @@ OPTIMIZED_RCP(double)
 OPTIMIZED_RCP(float)
 #undef OPTIMIZED_RCP
 #undef TARGET_NAME
+
+#define OPTIMIZED_AXPY(TYPE)                                                   \
+    extern "C" void fieldAxpy_##TYPE(                                          \
+        const TYPE, const TYPE *, TYPE *, const size_t);                       \
+    extern "C" void fieldAxpby_##TYPE(                                         \
+        const TYPE, const TYPE *, const TYPE, TYPE *, const size_t);           \
+    extern "C" void fieldLinComb_##TYPE(const TYPE,                            \
+                                        const TYPE *,                          \
+                                        const TYPE,                            \
+                                        const TYPE *,                          \
+                                        const TYPE,                            \
+                                        const TYPE *,                          \
+                                        TYPE *,                                \
+                                        const size_t);                         \
+    template <>                                                                \
+    inline void fieldAxpy(                                                     \
+        const TYPE a, const TYPE *x, TYPE *y, const size_t n)                  \
+    {                                                                          \
+        fieldAxpy_##TYPE(a, x, y, n);                                          \
+        return;                                                                \
+    }                                                                          \
+    template <>                                                                \
+    inline void fieldAxpby(                                                    \
+        const TYPE a, const TYPE *x, const TYPE b, TYPE *y, const size_t n)    \
+    {                                                                          \
+        fieldAxpby_##TYPE(a, x, b, y, n);                                      \
+        return;                                                                \
+    }                                                                          \
+    template <>                                                                \
+    inline void fieldLinComb(const TYPE a,                                     \
+                             const TYPE *src0,                                 \
+                             const TYPE b,                                     \
+                             const TYPE *src1,                                 \
+                             const TYPE c,                                     \
+                             const TYPE *src2,                                 \
+                             TYPE *dst,                                        \
+                             const size_t n)                                   \
+    {                                                                          \
+        fieldLinComb_##TYPE(a, src0, b, src1, c, src2, dst, n);                \
+        return;                                                                \
+    }
+
+OPTIMIZED_AXPY(double)
+OPTIMIZED_AXPY(float)
+#undef OPTIMIZED_AXPY
 #endif /* CUBISM_OPTIMIZED_FIELD_OP */
 
 #endif /* FIELDOPERATOR_H_0XUYE2ZQ */
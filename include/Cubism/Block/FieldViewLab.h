@@ -0,0 +1,346 @@
+// File       : FieldViewLab.h
+// Created    : Fri Oct 16 2026 04:26:13 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Data laboratory with inner domain aliased to block field
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef FIELDVIEWLAB_H_Q3MZ8RVE
+#define FIELDVIEWLAB_H_Q3MZ8RVE
+
+#include "Cubism/Block/FieldLabLoader.h"
+#include "Cubism/Common.h"
+#include "Cubism/Core/Index.h"
+#include "Cubism/Core/Stencil.h"
+#include "Cubism/Math.h"
+#include <cassert>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Block)
+
+/**
+ * @brief Field laboratory view
+ * @tparam TField Field type to map to the lab
+ *
+ * @rst
+ * A read-only lab where the inner domain is not copied but read directly from
+ * the memory of the active block field.  Only the ghost cells are loaded, one
+ * buffer per neighbor region (faces and, for tensorial stencils, edges and
+ * corners), such that the memory footprint is that of the halo only.  Loading
+ * a ``FieldViewLab`` therefore costs only the halo exchange and the lab always
+ * reflects the current state of the inner block data, which is useful for
+ * multi-stage kernels that update the block field between stages.
+ *
+ * The inner domain is accessed without branches through ``getInnerData()``
+ * and ``getInnerStride()``, loops over the inner domain can be vectorized as
+ * for the block field itself.  ``operator[]`` and ``operator()`` accept halo
+ * indices and must decide the region an index belongs to, which costs a
+ * branch per dimension.  Kernels that access ghosts in every stencil
+ * evaluation are therefore better served by a ``FieldLab`` and
+ * ``FieldLab::refreshGhosts()``.
+ *
+ * Boundary conditions operate on ``FieldLab`` types and can not be applied to
+ * a ``FieldViewLab``.  Loading a block field with non-periodic boundary
+ * conditions throws an exception.
+ * @endrst
+ */
+template <typename TField>
+class FieldViewLab
+{
+public:
+    using FieldType = TField;
+    using DataType = typename FieldType::DataType;
+    using IndexRangeType = typename FieldType::IndexRangeType;
+    using MultiIndex = typename IndexRangeType::MultiIndex;
+    using Index = typename MultiIndex::DataType;
+    using StencilType = Core::Stencil<IndexRangeType::Dim>;
+    using STDFunction = std::function<FieldType &(const MultiIndex &)>;
+
+    /** @brief Main constructor */
+    FieldViewLab()
+        : nregions_(IndexRangeType(3).size()), me_(nregions_ / 2),
+          is_allocated_(false), offset_(nregions_), field_(nullptr),
+          extent_(0), begin_(nregions_), extent_r_(nregions_)
+    {
+    }
+
+    FieldViewLab(const FieldViewLab &c) = delete;
+    FieldViewLab(FieldViewLab &&c) = delete;
+    FieldViewLab &operator=(const FieldViewLab &c) = delete;
+    FieldViewLab &operator=(FieldViewLab &&c) = delete;
+    ~FieldViewLab() = default;
+
+    /**
+     * @brief Allocate ghost buffers for a given stencil
+     * @param s Target stencil
+     * @param max_request_range Maximum index range to be processed in the lab
+     * @param force Force re-allocation
+     */
+    void allocate(const StencilType &s,
+                  const IndexRangeType &max_request_range,
+                  const bool force = false)
+    {
+        stencil_ = s;
+        max_range_ = IndexRangeType(max_request_range.getExtent() + 2);
+        size_t size = 0;
+        for (size_t r = 0; r < nregions_; ++r) {
+            offset_[r] = size;
+            size += getRegionExtent_(r, max_range_.getExtent()).prod();
+        }
+        if (force) {
+            std::vector<DataType>().swap(ghosts_);
+        }
+        ghosts_.resize(size);
+        is_allocated_ = true;
+    }
+
+    /**
+     * @brief Lab data loader
+     * @param fid Multi-dimensional index of target block field
+     * @param id2field Index mapping function for block fields
+     *
+     * @rst
+     * Maps the inner domain to the block field with index ``fid`` and loads
+     * the ghost cells.  See ``FieldLab::loadData()`` for the requirements on
+     * ``id2field``.
+     * @endrst
+     */
+    template <typename Functor = STDFunction>
+    void loadData(const MultiIndex &fid, Functor &id2field)
+    {
+        if (!is_allocated_) {
+            throw std::runtime_error(
+                "FieldViewLab: can not load lab data when not allocated first");
+        }
+        FieldType &f = id2field(fid);
+        for (const auto bc : f.getBC()) {
+            if (!bc->getBoundaryInfo().is_periodic) {
+                throw std::runtime_error("FieldViewLab: boundary conditions "
+                                         "are not supported");
+            }
+        }
+        field_ = &f;
+        extent_ = f.getIndexRange().getExtent();
+        assert(extent_ <= max_range_.getExtent());
+
+        const MultiIndex sbegin = stencil_.getBegin();
+        for (size_t r = 0; r < nregions_; ++r) {
+            const MultiIndex bi = getRegionOffset_(r);
+            MultiIndex &begin = begin_[r];
+            extent_r_[r] = getRegionExtent_(r, extent_);
+            for (size_t j = 0; j < IndexRangeType::Dim; ++j) {
+                begin[j] = (bi[j] < 0) ? sbegin[j]
+                                       : ((0 == bi[j]) ? 0 : extent_[j]);
+            }
+            if (me_ == r || 0 == extent_r_[r].prod()) {
+                continue;
+            }
+
+            // copy contiguous rows from the neighbor
+            const FieldType &nbr = id2field(fid + bi);
+            const IndexRangeType &nbr_memory = nbr.getIndexRange();
+            const MultiIndex nbr_extent = nbr_memory.getExtent();
+            MultiIndex nbr_begin = begin - bi * extent_;
+            for (size_t j = 0; j < IndexRangeType::Dim; ++j) {
+                if (bi[j] < 0) {
+                    nbr_begin[j] += nbr_extent[j] - extent_[j];
+                }
+            }
+            MultiIndex rows = extent_r_[r];
+            const size_t nx = rows[0];
+            rows[0] = 1;
+            DataType *dst = ghosts_.data() + offset_[r];
+            const DataType *src = nbr.getData();
+            for (const auto &p : IndexRangeType(rows)) {
+                labCopy(
+                    dst, src + nbr_memory.getFlatIndex(p + nbr_begin), nx);
+                dst += nx;
+            }
+        }
+    }
+
+    /**
+     * @brief Data access
+     * @param p Local multi-dimensional index
+     * @return ``const`` reference to data element
+     *
+     * @rst
+     * The local index ``p`` may reference halo cells.  Branch-free access to
+     * the inner domain is provided by ``getInnerData()``.
+     * @endrst
+     */
+    const DataType &operator[](const MultiIndex &p) const
+    {
+        assert(field_ != nullptr);
+        size_t r = 0;
+        size_t w = 1;
+        for (size_t j = 0; j < IndexRangeType::Dim; ++j) {
+            r += w * ((p[j] < 0) ? 0 : ((p[j] < extent_[j]) ? 1 : 2));
+            w *= 3;
+        }
+        if (me_ == r) {
+            return (*field_)[p];
+        }
+        const MultiIndex q = p - begin_[r];
+        const MultiIndex &extent = extent_r_[r];
+        size_t k = 0;
+        for (size_t j = IndexRangeType::Dim; j > 0; --j) {
+            assert(q[j - 1] >= 0 && q[j - 1] < extent[j - 1]);
+            k = k * extent[j - 1] + q[j - 1];
+        }
+        return ghosts_[offset_[r] + k];
+    }
+
+    /**
+     * @brief Classic data access
+     * @param ix Index for first dimension
+     * @param iy Index for second dimension
+     * @param iz Index for third dimension
+     * @return ``const`` reference to data element
+     *
+     * This operator is only supported for dimensions 1, 2 and 3.
+     */
+    const DataType &
+    operator()(const Index ix, const Index iy = 0, const Index iz = 0) const
+    {
+        static_assert(IndexRangeType::Dim < 4,
+                      "FieldViewLab: operator() not supported");
+        const Index idx[3] = {ix, iy, iz};
+        MultiIndex p;
+        for (size_t j = 0; j < IndexRangeType::Dim; ++j) {
+            p[j] = idx[j];
+        }
+        return (*this)[p];
+    }
+
+    /**
+     * @brief Get pointer to inner block data
+     * @return ``const`` pointer to first data element of the block field
+     */
+    const DataType *getInnerData() const
+    {
+        assert(field_ != nullptr);
+        return field_->getData();
+    }
+
+    /**
+     * @brief Memory stride of the inner block data
+     * @param d Dimension
+     * @return Distance between neighboring inner elements along ``d``
+     *
+     * @rst
+     * Inner element ``p`` is located at ``getInnerData()[p[0] *
+     * getInnerStride(0) + p[1] * getInnerStride(1) + ...]``.
+     * @endrst
+     */
+    Index getInnerStride(const size_t d) const
+    {
+        assert(d < IndexRangeType::Dim);
+        Index stride = 1;
+        for (size_t j = 0; j < d; ++j) {
+            stride *= extent_[j];
+        }
+        return stride;
+    }
+
+    /**
+     * @brief Get currently active (loaded) stencil
+     * @return ``const`` reference to ``StencilType``
+     */
+    const StencilType &getActiveStencil() const { return stencil_; }
+
+    /**
+     * @brief Get currently active (loaded) index range
+     * @return ``const`` reference to ``IndexRangeType``
+     */
+    const IndexRangeType &getActiveRange() const
+    {
+        return getActiveField().getIndexRange();
+    }
+
+    /**
+     * @brief Get currently active (loaded) lab index range
+     * @return Index range including ghost indices
+     */
+    IndexRangeType getActiveLabRange() const
+    {
+        return IndexRangeType(stencil_.getBegin(),
+                              extent_ + stencil_.getEnd() - 1);
+    }
+
+    /**
+     * @brief Get reference to currently active (loaded) field
+     * @return ``const`` reference to ``FieldType``
+     */
+    const FieldType &getActiveField() const
+    {
+        if (!field_) {
+            throw std::runtime_error("FieldViewLab: no field loaded");
+        }
+        return *field_;
+    }
+
+    /**
+     * @brief Get the maximum range that the lab can hold
+     * @return Index range of maximum span
+     */
+    IndexRangeType getMaximumRange() const { return max_range_; }
+
+    /**
+     * @brief Check if lab is allocated
+     * @return True if laboratory is allocated
+     */
+    bool isAllocated() const { return is_allocated_; }
+
+private:
+    // neighbor regions, enumerated by offset + 1 in base 3
+    const size_t nregions_;
+    const size_t me_; // inner domain
+
+    bool is_allocated_;
+    StencilType stencil_;
+    IndexRangeType max_range_;
+    std::vector<DataType> ghosts_; // ghost buffers of all regions
+    std::vector<size_t> offset_;   // buffer offset of region
+
+    // state of active field
+    const FieldType *field_;
+    MultiIndex extent_;                // extent of active field
+    std::vector<MultiIndex> begin_;    // first local index of region
+    std::vector<MultiIndex> extent_r_; // extent of region
+
+    static MultiIndex getRegionOffset_(size_t r)
+    {
+        MultiIndex bi;
+        for (size_t j = 0; j < IndexRangeType::Dim; ++j) {
+            bi[j] = static_cast<Index>(r % 3) - 1;
+            r /= 3;
+        }
+        return bi;
+    }
+
+    MultiIndex getRegionExtent_(const size_t r, const MultiIndex &inner) const
+    {
+        const MultiIndex bi = getRegionOffset_(r);
+        const MultiIndex sbegin = stencil_.getBegin();
+        const MultiIndex send = stencil_.getEnd();
+        MultiIndex extent;
+        Index isum = 0;
+        for (size_t j = 0; j < IndexRangeType::Dim; ++j) {
+            isum += Cubism::myAbs(bi[j]);
+            extent[j] = (bi[j] < 0)
+                            ? -sbegin[j]
+                            : ((0 == bi[j]) ? inner[j] : send[j] - 1);
+        }
+        if (me_ == r || (!stencil_.isTensorial() && isum > 1)) {
+            return MultiIndex(0);
+        }
+        return extent;
+    }
+};
+
+NAMESPACE_END(Block)
+NAMESPACE_END(Cubism)
+
+#endif /* FIELDVIEWLAB_H_Q3MZ8RVE */
@@ -0,0 +1,205 @@
+// File       : FixedFieldLab.h
+// Created    : Fri Oct 16 2026 09:17:06 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Data laboratory with compile-time block shape and stencil
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef FIXEDFIELDLAB_H_7EJQ4WNF
+#define FIXEDFIELDLAB_H_7EJQ4WNF
+
+#include "Cubism/Block/FieldLab.h"
+#include "Cubism/Common.h"
+#include "Cubism/Core/BlockShape.h"
+#include "Cubism/Core/Stencil.h"
+#include <cassert>
+#include <cstddef>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Block)
+
+/**
+ * @brief Field laboratory with compile-time geometry
+ * @tparam TField Field type to map to the lab
+ * @tparam TShape Block shape type ``Core::BlockShape``
+ * @tparam TStencil Stencil type ``Core::StaticStencil``
+ * @tparam TCompute Data type of the lab (compute precision)
+ *
+ * @rst
+ * A ``FieldLab`` for block fields with a block shape known at compile time.
+ * The lab extent, the alignment padding and the memory strides are
+ * ``constexpr`` values such that the classic data access
+ * ``operator()(ix, iy, iz)`` compiles to an address computation with constant
+ * strides which the compiler can unroll and vectorize in stencil loops.  Data
+ * loading and boundary conditions are inherited from ``FieldLab``, a
+ * ``FixedFieldLab`` can be used wherever a ``FieldLab`` is expected.  The
+ * lab can process block fields of any entity type with ``TShape`` cells.
+ * The constant strides of ``operator()`` require that the lab is allocated
+ * for ``TStencil`` and ``TShape``, which is the case for ``allocate(force)``
+ * and for ``FieldLab::allocate()`` with ``getStencil()`` and
+ * ``getMaximumShapeRange()`` (checked in debug builds).
+ * @endrst
+ */
+template <typename TField,
+          typename TShape,
+          typename TStencil,
+          typename TCompute = typename TField::DataType>
+class FixedFieldLab : public FieldLab<TField, TCompute>
+{
+    using BaseLab = FieldLab<TField, TCompute>;
+
+public:
+    using typename BaseLab::DataType;
+    using typename BaseLab::Index;
+    using typename BaseLab::IndexRangeType;
+    using typename BaseLab::MultiIndex;
+    using typename BaseLab::StencilType;
+    using ShapeType = TShape;
+    using StaticStencilType = TStencil;
+
+    /** @brief Lab dimension */
+    static constexpr size_t Dim = IndexRangeType::Dim;
+
+    static_assert(TShape::Dim == Dim,
+                  "FixedFieldLab: block shape dimension mismatch");
+
+    /**
+     * @brief Lab memory extent including ghosts and alignment padding
+     * @param d Dimension
+     * @return Extent along ``d`` or 1 if ``d >= Dim``
+     *
+     * @rst
+     * Identical to ``FieldLab::getLabExtent()`` for the stencil ``TStencil``
+     * and the maximum range of this lab.
+     * @endrst
+     */
+    static constexpr Index getExtent(const size_t d)
+    {
+        // see FieldLab::getLabExtent()
+        return (d >= Dim)
+                   ? 1
+                   : ((0 == d) ? align_(-TStencil::Begin) +
+                                     align_(maxSize_(0) + TStencil::End + 1)
+                               : maxSize_(d) - TStencil::Begin +
+                                     TStencil::End + 1);
+    }
+
+    /** @brief Main constructor */
+    FixedFieldLab() : BaseLab() {}
+
+    using BaseLab::allocate;
+
+    /**
+     * @brief Allocate data lab memory block
+     * @param force Force a reallocation
+     */
+    void allocate(const bool force = false)
+    {
+        BaseLab::allocate(getStencil(), getMaximumShapeRange(), force);
+        assert(isFixedGeometry_());
+    }
+
+    /**
+     * @brief Runtime stencil of this lab
+     * @return Stencil described by ``TStencil``
+     */
+    static StencilType getStencil()
+    {
+        return TStencil::template getStencil<Dim>();
+    }
+
+    /**
+     * @brief Maximum index range processed by this lab
+     * @return Index range of ``TShape`` extended by one for node and face
+     *         fields
+     */
+    static IndexRangeType getMaximumShapeRange()
+    {
+        return IndexRangeType(TShape::getExtent() +
+                              (TField::EntityType == Cubism::EntityType::Cell
+                                   ? 0
+                                   : 1));
+    }
+
+    /**
+     * @brief Classic data access
+     * @param ix Index for first dimension
+     * @param iy Index for second dimension
+     * @param iz Index for third dimension
+     * @return Reference to data element
+     *
+     * This operator is only supported for dimensions 1, 2 and 3.
+     */
+    DataType &operator()(const Index ix, const Index iy = 0, const Index iz = 0)
+    {
+        static_assert(Dim < 4, "FixedFieldLab: operator() not supported");
+        constexpr Index sy = getExtent(0);
+        constexpr Index sz = sy * getExtent(1);
+        assert(isFixedGeometry_());
+        return BaseLab::getInnerData()[ix + sy * iy + sz * iz];
+    }
+
+    /**
+     * @brief Classic data access
+     * @param ix Index for first dimension
+     * @param iy Index for second dimension
+     * @param iz Index for third dimension
+     * @return ``const`` reference to data element
+     *
+     * This operator is only supported for dimensions 1, 2 and 3.
+     */
+    const DataType &
+    operator()(const Index ix, const Index iy = 0, const Index iz = 0) const
+    {
+        static_assert(Dim < 4, "FixedFieldLab: operator() not supported");
+        constexpr Index sy = getExtent(0);
+        constexpr Index sz = sy * getExtent(1);
+        assert(isFixedGeometry_());
+        return BaseLab::getInnerData()[ix + sy * iy + sz * iz];
+    }
+
+private:
+    // lab memory matches the compile-time extent
+    bool isFixedGeometry_() const
+    {
+        if (!BaseLab::isAllocated()) {
+            return false;
+        }
+        const MultiIndex extent = BaseLab::getIndexRange().getExtent();
+        for (size_t d = 0; d < Dim; ++d) {
+            if (extent[d] != getExtent(d)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static constexpr Index maxSize_(const size_t d)
+    {
+        return TShape::size(d) +
+               ((TField::EntityType == Cubism::EntityType::Cell) ? 0 : 1);
+    }
+
+    static constexpr Index align_(const Index n)
+    {
+        return ((n + NAlign_ - 1) / NAlign_) * NAlign_;
+    }
+
+    static constexpr Index NAlign_ = CUBISM_ALIGNMENT / sizeof(DataType);
+};
+
+template <typename TField,
+          typename TShape,
+          typename TStencil,
+          typename TCompute>
+constexpr size_t FixedFieldLab<TField, TShape, TStencil, TCompute>::Dim;
+
+template <typename TField,
+          typename TShape,
+          typename TStencil,
+          typename TCompute>
+constexpr typename FixedFieldLab<TField, TShape, TStencil, TCompute>::Index
+    FixedFieldLab<TField, TShape, TStencil, TCompute>::NAlign_;
+
+NAMESPACE_END(Block)
+NAMESPACE_END(Cubism)
+
+#endif /* FIXEDFIELDLAB_H_7EJQ4WNF */
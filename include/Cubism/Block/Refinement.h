@@ -0,0 +1,171 @@
+// File       : Refinement.h
+// Created    : Sat Oct 17 2026 07:04:33 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Conservative restriction and prolongation of block fields
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef REFINEMENT_H_6PTJ0MWA
+#define REFINEMENT_H_6PTJ0MWA
+
+#include "Cubism/Common.h"
+#include <cmath>
+#include <cstddef>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Block)
+
+/**
+ * @brief Restriction of a fine block field onto a part of a coarse field
+ * @tparam TField Scalar cell field type
+ * @param fine Source field with the resolution of the next finer level
+ * @param coarse Destination field
+ * @param offset Local index in ``coarse`` of the first restricted cell
+ * @param range Restricted coarse cells relative to ``offset``
+ *
+ * @rst
+ * Each coarse cell is the average of its :math:`2^{DIM}` child cells, which
+ * conserves the integral of the field.  The ``fine`` field covers
+ * ``fine.getIndexRange().getExtent() / 2`` coarse cells starting at
+ * ``offset``, of which only the cells in ``range`` are restricted.
+ * @endrst
+ */
+template <typename TField>
+void restrictBlock(const TField &fine,
+                   TField &coarse,
+                   const typename TField::MultiIndex &offset,
+                   const typename TField::IndexRangeType &range)
+{
+    using IndexRangeType = typename TField::IndexRangeType;
+    using MultiIndex = typename TField::MultiIndex;
+    using DataType = typename TField::DataType;
+    static_assert(TField::EntityType == Cubism::EntityType::Cell,
+                  "restrictBlock: cell field required");
+
+    const MultiIndex begin = range.getBegin();
+    const IndexRangeType children(MultiIndex(2));
+    const DataType scale = static_cast<DataType>(1) / children.size();
+    for (const auto &r : range) {
+        const MultiIndex p = begin + r;
+        const MultiIndex q = MultiIndex(2) * p;
+        DataType sum = 0;
+        for (const auto &k : children) {
+            sum += fine[q + k];
+        }
+        coarse[offset + p] = scale * sum;
+    }
+}
+
+/**
+ * @brief Restriction of a fine block field onto a part of a coarse field
+ * @tparam TField Scalar cell field type
+ * @param fine Source field with the resolution of the next finer level
+ * @param coarse Destination field
+ * @param offset Local index in ``coarse`` of the first restricted cell
+ *
+ * @rst
+ * Restricts all cells of ``fine``.  The extent of ``fine`` must be even.
+ * @endrst
+ */
+template <typename TField>
+void restrictBlock(const TField &fine,
+                   TField &coarse,
+                   const typename TField::MultiIndex &offset)
+{
+    using IndexRangeType = typename TField::IndexRangeType;
+    restrictBlock(
+        fine,
+        coarse,
+        offset,
+        IndexRangeType(fine.getIndexRange().getExtent() / 2));
+}
+
+/**
+ * @brief Prolongation of a part of a coarse field onto a fine block field
+ * @tparam TField Scalar cell field type
+ * @param coarse Source field
+ * @param offset Local index in ``coarse`` of the first prolongated cell
+ * @param fine Destination field with the resolution of the next finer level
+ * @param range Prolongated coarse cells relative to ``offset``
+ *
+ * @rst
+ * Piecewise linear reconstruction with minmod limited slopes.  The slopes
+ * are computed from the cells of ``coarse`` only, the slope along a direction
+ * is zero for cells at the boundary of ``coarse``.  The average of the
+ * :math:`2^{DIM}` child cells is equal to the coarse cell value, hence the
+ * prolongation is conservative.  Only the children of the coarse cells in
+ * ``range`` are written to ``fine``.
+ * @endrst
+ */
+template <typename TField>
+void prolongateBlock(const TField &coarse,
+                     const typename TField::MultiIndex &offset,
+                     TField &fine,
+                     const typename TField::IndexRangeType &range)
+{
+    using IndexRangeType = typename TField::IndexRangeType;
+    using MultiIndex = typename TField::MultiIndex;
+    using DataType = typename TField::DataType;
+    constexpr size_t Dim = IndexRangeType::Dim;
+    static_assert(TField::EntityType == Cubism::EntityType::Cell,
+                  "prolongateBlock: cell field required");
+
+    const IndexRangeType &crange = coarse.getIndexRange();
+    const MultiIndex begin = range.getBegin();
+    const IndexRangeType children(MultiIndex(2));
+    const DataType h = static_cast<DataType>(0.25);
+    DataType slope[Dim];
+    for (const auto &r : range) {
+        const MultiIndex p = begin + r;
+        const MultiIndex c = offset + p;
+        const DataType u = coarse[c];
+        for (size_t d = 0; d < Dim; ++d) {
+            MultiIndex cm(c), cp(c);
+            --cm[d];
+            ++cp[d];
+            slope[d] = 0;
+            if (crange.isIndex(cm) && crange.isIndex(cp)) {
+                const DataType a = u - coarse[cm];
+                const DataType b = coarse[cp] - u;
+                if (a * b > 0) {
+                    slope[d] = (std::abs(a) < std::abs(b)) ? a : b;
+                }
+            }
+        }
+        const MultiIndex q = MultiIndex(2) * p;
+        for (const auto &k : children) {
+            DataType v = u;
+            for (size_t d = 0; d < Dim; ++d) {
+                v += k[d] ? h * slope[d] : -h * slope[d];
+            }
+            fine[q + k] = v;
+        }
+    }
+}
+
+/**
+ * @brief Prolongation of a part of a coarse field onto a fine block field
+ * @tparam TField Scalar cell field type
+ * @param coarse Source field
+ * @param offset Local index in ``coarse`` of the first prolongated cell
+ * @param fine Destination field with the resolution of the next finer level
+ *
+ * @rst
+ * Fills all cells of ``fine``.  The extent of ``fine`` must be even.
+ * @endrst
+ */
+template <typename TField>
+void prolongateBlock(const TField &coarse,
+                     const typename TField::MultiIndex &offset,
+                     TField &fine)
+{
+    using IndexRangeType = typename TField::IndexRangeType;
+    prolongateBlock(
+        coarse,
+        offset,
+        fine,
+        IndexRangeType(fine.getIndexRange().getExtent() / 2));
+}
+
+NAMESPACE_END(Block)
+NAMESPACE_END(Cubism)
+
+#endif /* REFINEMENT_H_6PTJ0MWA */
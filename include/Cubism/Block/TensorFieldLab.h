@@ -0,0 +1,647 @@
+// File       : TensorFieldLab.h
+// Created    : Fri Oct 16 2026 02:17:09 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Batched data laboratory for multi-component block fields
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef TENSORFIELDLAB_H_J6XWD2QM
+#define TENSORFIELDLAB_H_J6XWD2QM
+
+#include "Cubism/Alloc/AlignedBlockAllocator.h"
+#include "Cubism/BC/Engine.h"
+#include "Cubism/Block/FieldLab.h"
+#include "Cubism/Common.h"
+#include "Cubism/Core/Index.h"
+#include "Cubism/Core/Vector.h"
+#include "Cubism/Math.h"
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Block)
+
+/**
+ * @brief Memory layout of multi-component labs
+ *
+ * @rst
+ * SoA
+ *    Structure of arrays.  Each scalar component is stored in its own plane,
+ *    planes are adjacent in memory and aligned at ``CUBISM_ALIGNMENT``.
+ *
+ * AoS
+ *    Array of structures.  All scalar components of a lab element are stored
+ *    contiguously (interleaved).
+ * @endrst
+ */
+enum class LabLayout { SoA = 0, AoS };
+
+/**
+ * @brief Scalar component access for block field classes
+ * @tparam TField Block field type
+ * @tparam Class Field class of ``TField``
+ * @tparam RANK Rank of ``TField``
+ */
+template <typename TField, Cubism::FieldClass Class, size_t RANK>
+struct ScalarComponent {
+    using FieldType = typename TField::FieldType;
+    static FieldType &get(TField &f, const size_t c, const size_t)
+    {
+        return f[c];
+    }
+};
+
+template <typename TField, size_t RANK>
+struct ScalarComponent<TField, Cubism::FieldClass::Scalar, RANK> {
+    using FieldType = typename TField::FieldType;
+    static FieldType &get(TField &f, const size_t, const size_t) { return f; }
+};
+
+template <typename TField, size_t RANK>
+struct ScalarComponent<TField, Cubism::FieldClass::FaceContainer, RANK> {
+    using FieldType = typename TField::FieldType;
+    static FieldType &get(TField &f, const size_t c, const size_t d)
+    {
+        return f[d][c];
+    }
+};
+
+template <typename TField>
+struct ScalarComponent<TField, Cubism::FieldClass::FaceContainer, 0> {
+    using FieldType = typename TField::FieldType;
+    static FieldType &get(TField &f, const size_t, const size_t d)
+    {
+        return f[d];
+    }
+};
+
+/**
+ * @brief Batched field laboratory for multi-component block fields
+ * @tparam TField Block field type (scalar, tensor or face container)
+ * @tparam Layout Memory layout of the lab components
+ *
+ * @rst
+ * Loads all scalar components of a ``TensorField`` or all faces (and their
+ * components) of a ``FaceContainer`` in one pass.  Compared to one
+ * ``FieldLab`` per component, neighbor block fields are resolved once and the
+ * halo geometry is computed once per face direction.  The components are
+ * enumerated with the scalar index ``index(c, d) = d * NComponents + c``,
+ * consistent with ``FieldLabSet``.
+ *
+ * With the ``LabLayout::SoA`` layout, each component is accessible as a
+ * ``FieldLab`` view through ``getLab()`` such that boundary conditions and
+ * existing kernels can be used unchanged.  Boundary conditions operate on
+ * ``FieldLab`` types and can therefore not be applied with the
+ * ``LabLayout::AoS`` layout, where only periodic boundaries are supported.
+ *
+ * .. code-block:: cpp
+ *
+ *    using Lab = Block::TensorFieldLab<Grid::BaseType>;
+ *    Lab lab;
+ *    lab.allocate(stencil, grid[0].getIndexRange());
+ *    for (auto f : grid) {
+ *        grid.loadLab(*f, lab);
+ *        auto &u = lab.getLab(0);
+ *        auto &v = lab.getLab(1);
+ *        // ...
+ *    }
+ * @endrst
+ */
+template <typename TField, LabLayout Layout = LabLayout::SoA>
+class TensorFieldLab
+{
+    using ComponentMap = ScalarComponent<TField, TField::Class, TField::Rank>;
+    using Allocator = Cubism::AlignedBlockAllocator<typename TField::DataType>;
+
+public:
+    /** @brief Block field type */
+    using FieldType = TField;
+    /** @brief Scalar field sub-type */
+    using ScalarFieldType = typename TField::FieldType;
+    /** @brief Scalar component lab type */
+    using LabType = FieldLab<ScalarFieldType>;
+    using DataType = typename LabType::DataType;
+    using IndexRangeType = typename LabType::IndexRangeType;
+    using MultiIndex = typename LabType::MultiIndex;
+    using Index = typename LabType::Index;
+    using StencilType = typename LabType::StencilType;
+    using BCVector = typename ScalarFieldType::BCVector;
+    using STDFunction = std::function<FieldType &(const MultiIndex &)>;
+
+    /** @brief Field dimension */
+    static constexpr size_t Dim = IndexRangeType::Dim;
+    /** @brief Number of field components */
+    static constexpr size_t NComponents = FieldType::NComponents;
+    /** @brief Number of face directions (1 for non-face fields) */
+    static constexpr size_t NGroups =
+        (FieldType::Class == Cubism::FieldClass::FaceContainer) ? Dim : 1;
+    /** @brief Number of scalar components in the lab */
+    static constexpr size_t NScalars = NGroups * NComponents;
+
+    /** @brief Main constructor */
+    TensorFieldLab()
+        : is_allocated_(false), data_(nullptr), bytes_(0), plane_(0),
+          estride_(0), cstride_(0), lab_begin_(0)
+    {
+    }
+
+    TensorFieldLab(const TensorFieldLab &c) = delete;
+    TensorFieldLab(TensorFieldLab &&c) = delete;
+    TensorFieldLab &operator=(const TensorFieldLab &c) = delete;
+    TensorFieldLab &operator=(TensorFieldLab &&c) = delete;
+    ~TensorFieldLab() { dealloc_(); }
+
+    /**
+     * @brief Scalar index of a component
+     * @param c Component index
+     * @param d Face direction
+     * @return Scalar component index in the lab
+     */
+    static size_t index(const size_t c, const size_t d = 0)
+    {
+        assert(c < NComponents && d < NGroups);
+        return d * NComponents + c;
+    }
+
+    /**
+     * @brief Allocate lab memory for a given stencil
+     * @param s Target stencil
+     * @param max_request_range Maximum index range to be processed in the lab
+     * @param force Force re-allocation
+     *
+     * @rst
+     * All components are placed in a single allocation.  See
+     * ``FieldLab::allocate()`` for the meaning of ``max_request_range``.
+     * @endrst
+     */
+    void allocate(const StencilType &s,
+                  const IndexRangeType &max_request_range,
+                  const bool force = false)
+    {
+        const MultiIndex lab_extent =
+            LabType::getLabExtent(s, max_request_range, lab_begin_);
+        const size_t n_per_align = CUBISM_ALIGNMENT / sizeof(DataType);
+        const size_t plane =
+            ((lab_extent.prod() + n_per_align - 1) / n_per_align) *
+            n_per_align;
+        const bool can_reuse = is_allocated_ && plane <= plane_;
+
+        stencil_ = s;
+        max_range_ = IndexRangeType(max_request_range.getExtent() + 2);
+        range_ = IndexRangeType(lab_extent);
+        if (force || !can_reuse) {
+            dealloc_();
+            bytes_ = NScalars * plane * sizeof(DataType);
+            data_ = alloc_.allocate(bytes_);
+            plane_ = plane;
+            is_allocated_ = true;
+        }
+        if (LabLayout::SoA == Layout) {
+            estride_ = 1;
+            cstride_ = plane_;
+            for (size_t i = 0; i < NScalars; ++i) {
+                labs_[i].allocate(s, max_request_range, data_ + i * plane_);
+            }
+        } else {
+            estride_ = NScalars;
+            cstride_ = 1;
+        }
+    }
+
+    /**
+     * @brief Lab data loader
+     * @param fid Multi-dimensional index of target block field
+     * @param id2field Index mapping function for block fields
+     * @param apply_bc Flag whether to apply boundary conditions
+     *
+     * @rst
+     * The ``id2field`` mapping function takes a multi-dimensional block field
+     * index as an argument and returns a reference to the corresponding block
+     * field of type ``FieldType``.  The function must map indices
+     * periodically.  Each neighbor is resolved once for all components.
+     * Boundary conditions are taken from the individual scalar components and
+     * applied with one ``BC::Engine`` per component as in ``FieldLab``.
+     * @endrst
+     */
+    template <typename Functor = STDFunction>
+    void loadData(const MultiIndex &fid,
+                  Functor &id2field,
+                  const bool apply_bc = true)
+    {
+        if (!is_allocated_) {
+            throw std::runtime_error("TensorFieldLab: can not load lab data "
+                                     "when not allocated first");
+        }
+
+        // 1. load the block field data of all components
+        // 2. load the halos of all components
+        // 3. apply boundary conditions
+
+        // 1.
+        FieldType &f = id2field(fid);
+        for (size_t d = 0; d < NGroups; ++d) {
+            for (size_t c = 0; c < NComponents; ++c) {
+                const size_t i = index(c, d);
+                ScalarFieldType &sf = ComponentMap::get(f, c, d);
+                field_[i] = &sf;
+                curr_range_[i] = sf.getIndexRange();
+                if (LabLayout::SoA == Layout) {
+                    labs_[i].setActiveField(sf);
+                }
+                assert(curr_range_[i].getExtent() <= max_range_.getExtent());
+                copyBox_(i,
+                         sf,
+                         MultiIndex(0),
+                         curr_range_[i].getExtent(),
+                         MultiIndex(0));
+
+                skip_[i] = MultiIndex(0);
+                for (const auto bc : sf.getBC()) {
+                    const auto info = bc->getBoundaryInfo();
+                    assert(info.dir < Dim);
+                    if (!info.is_periodic) {
+                        skip_[i][info.dir] |= skipSideBit(info.side);
+                    }
+                    if (apply_bc && !info.is_periodic &&
+                        LabLayout::AoS == Layout) {
+                        throw std::runtime_error(
+                            "TensorFieldLab: boundary conditions are not "
+                            "supported with LabLayout::AoS");
+                    }
+                }
+            }
+        }
+
+        // 2.
+        loadGhosts_(fid, id2field);
+
+        // 3.
+        if (apply_bc && LabLayout::SoA == Layout) {
+            for (size_t i = 0; i < NScalars; ++i) {
+                bc_engine_[i].apply(labs_[i], field_[i]->getBC());
+            }
+        }
+    }
+
+    /**
+     * @brief Scalar component lab
+     * @param c Component index
+     * @param d Face direction
+     * @return Reference to ``FieldLab`` view of component
+     *
+     * Only available for the ``LabLayout::SoA`` layout.
+     */
+    LabType &getLab(const size_t c, const size_t d = 0)
+    {
+        static_assert(LabLayout::SoA == Layout,
+                      "TensorFieldLab: getLab() requires LabLayout::SoA");
+        return labs_[index(c, d)];
+    }
+
+    /**
+     * @brief Scalar component lab
+     * @param c Component index
+     * @param d Face direction
+     * @return ``const`` reference to ``FieldLab`` view of component
+     *
+     * Only available for the ``LabLayout::SoA`` layout.
+     */
+    const LabType &getLab(const size_t c, const size_t d = 0) const
+    {
+        static_assert(LabLayout::SoA == Layout,
+                      "TensorFieldLab: getLab() requires LabLayout::SoA");
+        return labs_[index(c, d)];
+    }
+
+    /**
+     * @brief Data access
+     * @param s Scalar component index (see ``index()``)
+     * @param p Local multi-dimensional index (may reference halo cells)
+     * @return Reference to data element
+     */
+    DataType &operator()(const size_t s, const MultiIndex &p)
+    {
+        assert(s < NScalars);
+        assert(range_.isIndex(p + lab_begin_));
+        return data_[s * cstride_ +
+                     estride_ * range_.getFlatIndex(p + lab_begin_)];
+    }
+
+    /**
+     * @brief Data access
+     * @param s Scalar component index (see ``index()``)
+     * @param p Local multi-dimensional index (may reference halo cells)
+     * @return ``const`` reference to data element
+     */
+    const DataType &operator()(const size_t s, const MultiIndex &p) const
+    {
+        assert(s < NScalars);
+        assert(range_.isIndex(p + lab_begin_));
+        return data_[s * cstride_ +
+                     estride_ * range_.getFlatIndex(p + lab_begin_)];
+    }
+
+    /**
+     * @brief Classic data access
+     * @param s Scalar component index (see ``index()``)
+     * @param ix Index for first dimension
+     * @param iy Index for second dimension
+     * @param iz Index for third dimension
+     * @return Reference to data element
+     *
+     * This operator is only supported for dimensions 1, 2 and 3.
+     */
+    DataType &operator()(const size_t s,
+                         const Index ix,
+                         const Index iy = 0,
+                         const Index iz = 0)
+    {
+        return data_[offset_(s, ix, iy, iz)];
+    }
+
+    /**
+     * @brief Classic data access
+     * @param s Scalar component index (see ``index()``)
+     * @param ix Index for first dimension
+     * @param iy Index for second dimension
+     * @param iz Index for third dimension
+     * @return ``const`` reference to data element
+     *
+     * This operator is only supported for dimensions 1, 2 and 3.
+     */
+    const DataType &operator()(const size_t s,
+                               const Index ix,
+                               const Index iy = 0,
+                               const Index iz = 0) const
+    {
+        return data_[offset_(s, ix, iy, iz)];
+    }
+
+    /**
+     * @brief Get pointer to inner block data of a component
+     * @param s Scalar component index (see ``index()``)
+     * @return Pointer to first inner data element of component ``s``
+     *
+     * @rst
+     * Consecutive elements in the first dimension are ``getElementStride()``
+     * apart.
+     * @endrst
+     */
+    DataType *getInnerData(const size_t s)
+    {
+        return data_ + s * cstride_ +
+               estride_ * range_.getFlatIndex(lab_begin_);
+    }
+
+    /**
+     * @brief Get pointer to inner block data of a component
+     * @param s Scalar component index (see ``index()``)
+     * @return ``const`` pointer to first inner data element of component ``s``
+     */
+    const DataType *getInnerData(const size_t s) const
+    {
+        return data_ + s * cstride_ +
+               estride_ * range_.getFlatIndex(lab_begin_);
+    }
+
+    /**
+     * @brief Distance between consecutive lab elements of a component
+     * @return Element stride
+     */
+    size_t getElementStride() const { return estride_; }
+
+    /**
+     * @brief Distance between the same lab element of consecutive components
+     * @return Component stride
+     */
+    size_t getComponentStride() const { return cstride_; }
+
+    /**
+     * @brief Get index range of lab memory
+     * @return Index range of one component including ghosts and padding
+     */
+    const IndexRangeType &getLabRange() const { return range_; }
+
+    /**
+     * @brief Get currently active (loaded) stencil
+     * @return ``const`` reference to ``StencilType``
+     */
+    const StencilType &getActiveStencil() const { return stencil_; }
+
+    /**
+     * @brief Get currently active (loaded) index range
+     * @param s Scalar component index (see ``index()``)
+     * @return ``const`` reference to ``IndexRangeType``
+     */
+    const IndexRangeType &getActiveRange(const size_t s = 0) const
+    {
+        assert(s < NScalars);
+        return curr_range_[s];
+    }
+
+    /**
+     * @brief Get the maximum range that the lab can hold
+     * @return Index range of maximum span
+     */
+    IndexRangeType getMaximumRange() const { return max_range_; }
+
+    /**
+     * @brief Check if lab is allocated
+     * @return True if laboratory is allocated
+     */
+    bool isAllocated() const { return is_allocated_; }
+
+private:
+    bool is_allocated_;
+    DataType *data_;
+    size_t bytes_;
+    size_t plane_;   // aligned number of elements per component
+    size_t estride_; // element stride
+    size_t cstride_; // component stride
+    Allocator alloc_;
+    StencilType stencil_;
+    IndexRangeType range_;     // lab memory range of one component
+    IndexRangeType max_range_; // maximum range that can be loaded
+    MultiIndex lab_begin_;     // offset of inner domain in lab memory
+
+    // state of active components
+    LabType labs_[NScalars]; // component views (LabLayout::SoA only)
+    BC::Engine<Dim> bc_engine_[NScalars]; // per component slab cache
+    ScalarFieldType *field_[NScalars];
+    IndexRangeType curr_range_[NScalars];
+    MultiIndex skip_[NScalars]; // non-periodic sides (see skipSideBit())
+
+    void dealloc_()
+    {
+        if (data_ != nullptr) {
+            alloc_.deallocate(data_);
+            data_ = nullptr;
+            bytes_ = 0;
+        }
+        is_allocated_ = false;
+    }
+
+    size_t offset_(const size_t s,
+                   const Index ix,
+                   const Index iy,
+                   const Index iz) const
+    {
+        assert(s < NScalars);
+        const MultiIndex &lb = lab_begin_;
+        if (1 == Dim) {
+            return s * cstride_ + estride_ * (ix + lb[0]);
+        } else if (2 == Dim) {
+            return s * cstride_ +
+                   estride_ * (ix + lb[0] + range_.sizeDim(0) * (iy + lb[1]));
+        } else if (3 == Dim) {
+            return s * cstride_ +
+                   estride_ * (ix + lb[0] +
+                               range_.sizeDim(0) *
+                                   (iy + lb[1] +
+                                    range_.sizeDim(1) * (iz + lb[2])));
+        }
+        throw std::runtime_error("TensorFieldLab: operator() not supported");
+    }
+
+    /**
+     * @brief Copy a box of source data into the lab
+     * @param s Scalar component index
+     * @param src Source scalar field
+     * @param begin Box begin in local lab indices
+     * @param end Box end in local lab indices
+     * @param src_shift Index shift from lab box to source indices
+     *
+     * Rows in the first dimension are copied contiguously.
+     */
+    void copyBox_(const size_t s,
+                  const ScalarFieldType &src,
+                  const MultiIndex &begin,
+                  const MultiIndex &end,
+                  const MultiIndex &src_shift)
+    {
+        const MultiIndex extent = end - begin;
+        for (size_t j = 0; j < Dim; ++j) {
+            if (extent[j] <= 0) {
+                return;
+            }
+        }
+        MultiIndex row_extent = extent;
+        row_extent[0] = 1;
+        const IndexRangeType rows(row_extent);
+        const IndexRangeType &src_range = src.getIndexRange();
+        const DataType *psrc = src.getData();
+        DataType *pdst = data_ + s * cstride_;
+        const MultiIndex src_begin = begin + src_shift;
+        const MultiIndex dst_begin = begin + lab_begin_;
+        const Index n = extent[0];
+        for (auto &p : rows) {
+            const DataType *srow = psrc + src_range.getFlatIndex(p + src_begin);
+            DataType *drow =
+                pdst + estride_ * range_.getFlatIndex(p + dst_begin);
+            if (LabLayout::SoA == Layout) {
+                std::memcpy(drow, srow, n * sizeof(DataType));
+            } else {
+                for (Index k = 0; k < n; ++k) {
+                    drow[k * estride_] = srow[k];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Load ghost cells of all components
+     * @param fid Multi-dimensional index of target block field
+     * @param id2field Index mapping function for block fields
+     */
+    template <typename Functor>
+    void loadGhosts_(const MultiIndex &fid, Functor &id2field)
+    {
+        const IndexRangeType nbr_range(0, 3);
+        const size_t neighbors = nbr_range.size();
+        const size_t me = neighbors / 2;
+        const MultiIndex stencil_begin = stencil_.getBegin();
+        const MultiIndex stencil_end = stencil_.getEnd() - 1;
+        for (size_t i = 0; i < neighbors; ++i) {
+            if (i == me) {
+                continue;
+            }
+            const MultiIndex bi = nbr_range.getMultiIndex(i) - 1;
+            Index isum = 0;
+            for (size_t j = 0; j < Dim; ++j) {
+                isum += Cubism::myAbs(bi[j]);
+            }
+            if (!stencil_.isTensorial() && isum > 1) {
+                continue;
+            }
+
+            // components that require data from this neighbor
+            bool load[NScalars];
+            bool any = false;
+            for (size_t s = 0; s < NScalars; ++s) {
+                load[s] = true;
+                for (size_t j = 0; j < Dim; ++j) {
+                    if (isSkippedSide(skip_[s][j], bi[j])) {
+                        load[s] = false;
+                        break;
+                    }
+                }
+                any = any || load[s];
+            }
+            if (!any) {
+                continue;
+            }
+
+            FieldType &f = id2field(fid + bi); // resolved once
+            for (size_t d = 0; d < NGroups; ++d) {
+                // halo geometry is shared by all components of a face
+                // direction
+                const size_t s0 = index(0, d);
+                const MultiIndex extent = curr_range_[s0].getExtent();
+                const MultiIndex nbr_extent =
+                    ComponentMap::get(f, 0, d).getIndexRange().getExtent();
+                MultiIndex begin, end, shift(0);
+                for (size_t j = 0; j < Dim; ++j) {
+                    if (bi[j] < 0) {
+                        shift[j] = nbr_extent[j] - extent[j];
+                        begin[j] = stencil_begin[j];
+                        end[j] = 0;
+                    } else if (bi[j] == 0) {
+                        begin[j] = 0;
+                        end[j] = extent[j];
+                    } else {
+                        begin[j] = extent[j];
+                        end[j] = extent[j] + stencil_end[j];
+                    }
+                }
+                const MultiIndex src_shift = shift - bi * extent;
+                for (size_t c = 0; c < NComponents; ++c) {
+                    const size_t s = index(c, d);
+                    if (load[s]) {
+                        copyBox_(s,
+                                 ComponentMap::get(f, c, d),
+                                 begin,
+                                 end,
+                                 src_shift);
+                    }
+                }
+            }
+        }
+    }
+};
+
+template <typename TField, LabLayout Layout>
+constexpr size_t TensorFieldLab<TField, Layout>::Dim;
+
+template <typename TField, LabLayout Layout>
+constexpr size_t TensorFieldLab<TField, Layout>::NComponents;
+
+template <typename TField, LabLayout Layout>
+constexpr size_t TensorFieldLab<TField, Layout>::NGroups;
+
+template <typename TField, LabLayout Layout>
+constexpr size_t TensorFieldLab<TField, Layout>::NScalars;
+
+NAMESPACE_END(Block)
+NAMESPACE_END(Cubism)
+
+#endif /* TENSORFIELDLAB_H_J6XWD2QM */
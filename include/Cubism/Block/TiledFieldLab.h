@@ -0,0 +1,453 @@
+// File       : TiledFieldLab.h
+// Created    : Fri Oct 16 2026 10:31:18 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Data laboratory for cache blocked processing of block tiles
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef TILEDFIELDLAB_H_UC8ZP1KD
+#define TILEDFIELDLAB_H_UC8ZP1KD
+
+#include "Cubism/Alloc/AlignedBlockAllocator.h"
+#include "Cubism/Block/FieldLab.h"
+#include "Cubism/Block/FieldLabLoader.h"
+#include "Cubism/Common.h"
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Block)
+
+/**
+ * @brief Field laboratory for sub-tiles of a block field
+ * @tparam TField Field type to map to the lab
+ * @tparam TCompute Data type of the lab (compute precision)
+ *
+ * @rst
+ * A ``TiledFieldLab`` holds one tile of a block field including the ghost
+ * cells of the tile for a given stencil.  Large blocks are processed tile by
+ * tile such that the working set of a kernel fits into the L1/L2 cache, while
+ * the block size can be kept large for efficient MPI messages.  Ghost cells
+ * of a tile are loaded from the block field itself or from its neighbor
+ * block fields.  The memory layout of a tile is identical to a ``FieldLab``
+ * allocated for the tile shape.
+ *
+ * Boundary conditions are applied to the full lab of a block and are not
+ * supported for tiles.  Loading a tile of a block field with non-periodic
+ * boundary conditions throws an exception.  The boundary conditions are
+ * checked on every load.
+ *
+ * .. code-block:: cpp
+ *
+ *    using GridType = Grid::Cartesian<double, Mesh, EntityType::Cell, 0>;
+ *    GridType grid(nblocks, block_cells);
+ *    GridType tmp(nblocks, block_cells); // destination with same topology
+ *    const Core::Stencil<3> stencil(-1, 2);
+ *
+ *    TiledFieldLab<GridType::BaseType> lab;
+ *    lab.allocate(stencil, lab.getTileShape(block_cells, stencil));
+ *    for (auto f : grid) {
+ *        const auto &bi = f->getState().block_index;
+ *        auto fmap = grid.getNeighborFunctor(*f);
+ *        lab.process(bi, fmap, tmp[bi], kernel);
+ *    }
+ * @endrst
+ */
+template <typename TField, typename TCompute = typename TField::DataType>
+class TiledFieldLab
+{
+    using LabType = FieldLab<TField, TCompute>;
+    using Allocator = Cubism::AlignedBlockAllocator<TCompute>;
+
+public:
+    using FieldType = TField;
+    using DataType = TCompute;
+    using IndexRangeType = typename LabType::IndexRangeType;
+    using MultiIndex = typename LabType::MultiIndex;
+    using Index = typename LabType::Index;
+    using StencilType = typename LabType::StencilType;
+    using STDFunction = std::function<FieldType &(const MultiIndex &)>;
+
+    /** @brief Lab dimension */
+    static constexpr size_t Dim = IndexRangeType::Dim;
+
+    /** @brief Main constructor */
+    TiledFieldLab()
+        : is_allocated_(false), data_(nullptr), bytes_(0), tile_(0),
+          lab_begin_(0)
+    {
+    }
+
+    TiledFieldLab(const TiledFieldLab &c) = delete;
+    TiledFieldLab(TiledFieldLab &&c) = delete;
+    TiledFieldLab &operator=(const TiledFieldLab &c) = delete;
+    TiledFieldLab &operator=(TiledFieldLab &&c) = delete;
+    ~TiledFieldLab() { dealloc_(); }
+
+    /**
+     * @brief Tile shape for a cache size
+     * @param block_extent Extent of the block fields to be processed
+     * @param s Target stencil
+     * @param cache_bytes Target size of the tile lab in bytes
+     * @return Tile shape
+     *
+     * @rst
+     * Heuristic tile shape: the fastest moving index is kept at the full
+     * block extent for long contiguous rows and the slowest moving indices are
+     * halved until the tile lab including ghosts fits into ``cache_bytes``.
+     * The default targets a typical L2 cache per core.
+     * @endrst
+     */
+    static MultiIndex getTileShape(const MultiIndex &block_extent,
+                                   const StencilType &s,
+                                   const size_t cache_bytes = 256 * 1024)
+    {
+        MultiIndex tile = block_extent;
+        MultiIndex lab_begin;
+        while (Dim > 1) {
+            const MultiIndex extent =
+                LabType::getLabExtent(s, IndexRangeType(tile), lab_begin);
+            if (extent.prod() * sizeof(DataType) <= cache_bytes) {
+                break;
+            }
+            // halve the slowest moving index with the largest tile extent
+            size_t d = Dim - 1;
+            for (size_t i = Dim - 1; i > 0; --i) {
+                if (tile[i] > tile[d]) {
+                    d = i;
+                }
+            }
+            if (1 == tile[d]) {
+                break;
+            }
+            tile[d] = (tile[d] + 1) / 2;
+        }
+        return tile;
+    }
+
+    /**
+     * @brief Allocate tile lab memory
+     * @param s Target stencil
+     * @param tile Maximum tile shape
+     *
+     * @rst
+     * Tiles with an extent smaller than ``tile`` can be loaded as well (e.g.
+     * truncated tiles at the end of a block).
+     * @endrst
+     */
+    void allocate(const StencilType &s, const MultiIndex &tile)
+    {
+        assert(tile > MultiIndex(0));
+        const MultiIndex extent =
+            LabType::getLabExtent(s, IndexRangeType(tile), lab_begin_);
+        const size_t bytes = extent.prod() * sizeof(DataType);
+        if (!is_allocated_ || bytes > bytes_) {
+            dealloc_();
+            bytes_ = bytes;
+            data_ = alloc_.allocate(bytes_);
+            is_allocated_ = true;
+        }
+        stencil_ = s;
+        tile_ = tile;
+        range_ = IndexRangeType(extent);
+        active_ = IndexRangeType(tile);
+    }
+
+    /**
+     * @brief Load a tile of a block field
+     * @param fid Multi-dimensional index of target block field
+     * @param id2field Index mapping function for block fields
+     * @param tile Index range of the tile in the block field
+     *
+     * @rst
+     * The extent of ``tile`` must not exceed the allocated tile shape.  See
+     * ``FieldLab::loadData()`` for the requirements on ``id2field``.
+     * Corner ghosts are not loaded for non-tensorial stencils.
+     * @endrst
+     */
+    template <typename Functor = STDFunction>
+    void loadTile(const MultiIndex &fid,
+                  Functor &id2field,
+                  const IndexRangeType &tile)
+    {
+        if (!is_allocated_) {
+            throw std::runtime_error(
+                "TiledFieldLab: Can not load tile when not allocated first");
+        }
+        FieldType &f = id2field(fid);
+        for (const auto bc : f.getBC()) {
+            if (!bc->getBoundaryInfo().is_periodic) {
+                throw std::runtime_error("TiledFieldLab: boundary "
+                                         "conditions are not supported");
+            }
+        }
+        assert(tile.getExtent() <= tile_);
+        assert(tile.getBegin() >= MultiIndex(0));
+        assert(tile.getEnd() <= f.getIndexRange().getExtent());
+        active_ = tile;
+
+        const MultiIndex curr = f.getIndexRange().getExtent();
+        const MultiIndex tbegin = tile.getBegin();
+        const MultiIndex lbegin = tbegin + stencil_.getBegin();
+        const MultiIndex lend = tile.getEnd() + stencil_.getEnd() - 1;
+
+        // x-segments of a row: lower neighbor, block, upper neighbor
+        Index xb[3], xe[3];
+        xb[0] = lbegin[0];
+        xe[0] = (lend[0] < 0) ? lend[0] : 0;
+        xb[1] = (lbegin[0] > 0) ? lbegin[0] : 0;
+        xe[1] = (lend[0] < curr[0]) ? lend[0] : curr[0];
+        xb[2] = (lbegin[0] > curr[0]) ? lbegin[0] : curr[0];
+        xe[2] = lend[0];
+
+        MultiIndex row_extent = lend - lbegin;
+        row_extent[0] = 1;
+        const IndexRangeType rows(row_extent);
+        for (const auto &q : rows) {
+            MultiIndex p = lbegin + q; // block local index
+            MultiIndex off(0);
+            size_t outside = 0;
+            for (size_t j = 1; j < Dim; ++j) {
+                off[j] = (p[j] < 0) ? -1 : ((p[j] >= curr[j]) ? 1 : 0);
+                outside += (0 != off[j]) ? 1 : 0;
+            }
+            for (size_t k = 0; k < 3; ++k) {
+                if (xe[k] <= xb[k]) {
+                    continue;
+                }
+                off[0] = static_cast<Index>(k) - 1;
+                const size_t n_outside = outside + ((1 == k) ? 0 : 1);
+                if (!stencil_.isTensorial() && n_outside > 1) {
+                    continue; // corners are not loaded
+                }
+                p[0] = xb[k];
+                const FieldType &nf =
+                    (0 == n_outside) ? f : id2field(fid + off);
+                const IndexRangeType &nr = nf.getIndexRange();
+                const MultiIndex next = nr.getExtent();
+                MultiIndex src = p;
+                for (size_t j = 0; j < Dim; ++j) {
+                    if (off[j] < 0) {
+                        src[j] += next[j];
+                    } else if (off[j] > 0) {
+                        src[j] -= curr[j];
+                    }
+                }
+                labCopy(data_ + range_.getFlatIndex(p - tbegin + lab_begin_),
+                        nf.getData() + nr.getFlatIndex(src),
+                        static_cast<size_t>(xe[k] - xb[k]));
+            }
+        }
+    }
+
+    /**
+     * @brief Process all tiles of a block field with a kernel
+     * @tparam Functor Index mapping function type
+     * @tparam Kernel Kernel type
+     * @param fid Multi-dimensional index of target block field
+     * @param id2field Index mapping function for block fields
+     * @param dst Destination field with the extent of the block field
+     * @param kernel Compute kernel
+     * @param factor Kernel argument passed through
+     *
+     * @rst
+     * Loads each tile of the block field ``id2field(fid)`` and calls
+     *
+     * .. code-block:: cpp
+     *
+     *    kernel(Nx, Ny, Nz,
+     *           src, x_pitch_src, xy_pitch_src,
+     *           dst, x_pitch_dst, xy_pitch_dst,
+     *           factor);
+     *
+     * where ``Nx``, ``Ny`` and ``Nz`` is the tile extent, ``src`` points to
+     * the first inner element of the tile lab and ``dst`` to the first
+     * element of the tile in ``dst``.  Pitches are element counts.  This is
+     * the low-level kernel signature used by the ISPC benchmark kernels.
+     * This method is only supported for dimensions 1, 2 and 3.
+     * @endrst
+     */
+    template <typename Functor, typename Kernel>
+    void process(const MultiIndex &fid,
+                 Functor &id2field,
+                 FieldType &dst,
+                 Kernel kernel,
+                 const DataType factor = 1)
+    {
+        static_assert(Dim < 4, "TiledFieldLab: process() not supported");
+        const MultiIndex extent = dst.getIndexRange().getExtent();
+        assert(extent == id2field(fid).getIndexRange().getExtent());
+        MultiIndex ntiles;
+        for (size_t j = 0; j < Dim; ++j) {
+            ntiles[j] = (extent[j] + tile_[j] - 1) / tile_[j];
+        }
+        const int x_pitch_src = static_cast<int>(getPitchX());
+        const int xy_pitch_src = static_cast<int>(getPitchXY());
+        const int x_pitch_dst = static_cast<int>(extent[0]);
+        const int xy_pitch_dst =
+            static_cast<int>(extent[0] * ((Dim > 1) ? extent[1] : 1));
+        const IndexRangeType dst_range(extent);
+        for (const auto &t : IndexRangeType(ntiles)) {
+            const MultiIndex tbegin = t * tile_;
+            MultiIndex tend = tbegin + tile_;
+            for (size_t j = 0; j < Dim; ++j) {
+                tend[j] = (tend[j] < extent[j]) ? tend[j] : extent[j];
+            }
+            const IndexRangeType tile(tbegin, tend);
+            loadTile(fid, id2field, tile);
+            const MultiIndex n = tile.getExtent();
+            kernel(static_cast<int>(n[0]),
+                   static_cast<int>((Dim > 1) ? n[1] : 1),
+                   static_cast<int>((Dim > 2) ? n[2] : 1),
+                   static_cast<const DataType *>(getInnerData()),
+                   x_pitch_src,
+                   xy_pitch_src,
+                   dst.getData() + dst_range.getFlatIndex(tbegin),
+                   x_pitch_dst,
+                   xy_pitch_dst,
+                   factor);
+        }
+    }
+
+    /**
+     * @brief Linear data access
+     * @param p Multi-dimensional index relative to the tile begin
+     * @return Reference to data element
+     *
+     * @rst
+     * The index ``p`` may reference ghost cells of the tile.
+     * @endrst
+     */
+    DataType &operator[](const MultiIndex &p)
+    {
+        assert(range_.isIndex(p + lab_begin_));
+        return data_[range_.getFlatIndex(p + lab_begin_)];
+    }
+
+    /**
+     * @brief Linear data access
+     * @param p Multi-dimensional index relative to the tile begin
+     * @return ``const`` reference to data element
+     */
+    const DataType &operator[](const MultiIndex &p) const
+    {
+        assert(range_.isIndex(p + lab_begin_));
+        return data_[range_.getFlatIndex(p + lab_begin_)];
+    }
+
+    /**
+     * @brief Classic data access
+     * @param ix Index for first dimension relative to the tile begin
+     * @param iy Index for second dimension relative to the tile begin
+     * @param iz Index for third dimension relative to the tile begin
+     * @return Reference to data element
+     *
+     * This operator is only supported for dimensions 1, 2 and 3.
+     */
+    DataType &operator()(const Index ix, const Index iy = 0, const Index iz = 0)
+    {
+        return getInnerData()[ix + getPitchX() * iy + getPitchXY() * iz];
+    }
+
+    /**
+     * @brief Classic data access
+     * @param ix Index for first dimension relative to the tile begin
+     * @param iy Index for second dimension relative to the tile begin
+     * @param iz Index for third dimension relative to the tile begin
+     * @return ``const`` reference to data element
+     *
+     * This operator is only supported for dimensions 1, 2 and 3.
+     */
+    const DataType &
+    operator()(const Index ix, const Index iy = 0, const Index iz = 0) const
+    {
+        return getInnerData()[ix + getPitchX() * iy + getPitchXY() * iz];
+    }
+
+    /**
+     * @brief Get pointer to the first inner element of the tile
+     * @return Pointer to data element
+     */
+    DataType *getInnerData()
+    {
+        return data_ + range_.getFlatIndex(lab_begin_);
+    }
+
+    /**
+     * @brief Get pointer to the first inner element of the tile
+     * @return ``const`` pointer to data element
+     */
+    const DataType *getInnerData() const
+    {
+        return data_ + range_.getFlatIndex(lab_begin_);
+    }
+
+    /**
+     * @brief Number of elements between consecutive x-rows
+     * @return x-pitch of the lab memory
+     */
+    Index getPitchX() const { return static_cast<Index>(range_.sizeDim(0)); }
+
+    /**
+     * @brief Number of elements between consecutive xy-slices
+     * @return xy-pitch of the lab memory
+     */
+    Index getPitchXY() const
+    {
+        const MultiIndex extent = range_.getExtent();
+        return extent[0] * ((Dim > 1) ? extent[1] : 1);
+    }
+
+    /**
+     * @brief Get currently active (loaded) tile
+     * @return Index range of the tile in the block field
+     */
+    const IndexRangeType &getActiveTile() const { return active_; }
+
+    /**
+     * @brief Get the allocated tile shape
+     * @return Maximum tile shape
+     */
+    const MultiIndex &getTileShape() const { return tile_; }
+
+    /**
+     * @brief Get the active stencil
+     * @return ``const`` reference to ``StencilType``
+     */
+    const StencilType &getActiveStencil() const { return stencil_; }
+
+    /**
+     * @brief Check if lab is allocated
+     * @return True if laboratory is allocated
+     */
+    bool isAllocated() const { return is_allocated_; }
+
+private:
+    bool is_allocated_;
+    DataType *data_;
+    size_t bytes_;
+    Allocator alloc_;
+    StencilType stencil_;
+    MultiIndex tile_;       // maximum tile shape
+    IndexRangeType range_;  // lab memory range
+    IndexRangeType active_; // active tile in block field
+    MultiIndex lab_begin_;  // offset of inner domain in lab memory
+
+    void dealloc_()
+    {
+        if (data_ != nullptr) {
+            alloc_.deallocate(data_);
+            data_ = nullptr;
+            bytes_ = 0;
+        }
+        is_allocated_ = false;
+    }
+};
+
+template <typename TField, typename TCompute>
+constexpr size_t TiledFieldLab<TField, TCompute>::Dim;
+
+NAMESPACE_END(Block)
+NAMESPACE_END(Cubism)
+
+#endif /* TILEDFIELDLAB_H_UC8ZP1KD */
@@ -0,0 +1,84 @@
+// File       : BlockShape.h
+// Created    : Fri Oct 16 2026 09:02:44 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Compile-time block shape
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef BLOCKSHAPE_H_H2QV9LCA
+#define BLOCKSHAPE_H_H2QV9LCA
+
+#include "Cubism/Common.h"
+#include "Cubism/Core/Index.h"
+#include <cstddef>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Core)
+
+/**
+ * @brief Compile-time number of cells in a block
+ * @tparam N Number of cells along each dimension
+ *
+ * @rst
+ * Describes the shape of a block at compile time, e.g.
+ * ``BlockShape<32, 32, 32>``.  Types that take a block shape parameter use it
+ * to derive strides and extents as ``constexpr`` values.
+ * @endrst
+ */
+template <Index... N>
+struct BlockShape {
+    /** @brief Dimension of the block */
+    static constexpr size_t Dim = sizeof...(N);
+    /** @brief Index range type */
+    using IndexRangeType = Core::IndexRange<Dim>;
+    /** @brief Type for higher dimensional index */
+    using MultiIndex = typename IndexRangeType::MultiIndex;
+
+    static_assert(Dim > 0, "BlockShape: dimension must be larger than zero");
+
+    /**
+     * @brief Number of cells along a dimension
+     * @param d Dimension
+     * @return Number of cells along ``d`` or 1 if ``d >= Dim``
+     */
+    static constexpr Index size(const size_t d)
+    {
+        return (d < Dim) ? extent_[d] : 1;
+    }
+
+    /**
+     * @brief Total number of cells in the block
+     * @return Number of cells
+     */
+    static constexpr size_t prod() { return prod_(0); }
+
+    /**
+     * @brief Number of cells along all dimensions
+     * @return Multi-dimensional extent of the block
+     */
+    static MultiIndex getExtent()
+    {
+        MultiIndex e;
+        for (size_t d = 0; d < Dim; ++d) {
+            e[d] = extent_[d];
+        }
+        return e;
+    }
+
+private:
+    static constexpr Index extent_[Dim] = {N...};
+
+    static constexpr size_t prod_(const size_t d)
+    {
+        return (d < Dim) ? static_cast<size_t>(extent_[d]) * prod_(d + 1) : 1;
+    }
+};
+
+template <Index... N>
+constexpr size_t BlockShape<N...>::Dim;
+
+template <Index... N>
+constexpr Index BlockShape<N...>::extent_[];
+
+NAMESPACE_END(Core)
+NAMESPACE_END(Cubism)
+
+#endif /* BLOCKSHAPE_H_H2QV9LCA */
@@ -91,6 +91,18 @@ public:
      */
     bool isTensorial() const { return is_tensorial_; }
 
+    /**
+     * @brief Equality operator
+     *
+     * Two stencils are equal if their begin, end and tensorial type are equal.
+     */
+    bool operator==(const Stencil &other) const
+    {
+        return begin_ == other.begin_ && end_ == other.end_ &&
+               is_tensorial_ == other.is_tensorial_;
+    }
+    bool operator!=(const Stencil &other) const { return !(*this == other); }
+
 private:
     MultiIndex begin_; // <= 0 (inclusive)
     MultiIndex end_;   // > 0 (exclusive)
@@ -107,6 +119,50 @@ private:
     }
 };
 
+/**
+ * @brief Describes a stencil at compile time
+ * @tparam B Begin of stencil (inclusive)
+ * @tparam E End of stencil (exclusive)
+ * @tparam TENSORIAL Flag for tensorial stencil type
+ *
+ * @rst
+ * The stencil extends symmetrically in all dimensions.  A symmetric stencil
+ * from -3 to +3 is described by ``StaticStencil<-3, 4>``.
+ * @endrst
+ */
+template <Index B, Index E, bool TENSORIAL = false>
+struct StaticStencil {
+    static_assert(B <= 0, "StaticStencil: begin must be <= 0");
+    static_assert(E > 0, "StaticStencil: end must be > 0");
+
+    /** @brief Begin of stencil (inclusive) */
+    static constexpr Index Begin = B;
+    /** @brief End of stencil (exclusive) */
+    static constexpr Index End = E;
+    /** @brief Tensorial stencil type */
+    static constexpr bool IsTensorial = TENSORIAL;
+
+    /**
+     * @brief Runtime stencil
+     * @tparam DIM Stencil dimensionality
+     * @return Stencil of this type
+     */
+    template <size_t DIM>
+    static Stencil<DIM> getStencil()
+    {
+        return Stencil<DIM>(B, E, TENSORIAL);
+    }
+};
+
+template <Index B, Index E, bool TENSORIAL>
+constexpr Index StaticStencil<B, E, TENSORIAL>::Begin;
+
+template <Index B, Index E, bool TENSORIAL>
+constexpr Index StaticStencil<B, E, TENSORIAL>::End;
+
+template <Index B, Index E, bool TENSORIAL>
+constexpr bool StaticStencil<B, E, TENSORIAL>::IsTensorial;
+
 NAMESPACE_END(Core)
 NAMESPACE_END(Cubism)
 
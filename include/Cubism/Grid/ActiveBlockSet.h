@@ -0,0 +1,208 @@
+// File       : ActiveBlockSet.h
+// Created    : Sat Oct 17 2026 05:26:44 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Thread-safe set of active blocks for sparse grid passes
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef ACTIVEBLOCKSET_H_3HXW9QCM
+#define ACTIVEBLOCKSET_H_3HXW9QCM
+
+#include "Cubism/Common.h"
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Grid)
+
+/**
+ * @brief Set of active blocks
+ *
+ * @rst
+ * Bitset with one bit per block of a grid, indexed in field container order.
+ * Blocks can be activated and deactivated concurrently from multiple threads,
+ * the bits are updated with atomic operations.  The updates are relaxed, a
+ * thread reading the set concurrently with updates observes some
+ * intermediate state.  Updates become visible to all threads at the next
+ * synchronization point, e.g. the implicit barrier at the end of an OpenMP
+ * parallel region.
+ *
+ * Active blocks are extracted word-wise in increasing index order, the cost
+ * of a sparse iteration is proportional to the number of active blocks plus
+ * the number of storage words (one per 64 blocks).
+ * @endrst
+ */
+class ActiveBlockSet
+{
+public:
+    /** @brief Storage word type */
+    using WordType = uint64_t;
+
+    /** @brief Number of bits per storage word */
+    static constexpr size_t WordBits = 64;
+
+    /** @brief Default constructor (empty set) */
+    ActiveBlockSet() : size_(0), nwords_(0) {}
+
+    /**
+     * @brief Main constructor
+     * @param n Number of blocks
+     *
+     * All blocks are inactive after construction.
+     */
+    explicit ActiveBlockSet(const size_t n) : size_(0), nwords_(0)
+    {
+        resize(n);
+    }
+
+    /** @brief Deleted copy constructor */
+    ActiveBlockSet(const ActiveBlockSet &c) = delete;
+    /** @brief Deleted copy assignment */
+    ActiveBlockSet &operator=(const ActiveBlockSet &c) = delete;
+
+    /**
+     * @brief Resize the set
+     * @param n Number of blocks
+     *
+     * @rst
+     * All blocks are inactive after resizing.  Not thread-safe.
+     * @endrst
+     */
+    void resize(const size_t n)
+    {
+        size_ = n;
+        nwords_ = (n + WordBits - 1) / WordBits;
+        words_.reset(new std::atomic<WordType>[nwords_]);
+        clear();
+    }
+
+    /**
+     * @brief Number of blocks
+     * @return Number of blocks covered by the set
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * @brief Activate a block
+     * @param i Block index
+     * @return True if the block was inactive before
+     */
+    bool activate(const size_t i)
+    {
+        assert(i < size_);
+        const WordType bit = static_cast<WordType>(1) << (i % WordBits);
+        return !(words_[i / WordBits].fetch_or(
+                     bit, std::memory_order_relaxed) &
+                 bit);
+    }
+
+    /**
+     * @brief Deactivate a block
+     * @param i Block index
+     * @return True if the block was active before
+     */
+    bool deactivate(const size_t i)
+    {
+        assert(i < size_);
+        const WordType bit = static_cast<WordType>(1) << (i % WordBits);
+        return words_[i / WordBits].fetch_and(~bit,
+                                              std::memory_order_relaxed) &
+               bit;
+    }
+
+    /**
+     * @brief Test if a block is active
+     * @param i Block index
+     * @return True if the block is active
+     */
+    bool isActive(const size_t i) const
+    {
+        assert(i < size_);
+        return (words_[i / WordBits].load(std::memory_order_relaxed) >>
+                (i % WordBits)) &
+               1;
+    }
+
+    /** @brief Deactivate all blocks */
+    void clear()
+    {
+        for (size_t k = 0; k < nwords_; ++k) {
+            words_[k].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /** @brief Activate all blocks */
+    void fill()
+    {
+        for (size_t k = 0; k < nwords_; ++k) {
+            words_[k].store(~static_cast<WordType>(0),
+                            std::memory_order_relaxed);
+        }
+        if ((size_ % WordBits) > 0) {
+            // keep bits beyond the last block cleared
+            words_[nwords_ - 1].store(
+                (static_cast<WordType>(1) << (size_ % WordBits)) - 1,
+                std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Number of active blocks
+     * @return Number of set bits
+     */
+    size_t count() const
+    {
+        size_t n = 0;
+        for (size_t k = 0; k < nwords_; ++k) {
+            WordType w = words_[k].load(std::memory_order_relaxed);
+            for (; w; w &= w - 1) {
+                ++n;
+            }
+        }
+        return n;
+    }
+
+    /**
+     * @brief Visit active blocks
+     * @tparam Func Callable type
+     * @param f Functor ``f(i)`` called for each active block index ``i``
+     *
+     * @rst
+     * Blocks are visited in increasing index order.
+     * @endrst
+     */
+    template <typename Func>
+    void forEach(Func &&f) const
+    {
+        for (size_t k = 0; k < nwords_; ++k) {
+            WordType w = words_[k].load(std::memory_order_relaxed);
+            while (w) {
+                f(k * WordBits + static_cast<size_t>(__builtin_ctzll(w)));
+                w &= w - 1; // clear lowest set bit
+            }
+        }
+    }
+
+    /**
+     * @brief Compact list of active blocks
+     * @return Vector of active block indices in increasing order
+     */
+    std::vector<size_t> getList() const
+    {
+        std::vector<size_t> list;
+        forEach([&list](const size_t i) { list.push_back(i); });
+        return list;
+    }
+
+private:
+    size_t size_;
+    size_t nwords_;
+    std::unique_ptr<std::atomic<WordType>[]> words_;
+};
+
+NAMESPACE_END(Grid)
+NAMESPACE_END(Cubism)
+
+#endif /* ACTIVEBLOCKSET_H_3HXW9QCM */
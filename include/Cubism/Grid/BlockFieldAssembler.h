@@ -8,6 +8,7 @@
 
 #include "Cubism/Block/Field.h"
 #include "Cubism/Common.h"
+#include <cassert>
 #include <cstddef>
 #include <vector>
 
@@ -77,10 +78,15 @@ struct BlockFieldAssembler {
      * @param block_bytes Number of bytes occupied by each block
      * @param component_bytes Number of bytes per tensor component (must be
      *        larger or equal to ``nblocks.prod() * block_bytes``)
+     * @param order Flat block indices (with respect to ``block_range``) in
+     *        memory order
      *
      * @rst
      * Assembles block fields and its sub mesh on a Cartesian topology using
-     * the external data ``src``.
+     * the external data ``src``.  The ``k``-th assembled field corresponds to
+     * the block with flat index ``order[k]`` and occupies the ``k``-th block
+     * slot in memory.  Blocks are assembled in lexicographic order if
+     * ``order`` is empty.
      * @endrst
      */
     void assemble(DataType *src,
@@ -89,7 +95,8 @@ struct BlockFieldAssembler {
                   const MultiIndex &block_cells,
                   const MultiIndex &scale,
                   const size_t block_bytes,
-                  const size_t component_bytes)
+                  const size_t component_bytes,
+                  const std::vector<size_t> &order = std::vector<size_t>())
     {
         dispose();
 
@@ -109,7 +116,10 @@ struct BlockFieldAssembler {
         std::vector<std::vector<size_t>> CC;
         std::vector<std::vector<FieldState *>> DD;
 
-        for (size_t i = 0; i < block_range.size(); ++i) {
+        assert(order.empty() || order.size() == block_range.size());
+        for (size_t k = 0; k < block_range.size(); ++k) {
+            const size_t i = order.empty() ? k : order[k];
+
             // initialize the field state
             FieldState *fs = new FieldState();
             field_states.push_back(fs);
@@ -158,7 +168,7 @@ struct BlockFieldAssembler {
                     for (size_t c = 0; c < BaseType::NComponents; ++c) {
                         char *dst =
                             base + d * BaseType::NComponents * component_bytes +
-                            c * component_bytes + i * block_bytes;
+                            c * component_bytes + k * block_bytes;
                         A.push_back(face_ranges[d]);
                         B.push_back(reinterpret_cast<DataType *>(dst));
                         C.push_back(block_bytes);
@@ -175,7 +185,7 @@ struct BlockFieldAssembler {
                 }
             } else if (Entity == Cubism::EntityType::Node) {
                 for (size_t c = 0; c < BaseType::NComponents; ++c) {
-                    char *dst = base + c * component_bytes + i * block_bytes;
+                    char *dst = base + c * component_bytes + k * block_bytes;
                     A.push_back(node_range);
                     B.push_back(reinterpret_cast<DataType *>(dst));
                     C.push_back(block_bytes);
@@ -187,7 +197,7 @@ struct BlockFieldAssembler {
                 DD.push_back(D);
             } else if (Entity == Cubism::EntityType::Cell) {
                 for (size_t c = 0; c < BaseType::NComponents; ++c) {
-                    char *dst = base + c * component_bytes + i * block_bytes;
+                    char *dst = base + c * component_bytes + k * block_bytes;
                     A.push_back(cell_range);
                     B.push_back(reinterpret_cast<DataType *>(dst));
                     C.push_back(block_bytes);
@@ -0,0 +1,145 @@
+// File       : BlockOrdering.h
+// Created    : Fri Oct 16 2026 06:41:27 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Space-filling curve block orderings for Cartesian grids
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef BLOCKORDERING_H_W7KM2PZE
+#define BLOCKORDERING_H_W7KM2PZE
+
+#include "Cubism/Common.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Grid)
+
+/**
+ * @brief Block ordering policy
+ *
+ * @rst
+ * Defines the order in which blocks of a Cartesian grid are placed in memory
+ * and visited when iterating over the grid.
+ *
+ * Lexicographic
+ *    Blocks are ordered by their flat index with the first dimension running
+ *    fastest (default).
+ *
+ * Morton
+ *    Blocks are ordered along a Z-order curve obtained from bit interleaving
+ *    of the block index.
+ *
+ * Hilbert
+ *    Blocks are ordered along a Hilbert curve.  Consecutive blocks are face
+ *    neighbors if the number of blocks is the same power of two in all
+ *    dimensions.
+ * @endrst
+ */
+enum class BlockOrder { Lexicographic = 0, Morton, Hilbert };
+
+/**
+ * @brief Compute block order along a curve
+ * @tparam IndexRange Index range type
+ * @param range Range of blocks
+ * @param order Ordering policy
+ * @return Vector of lexicographic flat block indices in curve order
+ *
+ * @rst
+ * The ``k``-th element of the returned vector is the flat index (with respect
+ * to ``range``) of the ``k``-th block along the curve.  For extents that are
+ * not a power of two, the blocks are sorted by their curve key in the
+ * enclosing power of two box.
+ * @endrst
+ */
+template <typename IndexRange>
+std::vector<size_t> computeBlockOrder(const IndexRange &range,
+                                      const BlockOrder order)
+{
+    using MultiIndex = typename IndexRange::MultiIndex;
+    constexpr size_t Dim = IndexRange::Dim;
+
+    const size_t nblocks = range.size();
+    std::vector<size_t> seq(nblocks);
+    for (size_t i = 0; i < nblocks; ++i) {
+        seq[i] = i;
+    }
+    if (BlockOrder::Lexicographic == order || nblocks < 2) {
+        return seq;
+    }
+
+    // number of bits per dimension
+    const MultiIndex extent = range.getExtent();
+    size_t bits = 0;
+    while ((static_cast<size_t>(1) << bits) <
+           static_cast<size_t>(extent.max())) {
+        ++bits;
+    }
+    if (Dim * bits > 64) {
+        throw std::runtime_error(
+            "computeBlockOrder: Too many blocks for 64-bit curve keys");
+    }
+
+    const bool hilbert = (BlockOrder::Hilbert == order);
+    std::vector<std::pair<uint64_t, size_t>> keys(nblocks);
+    uint64_t X[Dim];
+    for (size_t i = 0; i < nblocks; ++i) {
+        const MultiIndex p = range.getMultiIndex(i);
+        for (size_t d = 0; d < Dim; ++d) {
+            X[d] = static_cast<uint64_t>(p[d]);
+        }
+        if (hilbert && bits > 0) {
+            // Skilling, J. (2004). Programming the Hilbert curve. AIP
+            // Conference Proceedings, 707, 381-387.  Transforms the
+            // coordinates in-place into the transposed Hilbert index.
+            const uint64_t M = static_cast<uint64_t>(1) << (bits - 1);
+            for (uint64_t Q = M; Q > 1; Q >>= 1) {
+                const uint64_t P = Q - 1;
+                for (size_t d = 0; d < Dim; ++d) {
+                    if (X[d] & Q) {
+                        X[0] ^= P;
+                    } else {
+                        const uint64_t t = (X[0] ^ X[d]) & P;
+                        X[0] ^= t;
+                        X[d] ^= t;
+                    }
+                }
+            }
+            for (size_t d = 1; d < Dim; ++d) {
+                X[d] ^= X[d - 1];
+            }
+            uint64_t t = 0;
+            for (uint64_t Q = M; Q > 1; Q >>= 1) {
+                if (X[Dim - 1] & Q) {
+                    t ^= Q - 1;
+                }
+            }
+            for (size_t d = 0; d < Dim; ++d) {
+                X[d] ^= t;
+            }
+        }
+        // interleave bits.  The first dimension is least significant for
+        // Morton keys, the transposed Hilbert index stores the most
+        // significant bit in the first dimension.
+        uint64_t key = 0;
+        for (size_t b = bits; b > 0; --b) {
+            for (size_t d = 0; d < Dim; ++d) {
+                const size_t k = hilbert ? d : Dim - 1 - d;
+                key = (key << 1) | ((X[k] >> (b - 1)) & 1);
+            }
+        }
+        keys[i] = std::make_pair(key, i);
+    }
+    std::sort(keys.begin(), keys.end());
+    for (size_t i = 0; i < nblocks; ++i) {
+        seq[i] = keys[i].second;
+    }
+    return seq;
+}
+
+NAMESPACE_END(Grid)
+NAMESPACE_END(Cubism)
+
+#endif /* BLOCKORDERING_H_W7KM2PZE */
@@ -7,13 +7,32 @@
 #define CARTESIAN_H_QBSFTWK7
 
 #include "Cubism/Alloc/AlignedBlockAllocator.h"
+#include "Cubism/Block/CellMask.h"
 #include "Cubism/Block/Field.h"
 #include "Cubism/Block/FieldLab.h"
 #include "Cubism/Block/FieldLabLoader.h"
+#include "Cubism/Block/FieldViewLab.h"
+#include "Cubism/Block/TensorFieldLab.h"
 #include "Cubism/Common.h"
+#include "Cubism/Core/Stencil.h"
+#include "Cubism/Core/Vector.h"
+#include "Cubism/Grid/ActiveBlockSet.h"
 #include "Cubism/Grid/BlockFieldAssembler.h"
+#include "Cubism/Grid/BlockOrdering.h"
+#include "Cubism/Grid/NeighborTable.h"
+#include "Cubism/Grid/Reduction.h"
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif /* _OPENMP */
 
 NAMESPACE_BEGIN(Cubism)
 /**
@@ -22,6 +41,32 @@ NAMESPACE_BEGIN(Cubism)
 /** @brief Namespace for grid data types composed of block data types */
 NAMESPACE_BEGIN(Grid)
 
+/**
+ * @brief First-touch policy for grid memory
+ *
+ * @rst
+ * None
+ *    Memory is not touched during construction (default).  The application
+ *    is responsible to touch the data based on its thread partition strategy.
+ *
+ * Static
+ *    Blocks are zeroed in parallel using an OpenMP static partition of the
+ *    block index.  All components of a block are touched by the same thread,
+ *    such that memory pages are placed on the NUMA node of the thread that
+ *    processes the block in a loop over blocks with static schedule.
+ *    ``Grid::process()`` uses a static schedule for such grids.  Subsets of
+ *    blocks (``Grid::processActive()`` and the inner/halo blocks of a
+ *    distributed grid) are still scheduled dynamically and do not follow the
+ *    touch partition.
+ *
+ * Interleave
+ *    Memory pages are zeroed round-robin by all OpenMP threads.  This spreads
+ *    the pages evenly among the NUMA nodes the threads are bound to and is
+ *    suitable for dynamic scheduling of block processing.
+ * @endrst
+ */
+enum class FirstTouch { None = 0, Static, Interleave };
+
 /**
  * @brief Cartesian block (tensor) field
  * @tparam T Field data type
@@ -39,6 +84,27 @@ NAMESPACE_BEGIN(Grid)
  * section for a distributed variant of this class.  The field state can be
  * extended with the ``UserState`` extension.  The ``UserState`` type must be
  * trivially copyable.
+ *
+ * The order of the blocks in memory and for iteration over the grid is set by
+ * a ``BlockOrder`` policy.  Space-filling curve orderings place neighboring
+ * blocks close in memory and make the static thread partitions of block loops
+ * compact in space.  Access by multi-dimensional block index is independent of
+ * the ordering.
+ *
+ * Lab ghosts are loaded through a table of direct block neighbors built once
+ * for the topology (see ``getNeighborTable()``).  Periodic wrap-around is
+ * resolved when the table is built, such that blocks at the boundary of a
+ * periodic domain read their ghosts from the periodic images exactly like
+ * interior blocks from their neighbors, without per-block index arithmetic
+ * and without copying boundary slabs into a separate halo buffer.
+ *
+ * Optional cell masks mark solid cells for immersed boundaries with one bit
+ * per cell (see ``allocateMasks()``).  Blocks that are fully solid are
+ * skipped by ``Grid::process()`` and by the reductions of cell grids.
+ *
+ * Passes that only touch a small subset of the blocks mark these blocks in
+ * the set of active blocks (see ``activate()``) and visit them with
+ * ``getActiveBlocks()`` or ``Grid::processActive()``.
  * @endrst
  */
 template <typename T,
@@ -62,6 +128,8 @@ public:
     using PointType = typename MeshType::PointType;
     /** @brief Type float used to describe the mesh topology */
     using RealType = typename MeshType::RealType;
+    /** @brief Cell mask type of a block */
+    using MaskType = Block::CellMask<MeshType::Dim>;
 
     /**
      * @brief Field state
@@ -72,7 +140,8 @@ public:
      * Cartesian topology.  The mesh pointer points to the block (sub) mesh if
      * topological information is required.  The ``user`` addition can be
      * customized depending on the needs of the application.  The ``user`` field
-     * is not initialized during construction.
+     * is not initialized during construction.  The mask pointer is
+     * ``nullptr`` unless cell masks are allocated for the grid.
      * @endrst
      */
     struct FieldState {
@@ -80,10 +149,46 @@ public:
         MultiIndex block_index;
         /** @brief Block mesh */
         MeshType *mesh;
+        /** @brief Block cell mask */
+        const MaskType *mask;
         /** @brief User extension */
         UserState user;
     };
 
+    /**
+     * @brief Component values of a cell
+     *
+     * @rst
+     * Argument type for the per-cell functor in ``reduce()``.  Component ``c``
+     * is accessed with ``operator[](c)``.
+     * @endrst
+     */
+    class CellValues
+    {
+    public:
+        CellValues(const T *p, const size_t stride) : p_(p), stride_(stride)
+        {
+        }
+
+        /**
+         * @brief Component value
+         * @param c Component index
+         * @return Value of component ``c``
+         */
+        const T &operator[](const size_t c) const { return p_[c * stride_]; }
+
+    private:
+        const T *const p_;
+        const size_t stride_;
+    };
+
+    /**
+     * @brief Result type of a reduction with per-cell functor ``Func``
+     */
+    template <typename Func>
+    using ReduceResult = typename std::decay<
+        typename std::result_of<Func(const CellValues &)>::type>::type;
+
 protected:
     /** @brief Type of mesh hull (full mesh or sub-mesh) */
     using MeshIntegrity = typename MeshType::MeshIntegrity;
@@ -101,6 +206,13 @@ public:
     /** @brief Periodic block field access by index */
     using IndexFunctor =
         Block::PeriodicIndexFunctor<FieldContainer, BaseType::Class, RANK>;
+    /** @brief Boolean vector type */
+    using BoolVec = Core::Vector<bool, Mesh::Dim>;
+    /** @brief Table of direct block neighbors */
+    using NeighborTableType = NeighborTable<Mesh::Dim>;
+    /** @brief Block field access through the neighbor table */
+    using NeighborIndexFunctor =
+        NeighborFunctor<FieldContainer, BaseType::Class, RANK>;
 
     /** @brief Field dimension */
     static constexpr size_t Dim = MeshType::Dim;
@@ -110,13 +222,16 @@ public:
     static constexpr size_t NComponents = BaseType::NComponents;
     /** @brief Entity type of field */
     static constexpr typename Cubism::EntityType EntityType = Entity;
+    /** @brief Stencil type */
+    using StencilType = Core::Stencil<Dim>;
 
     /**
      * @brief Default constructor (empty topology)
      */
     Cartesian()
         : nblocks_(0), block_cells_(0), block_range_(0), mesh_(nullptr),
-          global_mesh_(nullptr), data_(nullptr)
+          global_mesh_(nullptr), block_order_(BlockOrder::Lexicographic),
+          first_touch_(FirstTouch::None), data_(nullptr), nslices_(0)
     {
     }
 
@@ -128,17 +243,22 @@ public:
      * @param end Physical end for this Cartesian grid (top right)
      * @param gbegin Global begin of physical domain
      * @param gend Global end of physical domain
+     * @param touch First-touch policy for block data
+     * @param order Ordering of blocks in memory and for iteration
      */
     Cartesian(const MultiIndex &nblocks,
               const MultiIndex &block_cells,
               const PointType &begin = PointType(0),
               const PointType &end = PointType(1),
               const PointType &gbegin = PointType(0),
-              const PointType &gend = PointType(1))
+              const PointType &gend = PointType(1),
+              const FirstTouch touch = FirstTouch::None,
+              const BlockOrder order = BlockOrder::Lexicographic)
         : nblocks_(nblocks), block_cells_(block_cells), block_range_(nblocks),
-          mesh_(nullptr), global_mesh_(nullptr), data_(nullptr)
+          mesh_(nullptr), global_mesh_(nullptr), block_order_(order),
+          first_touch_(FirstTouch::None), data_(nullptr)
     {
-        initTopology_(gbegin, gend, begin, end);
+        initTopology_(gbegin, gend, begin, end, MultiIndex(1), touch);
         global_mesh_ = mesh_;
     }
 
@@ -163,9 +283,8 @@ public:
             throw std::runtime_error(
                 "Cartesian: Can not assign two grids of unequal size.");
         }
-        for (size_t i = 0; i < c.size(); ++i) {
-            assembler_.fields[i].copyData(c.assembler_.fields[i]);
-        }
+        copy(c);
+        return *this;
     }
 
     /** @brief Default destructor */
@@ -261,6 +380,31 @@ public:
      */
     IndexRangeType getBlockRange() const { return block_range_; }
 
+    /**
+     * @brief Get the block ordering policy
+     * @return Ordering of blocks in memory and for iteration
+     */
+    BlockOrder getBlockOrder() const { return block_order_; }
+
+    /**
+     * @brief Get the first-touch policy
+     * @return First-touch policy used for the block data
+     */
+    FirstTouch getFirstTouch() const { return first_touch_; }
+
+    /**
+     * @brief Get the block index map
+     * @return Vector that maps a flat block index to the linear index of the
+     *         block field in this grid
+     *
+     * @rst
+     * The flat block index is obtained from ``getBlockRange().getFlatIndex()``
+     * for a block index relative to the begin of the block range.  The map is
+     * the identity for ``BlockOrder::Lexicographic``.
+     * @endrst
+     */
+    const std::vector<size_t> &getBlockMap() const { return block_map_; }
+
     /**
      * @brief Local mesh for the grid
      * @return ``const`` reference to local mesh
@@ -326,6 +470,88 @@ public:
         return assembler_.field_states;
     }
 
+    /**
+     * @brief Allocate cell masks
+     * @param solid Initial state of all cells
+     *
+     * @rst
+     * Allocates a ``Block::CellMask`` for each block and sets the ``mask``
+     * pointer in the field states.  Existing masks are reset.  Masks are
+     * indexed like block fields, use ``getMask()`` to set solid cells.  The
+     * ``Grid::process()`` driver and the reductions of cell grids skip
+     * blocks that are fully solid.  For mixed blocks, reductions only
+     * include fluid cells while kernels passed to ``Grid::process()`` must
+     * treat solid cells themselves.  Reductions of node and face grids ignore
+     * the masks.
+     * @endrst
+     */
+    void allocateMasks(const bool solid = false)
+    {
+        const size_t nblocks = assembler_.field_states.size();
+        masks_.assign(nblocks, MaskType(IndexRangeType(block_cells_), solid));
+        for (size_t k = 0; k < nblocks; ++k) {
+            assembler_.field_states[k]->mask = &masks_[k];
+        }
+    }
+
+    /** @brief Release cell masks */
+    void freeMasks()
+    {
+        for (auto fs : assembler_.field_states) {
+            fs->mask = nullptr;
+        }
+        masks_.clear();
+        masks_.shrink_to_fit();
+    }
+
+    /**
+     * @brief Check if cell masks are allocated
+     * @return True if ``allocateMasks()`` has been called
+     */
+    bool hasMasks() const { return !masks_.empty(); }
+
+    /**
+     * @brief Cell mask access
+     * @param i One-dimensional block index (field container order)
+     * @return Reference to cell mask of block ``i``
+     */
+    MaskType &getMask(const size_t i)
+    {
+        assert(i < masks_.size());
+        return masks_[i];
+    }
+
+    /**
+     * @brief Cell mask access
+     * @param i One-dimensional block index (field container order)
+     * @return ``const`` reference to cell mask of block ``i``
+     */
+    const MaskType &getMask(const size_t i) const
+    {
+        assert(i < masks_.size());
+        return masks_[i];
+    }
+
+    /**
+     * @brief Cell mask access
+     * @param p Multi-dimensional block index
+     * @return Reference to cell mask of block ``p``
+     */
+    MaskType &getMask(const MultiIndex &p)
+    {
+        return getMask(block_map_[block_range_.getFlatIndex(p)]);
+    }
+
+    /**
+     * @brief Cell mask access
+     * @param p Multi-dimensional block index
+     * @return ``const`` reference to cell mask of block ``p``
+     */
+    const MaskType &getMask(const MultiIndex &p) const
+    {
+        return getMask(block_map_[block_range_.getFlatIndex(p)]);
+    }
+
     /**
      * @brief Block field access
      * @param p Multi-dimensional block index
@@ -334,7 +560,7 @@ public:
     BaseType &operator[](const MultiIndex &p)
     {
         assert(assembler_.fields.size() > 0);
-        return assembler_.fields[block_range_.getFlatIndex(p)];
+        return assembler_.fields[block_map_[block_range_.getFlatIndex(p)]];
     }
 
     /**
@@ -345,7 +571,7 @@ public:
     const BaseType &operator[](const MultiIndex &p) const
     {
         assert(assembler_.fields.size() > 0);
-        return assembler_.fields[block_range_.getFlatIndex(p)];
+        return assembler_.fields[block_map_[block_range_.getFlatIndex(p)]];
     }
 
     /**
@@ -386,7 +612,179 @@ public:
         return IndexFunctor(assembler_.fields,
                             block_range_,
                             static_cast<size_t>(c),
-                            static_cast<size_t>(d));
+                            static_cast<size_t>(d),
+                            block_map_.data());
+    }
+
+    /**
+     * @brief Get the neighbor table
+     * @return ``const`` reference to the table of direct block neighbors
+     *
+     * @rst
+     * Rows are stored in the order of the block fields in this grid.
+     * Neighbors outside of the grid are resolved periodically.
+     * @endrst
+     */
+    const NeighborTableType &getNeighborTable() const { return neighbors_; }
+
+    /**
+     * @brief Get neighbor field access functor
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @param field Block field contained in this grid
+     * @param c Component index
+     * @param d Face direction
+     * @return Field access functor for the direct neighbors of ``field``
+     *
+     * @rst
+     * The returned functor resolves block indices in the direct neighborhood
+     * of ``field`` with a single table lookup and is the preferred index
+     * functor for ``Block::FieldLab::loadData()``.  Use ``getIndexFunctor()``
+     * for arbitrary block indices.
+     * @endrst
+     */
+    template <typename Comp = size_t, typename Dir = size_t>
+    NeighborIndexFunctor
+    getNeighborFunctor(const BaseType &field, const Comp c = 0, const Dir d = 0)
+    {
+        return NeighborIndexFunctor(
+            assembler_.fields,
+            neighbors_.getRow(getFieldIndex_(field)),
+            field.getState().block_index,
+            nullptr,
+            static_cast<size_t>(c),
+            static_cast<size_t>(d));
+    }
+
+    /**
+     * @brief Set of active blocks
+     * @return Reference to the active block set
+     *
+     * @rst
+     * The set is indexed in field container order (the linear block index).
+     * All blocks are inactive after construction of the grid.
+     * @endrst
+     */
+    ActiveBlockSet &getActiveSet() { return active_; }
+
+    /**
+     * @brief Set of active blocks
+     * @return ``const`` reference to the active block set
+     */
+    const ActiveBlockSet &getActiveSet() const { return active_; }
+
+    /**
+     * @brief Activate a block
+     * @param field Block field contained in this grid
+     * @return True if the block was inactive before
+     *
+     * @rst
+     * Thread-safe, blocks may be activated from within a kernel of
+     * ``Grid::process()``.
+     * @endrst
+     */
+    bool activate(const BaseType &field)
+    {
+        return active_.activate(getFieldIndex_(field));
+    }
+
+    /**
+     * @brief Activate a block
+     * @param p Multi-dimensional block index
+     * @return True if the block was inactive before
+     */
+    bool activate(const MultiIndex &p)
+    {
+        return active_.activate(block_map_[block_range_.getFlatIndex(p)]);
+    }
+
+    /**
+     * @brief Deactivate a block
+     * @param field Block field contained in this grid
+     * @return True if the block was active before
+     */
+    bool deactivate(const BaseType &field)
+    {
+        return active_.deactivate(getFieldIndex_(field));
+    }
+
+    /**
+     * @brief Test if a block is active
+     * @param field Block field contained in this grid
+     * @return True if the block is active
+     */
+    bool isActive(const BaseType &field) const
+    {
+        return active_.isActive(getFieldIndex_(field));
+    }
+
+    /**
+     * @brief Activate the stencil neighbors of all active blocks
+     * @param s Stencil
+     *
+     * @rst
+     * Extends the active set by the blocks in the stencil neighborhood of the
+     * active blocks, i.e. the blocks that are accessed when labs of active
+     * blocks are loaded with stencil ``s``.  Only neighbors with non-zero halo
+     * width are activated, edge and corner neighbors for tensorial stencils
+     * only.  Neighbors are resolved with the neighbor table and the domain is
+     * assumed to be periodic.  Periodic images across a dimension where this
+     * grid does not span the global grid are not activated (they are owned by
+     * another rank).
+     * @endrst
+     */
+    void activateNeighbors(const StencilType &s)
+    {
+        activateNeighbors_(s, BoolVec(true));
+    }
+
+    /**
+     * @brief Activate the stencil neighbors of all active blocks
+     * @tparam BCVector Vector type of boundary conditions
+     * @param s Stencil
+     * @param bcs Boundary conditions used to load the labs
+     *
+     * @rst
+     * Same as above but neighbors across the domain boundary are not
+     * activated in directions with non-periodic boundary conditions in
+     * ``bcs``.
+     * @endrst
+     */
+    template <typename BCVector>
+    void activateNeighbors(const StencilType &s, const BCVector &bcs)
+    {
+        BoolVec periodic(true);
+        for (const auto bc : bcs) {
+            const BC::BoundaryInfo &info = bc->getBoundaryInfo();
+            assert(info.dir < Dim);
+            periodic[info.dir] = info.is_periodic;
+        }
+        activateNeighbors_(s, periodic);
+    }
+
+    /**
+     * @brief Active block fields
+     * @return Vector of pointers to the active block fields in field container
+     *         order
+     *
+     * @rst
+     * Sparse iteration over the grid.  The cost is proportional to the number
+     * of active blocks (plus one word test per 64 blocks).
+     *
+     * .. code-block:: cpp
+     *
+     *    for (auto bf : grid.getActiveBlocks()) {
+     *        // process block field *bf
+     *    }
+     * @endrst
+     */
+    std::vector<BaseType *> getActiveBlocks()
+    {
+        std::vector<BaseType *> blocks;
+        active_.forEach([this, &blocks](const size_t k) {
+            blocks.push_back(&assembler_.fields[k]);
+        });
+        return blocks;
     }
 
     /**
@@ -399,6 +797,7 @@ public:
      * @brief Field lab loader utility to load data from ``field`` into ``lab``
      * @tparam Comp Type for components that defines a cast to ``size_t``
      * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @tparam TCompute Data type of the lab
      * @param field Source field data to be loaded
      * @param lab Laboratory where data is loaded into
      * @param c Component index
@@ -408,9 +807,9 @@ public:
      * The ``field`` must be contained in within this Cartesian grid.
      * @endrst
      */
-    template <typename Comp = size_t, typename Dir = size_t>
+    template <typename Comp = size_t, typename Dir = size_t, typename TCompute>
     void loadLab(const BaseType &field,
-                 Block::FieldLab<typename BaseType::FieldType> &lab,
+                 Block::FieldLab<typename BaseType::FieldType, TCompute> &lab,
                  const Comp c = 0,
                  const Dir d = 0)
     {
@@ -419,19 +818,370 @@ public:
         // The `lab` must be allocated
         assert(lab.isAllocated());
         // The allocated `lab` must be large enough to process `field`
-        assert(field.getIndexRange().getExtent() <=
+        assert(field.getIndexRange(static_cast<size_t>(d)).getExtent() <=
                lab.getMaximumRange().getExtent());
         const auto &bi = field.getState().block_index;
-        auto idx_functor = this->getIndexFunctor(c, d);
+        auto idx_functor = this->getNeighborFunctor(field, c, d);
         lab.loadData(bi, idx_functor);
     }
 
+    /**
+     * @brief Field lab loader utility with boundary conditions
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @tparam TCompute Data type of the lab
+     * @param field Source field data to be loaded
+     * @param lab Laboratory where data is loaded into
+     * @param boundaries Vector of boundary conditions
+     * @param c Component index
+     * @param d Face direction
+     *
+     * @rst
+     * Boundary conditions in ``boundaries`` are applied to the sides of
+     * ``field`` that coincide with the domain boundary instead of the
+     * boundary conditions of the block field.  The ``field`` must be
+     * contained in within this Cartesian grid.
+     * @endrst
+     */
+    template <typename Comp = size_t, typename Dir = size_t, typename TCompute>
+    void loadLab(
+        const BaseType &field,
+        Block::FieldLab<typename BaseType::FieldType, TCompute> &lab,
+        const std::vector<BC::Base<
+            Block::FieldLab<typename BaseType::FieldType, TCompute>> *>
+            &boundaries,
+        const Comp c = 0,
+        const Dir d = 0)
+    {
+        // `field` bust be owned by `assembler_`
+        assert(assembler_.fields.contains(field));
+        // The `lab` must be allocated
+        assert(lab.isAllocated());
+        // The allocated `lab` must be large enough to process `field`
+        assert(field.getIndexRange(static_cast<size_t>(d)).getExtent() <=
+               lab.getMaximumRange().getExtent());
+        auto idx_functor = this->getNeighborFunctor(field, c, d);
+        loadBoundaryLab(
+            lab, field.getState().block_index, idx_functor, boundaries);
+    }
+
+    /**
+     * @brief View lab loader utility to load ghosts of ``field`` into ``lab``
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @param field Source field data to be mapped
+     * @param lab View laboratory where ghost data is loaded into
+     * @param c Component index
+     * @param d Face direction
+     *
+     * @rst
+     * The ``field`` must be contained in within this Cartesian grid.
+     * @endrst
+     */
+    template <typename Comp = size_t, typename Dir = size_t>
+    void loadLab(const BaseType &field,
+                 Block::FieldViewLab<typename BaseType::FieldType> &lab,
+                 const Comp c = 0,
+                 const Dir d = 0)
+    {
+        // `field` bust be owned by `assembler_`
+        assert(assembler_.fields.contains(field));
+        // The `lab` must be allocated
+        assert(lab.isAllocated());
+        const auto &bi = field.getState().block_index;
+        auto idx_functor = this->getNeighborFunctor(field, c, d);
+        lab.loadData(bi, idx_functor);
+    }
+
+    /**
+     * @brief Batched lab loader utility for all components of ``field``
+     * @tparam Layout Memory layout of the lab
+     * @param field Source field data to be loaded
+     * @param lab Multi-component laboratory where data is loaded into
+     *
+     * @rst
+     * Loads all components (and face directions) of ``field`` in one pass.
+     * The ``field`` must be contained in within this Cartesian grid.
+     * @endrst
+     */
+    template <Block::LabLayout Layout>
+    void loadLab(const BaseType &field,
+                 Block::TensorFieldLab<BaseType, Layout> &lab)
+    {
+        // `field` bust be owned by `assembler_`
+        assert(assembler_.fields.contains(field));
+        // The `lab` must be allocated
+        assert(lab.isAllocated());
+        const auto &bi = field.getState().block_index;
+        const auto *row = neighbors_.getRow(getFieldIndex_(field));
+        auto id2field = [this, row, &bi](const MultiIndex &p) -> BaseType & {
+            const size_t k = row[NeighborTableType::getSlot(p - bi)].index;
+            return assembler_.fields[k];
+        };
+        lab.loadData(bi, id2field);
+    }
+
+    /**
+     * @brief Fill the grid with a constant value
+     * @param v Fill value
+     *
+     * @rst
+     * Whole-grid operations work directly on the contiguous grid allocation
+     * in a single threaded and vectorized pass instead of a loop over block
+     * fields.  Each thread processes the same static block partition as used
+     * by ``FirstTouch::Static``.  Whole-grid operations with other grids pair
+     * the blocks by memory slot and therefore require the same number of
+     * blocks, block cells and block order, otherwise ``std::runtime_error`` is
+     * thrown.
+     * @endrst
+     */
+    void fill(const DataType v)
+    {
+        DataType *dst = data_;
+        forEachSlab_([&](const size_t offset, const size_t n) {
+            std::fill(dst + offset, dst + offset + n, v);
+        });
+    }
+
+    /**
+     * @brief Copy the data of another grid
+     * @param c Source grid with identical topology
+     */
+    void copy(const Cartesian &c)
+    {
+        checkCompatible_(c);
+        if (this == &c) {
+            return;
+        }
+        const DataType *src = c.data_;
+        DataType *dst = data_;
+        forEachSlab_([&](const size_t offset, const size_t n) {
+            std::memcpy(dst + offset, src + offset, n * sizeof(DataType));
+        });
+    }
+
+    /**
+     * @brief Scale the grid data
+     * @param a Scalar factor
+     */
+    void scale(const DataType a)
+    {
+        DataType *dst = data_;
+        forEachSlab_([&](const size_t offset, const size_t n) {
+            fieldMul(dst + offset, a, dst + offset, n);
+        });
+    }
+
+    /**
+     * @brief Minimum value of all grid data
+     * @return Minimum over all blocks and components of the local grid
+     *
+     * @rst
+     * Reductions exclude block padding.  Partial results of the blocks are
+     * combined pairwise in block order, the result does not depend on the
+     * number of threads.  NaN values propagate into the result of ``min()``
+     * and ``max()``.
+     * @endrst
+     */
+    DataType min() const
+    {
+        using Op = ReduceMin<DataType>;
+        return reduce_<Op>([](DataType r, const DataType *p, const size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                r = Op::combine(r, p[i]);
+            }
+            return r;
+        });
+    }
+
+    /**
+     * @brief Maximum value of all grid data
+     * @return Maximum over all blocks and components of the local grid
+     */
+    DataType max() const
+    {
+        using Op = ReduceMax<DataType>;
+        return reduce_<Op>([](DataType r, const DataType *p, const size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                r = Op::combine(r, p[i]);
+            }
+            return r;
+        });
+    }
+
+    /**
+     * @brief Sum of all grid data
+     * @return Sum over all blocks and components of the local grid
+     */
+    DataType sum() const
+    {
+        return reduce_<ReduceSum<DataType>>(
+            [](const DataType r, const DataType *p, const size_t n) {
+                DataType bsum = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    bsum += p[i];
+                }
+                return r + bsum;
+            });
+    }
+
+    /**
+     * @brief Discrete L2 norm of all grid data
+     * @return Square root of the sum of squares of the local grid data
+     */
+    DataType normL2() const
+    {
+        const DataType sum2 = reduce_<ReduceSum<DataType>>(
+            [](const DataType r, const DataType *p, const size_t n) {
+                DataType bsum = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    bsum += p[i] * p[i];
+                }
+                return r + bsum;
+            });
+        return static_cast<DataType>(std::sqrt(sum2));
+    }
+
+    /**
+     * @brief Cell reduction with a per-cell functor
+     * @tparam Func Functor type with signature ``R(const CellValues &)``
+     * @param f Functor evaluated for each cell
+     * @param op Reduction operation
+     * @param weighted Multiply functor values by the cell volume
+     * @return Reduced value of the local grid
+     *
+     * @rst
+     * The functor has access to all components of a cell through the
+     * ``CellValues`` argument.  The reduction is thread-parallel over blocks.
+     * Within a block, values are accumulated in independent lanes that can
+     * be vectorized.  Lanes and block results are combined pairwise in a
+     * fixed order, hence the result does not depend on the number of threads.
+     * ``ReduceOp::Min`` and ``ReduceOp::Max`` propagate NaN values.  A
+     * weighted reduction requires a floating point result type of ``f``,
+     * otherwise ``std::runtime_error`` is thrown.
+     *
+     * .. code-block:: cpp
+     *
+     *    // maximum wave speed of a velocity field (rank-1 grid)
+     *    using CV = typename Grid::CellValues;
+     *    const double umax = grid.reduce(
+     *        [](const CV &c) {
+     *            return std::max(
+     *                {std::abs(c[0]), std::abs(c[1]), std::abs(c[2])});
+     *        },
+     *        Cubism::Grid::ReduceOp::Max);
+     *
+     *    // volume integral of a scalar field
+     *    const double mass =
+     *        grid.reduce([](const CV &c) { return c[0]; },
+     *                    Cubism::Grid::ReduceOp::Sum,
+     *                    true);
+     *
+     * For MPI grids the result is reduced over all ranks, see
+     * ``CartesianMPI::ireduce()``.
+     * @endrst
+     */
+    template <typename Func>
+    ReduceResult<Func>
+    reduce(Func &&f, const ReduceOp op, const bool weighted = false) const
+    {
+        static_assert(Cubism::EntityType::Cell == EntityType,
+                      "Cartesian: reduce() requires a cell field grid");
+        using R = ReduceResult<Func>;
+        if (weighted && !std::is_floating_point<R>::value) {
+            // the cell volume would be truncated when converted to R
+            throw std::runtime_error("Cartesian: weighted reduction requires "
+                                     "a floating point result type.");
+        }
+        if (ReduceOp::Sum == op) {
+            return reduceCells_<ReduceSum<R>>(f, weighted);
+        } else if (ReduceOp::Min == op) {
+            return reduceCells_<ReduceMin<R>>(f, weighted);
+        } else if (ReduceOp::Max == op) {
+            return reduceCells_<ReduceMax<R>>(f, weighted);
+        }
+        throw std::runtime_error("Cartesian: Unknown reduction operation.");
+    }
+
+    /**
+     * @brief Fused grid update ``this = a * x + this``
+     * @param a Scalar factor
+     * @param x Grid to be scaled and added
+     */
+    void axpy(const DataType a, const Cartesian &x)
+    {
+        checkCompatible_(x);
+        const DataType *src = x.data_;
+        DataType *dst = data_;
+        forEachSlab_([&](const size_t offset, const size_t n) {
+            fieldAxpy(a, src + offset, dst + offset, n);
+        });
+    }
+
+    /**
+     * @brief Fused grid update ``this = a * x + b * this``
+     * @param a Scalar factor for ``x``
+     * @param x Source grid
+     * @param b Scalar factor for this grid
+     */
+    void axpby(const DataType a, const Cartesian &x, const DataType b)
+    {
+        checkCompatible_(x);
+        const DataType *src = x.data_;
+        DataType *dst = data_;
+        forEachSlab_([&](const size_t offset, const size_t n) {
+            fieldAxpby(a, src + offset, b, dst + offset, n);
+        });
+    }
+
+    /**
+     * @brief Fused grid update ``this = a * u0 + b * u1 + c * rhs``
+     * @param a Scalar factor for ``u0``
+     * @param u0 First source grid
+     * @param b Scalar factor for ``u1``
+     * @param u1 Second source grid
+     * @param c Scalar factor for ``rhs``
+     * @param rhs Third source grid
+     *
+     * @rst
+     * Single-pass Runge-Kutta stage update, where ``c`` includes the time step
+     * (``c * dt``).  Any of the source grids may be this grid.
+     * @endrst
+     */
+    void linComb(const DataType a,
+                 const Cartesian &u0,
+                 const DataType b,
+                 const Cartesian &u1,
+                 const DataType c,
+                 const Cartesian &rhs)
+    {
+        checkCompatible_(u0);
+        checkCompatible_(u1);
+        checkCompatible_(rhs);
+        const DataType *src0 = u0.data_;
+        const DataType *src1 = u1.data_;
+        const DataType *src2 = rhs.data_;
+        DataType *dst = data_;
+        forEachSlab_([&](const size_t offset, const size_t n) {
+            fieldLinComb(a,
+                         src0 + offset,
+                         b,
+                         src1 + offset,
+                         c,
+                         src2 + offset,
+                         dst + offset,
+                         n);
+        });
+    }
+
 protected:
     MultiIndex nblocks_;
     MultiIndex block_cells_;
     IndexRangeType block_range_;
     MeshType *mesh_;
     MeshType *global_mesh_;
+    BlockOrder block_order_;
+    FirstTouch first_touch_;
 
     /**
      * @brief Initialize Cartesian topology
@@ -440,15 +1190,19 @@ protected:
      * @param begin Lower left point of mesh (rectangular box)
      * @param end Upper right point of mesh (rectangular box)
      * @param nranks Number of ranks in topology
+     * @param touch First-touch policy for block data
      */
     void initTopology_(const PointType &gbegin,
                        const PointType &gend,
                        const PointType &begin,
                        const PointType &end,
-                       const MultiIndex &nranks = MultiIndex(1))
+                       const MultiIndex &nranks = MultiIndex(1),
+                       const FirstTouch touch = FirstTouch::None)
     {
         // allocate the memory
         alloc_();
+        first_touch_ = touch;
+        touch_(touch);
         // allocate the global mesh (gbegin and begin may be different)
         mesh_ =
             new MeshType(RangeType(gbegin, gend),
@@ -456,21 +1210,43 @@ protected:
                          IndexRangeType(block_cells_ * block_range_.getBegin(),
                                         block_cells_ * block_range_.getEnd()),
                          MeshIntegrity::FullMesh);
-        // assemble the block fields
+        // assemble the block fields along the requested block order
+        const std::vector<size_t> order =
+            computeBlockOrder(block_range_, block_order_);
+        block_map_.resize(order.size());
+        for (size_t k = 0; k < order.size(); ++k) {
+            block_map_[order[k]] = k;
+        }
         assembler_.assemble(data_,
                             *mesh_,
                             block_range_,
                             block_cells_,
                             nranks,
                             block_bytes_,
-                            component_bytes_);
+                            component_bytes_,
+                            order);
+        buildNeighbors_();
+        active_.resize(assembler_.fields.size());
 
-        // No NUMA touch has been carried out until here.  The user should touch
-        // the data based on her/his thread partition strategy in the
-        // application.
+        // No NUMA touch has been carried out until here for
+        // FirstTouch::None.  The user should touch the data based on her/his
+        // thread partition strategy in the application.
 
         assert(assembler_.fields.size() == assembler_.field_states.size());
         assert(assembler_.fields.size() == assembler_.field_meshes.size());
+
+        // number of valid (unpadded) elements for each block and face
+        // direction
+        const size_t nblocks = assembler_.field_states.size();
+        const size_t ndirs = nslices_ / BaseType::NComponents;
+        block_valid_.resize(ndirs * nblocks);
+        for (size_t d = 0; d < ndirs; ++d) {
+            for (size_t b = 0; b < nblocks; ++b) {
+                const MeshType &bm = *assembler_.field_states[b]->mesh;
+                block_valid_[d * nblocks + b] =
+                    bm.getIndexRange(BaseType::EntityType, d).size();
+            }
+        }
     }
 
 private:
@@ -483,6 +1259,56 @@ private:
     size_t block_bytes_;
     size_t component_bytes_;
     size_t all_bytes_;
+    size_t nslices_;
+    std::vector<size_t> block_valid_;
+    std::vector<size_t> block_map_; // flat block index -> field index
+    std::vector<MaskType> masks_;   // cell masks in field container order
+    ActiveBlockSet active_;         // active blocks in field container order
+
+    NeighborTableType neighbors_;
+
+    /**
+     * @brief Field container index of a block field
+     * @param field Block field contained in this grid
+     * @return Index of ``field`` in the field container
+     */
+    size_t getFieldIndex_(const BaseType &field) const
+    {
+        const size_t k =
+            block_map_[block_range_.getFlatIndex(field.getState().block_index)];
+        assert(&assembler_.fields[k] == &field);
+        return k;
+    }
+
+    /**
+     * @brief Build the neighbor table
+     *
+     * @rst
+     * Neighbors are resolved periodically within this grid.  The boundary
+     * flag is set for neighbors outside of the global grid.
+     * @endrst
+     */
+    void buildNeighbors_()
+    {
+        const MultiIndex extent = block_range_.getExtent();
+        const MultiIndex gbegin = block_range_.getBegin();
+        const MultiIndex gsize = this->getGlobalSize();
+        auto resolve = [&](MultiIndex p) {
+            typename NeighborTableType::Entry e;
+            e.remote = false;
+            e.boundary = false;
+            for (size_t i = 0; i < Dim; ++i) {
+                const auto g = gbegin[i] + p[i];
+                if (g < 0 || g >= gsize[i]) {
+                    e.boundary = true;
+                }
+                p[i] = (p[i] + extent[i]) % extent[i];
+            }
+            e.index = block_map_[block_range_.getFlatIndex(p)];
+            return e;
+        };
+        neighbors_.build(assembler_.field_states, resolve);
+    }
 
     /**
      * @brief Allocate grid memory
@@ -520,7 +1346,8 @@ private:
         }
 
         // total number of bytes
-        all_bytes_ = nfaces * component_bytes_ * BaseType::NComponents;
+        nslices_ = nfaces * BaseType::NComponents;
+        all_bytes_ = nslices_ * component_bytes_;
 
         // get the allocation
         assert(all_bytes_ > 0);
@@ -528,6 +1355,304 @@ private:
         assert(data_ != nullptr);
     }
 
+    /**
+     * @brief First-touch grid memory
+     * @param touch First-touch policy
+     */
+    void touch_(const FirstTouch touch)
+    {
+        char *base = reinterpret_cast<char *>(data_);
+        if (FirstTouch::Static == touch) {
+            // touch all components of a block with the same thread
+            const size_t nblocks = nblocks_.prod();
+#pragma omp parallel for schedule(static)
+            for (size_t b = 0; b < nblocks; ++b) {
+                for (size_t s = 0; s < nslices_; ++s) {
+                    std::memset(base + s * component_bytes_ + b * block_bytes_,
+                                0,
+                                block_bytes_);
+                }
+            }
+        } else if (FirstTouch::Interleave == touch) {
+            // touch memory pages round-robin
+            const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            const size_t npages = (all_bytes_ + page - 1) / page;
+#pragma omp parallel for schedule(static, 1)
+            for (size_t p = 0; p < npages; ++p) {
+                const size_t offset = p * page;
+                std::memset(
+                    base + offset, 0, std::min(page, all_bytes_ - offset));
+            }
+        }
+    }
+
+    /**
+     * @brief Static block partition of a thread
+     * @param tid Thread ID
+     * @param nthreads Number of threads
+     * @param b0 First block index of the partition (output)
+     * @param nb Number of blocks in the partition (output)
+     *
+     * @rst
+     * Identical to the OpenMP static schedule without chunk size.
+     * @endrst
+     */
+    void partition_(const size_t tid,
+                    const size_t nthreads,
+                    size_t &b0,
+                    size_t &nb) const
+    {
+        const size_t nblocks = nblocks_.prod();
+        const size_t q = nblocks / nthreads;
+        const size_t r = nblocks % nthreads;
+        b0 = tid * q + std::min(tid, r);
+        nb = q + ((tid < r) ? 1 : 0);
+    }
+
+    /**
+     * @brief Apply a kernel to the contiguous grid allocation
+     * @tparam Kernel Callable type
+     * @param kernel Kernel ``kernel(offset, n)`` processing ``n`` elements
+     * starting at element ``offset``
+     *
+     * @rst
+     * Each thread is assigned a contiguous range of blocks and calls the
+     * kernel once for each component slice.  Block padding is included.
+     * @endrst
+     */
+    template <typename Kernel>
+    void forEachSlab_(Kernel &&kernel) const
+    {
+        assert(block_bytes_ % sizeof(DataType) == 0);
+        const size_t block_elements = block_bytes_ / sizeof(DataType);
+        const size_t slice_elements = component_bytes_ / sizeof(DataType);
+#pragma omp parallel
+        {
+            size_t tid = 0;
+            size_t nthreads = 1;
+#ifdef _OPENMP
+            tid = static_cast<size_t>(omp_get_thread_num());
+            nthreads = static_cast<size_t>(omp_get_num_threads());
+#endif /* _OPENMP */
+            size_t b0, nb;
+            partition_(tid, nthreads, b0, nb);
+            if (nb > 0) {
+                for (size_t s = 0; s < nslices_; ++s) {
+                    kernel(s * slice_elements + b0 * block_elements,
+                           nb * block_elements);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Activate the stencil neighbors of all active blocks
+     * @param s Stencil
+     * @param periodic Periodicity of the domain boundaries
+     */
+    void activateNeighbors_(const StencilType &s, const BoolVec &periodic)
+    {
+        // neighbor slots in the stencil footprint (see
+        // CartesianMPI::isInnerBlock())
+        const MultiIndex sbegin = s.getBegin();
+        const MultiIndex send = s.getEnd();
+        std::vector<size_t> slots;
+        for (size_t n = 0; n < NeighborTableType::NNeighbors; ++n) {
+            const MultiIndex o = NeighborTableType::getOffset(n);
+            size_t noff = 0;
+            bool required = true;
+            for (size_t i = 0; i < Dim; ++i) {
+                if ((o[i] < 0 && 0 == sbegin[i]) ||
+                    (o[i] > 0 && 1 == send[i])) {
+                    required = false;
+                    break;
+                }
+                noff += (0 != o[i]) ? 1 : 0;
+            }
+            if (required && noff > 0 && (1 == noff || s.isTensorial())) {
+                slots.push_back(n);
+            }
+        }
+
+        const MultiIndex gsize = this->getGlobalSize();
+        for (const size_t k : active_.getList()) {
+            const MultiIndex &bi = assembler_.field_states[k]->block_index;
+            const auto *row = neighbors_.getRow(k);
+            for (const size_t n : slots) {
+                const MultiIndex q = bi + NeighborTableType::getOffset(n);
+                bool local = !row[n].remote;
+                for (size_t i = 0; i < Dim; ++i) {
+                    if ((q[i] < 0 || q[i] >= nblocks_[i]) &&
+                        (gsize[i] != nblocks_[i] ||
+                         (row[n].boundary && !periodic[i]))) {
+                        local = false;
+                    }
+                }
+                if (local) {
+                    active_.activate(row[n].index);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Reduction over the grid data excluding block padding
+     * @tparam Op Reduction type
+     * @tparam Kernel Callable type
+     * @param kernel Kernel ``r = kernel(r, p, n)`` that reduces the ``n``
+     * valid elements of a block starting at ``p`` into ``r``
+     * @return Reduced value
+     *
+     * @rst
+     * Each block is reduced into its own partial result and the partial
+     * results are combined with ``reducePairwise()``, such that the result
+     * does not depend on the number of threads.  For masked cell grids, fully
+     * solid blocks are skipped and the kernel is called for each run of fluid
+     * cells in mixed blocks.
+     * @endrst
+     */
+    template <typename Op, typename Kernel>
+    DataType reduce_(Kernel &&kernel) const
+    {
+        assert(block_bytes_ % sizeof(DataType) == 0);
+        const size_t nblocks = nblocks_.prod();
+        const size_t block_elements = block_bytes_ / sizeof(DataType);
+        const size_t slice_elements = component_bytes_ / sizeof(DataType);
+        const DataType *base = data_;
+        const MaskType *masks = getCellMasks_();
+        std::vector<DataType> partial(nblocks, Op::identity());
+#pragma omp parallel
+        {
+            size_t tid = 0;
+            size_t nthreads = 1;
+#ifdef _OPENMP
+            tid = static_cast<size_t>(omp_get_thread_num());
+            nthreads = static_cast<size_t>(omp_get_num_threads());
+#endif /* _OPENMP */
+            size_t b0, nb;
+            partition_(tid, nthreads, b0, nb);
+            for (size_t b = b0; b < b0 + nb; ++b) {
+                const Block::MaskState state =
+                    masks ? masks[b].getState() : Block::MaskState::Fluid;
+                if (Block::MaskState::Solid == state) {
+                    continue;
+                }
+                DataType r = Op::identity();
+                for (size_t s = 0; s < nslices_; ++s) {
+                    const size_t *valid =
+                        &block_valid_[(s / BaseType::NComponents) * nblocks];
+                    const DataType *p =
+                        base + s * slice_elements + b * block_elements;
+                    if (Block::MaskState::Fluid == state) {
+                        r = kernel(r, p, valid[b]);
+                    } else {
+                        masks[b].forEachFluidRun(
+                            [&](const size_t i, const size_t n) {
+                                r = kernel(r, p + i, n);
+                            });
+                    }
+                }
+                partial[b] = r;
+            }
+        }
+        return reducePairwise<Op>(partial.data(), partial.size());
+    }
+
+    /**
+     * @brief Cell reduction with a per-cell functor
+     * @tparam Op Reduction type
+     * @tparam Func Functor type
+     * @param f Functor evaluated for each cell
+     * @param weighted Multiply functor values by the cell volume
+     * @return Reduced value
+     */
+    template <typename Op, typename Func>
+    ReduceResult<Func> reduceCells_(Func &f, const bool weighted) const
+    {
+        using R = ReduceResult<Func>;
+        constexpr size_t Lanes = 8;
+        const size_t nblocks = nblocks_.prod();
+        const size_t block_elements = block_bytes_ / sizeof(DataType);
+        const size_t slice_elements = component_bytes_ / sizeof(DataType);
+        const MaskType *masks = getCellMasks_();
+        std::vector<R> partial(nblocks);
+#pragma omp parallel for schedule(static)
+        for (size_t b = 0; b < nblocks; ++b) {
+            const DataType *src = data_ + b * block_elements;
+            const MeshType &bm = *assembler_.field_states[b]->mesh;
+            const size_t n = block_valid_[b];
+            const Block::MaskState state =
+                masks ? masks[b].getState() : Block::MaskState::Fluid;
+            R lane[Lanes];
+            for (size_t l = 0; l < Lanes; ++l) {
+                lane[l] = Op::identity();
+            }
+            if (Block::MaskState::Solid == state) {
+                partial[b] = Op::identity();
+                continue;
+            } else if (Block::MaskState::Mixed == state) {
+                // lane assignment as for unmasked blocks
+                masks[b].forEachFluidRun([&](const size_t i0, const size_t m) {
+                    for (size_t i = i0; i < i0 + m; ++i) {
+                        R v = f(CellValues(src + i, slice_elements));
+                        if (weighted) {
+                            v *= static_cast<R>(bm.getCellVolume(i));
+                        }
+                        lane[i % Lanes] = Op::combine(lane[i % Lanes], v);
+                    }
+                });
+            } else if (weighted) {
+                for (size_t i = 0; i < n; ++i) {
+                    const R v = f(CellValues(src + i, slice_elements)) *
+                                static_cast<R>(bm.getCellVolume(i));
+                    lane[i % Lanes] = Op::combine(lane[i % Lanes], v);
+                }
+            } else {
+                size_t i = 0;
+                for (; i + Lanes <= n; i += Lanes) {
+                    for (size_t l = 0; l < Lanes; ++l) {
+                        lane[l] = Op::combine(
+                            lane[l],
+                            f(CellValues(src + i + l, slice_elements)));
+                    }
+                }
+                for (; i < n; ++i) {
+                    const R v = f(CellValues(src + i, slice_elements));
+                    lane[i % Lanes] = Op::combine(lane[i % Lanes], v);
+                }
+            }
+            partial[b] = reducePairwise<Op>(lane, Lanes);
+        }
+        return reducePairwise<Op>(partial.data(), partial.size());
+    }
+
+    /**
+     * @brief Cell masks considered by reductions
+     * @return Pointer to the first cell mask or ``nullptr`` if the grid is not
+     * masked or not a cell grid
+     */
+    const MaskType *getCellMasks_() const
+    {
+        if (Cubism::EntityType::Cell != EntityType || masks_.empty()) {
+            return nullptr;
+        }
+        return masks_.data();
+    }
+
+    /**
+     * @brief Check if the data layout of another grid is identical
+     * @param c Other Cartesian topology of same type
+     */
+    void checkCompatible_(const Cartesian &c) const
+    {
+        // blocks are paired by memory slot
+        if (nblocks_ != c.nblocks_ || block_cells_ != c.block_cells_ ||
+            block_order_ != c.block_order_) {
+            throw std::runtime_error(
+                "Cartesian: Incompatible grids for whole-grid operation.");
+        }
+    }
+
     /**
      * @brief Deallocate grid memory
      */
@@ -7,10 +7,18 @@
 #define CARTESIANMPI_H_INHL4O2K
 
 #include "Cubism/Common.h"
+#include "Cubism/Core/Stencil.h"
 #include "Cubism/Core/Vector.h"
 #include "Cubism/Grid/Cartesian.h"
+#include "Cubism/Grid/Process.h"
+#include "Cubism/Grid/Reduction.h"
+#include "Cubism/Grid/SynchronizerMPI.h"
 #include <cassert>
+#include <memory>
 #include <mpi.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 NAMESPACE_BEGIN(Cubism)
 NAMESPACE_BEGIN(Grid)
@@ -23,6 +31,148 @@ NAMESPACE_BEGIN(Grid)
  * @endrst
  */
 
+/**
+ * @ingroup MPI
+ * @brief Non-blocking global reduction
+ * @tparam T Data type of reduced value
+ *
+ * @rst
+ * Handle for a reduction over all ranks that is started with
+ * ``MPI_Iallreduce``.  Work that does not depend on the result can be carried
+ * out before ``get()`` is called.  The rank local values are combined with
+ * the same NaN-aware operations as used for the rank local reduction.  The
+ * operations are registered as non-commutative such that MPI combines the
+ * values in rank order and the result is reproducible.  The MPI datatype and
+ * operations are created on first use and released in ``MPI_Finalize()``.
+ * The destructor waits for completion of the reduction.
+ * @endrst
+ */
+template <typename T>
+class ReductionMPI
+{
+public:
+    /**
+     * @brief Start a global reduction
+     * @param local Rank local value
+     * @param op Reduction operation
+     * @param comm MPI communicator
+     */
+    ReductionMPI(const T local, const ReduceOp op, const MPI_Comm comm)
+        : buf_(new T[2]), request_(MPI_REQUEST_NULL)
+    {
+        buf_[0] = local;
+        buf_[1] = local;
+        MPI_Iallreduce(&buf_[0],
+                       &buf_[1],
+                       1,
+                       getHandles_().type,
+                       getHandles_().ops[static_cast<size_t>(op)],
+                       comm,
+                       &request_);
+    }
+
+    ReductionMPI(const ReductionMPI &c) = delete;
+    ReductionMPI &operator=(const ReductionMPI &c) = delete;
+    ReductionMPI &operator=(ReductionMPI &&c) = delete;
+
+    /**
+     * @brief Move constructor
+     * @param c Reduction to move from
+     */
+    ReductionMPI(ReductionMPI &&c) noexcept
+        : buf_(std::move(c.buf_)), request_(c.request_)
+    {
+        c.request_ = MPI_REQUEST_NULL;
+    }
+
+    ~ReductionMPI() { wait(); }
+
+    /**
+     * @brief Test for completion
+     * @return True if the reduction has completed
+     */
+    bool test()
+    {
+        int flag = 0;
+        MPI_Test(&request_, &flag, MPI_STATUS_IGNORE);
+        return (0 != flag);
+    }
+
+    /**
+     * @brief Wait for completion
+     */
+    void wait()
+    {
+        if (MPI_REQUEST_NULL != request_) {
+            MPI_Wait(&request_, MPI_STATUS_IGNORE);
+        }
+    }
+
+    /**
+     * @brief Get the global result
+     * @return Reduced value over all ranks
+     *
+     * Waits for completion if the reduction is still in progress.
+     */
+    T get()
+    {
+        wait();
+        return buf_[1];
+    }
+
+private:
+    std::unique_ptr<T[]> buf_; // send and receive buffer (stable address)
+    MPI_Request request_;
+
+    template <typename Op>
+    static void apply_(void *in, void *inout, int *len, MPI_Datatype *)
+    {
+        const T *a = static_cast<const T *>(in);
+        T *b = static_cast<T *>(inout);
+        for (int i = 0; i < *len; ++i) {
+            b[i] = Op::combine(a[i], b[i]);
+        }
+    }
+
+    // MPI handles shared by all reductions of type T
+    struct Handles_ {
+        MPI_Datatype type;
+        MPI_Op ops[3]; // indexed by ReduceOp
+    };
+
+    static const Handles_ &getHandles_()
+    {
+        static const Handles_ *handles = []() {
+            Handles_ *h = new Handles_;
+            MPI_Type_contiguous(sizeof(T), MPI_BYTE, &h->type);
+            MPI_Type_commit(&h->type);
+            // non-commutative: deterministic order of combination
+            MPI_Op_create(&apply_<ReduceSum<T>>, 0, &h->ops[0]);
+            MPI_Op_create(&apply_<ReduceMin<T>>, 0, &h->ops[1]);
+            MPI_Op_create(&apply_<ReduceMax<T>>, 0, &h->ops[2]);
+            // MPI_COMM_SELF attributes are deleted first in MPI_Finalize()
+            int keyval;
+            MPI_Comm_create_keyval(
+                MPI_COMM_NULL_COPY_FN, &freeHandles_, &keyval, nullptr);
+            MPI_Comm_set_attr(MPI_COMM_SELF, keyval, h);
+            return h;
+        }();
+        return *handles;
+    }
+
+    static int freeHandles_(MPI_Comm, int keyval, void *attr, void *)
+    {
+        Handles_ *h = static_cast<Handles_ *>(attr);
+        MPI_Type_free(&h->type);
+        for (auto &op : h->ops) {
+            MPI_Op_free(&op);
+        }
+        delete h;
+        MPI_Comm_free_keyval(&keyval);
+        return MPI_SUCCESS;
+    }
+};
+
 /**
  * @ingroup MPI
  * @brief Cartesian MPI block (tensor) field
@@ -39,6 +189,12 @@ NAMESPACE_BEGIN(Grid)
  * local Cartesian topology instead of just individual blocks.  See the
  * :ref:`cartesian` grid section for a non-distributed variant of this class as
  * well as the ``UserState`` extension.
+ *
+ * For a given stencil, the rank local blocks are classified into *inner* and
+ * *halo* blocks.  The stencil footprint of inner blocks is entirely rank local
+ * while halo blocks depend on ghosts from neighbor ranks.  Inner blocks can
+ * be processed while the halo exchange is in flight, see
+ * :ref:`synchronizermpi`.
  * @endrst
  */
 template <typename T,
@@ -55,6 +211,7 @@ class CartesianMPI
     using IntVec = typename Core::Vector<int, BaseGrid::Dim>;
 
     using BaseGrid::block_cells_;
+    using BaseGrid::block_order_;
     using BaseGrid::block_range_;
     using BaseGrid::global_mesh_;
     using BaseGrid::mesh_;
@@ -62,6 +219,7 @@ class CartesianMPI
 
 public:
     using typename BaseGrid::BaseType;
+    using typename BaseGrid::CellValues;
     using typename BaseGrid::DataType;
     using typename BaseGrid::FieldContainer;
     using typename BaseGrid::FieldState;
@@ -72,6 +230,13 @@ public:
     using typename BaseGrid::PointType;
     using typename BaseGrid::RangeType;
     using typename BaseGrid::RealType;
+    /** @brief Stencil type */
+    using StencilType = Core::Stencil<BaseGrid::Dim>;
+    /** @brief Halo synchronizer type */
+    using SynchronizerType = SynchronizerMPI<CartesianMPI>;
+    /** @brief Result type of a reduction with per-cell functor ``Func`` */
+    template <typename Func>
+    using ReduceResult = typename BaseGrid::template ReduceResult<Func>;
 
     /**
      * @brief Main constructor for a Cartesian MPI block field topology
@@ -85,6 +250,8 @@ public:
      *            right)
      * @param gbegin Global begin of physical domain
      * @param gend Global end of physical domain
+     * @param touch First-touch policy for rank local block data
+     * @param order Ordering of rank local blocks in memory and for iteration
      */
     CartesianMPI(const MPI_Comm &comm,
                  const MultiIndex &nprocs,
@@ -93,11 +260,14 @@ public:
                  const PointType &begin = PointType(0),
                  const PointType &end = PointType(1),
                  const PointType &gbegin = PointType(0),
-                 const PointType &gend = PointType(1))
+                 const PointType &gend = PointType(1),
+                 const FirstTouch touch = FirstTouch::None,
+                 const BlockOrder order = BlockOrder::Lexicographic)
         : BaseGrid(), comm_(comm), comm_cart_(MPI_COMM_NULL), nprocs_(nprocs)
     {
         nblocks_ = nblocks;
         block_cells_ = block_cells;
+        block_order_ = order;
 
         // MPI topology
         int size;
@@ -131,7 +301,8 @@ public:
         const PointType begin_rank =
             begin + PointType(rank_index_) * extent_rank; // rank domain begin
         const PointType end_rank = begin_rank + extent_rank; // rank domain end
-        this->initTopology_(gbegin, gend, begin_rank, end_rank, nprocs_);
+        this->initTopology_(
+            gbegin, gend, begin_rank, end_rank, nprocs_, touch);
 
         // setup global mesh
         const MultiIndex global_blocks = this->getGlobalSize();
@@ -154,6 +325,7 @@ public:
 
     ~CartesianMPI() override
     {
+        synchronizers_.clear();
         if (global_mesh_) {
             delete global_mesh_;
             global_mesh_ = nullptr;
@@ -191,12 +363,347 @@ public:
      */
     bool isRoot() const { return (0 == rank_cart_); }
 
+    /**
+     * @brief Test for inner block
+     * @param bi Local block index
+     * @param s Stencil
+     * @return True if the stencil footprint of block ``bi`` is rank local
+     *
+     * @rst
+     * Only neighbors with non-zero halo width are considered.  Edge and corner
+     * neighbors are considered for tensorial stencils only.
+     * @endrst
+     */
+    bool isInnerBlock(const MultiIndex &bi, const StencilType &s) const
+    {
+        const IndexRangeType local(nblocks_);
+        const IndexRangeType nbr_range(3);
+        const MultiIndex sbegin = s.getBegin();
+        const MultiIndex send = s.getEnd();
+        for (const auto &p : nbr_range) {
+            const MultiIndex o = p - 1;
+            size_t noff = 0;
+            bool required = true;
+            for (size_t i = 0; i < BaseGrid::Dim; ++i) {
+                if ((o[i] < 0 && 0 == sbegin[i]) ||
+                    (o[i] > 0 && 1 == send[i])) {
+                    required = false;
+                    break;
+                }
+                noff += (0 != o[i]) ? 1 : 0;
+            }
+            if (!required || 0 == noff || (noff > 1 && !s.isTensorial())) {
+                continue;
+            }
+            if (!local.isIndex(bi + o)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Get inner blocks
+     * @param s Stencil
+     * @return Vector of block fields whose stencil footprint is rank local
+     */
+    std::vector<BaseType *> getInnerBlocks(const StencilType &s)
+    {
+        std::vector<BaseType *> blocks;
+        for (auto f : *this) {
+            if (isInnerBlock(f->getState().block_index, s)) {
+                blocks.push_back(f);
+            }
+        }
+        return blocks;
+    }
+
+    /**
+     * @brief Get halo blocks
+     * @param s Stencil
+     * @return Vector of block fields that depend on ghosts from neighbor ranks
+     */
+    std::vector<BaseType *> getHaloBlocks(const StencilType &s)
+    {
+        std::vector<BaseType *> blocks;
+        for (auto f : *this) {
+            if (!isInnerBlock(f->getState().block_index, s)) {
+                blocks.push_back(f);
+            }
+        }
+        return blocks;
+    }
+
+    /**
+     * @brief Start a global cell reduction with a per-cell functor
+     * @tparam Func Functor type with signature ``R(const CellValues &)``
+     * @param f Functor evaluated for each cell
+     * @param op Reduction operation
+     * @param weighted Multiply functor values by the cell volume
+     * @return Handle of the non-blocking reduction
+     *
+     * @rst
+     * The rank local part is computed as in ``Cartesian::reduce()``, the
+     * global reduction is started with a single ``MPI_Iallreduce``.  Call
+     * ``get()`` on the returned handle to obtain the result.
+     *
+     * .. code-block:: cpp
+     *
+     *    auto pending = grid.ireduce(wave_speed, Cubism::Grid::ReduceOp::Max);
+     *    sync.start(); // overlap with other work
+     *    const double umax = pending.get();
+     * @endrst
+     */
+    template <typename Func>
+    ReductionMPI<ReduceResult<Func>>
+    ireduce(Func &&f, const ReduceOp op, const bool weighted = false) const
+    {
+        return ReductionMPI<ReduceResult<Func>>(
+            BaseGrid::reduce(std::forward<Func>(f), op, weighted),
+            op,
+            comm_cart_);
+    }
+
+    /**
+     * @brief Global cell reduction with a per-cell functor
+     * @tparam Func Functor type with signature ``R(const CellValues &)``
+     * @param f Functor evaluated for each cell
+     * @param op Reduction operation
+     * @param weighted Multiply functor values by the cell volume
+     * @return Reduced value over all ranks
+     */
+    template <typename Func>
+    ReduceResult<Func>
+    reduce(Func &&f, const ReduceOp op, const bool weighted = false) const
+    {
+        return ireduce(std::forward<Func>(f), op, weighted).get();
+    }
+
+    /**
+     * @brief Get halo synchronizer
+     * @param s Stencil
+     * @return Reference to the synchronizer for stencil ``s``
+     *
+     * @rst
+     * The synchronizer is created on the first request for a stencil and
+     * cached for subsequent requests with the same stencil.  Message buffers
+     * and persistent MPI requests are therefore set up only once for each
+     * stencil used with this grid.  This method is not thread-safe and must
+     * not be called from within a parallel region.
+     * @endrst
+     */
+    SynchronizerType &getSynchronizer(const StencilType &s)
+    {
+        for (auto &sync : synchronizers_) {
+            if (sync->getStencil() == s) {
+                return *sync;
+            }
+        }
+        synchronizers_.emplace_back(new SynchronizerType(*this, s));
+        return *synchronizers_.back();
+    }
+
+    /**
+     * @brief Field lab loader utility to load data from ``field`` into ``lab``
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @tparam TCompute Data type of the lab
+     * @param field Source field data to be loaded
+     * @param lab Laboratory where data is loaded into
+     * @param c Component index
+     * @param d Face direction
+     *
+     * @rst
+     * Ghosts across rank boundaries are loaded from the receive buffers of the
+     * synchronizer for the active stencil of ``lab``.  The halos must have been
+     * exchanged with ``getSynchronizer(s).sync()`` (or ``start()`` and
+     * ``wait()``) before, otherwise ``std::runtime_error`` is thrown.  Only
+     * the exchange itself is checked: after modifying the grid data the
+     * halos must be exchanged again, otherwise stale halos are loaded.  This
+     * method does not create synchronizers and can be called concurrently.
+     * @endrst
+     */
+    template <typename Comp = size_t, typename Dir = size_t, typename TCompute>
+    void loadLab(const BaseType &field,
+                 Block::FieldLab<typename BaseType::FieldType, TCompute> &lab,
+                 const Comp c = 0,
+                 const Dir d = 0)
+    {
+        getSynchronized_(lab.getActiveStencil()).loadLab(field, lab, c, d);
+    }
+
+    /**
+     * @brief Field lab loader utility with boundary conditions
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @tparam TCompute Data type of the lab
+     * @param field Source field data to be loaded
+     * @param lab Laboratory where data is loaded into
+     * @param boundaries Vector of boundary conditions
+     * @param c Component index
+     * @param d Face direction
+     *
+     * @rst
+     * Boundary conditions in ``boundaries`` are applied to the sides of
+     * ``field`` that coincide with the global domain boundary.  See the
+     * overload without boundary conditions.
+     * @endrst
+     */
+    template <typename Comp = size_t, typename Dir = size_t, typename TCompute>
+    void loadLab(
+        const BaseType &field,
+        Block::FieldLab<typename BaseType::FieldType, TCompute> &lab,
+        const std::vector<BC::Base<
+            Block::FieldLab<typename BaseType::FieldType, TCompute>> *>
+            &boundaries,
+        const Comp c = 0,
+        const Dir d = 0)
+    {
+        getSynchronized_(lab.getActiveStencil())
+            .loadLab(field, lab, boundaries, c, d);
+    }
+
+    /**
+     * @brief View lab loader utility to load ghosts of ``field`` into ``lab``
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @param field Source field data to be mapped
+     * @param lab View laboratory where ghost data is loaded into
+     * @param c Component index
+     * @param d Face direction
+     *
+     * @rst
+     * See the ``Block::FieldLab`` overload.
+     * @endrst
+     */
+    template <typename Comp = size_t, typename Dir = size_t>
+    void loadLab(const BaseType &field,
+                 Block::FieldViewLab<typename BaseType::FieldType> &lab,
+                 const Comp c = 0,
+                 const Dir d = 0)
+    {
+        getSynchronized_(lab.getActiveStencil()).loadLab(field, lab, c, d);
+    }
+
+    /**
+     * @brief Batched lab loader utility for all components of ``field``
+     * @tparam Layout Memory layout of the lab
+     * @param field Source field data to be loaded
+     * @param lab Multi-component laboratory where data is loaded into
+     *
+     * @rst
+     * See the ``Block::FieldLab`` overload.
+     * @endrst
+     */
+    template <Block::LabLayout Layout>
+    void loadLab(const BaseType &field,
+                 Block::TensorFieldLab<BaseType, Layout> &lab)
+    {
+        getSynchronized_(lab.getActiveStencil()).loadLab(field, lab);
+    }
+
 private:
     MPI_Comm comm_;         // World communicator
     MPI_Comm comm_cart_;    // Cartesian communicator
     MultiIndex nprocs_;     // Number of MPI processes
     MultiIndex rank_index_; // Cartesian index of this rank
     int rank_cart_;         // Cartesian MPI rank
+
+    // halo synchronizers for requested stencils
+    std::vector<std::unique_ptr<SynchronizerType>> synchronizers_;
+
+    // lookup only, such that concurrent lab loads do not modify the cache
+    SynchronizerType &getSynchronized_(const StencilType &s)
+    {
+        for (auto &sync : synchronizers_) {
+            if (sync->getStencil() == s && sync->isSynchronized()) {
+                return *sync;
+            }
+        }
+        throw std::runtime_error(
+            "CartesianMPI: halos are not synchronized for the lab "
+            "stencil, call getSynchronizer(s).sync() before loading");
+    }
+};
+
+/**
+ * @ingroup MPI
+ * @brief Block processor for Cartesian MPI grids
+ *
+ * @rst
+ * Specialization for ``Grid::process()`` that overlaps the halo exchange with
+ * the processing of inner blocks.  Halo blocks are processed in the order in
+ * which their messages complete.  ``Grid::processActive()`` only processes the
+ * active blocks of this rank, the halo exchange is unchanged because the
+ * activity of blocks on neighbor ranks is not known locally.
+ * @endrst
+ */
+template <typename T,
+          typename Mesh,
+          Cubism::EntityType Entity,
+          size_t RANK,
+          typename UserState,
+          template <typename>
+          class Alloc>
+struct BlockProcessor<CartesianMPI<T, Mesh, Entity, RANK, UserState, Alloc>>
+    : public BlockProcessorBase<
+          CartesianMPI<T, Mesh, Entity, RANK, UserState, Alloc>> {
+    using GridType = CartesianMPI<T, Mesh, Entity, RANK, UserState, Alloc>;
+    using Base = BlockProcessorBase<GridType>;
+    using typename Base::BaseType;
+    using typename Base::StencilType;
+
+    template <typename Kernel, typename BCs>
+    static void run(GridType &grid,
+                    const StencilType &s,
+                    Kernel &kernel,
+                    LabPool<GridType> &pool,
+                    const BCs &bcs)
+    {
+        auto &labs =
+            pool.getLabs(s, Base::getMaxRange(grid), Base::getNumThreads());
+        auto &sync = grid.getSynchronizer(s);
+        sync.start();
+        Base::processBlocks(sync, sync.getInnerBlocks(), labs, kernel, bcs);
+        std::vector<BaseType *> ready;
+        while (sync.waitHalo(ready)) {
+            Base::processBlocks(sync, ready, labs, kernel, bcs);
+        }
+    }
+
+    template <typename Kernel, typename BCs>
+    static void runActive(GridType &grid,
+                          const StencilType &s,
+                          Kernel &kernel,
+                          LabPool<GridType> &pool,
+                          const BCs &bcs)
+    {
+        auto &labs =
+            pool.getLabs(s, Base::getMaxRange(grid), Base::getNumThreads());
+        auto &sync = grid.getSynchronizer(s);
+        sync.start();
+        std::vector<BaseType *> blocks;
+        getActive_(grid, sync.getInnerBlocks(), blocks);
+        Base::processBlocks(sync, blocks, labs, kernel, bcs);
+        std::vector<BaseType *> ready;
+        while (sync.waitHalo(ready)) {
+            getActive_(grid, ready, blocks);
+            Base::processBlocks(sync, blocks, labs, kernel, bcs);
+        }
+    }
+
+private:
+    static void getActive_(const GridType &grid,
+                           const std::vector<BaseType *> &src,
+                           std::vector<BaseType *> &dst)
+    {
+        dst.clear();
+        for (auto bf : src) {
+            if (grid.isActive(*bf)) {
+                dst.push_back(bf);
+            }
+        }
+    }
 };
 
 NAMESPACE_END(Grid)
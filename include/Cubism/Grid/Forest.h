@@ -0,0 +1,786 @@
+// File       : Forest.h
+// Created    : Sat Oct 17 2026 07:38:52 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Block-structured adaptive grid (forest of block trees)
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef FOREST_H_Y2GQ7RVE
+#define FOREST_H_Y2GQ7RVE
+
+#include "Cubism/Block/CellMask.h"
+#include "Cubism/Block/Field.h"
+#include "Cubism/Block/FieldLab.h"
+#include "Cubism/Block/Refinement.h"
+#include "Cubism/Common.h"
+#include "Cubism/Grid/NeighborTable.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif /* _OPENMP */
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Grid)
+
+/**
+ * @brief Refinement request for a block
+ *
+ * @rst
+ * Return type of the refinement criterion passed to ``Forest::adapt()``.
+ * @endrst
+ */
+enum class RefineFlag { Coarsen = -1, Keep = 0, Refine = 1 };
+
+/**
+ * @brief Block-structured adaptive grid
+ * @tparam T Field data type
+ * @tparam Mesh Mesh type to be associated with fields
+ * @tparam UserState Type for field state user extension
+ *
+ * @rst
+ * Forest of block trees for adaptive mesh refinement (AMR) of cell fields.
+ * The root level is a Cartesian arrangement of blocks, each block can be
+ * refined recursively into :math:`2^{DIM}` child blocks with the same number
+ * of cells up to a maximum level.  The leaves of the trees are block
+ * :ref:`field` types that carry the data, each with a block mesh like the
+ * block fields of a :ref:`cartesian` grid.  The field state of a leaf stores
+ * its refinement level and the block index with respect to the blocks on
+ * that level.
+ *
+ * The grid is periodic and the levels of neighboring leaves (including edge
+ * and corner neighbors) differ by at most one (2:1 balance).  Ghost cells of
+ * a ``Block::FieldLab`` are filled across level jumps by conservative
+ * restriction of finer neighbors and prolongation of coarser neighbors, see
+ * ``Block::restrictBlock()`` and ``Block::prolongateBlock()``.  The stencil
+ * width must not exceed half the number of block cells.  The grid can be
+ * used with ``Grid::process()``.
+ *
+ * .. code-block:: cpp
+ *
+ *    using Forest = Cubism::Grid::Forest<double, Mesh>;
+ *    Forest forest(MIndex(4), MIndex(16), PointType(0), PointType(1), 3);
+ *    forest.adapt([](const Forest::FieldType &f) {
+ *        return needsResolution(f) ? Cubism::Grid::RefineFlag::Refine
+ *                                  : Cubism::Grid::RefineFlag::Coarsen;
+ *    });
+ * @endrst
+ */
+template <typename T, typename Mesh, typename UserState = Block::FieldState>
+class Forest
+{
+public:
+    /** @brief Type of mesh */
+    using MeshType = Mesh;
+    /** @brief Index range type */
+    using IndexRangeType = typename MeshType::IndexRangeType;
+    /** @brief Type for higher dimensional index */
+    using MultiIndex = typename IndexRangeType::MultiIndex;
+    /** @brief Type for physical domain ranges spanned by ``MeshType`` */
+    using RangeType = typename MeshType::RangeType;
+    /** @brief Type of point in physical domain */
+    using PointType = typename MeshType::PointType;
+    /** @brief Cell mask type of a block */
+    using MaskType = Block::CellMask<MeshType::Dim>;
+
+    /**
+     * @brief Field state
+     *
+     * @rst
+     * State of a leaf block field.  The block index is relative to the
+     * blocks on the refinement level of the leaf.  Cell masks are not
+     * supported by this grid, the mask pointer is always ``nullptr``.
+     * @endrst
+     */
+    struct FieldState {
+        /** @brief Block index on refinement level */
+        MultiIndex block_index;
+        /** @brief Refinement level */
+        size_t level;
+        /** @brief Block mesh */
+        MeshType *mesh;
+        /** @brief Block cell mask */
+        const MaskType *mask;
+        /** @brief User extension */
+        UserState user;
+    };
+
+    /** @brief Block field type */
+    using BaseType =
+        Block::Field<T, Cubism::EntityType::Cell, MeshType::Dim, FieldState>;
+    /** @brief Block field type */
+    using FieldType = BaseType;
+    /** @brief Data type of carried fields */
+    using DataType = typename BaseType::DataType;
+    /** @brief Field lab type */
+    using FieldLabType = Block::FieldLab<FieldType>;
+    /** @brief Boundary condition vector type */
+    using BCVector = typename FieldLabType::BCVector;
+
+    /** @brief Field dimension */
+    static constexpr size_t Dim = MeshType::Dim;
+    /** @brief Field rank */
+    static constexpr size_t Rank = 0;
+    /** @brief Number of field components */
+    static constexpr size_t NComponents = 1;
+    /** @brief Entity type of field */
+    static constexpr typename Cubism::EntityType EntityType =
+        Cubism::EntityType::Cell;
+
+    /**
+     * @brief Main constructor
+     * @param nblocks Number of root blocks
+     * @param block_cells Number of cells in each block
+     * @param begin Physical origin of the domain (lower left)
+     * @param end Physical end of the domain (top right)
+     * @param max_level Maximum refinement level
+     *
+     * @rst
+     * All leaves are on level 0 after construction.  The number of block
+     * cells must be even if ``max_level > 0``.
+     * @endrst
+     */
+    Forest(const MultiIndex &nblocks,
+           const MultiIndex &block_cells,
+           const PointType &begin = PointType(0),
+           const PointType &end = PointType(1),
+           const size_t max_level = 0)
+        : nblocks_(nblocks), block_cells_(block_cells), begin_(begin),
+          end_(end), max_level_(max_level), index_(max_level + 1)
+    {
+#ifdef _OPENMP
+        scratch_.resize(static_cast<size_t>(omp_get_max_threads()));
+#else
+        scratch_.resize(1);
+#endif /* _OPENMP */
+        for (size_t d = 0; d < Dim; ++d) {
+            if (max_level > 0 && block_cells[d] % 2 != 0) {
+                throw std::runtime_error(
+                    "Forest: Number of block cells must be even.");
+            }
+        }
+        for (const auto &bi : IndexRangeType(nblocks_)) {
+            leaves_.push_back(newLeaf_(0, bi, UserState()));
+        }
+        buildIndex_();
+    }
+
+    /** @brief Deleted copy constructor */
+    Forest(const Forest &c) = delete;
+    /** @brief Deleted copy assignment */
+    Forest &operator=(const Forest &c) = delete;
+
+    /** @brief Destructor */
+    ~Forest()
+    {
+        for (auto f : leaves_) {
+            deleteLeaf_(f);
+        }
+    }
+
+    /** @brief Leaf iterator */
+    using iterator = typename std::vector<FieldType *>::iterator;
+    /** @brief Leaf iterator */
+    using const_iterator = typename std::vector<FieldType *>::const_iterator;
+
+    /** @return Iterator to first leaf */
+    iterator begin() noexcept { return leaves_.begin(); }
+    /** @return Iterator to first leaf */
+    const_iterator begin() const noexcept { return leaves_.begin(); }
+    /** @return Iterator to last leaf */
+    iterator end() noexcept { return leaves_.end(); }
+    /** @return Iterator to last leaf */
+    const_iterator end() const noexcept { return leaves_.end(); }
+
+    /**
+     * @brief Number of leaves
+     * @return Number of leaf block fields
+     */
+    size_t size() const { return leaves_.size(); }
+
+    /**
+     * @brief Leaf access
+     * @param i Leaf index
+     * @return Reference to leaf block field
+     */
+    FieldType &operator[](const size_t i)
+    {
+        assert(i < leaves_.size());
+        return *leaves_[i];
+    }
+
+    /**
+     * @brief Leaf access
+     * @param i Leaf index
+     * @return ``const`` reference to leaf block field
+     */
+    const FieldType &operator[](const size_t i) const
+    {
+        assert(i < leaves_.size());
+        return *leaves_[i];
+    }
+
+    /**
+     * @brief Get the number of cells per block
+     * @return Number of cells in a block along all dimensions
+     */
+    MultiIndex getBlockCells() const { return block_cells_; }
+
+    /**
+     * @brief Maximum refinement level
+     * @return Level index of the finest level
+     */
+    size_t getMaxLevel() const { return max_level_; }
+
+    /**
+     * @brief Number of blocks on a level
+     * @param level Refinement level
+     * @return Number of blocks in all dimensions if the domain was covered
+     *         with blocks of level ``level``
+     */
+    MultiIndex getLevelSize(const size_t level) const
+    {
+        return nblocks_ *
+               MultiIndex(static_cast<typename MultiIndex::DataType>(1)
+                          << level);
+    }
+
+    /**
+     * @brief Find a leaf
+     * @param level Refinement level
+     * @param bi Block index on ``level`` (mapped periodically)
+     * @return Pointer to the leaf or ``nullptr`` if there is no leaf with
+     *         index ``bi`` on ``level``
+     */
+    FieldType *getLeaf(const size_t level, const MultiIndex &bi) const
+    {
+        if (level > max_level_) {
+            return nullptr;
+        }
+        const MultiIndex q = wrap_(level, bi);
+        const auto it = index_[level].find(
+            IndexRangeType(getLevelSize(level)).getFlatIndex(q));
+        return (it == index_[level].end()) ? nullptr : leaves_[it->second];
+    }
+
+    /**
+     * @brief Adapt the grid
+     * @tparam Criterion Callable type
+     * @param criterion Functor ``RefineFlag criterion(const FieldType &)``
+     * @return True if the set of leaves changed
+     *
+     * @rst
+     * The criterion is evaluated for each leaf.  A coarsening request is
+     * granted if all :math:`2^{DIM}` siblings of a leaf request coarsening.
+     * Requests are adjusted to maintain the 2:1 balance, refinement takes
+     * precedence over coarsening.  New leaves are initialized with
+     * ``Block::prolongateBlock()`` and ``Block::restrictBlock()``, the
+     * integral of the data is conserved.  The leaf order is depth-first
+     * within the lexicographic order of the root blocks.  Invalidates all
+     * references to leaves that have been refined or coarsened.
+     * @endrst
+     */
+    template <typename Criterion>
+    bool adapt(Criterion &&criterion)
+    {
+        const size_t n = leaves_.size();
+        std::vector<size_t> target(n);
+        for (size_t i = 0; i < n; ++i) {
+            const size_t l = leaves_[i]->getState().level;
+            const RefineFlag flag = criterion(*leaves_[i]);
+            target[i] = l;
+            if (RefineFlag::Refine == flag && l < max_level_) {
+                target[i] = l + 1;
+            } else if (RefineFlag::Coarsen == flag && l > 0) {
+                target[i] = l - 1;
+            }
+        }
+        balance_(target);
+
+        bool changed = false;
+        std::vector<FieldType *> next;
+        std::vector<bool> done(n, false);
+        const IndexRangeType children(MultiIndex(2));
+        const MultiIndex half = block_cells_ / 2;
+        for (size_t i = 0; i < n; ++i) {
+            if (done[i]) {
+                continue;
+            }
+            done[i] = true;
+            FieldType *f = leaves_[i];
+            const FieldState &fs = f->getState();
+            if (target[i] == fs.level) {
+                next.push_back(f);
+                continue;
+            }
+            changed = true;
+            if (target[i] > fs.level) {
+                // refine
+                for (const auto &k : children) {
+                    FieldType *c = newLeaf_(fs.level + 1,
+                                            MultiIndex(2) * fs.block_index + k,
+                                            fs.user);
+                    Block::prolongateBlock(*f, k * half, *c);
+                    next.push_back(c);
+                }
+                deleteLeaf_(f);
+            } else {
+                // coarsen (leaf i is the first sibling in leaf order)
+                const size_t level = fs.level;
+                const MultiIndex pi = fs.block_index / 2;
+                FieldType *p = newLeaf_(level - 1, pi, fs.user);
+                std::vector<size_t> siblings;
+                for (const auto &k : children) {
+                    const size_t j = getIndex_(level, MultiIndex(2) * pi + k);
+                    Block::restrictBlock(*leaves_[j], *p, k * half);
+                    siblings.push_back(j);
+                }
+                for (const size_t j : siblings) {
+                    done[j] = true;
+                    deleteLeaf_(leaves_[j]);
+                }
+                next.push_back(p);
+            }
+        }
+        leaves_.swap(next);
+        buildIndex_();
+        return changed;
+    }
+
+    /**
+     * @brief Field lab loader utility to load data from ``field`` into ``lab``
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @param field Leaf block field contained in this grid
+     * @param lab Laboratory where data is loaded into
+     *
+     * @rst
+     * Ghost cells are loaded from neighbors on the same level.  Ghosts from
+     * coarser (finer) neighbors are prolongated (restricted) to the level of
+     * ``field`` first, only for the cells read by the active stencil of
+     * ``lab``.  The component arguments exist for compatibility with
+     * ``Grid::process()``.  Thread-safe.
+     * @endrst
+     */
+    template <typename Comp = size_t, typename Dir = size_t>
+    void loadLab(const FieldType &field,
+                 FieldLabType &lab,
+                 const Comp = 0,
+                 const Dir = 0)
+    {
+        std::unique_ptr<Scratch> tmp;
+        LevelFunctor id2field(*this, field, lab, getScratch_(tmp));
+        lab.loadData(field.getState().block_index, id2field);
+    }
+
+    /**
+     * @brief Field lab loader utility with boundary conditions
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @param field Leaf block field contained in this grid
+     * @param lab Laboratory where data is loaded into
+     * @param boundaries Vector of boundary conditions
+     *
+     * @rst
+     * Boundary conditions in ``boundaries`` are applied to the sides of
+     * ``field`` that coincide with the domain boundary, leaves in the
+     * interior of the domain are loaded from their neighbors only.  The
+     * component arguments exist for compatibility with ``Grid::process()``.
+     * @endrst
+     */
+    template <typename Comp = size_t, typename Dir = size_t>
+    void loadLab(const FieldType &field,
+                 FieldLabType &lab,
+                 const BCVector &boundaries,
+                 const Comp = 0,
+                 const Dir = 0)
+    {
+        std::unique_ptr<Scratch> tmp;
+        Scratch &scratch = getScratch_(tmp);
+        const FieldState &fs = field.getState();
+        const MultiIndex nlevel = getLevelSize(fs.level);
+        scratch.bcs.clear();
+        for (const auto bc : boundaries) {
+            const BC::BoundaryInfo &info = bc->getBoundaryInfo();
+            const auto edge = (0 == info.side) ? 0 : nlevel[info.dir] - 1;
+            if (fs.block_index[info.dir] == edge) {
+                scratch.bcs.push_back(bc);
+            }
+        }
+        LevelFunctor id2field(*this, field, lab, scratch);
+        lab.loadData(fs.block_index, id2field, scratch.bcs);
+    }
+
+private:
+    using MeshIntegrity = typename MeshType::MeshIntegrity;
+    using TableType = NeighborTable<Dim>;
+
+    const MultiIndex nblocks_;
+    const MultiIndex block_cells_;
+    const PointType begin_;
+    const PointType end_;
+    const size_t max_level_;
+    std::vector<FieldType *> leaves_;
+    // flat block index on level -> leaf index
+    std::vector<std::unordered_map<size_t, size_t>> index_;
+
+    /**
+     * @brief Thread local scratch data for lab loading
+     *
+     * @rst
+     * Scratch fields hold the ghost data of neighbors on a different level,
+     * one per neighbor table slot.  They are allocated on first use and
+     * reused for subsequent loads.
+     * @endrst
+     */
+    struct Scratch {
+        std::unique_ptr<FieldType> fields[TableType::NNeighbors];
+        BCVector bcs;
+    };
+
+    std::vector<std::unique_ptr<Scratch>> scratch_;
+
+    /**
+     * @brief Scratch data of the calling thread
+     * @param tmp Fallback storage
+     * @return Reference to scratch data
+     *
+     * @rst
+     * Threads beyond the number of threads at construction use ``tmp``.
+     * @endrst
+     */
+    Scratch &getScratch_(std::unique_ptr<Scratch> &tmp)
+    {
+        size_t tid = 0;
+#ifdef _OPENMP
+        tid = static_cast<size_t>(omp_get_thread_num());
+#endif /* _OPENMP */
+        std::unique_ptr<Scratch> &s = (tid < scratch_.size()) ? scratch_[tid]
+                                                              : tmp;
+        if (!s) {
+            s.reset(new Scratch());
+        }
+        return *s;
+    }
+
+    /**
+     * @brief Block access on the level of a leaf
+     *
+     * @rst
+     * Index functor for ``Block::FieldLab::loadData()``.  Neighbor blocks that
+     * are not leaves on the level of the lab field are assembled in a scratch
+     * field from the covering coarser leaf or the adjacent finer leaves on
+     * first access.  Only the ghost region read by the lab is assembled.
+     * @endrst
+     */
+    class LevelFunctor
+    {
+    public:
+        LevelFunctor(Forest &forest,
+                     const FieldType &field,
+                     const FieldLabType &lab,
+                     Scratch &scratch)
+            : forest_(forest), field_(const_cast<FieldType &>(field)),
+              stencil_(lab.getActiveStencil()), scratch_(scratch),
+              level_(field.getState().level),
+              i0_(field.getState().block_index)
+        {
+            for (size_t n = 0; n < TableType::NNeighbors; ++n) {
+                cache_[n] = nullptr;
+            }
+        }
+
+        FieldType &operator()(const MultiIndex &p)
+        {
+            const MultiIndex o = p - i0_;
+            const size_t slot = TableType::getSlot(o);
+            if (!cache_[slot]) {
+                cache_[slot] = (o == MultiIndex(0)) ? &field_
+                                                    : resolve_(p, o, slot);
+            }
+            return *cache_[slot];
+        }
+
+    private:
+        using StencilType = typename FieldLabType::StencilType;
+
+        Forest &forest_;
+        FieldType &field_;
+        const StencilType stencil_;
+        Scratch &scratch_;
+        const size_t level_;
+        const MultiIndex i0_;
+        FieldType *cache_[TableType::NNeighbors];
+
+        FieldType *
+        resolve_(const MultiIndex &p, const MultiIndex &o, const size_t slot)
+        {
+            FieldType *f = forest_.getLeaf(level_, p);
+            if (f) {
+                return f;
+            }
+            const MultiIndex n = forest_.block_cells_;
+            const MultiIndex half = n / 2;
+            std::unique_ptr<FieldType> &sp = scratch_.fields[slot];
+            if (!sp) {
+                sp.reset(new FieldType(IndexRangeType(n)));
+            }
+            FieldType &s = *sp;
+
+            // ghost cells of the lab in the index space of the neighbor
+            MultiIndex gbegin(0), gend(n);
+            for (size_t d = 0; d < Dim; ++d) {
+                if (o[d] < 0) {
+                    gbegin[d] = n[d] + stencil_.getBegin()[d];
+                } else if (o[d] > 0) {
+                    gend[d] = stencil_.getEnd()[d] - 1;
+                }
+                if (gend[d] <= gbegin[d]) {
+                    return &s; // nothing is read from this neighbor
+                }
+            }
+
+            const MultiIndex q = forest_.wrap_(level_, p);
+            if (level_ > 0) {
+                const FieldType *c = forest_.getLeaf(level_ - 1, q / 2);
+                if (c) {
+                    const MultiIndex k = q - MultiIndex(2) * (q / 2);
+                    Block::prolongateBlock(
+                        *c,
+                        k * half,
+                        s,
+                        IndexRangeType(gbegin / 2, (gend + MultiIndex(1)) / 2));
+                    return &s;
+                }
+            }
+            // finer neighbor: restrict the children that overlap the ghost
+            // region (children further away may be refined further)
+            for (const auto &k : IndexRangeType(MultiIndex(2))) {
+                MultiIndex cbegin, cend;
+                bool overlap = true;
+                for (size_t d = 0; d < Dim; ++d) {
+                    cbegin[d] = std::max(gbegin[d], k[d] * half[d]);
+                    cend[d] = std::min(gend[d], (k[d] + 1) * half[d]);
+                    overlap = overlap && (cbegin[d] < cend[d]);
+                }
+                if (!overlap) {
+                    continue;
+                }
+                const FieldType *c =
+                    forest_.getLeaf(level_ + 1, MultiIndex(2) * q + k);
+                if (!c) {
+                    throw std::runtime_error(
+                        "Forest: Neighbor level difference exceeds one.");
+                }
+                const MultiIndex offset = k * half;
+                Block::restrictBlock(
+                    *c,
+                    s,
+                    offset,
+                    IndexRangeType(cbegin - offset, cend - offset));
+            }
+            return &s;
+        }
+    };
+
+    /**
+     * @brief Periodic block index on a level
+     * @param level Refinement level
+     * @param p Block index
+     * @return Block index mapped into the blocks of ``level``
+     */
+    MultiIndex wrap_(const size_t level, MultiIndex p) const
+    {
+        const MultiIndex n = getLevelSize(level);
+        for (size_t d = 0; d < Dim; ++d) {
+            p[d] = ((p[d] % n[d]) + n[d]) % n[d];
+        }
+        return p;
+    }
+
+    /**
+     * @brief Leaf index of an existing leaf
+     * @param level Refinement level
+     * @param bi Block index on ``level``
+     * @return Index in the leaf vector
+     */
+    size_t getIndex_(const size_t level, const MultiIndex &bi) const
+    {
+        const auto it = index_[level].find(
+            IndexRangeType(getLevelSize(level)).getFlatIndex(wrap_(level, bi)));
+        assert(it != index_[level].end());
+        return it->second;
+    }
+
+    /** @brief Rebuild the leaf lookup tables */
+    void buildIndex_()
+    {
+        for (auto &m : index_) {
+            m.clear();
+        }
+        for (size_t i = 0; i < leaves_.size(); ++i) {
+            const FieldState &fs = leaves_[i]->getState();
+            index_[fs.level][IndexRangeType(getLevelSize(fs.level))
+                                 .getFlatIndex(fs.block_index)] = i;
+        }
+    }
+
+    /**
+     * @brief Visit the neighbor leaves of a leaf
+     * @tparam Func Callable type
+     * @param i Leaf index
+     * @param f Functor ``f(j)`` called with the leaf index of each neighbor
+     *
+     * @rst
+     * Neighbors include edge and corner neighbors and may be visited more
+     * than once.
+     * @endrst
+     */
+    template <typename Func>
+    void forEachNeighbor_(const size_t i, Func &&f) const
+    {
+        const FieldState &fs = leaves_[i]->getState();
+        const size_t l = fs.level;
+        for (size_t n = 0; n < TableType::NNeighbors; ++n) {
+            const MultiIndex o = TableType::getOffset(n);
+            if (o == MultiIndex(0)) {
+                continue;
+            }
+            const MultiIndex q = wrap_(l, fs.block_index + o);
+            if (getLeaf(l, q)) {
+                f(getIndex_(l, q));
+            } else if (l > 0 && getLeaf(l - 1, q / 2)) {
+                f(getIndex_(l - 1, q / 2));
+            } else if (l < max_level_) {
+                // children of q adjacent to leaf i
+                for (const auto &k : IndexRangeType(MultiIndex(2))) {
+                    bool adjacent = true;
+                    for (size_t d = 0; d < Dim; ++d) {
+                        if ((o[d] > 0 && k[d] != 0) ||
+                            (o[d] < 0 && k[d] != 1)) {
+                            adjacent = false;
+                        }
+                    }
+                    const MultiIndex c = MultiIndex(2) * q + k;
+                    if (adjacent && getLeaf(l + 1, c)) {
+                        f(getIndex_(l + 1, c));
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Adjust target levels for sibling consistency and 2:1 balance
+     * @param target Target level of each leaf
+     */
+    void balance_(std::vector<size_t> &target) const
+    {
+        const size_t n = leaves_.size();
+        const IndexRangeType children(MultiIndex(2));
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            // coarsening requires all siblings
+            for (size_t i = 0; i < n; ++i) {
+                const FieldState &fs = leaves_[i]->getState();
+                if (target[i] >= fs.level) {
+                    continue;
+                }
+                const MultiIndex pi = fs.block_index / 2;
+                bool granted = true;
+                for (const auto &k : children) {
+                    const FieldType *s =
+                        getLeaf(fs.level, MultiIndex(2) * pi + k);
+                    if (!s || target[getIndex_(fs.level, MultiIndex(2) * pi +
+                                                             k)] >= fs.level) {
+                        granted = false;
+                    }
+                }
+                if (!granted) {
+                    target[i] = fs.level;
+                    changed = true;
+                }
+            }
+            // 2:1 balance of target levels
+            for (size_t i = 0; i < n; ++i) {
+                forEachNeighbor_(i, [&](const size_t j) {
+                    if (target[j] + 1 < target[i]) {
+                        target[j] = target[i] - 1;
+                        changed = true;
+                    }
+                });
+            }
+        }
+    }
+
+    /**
+     * @brief Create a leaf
+     * @param level Refinement level
+     * @param bi Block index on ``level``
+     * @param user User state
+     * @return Pointer to new leaf block field
+     */
+    FieldType *
+    newLeaf_(const size_t level, const MultiIndex &bi, const UserState &user)
+    {
+        const MultiIndex nlevel = getLevelSize(level);
+        const PointType block_extent = (end_ - begin_) / PointType(nlevel);
+        const PointType bstart = begin_ + PointType(bi) * block_extent;
+        const MultiIndex cstart = bi * block_cells_;
+        MultiIndex nodes = block_cells_;
+        std::vector<IndexRangeType> face_ranges(Dim);
+        for (size_t d = 0; d < Dim; ++d) {
+            MultiIndex faces(block_cells_);
+            if (bi[d] == nlevel[d] - 1) {
+                ++nodes[d];
+                ++faces[d];
+            }
+            face_ranges[d] = IndexRangeType(cstart, cstart + faces);
+        }
+        MeshType *mesh =
+            new MeshType(RangeType(begin_, end_),
+                         RangeType(bstart, bstart + block_extent),
+                         IndexRangeType(cstart, cstart + block_cells_),
+                         IndexRangeType(cstart, cstart + nodes),
+                         face_ranges,
+                         MeshIntegrity::SubMesh);
+        FieldState fs;
+        fs.block_index = bi;
+        fs.level = level;
+        fs.mesh = mesh;
+        fs.mask = nullptr;
+        fs.user = user;
+        return new FieldType(IndexRangeType(block_cells_), fs);
+    }
+
+    /**
+     * @brief Delete a leaf and its block mesh
+     * @param f Leaf block field
+     */
+    static void deleteLeaf_(FieldType *f)
+    {
+        delete f->getState().mesh;
+        delete f;
+    }
+};
+
+template <typename T, typename Mesh, typename UserState>
+constexpr size_t Forest<T, Mesh, UserState>::Dim;
+
+template <typename T, typename Mesh, typename UserState>
+constexpr size_t Forest<T, Mesh, UserState>::Rank;
+
+template <typename T, typename Mesh, typename UserState>
+constexpr size_t Forest<T, Mesh, UserState>::NComponents;
+
+template <typename T, typename Mesh, typename UserState>
+constexpr typename Cubism::EntityType Forest<T, Mesh, UserState>::EntityType;
+
+NAMESPACE_END(Grid)
+NAMESPACE_END(Cubism)
+
+#endif /* FOREST_H_Y2GQ7RVE */
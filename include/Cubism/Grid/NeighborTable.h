@@ -0,0 +1,302 @@
+// File       : NeighborTable.h
+// Created    : Fri Oct 16 2026 08:03:52 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Precomputed block neighbor table for lab loading
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef NEIGHBORTABLE_H_5NDKX0TB
+#define NEIGHBORTABLE_H_5NDKX0TB
+
+#include "Cubism/Block/FieldLabLoader.h"
+#include "Cubism/Common.h"
+#include "Cubism/Core/Index.h"
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Grid)
+
+/**
+ * @brief Number of direct neighbors of a block including the block itself
+ * @param dim Dimension
+ * @return :math:`3^{dim}`
+ */
+constexpr size_t getNeighborCount(const size_t dim)
+{
+    return (0 == dim) ? 1 : 3 * getNeighborCount(dim - 1);
+}
+
+/**
+ * @brief Table of the direct neighbors of all blocks in a grid
+ * @tparam DIM Dimension
+ *
+ * @rst
+ * Stores :math:`3^{DIM}` entries per block (including the block itself) in
+ * lexicographic order of the neighbor offset :math:`\{-1,0,1\}^{DIM}`.  An
+ * entry refers either to a block field in the field container of the grid or
+ * to a remote ghost slot.  Periodic wrap is resolved when the table is built,
+ * such that a neighbor lookup during lab loading is a single table access.
+ * The table must be rebuilt if the block topology changes.
+ * @endrst
+ */
+template <size_t DIM>
+class NeighborTable
+{
+public:
+    /** @brief Index range type */
+    using IndexRangeType = Core::IndexRange<DIM>;
+    /** @brief Type for higher dimensional index */
+    using MultiIndex = typename IndexRangeType::MultiIndex;
+
+    /** @brief Neighbor entry */
+    struct Entry {
+        /** @brief Field container index or remote ghost slot */
+        size_t index;
+        /** @brief True if ``index`` refers to a remote ghost slot */
+        bool remote;
+        /** @brief True if the neighbor is across the domain boundary */
+        bool boundary;
+    };
+
+    /** @brief Number of table entries per block */
+    static constexpr size_t NNeighbors = getNeighborCount(DIM);
+
+    /**
+     * @brief Build the neighbor table
+     * @tparam States Random access container of field state pointers
+     * @tparam Resolver Callable that returns an ``Entry`` given a block index
+     * @param states Field states in field container order
+     * @param resolve Resolver for neighbor block indices
+     *
+     * @rst
+     * The block index passed to ``resolve`` may be outside of the grid.
+     * @endrst
+     */
+    template <typename States, typename Resolver>
+    void build(const States &states, Resolver resolve)
+    {
+        const size_t nblocks = states.size();
+        table_.resize(nblocks * NNeighbors);
+        for (size_t k = 0; k < nblocks; ++k) {
+            const MultiIndex bi = states[k]->block_index;
+            Entry *row = table_.data() + k * NNeighbors;
+            for (size_t n = 0; n < NNeighbors; ++n) {
+                row[n] = resolve(bi + getOffset(n));
+            }
+        }
+    }
+
+    /** @brief Clear the table */
+    void clear() { table_.clear(); }
+
+    /**
+     * @brief Number of blocks in the table
+     * @return Number of blocks
+     */
+    size_t size() const { return table_.size() / NNeighbors; }
+
+    /**
+     * @brief Neighbors of a block
+     * @param k Field container index of the block
+     * @return Pointer to the first of ``NNeighbors`` entries
+     */
+    const Entry *getRow(const size_t k) const
+    {
+        assert(k < size());
+        return table_.data() + k * NNeighbors;
+    }
+
+    /**
+     * @brief Neighbor entry of a block
+     * @param k Field container index of the block
+     * @param offset Neighbor offset with components in :math:`\{-1,0,1\}`
+     * @return ``const`` reference to neighbor entry
+     */
+    const Entry &operator()(const size_t k, const MultiIndex &offset) const
+    {
+        return getRow(k)[getSlot(offset)];
+    }
+
+    /**
+     * @brief Table slot of a neighbor offset
+     * @param offset Neighbor offset with components in :math:`\{-1,0,1\}`
+     * @return Slot index in a table row
+     */
+    static size_t getSlot(const MultiIndex &offset)
+    {
+        size_t slot = 0;
+        size_t stride = 1;
+        for (size_t i = 0; i < DIM; ++i) {
+            assert(offset[i] >= -1 && offset[i] <= 1);
+            slot += static_cast<size_t>(offset[i] + 1) * stride;
+            stride *= 3;
+        }
+        return slot;
+    }
+
+    /**
+     * @brief Neighbor offset of a table slot
+     * @param slot Slot index in a table row
+     * @return Neighbor offset with components in :math:`\{-1,0,1\}`
+     */
+    static MultiIndex getOffset(size_t slot)
+    {
+        assert(slot < NNeighbors);
+        MultiIndex offset;
+        for (size_t i = 0; i < DIM; ++i) {
+            offset[i] =
+                static_cast<typename MultiIndex::DataType>(slot % 3) - 1;
+            slot /= 3;
+        }
+        return offset;
+    }
+
+private:
+    std::vector<Entry> table_;
+};
+
+template <size_t DIM>
+constexpr size_t NeighborTable<DIM>::NNeighbors;
+
+/**
+ * @brief Scalar field access through a neighbor table row
+ * @tparam FContainer Field container type
+ * @tparam Class Field class
+ * @tparam RANK Tensor rank
+ *
+ * @rst
+ * Field lab index functor bound to one block.  The functor only resolves
+ * block indices in the direct neighborhood of the block it is bound to, which
+ * are the only indices requested by the lab loaders.  The loaders use the
+ * boundary markers of the table to test only neighbors across the domain
+ * boundary for non-periodic boundary conditions.
+ * @endrst
+ */
+template <typename FContainer, Cubism::FieldClass Class, size_t RANK>
+class NeighborFunctor
+{
+public:
+    using ScalarField = typename FContainer::BaseType::FieldType;
+    using IndexRangeType = typename ScalarField::IndexRangeType;
+    using MultiIndex = typename IndexRangeType::MultiIndex;
+    using TableType = NeighborTable<IndexRangeType::Dim>;
+    using Entry = typename TableType::Entry;
+
+    /**
+     * @brief Main constructor
+     * @param fields Field container of the grid
+     * @param row Neighbor table row of the block
+     * @param i0 Block index of the block
+     * @param remote Remote ghost fields indexed by the remote slot
+     * @param comp Component index
+     * @param fdir Face direction
+     */
+    NeighborFunctor(FContainer &fields,
+                    const Entry *row,
+                    const MultiIndex &i0,
+                    const ScalarField *const *remote = nullptr,
+                    const size_t comp = 0,
+                    const size_t fdir = 0)
+        : fields_(fields), row_(row), i0_(i0), remote_(remote), comp_(comp),
+          face_dir_(fdir)
+    {
+    }
+    NeighborFunctor() = delete;
+    NeighborFunctor(const NeighborFunctor &c) = default;
+    NeighborFunctor(NeighborFunctor &&c) = default;
+    NeighborFunctor &operator=(const NeighborFunctor &c) = default;
+    NeighborFunctor &operator=(NeighborFunctor &&c) = default;
+
+    ScalarField &operator()(const MultiIndex &p)
+    {
+        return const_cast<ScalarField &>(get_(p));
+    }
+
+    const ScalarField &operator()(const MultiIndex &p) const
+    {
+        return get_(p);
+    }
+
+    /**
+     * @brief Boundary marker of a neighbor
+     * @param p Block index of the neighbor
+     * @return True if the neighbor is across the domain boundary
+     */
+    bool isBoundary(const MultiIndex &p) const
+    {
+        return row_[TableType::getSlot(p - i0_)].boundary;
+    }
+
+private:
+    Block::ScalarFieldMap<FContainer, Class, RANK> fields_;
+    const Entry *row_;
+    const MultiIndex i0_;
+    const ScalarField *const *remote_;
+    const size_t comp_;     // component
+    const size_t face_dir_; // face direction
+
+    const ScalarField &get_(const MultiIndex &p) const
+    {
+        const Entry &e = row_[TableType::getSlot(p - i0_)];
+        if (e.remote) {
+            assert(remote_ != nullptr && remote_[e.index] != nullptr);
+            return *remote_[e.index];
+        }
+        return fields_(e.index, comp_, face_dir_);
+    }
+};
+
+/**
+ * @brief Load a lab with the boundary conditions at the domain boundary
+ * @tparam Lab Field lab type
+ * @tparam Functor Neighbor functor type
+ * @param lab Laboratory where data is loaded into
+ * @param fid Block index of the loaded block field
+ * @param nbr Neighbor functor bound to block ``fid``
+ * @param boundaries Vector of boundary conditions
+ *
+ * @rst
+ * Boundary conditions in ``boundaries`` are applied to the sides of block
+ * ``fid`` that coincide with the domain boundary according to the boundary
+ * markers of the neighbor table, periodic ones are always passed on.  A
+ * temporary vector is only required for blocks at the domain boundary where
+ * a subset of ``boundaries`` applies.
+ * @endrst
+ */
+template <typename Lab, typename Functor>
+void loadBoundaryLab(Lab &lab,
+                     const typename Functor::MultiIndex &fid,
+                     Functor &nbr,
+                     const typename Lab::BCVector &boundaries)
+{
+    auto applies = [&fid, &nbr](const typename Lab::BCType *bc) {
+        const auto &info = bc->getBoundaryInfo();
+        if (info.is_periodic) {
+            return true;
+        }
+        typename Functor::MultiIndex p(fid);
+        p[info.dir] += (0 == info.side) ? -1 : 1;
+        return nbr.isBoundary(p);
+    };
+    size_t n = 0;
+    for (const auto bc : boundaries) {
+        n += applies(bc) ? 1 : 0;
+    }
+    if (n == boundaries.size()) {
+        lab.loadData(fid, nbr, boundaries);
+        return;
+    }
+    typename Lab::BCVector bcs;
+    bcs.reserve(n);
+    for (const auto bc : boundaries) {
+        if (applies(bc)) {
+            bcs.push_back(bc);
+        }
+    }
+    lab.loadData(fid, nbr, bcs);
+}
+
+NAMESPACE_END(Grid)
+NAMESPACE_END(Cubism)
+
+#endif /* NEIGHBORTABLE_H_5NDKX0TB */
@@ -0,0 +1,653 @@
+// File       : Process.h
+// Created    : Thu Oct 15 2026 02:12:40 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Thread-parallel block processing driver for grids
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef PROCESS_H_R2MXW7NB
+#define PROCESS_H_R2MXW7NB
+
+#include "Cubism/Block/CellMask.h"
+#include "Cubism/Block/FieldLab.h"
+#include "Cubism/Common.h"
+#include "Cubism/Core/Stencil.h"
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif /* _OPENMP */
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Grid)
+
+/**
+ * @brief Set of field labs for all scalar fields of a block field
+ * @tparam TGrid Grid type
+ *
+ * @rst
+ * Contains one ``Block::FieldLab`` for each scalar component of the grid
+ * block field type.  For face fields the labs are ordered by face direction
+ * first such that ``labs[d * NComponents + c]`` corresponds to component ``c``
+ * of the face field with direction ``d``.
+ * @endrst
+ */
+template <typename TGrid>
+class FieldLabSet
+{
+public:
+    /** @brief Scalar field type */
+    using FieldType = typename TGrid::BaseType::FieldType;
+    /** @brief Field lab type */
+    using FieldLabType = Block::FieldLab<FieldType>;
+    /** @brief Stencil type */
+    using StencilType = typename FieldLabType::StencilType;
+    /** @brief Index range type */
+    using IndexRangeType = typename FieldLabType::IndexRangeType;
+    /** @brief Vector of boundary conditions */
+    using BCVector = typename FieldLabType::BCVector;
+
+    /** @brief Number of labs in the set */
+    static constexpr size_t NScalars =
+        TGrid::NComponents *
+        ((TGrid::EntityType == Cubism::EntityType::Face) ? TGrid::Dim : 1);
+
+    FieldLabSet() = default;
+    FieldLabSet(const FieldLabSet &c) = delete;
+    FieldLabSet(FieldLabSet &&c) = delete;
+    FieldLabSet &operator=(const FieldLabSet &c) = delete;
+    FieldLabSet &operator=(FieldLabSet &&c) = delete;
+
+    /**
+     * @brief Allocate all labs in the set
+     * @param s Target stencil
+     * @param max_request_range Maximum index range to be processed in the lab
+     */
+    void allocate(const StencilType &s, const IndexRangeType &max_request_range)
+    {
+        for (size_t i = 0; i < NScalars; ++i) {
+            labs_[i].allocate(s, max_request_range);
+        }
+    }
+
+    /**
+     * @brief Number of labs
+     * @return Number of scalar labs in this set
+     */
+    constexpr size_t size() const { return NScalars; }
+
+    /**
+     * @brief Lab access
+     * @param i Scalar lab index
+     * @return Reference to lab
+     */
+    FieldLabType &operator[](const size_t i)
+    {
+        assert(i < NScalars);
+        return labs_[i];
+    }
+
+    /**
+     * @brief Lab access
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @param c Component index
+     * @param d Face direction
+     * @return Reference to lab
+     */
+    template <typename Comp = size_t, typename Dir = size_t>
+    FieldLabType &operator()(const Comp c = 0, const Dir d = 0)
+    {
+        return (*this)[index(c, d)];
+    }
+
+    /**
+     * @brief Scalar lab index
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @param c Component index
+     * @param d Face direction
+     * @return Index of the lab for component ``c`` and face direction ``d``
+     */
+    template <typename Comp = size_t, typename Dir = size_t>
+    static size_t index(const Comp c = 0, const Dir d = 0)
+    {
+        assert(static_cast<size_t>(c) < TGrid::NComponents);
+        if (TGrid::EntityType == Cubism::EntityType::Face) {
+            return static_cast<size_t>(d) * TGrid::NComponents +
+                   static_cast<size_t>(c);
+        }
+        return static_cast<size_t>(c);
+    }
+
+private:
+    FieldLabType labs_[NScalars];
+};
+
+template <typename TGrid>
+constexpr size_t FieldLabSet<TGrid>::NScalars;
+
+/**
+ * @brief Pool of thread local field labs
+ * @tparam TGrid Grid type
+ *
+ * @rst
+ * Holds one ``FieldLabSet`` per thread for each stencil requested.  Labs are
+ * allocated on the first request for a stencil and reused for subsequent
+ * requests, avoiding repeated lab allocations in a time loop.
+ * @endrst
+ */
+template <typename TGrid>
+class LabPool
+{
+public:
+    /** @brief Lab set type */
+    using LabSetType = FieldLabSet<TGrid>;
+    /** @brief Stencil type */
+    using StencilType = typename LabSetType::StencilType;
+    /** @brief Index range type */
+    using IndexRangeType = typename LabSetType::IndexRangeType;
+
+    LabPool() = default;
+    LabPool(const LabPool &c) = delete;
+    LabPool(LabPool &&c) = delete;
+    LabPool &operator=(const LabPool &c) = delete;
+    LabPool &operator=(LabPool &&c) = delete;
+
+    /**
+     * @brief Get thread local lab sets for a stencil
+     * @param s Stencil
+     * @param max_request_range Maximum index range to be processed in the lab
+     * @param nthreads Number of threads
+     * @return Vector of lab sets, one for each thread
+     *
+     * @rst
+     * Must be called outside of a parallel region.
+     * @endrst
+     */
+    std::vector<std::unique_ptr<LabSetType>> &
+    getLabs(const StencilType &s,
+            const IndexRangeType &max_request_range,
+            const size_t nthreads)
+    {
+        Entry *entry = nullptr;
+        for (auto &e : entries_) {
+            if (e.stencil == s) {
+                entry = &e;
+                break;
+            }
+        }
+        if (!entry) {
+            entries_.push_back(Entry{s, max_request_range, {}});
+            entry = &entries_.back();
+        }
+        if (entry->range != max_request_range) {
+            // different block extent, all labs must be checked
+            entry->range = max_request_range;
+            for (auto &labs : entry->labs) {
+                labs->allocate(s, max_request_range);
+            }
+        }
+        while (entry->labs.size() < nthreads) {
+            entry->labs.emplace_back(new LabSetType());
+            entry->labs.back()->allocate(s, max_request_range);
+        }
+        return entry->labs;
+    }
+
+    /**
+     * @brief Release all labs in the pool
+     */
+    void clear() { entries_.clear(); }
+
+private:
+    struct Entry {
+        StencilType stencil;
+        IndexRangeType range;
+        std::vector<std::unique_ptr<LabSetType>> labs;
+    };
+
+    std::vector<Entry> entries_;
+};
+
+/**
+ * @brief Common block processing utilities
+ * @tparam TGrid Grid type
+ */
+template <typename TGrid>
+struct BlockProcessorBase {
+    using BaseType = typename TGrid::BaseType;
+    using LabSetType = FieldLabSet<TGrid>;
+    using StencilType = typename LabSetType::StencilType;
+    using IndexRangeType = typename LabSetType::IndexRangeType;
+    using BCVector = typename LabSetType::BCVector;
+
+    /**
+     * @brief Maximum block index range of a grid
+     * @param grid Grid
+     * @return Index range for lab allocation
+     *
+     * @rst
+     * Field labs account for blocks that are one element larger than the
+     * number of block cells (e.g. node fields), see ``FieldLab::allocate()``.
+     * @endrst
+     */
+    static IndexRangeType getMaxRange(const TGrid &grid)
+    {
+        return IndexRangeType(grid.getBlockCells());
+    }
+
+    /**
+     * @brief Number of threads used for processing
+     * @return Maximum number of threads of a parallel region
+     */
+    static size_t getNumThreads()
+    {
+#ifdef _OPENMP
+        return static_cast<size_t>(omp_get_max_threads());
+#else
+        return 1;
+#endif /* _OPENMP */
+    }
+
+    /**
+     * @brief Process a list of blocks in parallel
+     * @tparam Loader Type that implements ``loadLab(field, lab, c, d)``
+     * @tparam Blocks Random access container of block field pointers
+     * @tparam Kernel Kernel type
+     * @tparam BCs ``BCVector`` or ``std::nullptr_t``
+     * @param loader Lab loader
+     * @param blocks Blocks to be processed
+     * @param labs Thread local lab sets
+     * @param kernel Kernel with signature ``void(LabSetType &, BaseType &)``
+     * @param bcs Boundary conditions or ``nullptr`` for the boundary
+     *            conditions of the block fields
+     * @param static_schedule Distribute the blocks with an OpenMP static
+     *                        schedule instead of a dynamic schedule
+     *
+     * @rst
+     * Blocks with a fully solid cell mask are skipped, see
+     * ``Cartesian::allocateMasks()``.  With boundary conditions ``bcs`` the
+     * loader must also implement ``loadLab(field, lab, bcs, c, d)``.
+     * @endrst
+     */
+    template <typename Loader, typename Blocks, typename Kernel, typename BCs>
+    static void processBlocks(Loader &loader,
+                              Blocks &blocks,
+                              std::vector<std::unique_ptr<LabSetType>> &labs,
+                              Kernel &kernel,
+                              const BCs &bcs,
+                              const bool static_schedule = false)
+    {
+        const size_t nblocks = blocks.size();
+#pragma omp parallel
+        {
+#ifdef _OPENMP
+            LabSetType &tlabs = *labs[omp_get_thread_num()];
+#else
+            LabSetType &tlabs = *labs[0];
+#endif /* _OPENMP */
+            auto processBlock = [&](const size_t i) {
+                BaseType &bf = getBlock_(blocks, i);
+                if (isSolid_(bf)) {
+                    return;
+                }
+                for (size_t j = 0; j < LabSetType::NScalars; ++j) {
+                    loadLab_(loader,
+                             bf,
+                             tlabs[j],
+                             j % TGrid::NComponents,
+                             j / TGrid::NComponents,
+                             bcs);
+                }
+                kernel(tlabs, bf);
+            };
+            if (static_schedule) {
+#pragma omp for schedule(static)
+                for (size_t i = 0; i < nblocks; ++i) {
+                    processBlock(i);
+                }
+            } else {
+#pragma omp for schedule(dynamic, 1)
+                for (size_t i = 0; i < nblocks; ++i) {
+                    processBlock(i);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Test for a static first-touch placement of the grid memory
+     * @param grid Grid
+     * @return True if the blocks of ``grid`` were touched with a static
+     *         partition, see ``FirstTouch::Static``
+     */
+    template <typename G>
+    static bool isStaticTouch(const G &grid)
+    {
+        return isStaticTouch_(grid, 0);
+    }
+
+private:
+    template <typename Loader>
+    static void loadLab_(Loader &loader,
+                         BaseType &bf,
+                         typename LabSetType::FieldLabType &lab,
+                         const size_t c,
+                         const size_t d,
+                         std::nullptr_t)
+    {
+        loader.loadLab(bf, lab, c, d);
+    }
+
+    template <typename Loader>
+    static void loadLab_(Loader &loader,
+                         BaseType &bf,
+                         typename LabSetType::FieldLabType &lab,
+                         const size_t c,
+                         const size_t d,
+                         const BCVector &bcs)
+    {
+        loader.loadLab(bf, lab, bcs, c, d);
+    }
+
+    static BaseType &getBlock_(TGrid &grid, const size_t i) { return grid[i]; }
+
+    template <typename G>
+    static auto isStaticTouch_(const G &grid, int)
+        -> decltype(grid.getFirstTouch(), bool())
+    {
+        using Touch = decltype(grid.getFirstTouch());
+        return (Touch::Static == grid.getFirstTouch());
+    }
+
+    template <typename G>
+    static bool isStaticTouch_(const G &, long)
+    {
+        return false;
+    }
+
+    static bool isSolid_(const BaseType &bf)
+    {
+        const auto *mask = bf.getState().mask;
+        return (mask != nullptr &&
+                Block::MaskState::Solid == mask->getState());
+    }
+
+    static BaseType &getBlock_(const std::vector<BaseType *> &blocks,
+                               const size_t i)
+    {
+        return *blocks[i];
+    }
+};
+
+/**
+ * @brief Block processor
+ * @tparam TGrid Grid type
+ *
+ * @rst
+ * Implements the block processing for ``Grid::process()`` and
+ * ``Grid::processActive()``.  Grid types that require a different processing
+ * strategy (e.g. distributed grids) specialize this class.
+ * @endrst
+ */
+template <typename TGrid>
+struct BlockProcessor : public BlockProcessorBase<TGrid> {
+    using Base = BlockProcessorBase<TGrid>;
+    using typename Base::BaseType;
+    using typename Base::StencilType;
+
+    template <typename Kernel, typename BCs>
+    static void run(TGrid &grid,
+                    const StencilType &s,
+                    Kernel &kernel,
+                    LabPool<TGrid> &pool,
+                    const BCs &bcs)
+    {
+        auto &labs =
+            pool.getLabs(s, Base::getMaxRange(grid), Base::getNumThreads());
+        Base::processBlocks(
+            grid, grid, labs, kernel, bcs, Base::isStaticTouch(grid));
+    }
+
+    template <typename Kernel, typename BCs>
+    static void runActive(TGrid &grid,
+                          const StencilType &s,
+                          Kernel &kernel,
+                          LabPool<TGrid> &pool,
+                          const BCs &bcs)
+    {
+        auto &labs =
+            pool.getLabs(s, Base::getMaxRange(grid), Base::getNumThreads());
+        std::vector<BaseType *> blocks = grid.getActiveBlocks();
+        Base::processBlocks(grid, blocks, labs, kernel, bcs);
+    }
+};
+
+/**
+ * @brief Thread-parallel block processing
+ * @tparam TGrid Grid type
+ * @tparam Kernel Kernel type
+ * @param grid Grid to be processed
+ * @param s Stencil
+ * @param kernel Kernel applied to each block
+ * @param pool Pool of thread local field labs
+ *
+ * @rst
+ * Loads the field labs for all scalar components of each block in ``grid``
+ * and applies ``kernel`` to it.  The kernel signature is
+ *
+ * .. code-block:: cpp
+ *
+ *    void kernel(Grid::FieldLabSet<TGrid> &labs, TGrid::BaseType &field);
+ *
+ * Blocks are distributed dynamically among the OpenMP threads, each thread
+ * uses its own set of labs from ``pool``.  Grids constructed with
+ * ``FirstTouch::Static`` are processed with a static schedule instead, such
+ * that each thread processes the blocks it has touched.  The kernel is
+ * called concurrently and must only write to data associated with
+ * ``field``.  For the :ref:`cartesianmpi` grid, the halo exchange is
+ * overlapped with the processing of the inner blocks.  The labs in ``pool``
+ * are reused by subsequent calls with the same stencil, a pool must not be
+ * used by concurrent or nested calls.
+ *
+ * If the grid carries cell masks, fully solid blocks are neither loaded nor
+ * passed to ``kernel``.  For mixed blocks the kernel obtains the mask with
+ * ``field.getState().mask`` and must handle solid cells itself.
+ * @endrst
+ */
+template <typename TGrid, typename Kernel>
+void process(TGrid &grid,
+             const typename FieldLabSet<TGrid>::StencilType &s,
+             Kernel &&kernel,
+             LabPool<TGrid> &pool)
+{
+    BlockProcessor<TGrid>::run(grid, s, kernel, pool, nullptr);
+}
+
+/**
+ * @brief Thread-parallel block processing
+ * @tparam TGrid Grid type
+ * @tparam Kernel Kernel type
+ * @param grid Grid to be processed
+ * @param s Stencil
+ * @param kernel Kernel applied to each block
+ *
+ * @rst
+ * Same as above with labs that are allocated for this call only.  Every call
+ * allocates and releases one ``FieldLabSet`` per OpenMP thread, which adds
+ * to the cost of each step when called repeatedly.  Pass a ``LabPool`` that
+ * outlives the time loop to reuse the labs instead:
+ *
+ * .. code-block:: cpp
+ *
+ *    Grid::LabPool<GridType> pool;
+ *    for (int step = 0; step < nsteps; ++step) {
+ *        Grid::process(grid, s, kernel, pool);
+ *    }
+ * @endrst
+ */
+template <typename TGrid, typename Kernel>
+void process(TGrid &grid,
+             const typename FieldLabSet<TGrid>::StencilType &s,
+             Kernel &&kernel)
+{
+    LabPool<TGrid> pool;
+    BlockProcessor<TGrid>::run(grid, s, kernel, pool, nullptr);
+}
+
+/**
+ * @brief Thread-parallel block processing with boundary conditions
+ * @tparam TGrid Grid type
+ * @tparam Kernel Kernel type
+ * @param grid Grid to be processed
+ * @param s Stencil
+ * @param kernel Kernel applied to each block
+ * @param boundaries Vector of boundary conditions
+ * @param pool Pool of thread local field labs
+ *
+ * @rst
+ * Same as ``Grid::process()`` above but the boundary conditions in
+ * ``boundaries`` are applied to the labs of all scalar components instead of
+ * the boundary conditions of the block fields.  A boundary condition is only
+ * applied to blocks adjacent to the domain boundary at its side.
+ * @endrst
+ */
+template <typename TGrid, typename Kernel>
+void process(TGrid &grid,
+             const typename FieldLabSet<TGrid>::StencilType &s,
+             Kernel &&kernel,
+             const typename FieldLabSet<TGrid>::BCVector &boundaries,
+             LabPool<TGrid> &pool)
+{
+    BlockProcessor<TGrid>::run(grid, s, kernel, pool, boundaries);
+}
+
+/**
+ * @brief Thread-parallel block processing with boundary conditions
+ * @tparam TGrid Grid type
+ * @tparam Kernel Kernel type
+ * @param grid Grid to be processed
+ * @param s Stencil
+ * @param kernel Kernel applied to each block
+ * @param boundaries Vector of boundary conditions
+ *
+ * @rst
+ * Same as above with labs that are allocated for this call only.  Use the
+ * overload with a ``LabPool`` to avoid the lab allocation in repeated calls.
+ * @endrst
+ */
+template <typename TGrid, typename Kernel>
+void process(TGrid &grid,
+             const typename FieldLabSet<TGrid>::StencilType &s,
+             Kernel &&kernel,
+             const typename FieldLabSet<TGrid>::BCVector &boundaries)
+{
+    LabPool<TGrid> pool;
+    BlockProcessor<TGrid>::run(grid, s, kernel, pool, boundaries);
+}
+
+/**
+ * @brief Thread-parallel processing of active blocks
+ * @tparam TGrid Grid type
+ * @tparam Kernel Kernel type
+ * @param grid Grid to be processed
+ * @param s Stencil
+ * @param kernel Kernel applied to each active block
+ * @param pool Pool of thread local field labs
+ *
+ * @rst
+ * Same as ``Grid::process()`` for the active blocks of ``grid`` only (see
+ * ``Cartesian::activate()``).  Labs of active blocks are loaded from their
+ * stencil neighbors irrespective of whether the neighbors are active.  The
+ * cost of the pass is proportional to the number of active blocks.  The
+ * kernel may activate blocks concurrently, newly activated blocks are
+ * processed in the next pass.
+ *
+ * For the :ref:`cartesianmpi` grid the halo exchange of the stencil is
+ * carried out as for ``Grid::process()``.
+ * @endrst
+ */
+template <typename TGrid, typename Kernel>
+void processActive(TGrid &grid,
+                   const typename FieldLabSet<TGrid>::StencilType &s,
+                   Kernel &&kernel,
+                   LabPool<TGrid> &pool)
+{
+    BlockProcessor<TGrid>::runActive(grid, s, kernel, pool, nullptr);
+}
+
+/**
+ * @brief Thread-parallel processing of active blocks
+ * @tparam TGrid Grid type
+ * @tparam Kernel Kernel type
+ * @param grid Grid to be processed
+ * @param s Stencil
+ * @param kernel Kernel applied to each active block
+ *
+ * @rst
+ * Same as above with labs that are allocated for this call only.  Use the
+ * overload with a ``LabPool`` to avoid the lab allocation in repeated calls.
+ * @endrst
+ */
+template <typename TGrid, typename Kernel>
+void processActive(TGrid &grid,
+                   const typename FieldLabSet<TGrid>::StencilType &s,
+                   Kernel &&kernel)
+{
+    LabPool<TGrid> pool;
+    BlockProcessor<TGrid>::runActive(grid, s, kernel, pool, nullptr);
+}
+
+/**
+ * @brief Thread-parallel processing of active blocks with boundary conditions
+ * @tparam TGrid Grid type
+ * @tparam Kernel Kernel type
+ * @param grid Grid to be processed
+ * @param s Stencil
+ * @param kernel Kernel applied to each active block
+ * @param boundaries Vector of boundary conditions
+ * @param pool Pool of thread local field labs
+ *
+ * @rst
+ * See ``Grid::process()`` with boundary conditions.
+ * @endrst
+ */
+template <typename TGrid, typename Kernel>
+void processActive(TGrid &grid,
+                   const typename FieldLabSet<TGrid>::StencilType &s,
+                   Kernel &&kernel,
+                   const typename FieldLabSet<TGrid>::BCVector &boundaries,
+                   LabPool<TGrid> &pool)
+{
+    BlockProcessor<TGrid>::runActive(grid, s, kernel, pool, boundaries);
+}
+
+/**
+ * @brief Thread-parallel processing of active blocks with boundary conditions
+ * @tparam TGrid Grid type
+ * @tparam Kernel Kernel type
+ * @param grid Grid to be processed
+ * @param s Stencil
+ * @param kernel Kernel applied to each active block
+ * @param boundaries Vector of boundary conditions
+ *
+ * @rst
+ * Same as above with labs that are allocated for this call only.  Use the
+ * overload with a ``LabPool`` to avoid the lab allocation in repeated calls.
+ * @endrst
+ */
+template <typename TGrid, typename Kernel>
+void processActive(TGrid &grid,
+                   const typename FieldLabSet<TGrid>::StencilType &s,
+                   Kernel &&kernel,
+                   const typename FieldLabSet<TGrid>::BCVector &boundaries)
+{
+    LabPool<TGrid> pool;
+    BlockProcessor<TGrid>::runActive(grid, s, kernel, pool, boundaries);
+}
+
+NAMESPACE_END(Grid)
+NAMESPACE_END(Cubism)
+
+#endif /* PROCESS_H_R2MXW7NB */
@@ -0,0 +1,117 @@
+// File       : Reduction.h
+// Created    : Fri Oct 16 2026 09:12:40 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Reduction operations for grid data
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef REDUCTION_H_R4TQ8XNB
+#define REDUCTION_H_R4TQ8XNB
+
+#include "Cubism/Common.h"
+#include <cstddef>
+#include <limits>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Grid)
+
+/**
+ * @brief Reduction operation
+ *
+ * @rst
+ * Sum
+ *    Sum of all values.
+ *
+ * Min
+ *    Minimum value.  NaN values propagate into the result.
+ *
+ * Max
+ *    Maximum value.  NaN values propagate into the result.
+ * @endrst
+ */
+enum class ReduceOp { Sum = 0, Min, Max };
+
+/**
+ * @brief Sum reduction
+ * @tparam T Data type
+ */
+template <typename T>
+struct ReduceSum {
+    static T identity() { return static_cast<T>(0); }
+    static T combine(const T a, const T b) { return a + b; }
+};
+
+/**
+ * @brief NaN-aware minimum reduction
+ * @tparam T Data type
+ *
+ * @rst
+ * Unlike ``std::min``, the result is NaN if any of the operands is NaN,
+ * independent of the order of evaluation.
+ * @endrst
+ */
+template <typename T>
+struct ReduceMin {
+    static T identity()
+    {
+        return std::numeric_limits<T>::has_infinity
+                   ? std::numeric_limits<T>::infinity()
+                   : std::numeric_limits<T>::max();
+    }
+    static T combine(const T a, const T b)
+    {
+        return (b < a || b != b) ? b : a;
+    }
+};
+
+/**
+ * @brief NaN-aware maximum reduction
+ * @tparam T Data type
+ *
+ * @rst
+ * Unlike ``std::max``, the result is NaN if any of the operands is NaN,
+ * independent of the order of evaluation.
+ * @endrst
+ */
+template <typename T>
+struct ReduceMax {
+    static T identity()
+    {
+        return std::numeric_limits<T>::has_infinity
+                   ? -std::numeric_limits<T>::infinity()
+                   : std::numeric_limits<T>::lowest();
+    }
+    static T combine(const T a, const T b)
+    {
+        return (b > a || b != b) ? b : a;
+    }
+};
+
+/**
+ * @brief Pairwise reduction of an array
+ * @tparam Op Reduction type
+ * @tparam T Data type
+ * @param v Pointer to first element
+ * @param n Number of elements
+ * @return Reduced value
+ *
+ * @rst
+ * The order of evaluation depends on ``n`` only, the result is therefore
+ * deterministic.  The rounding error of sums grows with :math:`O(\log n)`.
+ * @endrst
+ */
+template <typename Op, typename T>
+T reducePairwise(const T *v, const size_t n)
+{
+    if (0 == n) {
+        return Op::identity();
+    } else if (1 == n) {
+        return v[0];
+    }
+    const size_t h = n / 2;
+    return Op::combine(reducePairwise<Op>(v, h),
+                       reducePairwise<Op>(v + h, n - h));
+}
+
+NAMESPACE_END(Grid)
+NAMESPACE_END(Cubism)
+
+#endif /* REDUCTION_H_R4TQ8XNB */
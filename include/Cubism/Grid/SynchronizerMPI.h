@@ -0,0 +1,1064 @@
+// File       : SynchronizerMPI.h
+// Created    : Thu Oct 15 2026 09:41:27 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Halo synchronizer for Cartesian MPI grids
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+#ifndef SYNCHRONIZERMPI_H_T8QZ3KMW
+#define SYNCHRONIZERMPI_H_T8QZ3KMW
+
+#include "Cubism/Alloc/AlignedBlockAllocator.h"
+#include "Cubism/Block/FieldLab.h"
+#include "Cubism/Block/FieldLabLoader.h"
+#include "Cubism/Block/FieldViewLab.h"
+#include "Cubism/Block/TensorFieldLab.h"
+#include "Cubism/Common.h"
+#include "Cubism/Core/Index.h"
+#include "Cubism/Core/Stencil.h"
+#include "Cubism/Core/Vector.h"
+#include "Cubism/Grid/NeighborTable.h"
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <mpi.h>
+#include <stdexcept>
+#include <vector>
+
+NAMESPACE_BEGIN(Cubism)
+NAMESPACE_BEGIN(Grid)
+
+/**
+ * @ingroup MPI
+ * @brief Halo synchronizer for Cartesian MPI grids
+ * @tparam TGrid Cartesian MPI grid type
+ *
+ * @rst
+ * Exchanges the block halos required by a stencil with the neighboring ranks
+ * of a :ref:`cartesianmpi` grid.  Messages are exchanged with persistent
+ * non-blocking point-to-point communication with up to :math:`3^D - 1`
+ * neighbor ranks.  For a non-tensorial stencil only the faces of the rank
+ * local block topology are exchanged, edges and corners are exchanged in
+ * addition for a tensorial stencil.  The persistent requests as well as the
+ * aligned message buffers are set up once during construction, a halo
+ * exchange merely starts and completes the requests.  Use
+ * ``CartesianMPI::getSynchronizer()`` to obtain a synchronizer that is cached
+ * for each stencil of the grid.
+ *
+ * Received halos are stored in thin ghost block fields that point into the
+ * receive buffers.  The ghost fields are accessed through the index functor
+ * returned by ``getIndexFunctor()`` such that a ``Block::FieldLab`` loads its
+ * ghost cells directly from the receive buffers.  Ghosts on the rank
+ * boundary are valid after a call to ``wait()``:
+ *
+ * .. code-block:: cpp
+ *
+ *    Grid::SynchronizerMPI<Grid> sync(grid, Core::Stencil<3>(-1, 2));
+ *    sync.start();  // post receives and send packed halos
+ *    // ... overlap with work independent of halos
+ *    sync.wait();   // complete communication
+ *    for (auto f : grid) {
+ *        sync.loadLab(*f, lab);
+ *        // ... process lab
+ *    }
+ *
+ * Communication and computation can be overlapped by processing the inner
+ * blocks of the grid first and the halo blocks in the order their messages
+ * complete:
+ *
+ * .. code-block:: cpp
+ *
+ *    auto kernel = [&](Grid::BaseType &f) {
+ *        sync.loadLab(f, lab);
+ *        // ... process lab
+ *    };
+ *    sync.processInner(kernel); // start exchange and process inner blocks
+ *    sync.processHalo(kernel);  // process halo blocks as messages complete
+ * @endrst
+ */
+template <typename TGrid>
+class SynchronizerMPI
+{
+public:
+    /** @brief Cartesian MPI grid type */
+    using GridType = TGrid;
+    /** @brief Block (scalar, tensor, face) field type of grid */
+    using BaseType = typename GridType::BaseType;
+    /** @brief Scalar field type */
+    using FieldType = typename BaseType::FieldType;
+    /** @brief Field state type */
+    using FieldState = typename GridType::FieldState;
+    /** @brief Container type for block fields of grid */
+    using FieldContainer = typename GridType::FieldContainer;
+    /** @brief Data type of carried fields */
+    using DataType = typename GridType::DataType;
+    /** @brief Index range type */
+    using IndexRangeType = typename GridType::IndexRangeType;
+    /** @brief Multi-dimensional index type */
+    using MultiIndex = typename GridType::MultiIndex;
+    /** @brief Stencil type */
+    using StencilType = Core::Stencil<GridType::Dim>;
+    /** @brief Field lab type */
+    using FieldLabType = Block::FieldLab<FieldType>;
+    /** @brief Table of direct block neighbors */
+    using NeighborTableType = typename GridType::NeighborTableType;
+    /** @brief Block field access through the neighbor table */
+    using NeighborIndexFunctor = typename GridType::NeighborIndexFunctor;
+
+    /** @brief Grid dimension */
+    static constexpr size_t Dim = GridType::Dim;
+    /** @brief Number of scalar fields per block */
+    static constexpr size_t NScalars =
+        GridType::NComponents *
+        ((GridType::EntityType == Cubism::EntityType::Face) ? Dim : 1);
+
+private:
+    using ScalarMap =
+        Block::ScalarFieldMap<FieldContainer, BaseType::Class, GridType::Rank>;
+    using PeriodicFunctor =
+        Block::PeriodicIndexFunctor<FieldContainer,
+                                    BaseType::Class,
+                                    GridType::Rank>;
+
+public:
+    /**
+     * @brief Periodic block field access by index including remote ghosts
+     *
+     * @rst
+     * Returns the rank local block field for a local block index, the ghost
+     * block field for a block index in the halo shell of the rank or a
+     * periodic rank local block field otherwise.  The latter case applies to
+     * neighbors not required by the stencil which are never accessed by the
+     * lab loader.
+     * @endrst
+     */
+    class IndexFunctor
+    {
+    public:
+        IndexFunctor(FieldContainer &fields,
+                     const IndexRangeType &local,
+                     const IndexRangeType &shell,
+                     const FieldType *const *ghosts,
+                     const size_t *map,
+                     const size_t comp = 0,
+                     const size_t fdir = 0)
+            : fields_(fields), periodic_(fields, local, comp, fdir, map),
+              local_(local), shell_(shell), ghosts_(ghosts), map_(map),
+              comp_(comp), face_dir_(fdir)
+        {
+        }
+
+        FieldType &operator()(const MultiIndex &p)
+        {
+            return const_cast<FieldType &>(get_(p));
+        }
+
+        const FieldType &operator()(const MultiIndex &p) const
+        {
+            return get_(p);
+        }
+
+    private:
+        ScalarMap fields_;
+        PeriodicFunctor periodic_;
+        const IndexRangeType local_;
+        const IndexRangeType shell_;
+        const FieldType *const *ghosts_;
+        const size_t *map_;     // block index to field index
+        const size_t comp_;     // component
+        const size_t face_dir_; // face direction
+
+        const FieldType &get_(const MultiIndex &p) const
+        {
+            if (local_.isIndex(p)) {
+                return fields_(map_[local_.getFlatIndex(p)], comp_, face_dir_);
+            }
+            if (shell_.isGlobalIndex(p)) {
+                const FieldType *g = ghosts_[shell_.getFlatIndexFromGlobal(p)];
+                if (g) {
+                    return *g;
+                }
+            }
+            return periodic_(p);
+        }
+    };
+
+    /**
+     * @brief Main constructor
+     * @param grid Cartesian MPI grid
+     * @param s Stencil that defines the halo width
+     *
+     * @rst
+     * The stencil width must not exceed the number of cells in a block.
+     * Communication buffers, persistent requests and ghost fields are
+     * allocated once during construction.
+     * @endrst
+     */
+    SynchronizerMPI(GridType &grid, const StencilType &s)
+        : grid_(grid), stencil_(s), comm_(grid.getCartComm()),
+          local_range_(grid.getSize()),
+          shell_range_(MultiIndex(-1), grid.getSize() + 1), is_active_(false),
+          is_synced_(false), remaining_(0)
+    {
+        const MultiIndex block_cells = grid_.getBlockCells();
+        ghost_lo_ = -stencil_.getBegin();
+        ghost_hi_ = stencil_.getEnd() - 1;
+        if (!(ghost_lo_ <= block_cells && ghost_hi_ <= block_cells)) {
+            throw std::runtime_error(
+                "SynchronizerMPI: stencil width exceeds block cells");
+        }
+        init_(block_cells);
+        buildNeighbors_();
+    }
+
+    /** @brief Default constructor */
+    SynchronizerMPI() = delete;
+    /** @brief Deleted copy constructor */
+    SynchronizerMPI(const SynchronizerMPI &c) = delete;
+    /** @brief Deleted move constructor */
+    SynchronizerMPI(SynchronizerMPI &&c) = delete;
+    /** @brief Deleted copy assignment */
+    SynchronizerMPI &operator=(const SynchronizerMPI &c) = delete;
+    /** @brief Deleted move assignment */
+    SynchronizerMPI &operator=(SynchronizerMPI &&c) = delete;
+
+    ~SynchronizerMPI()
+    {
+        // the owning grid may be destroyed after MPI_Finalize(), in which case
+        // the persistent requests have been released by MPI already
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (!finalized) {
+            if (is_active_) {
+                wait();
+            }
+            for (auto &r : recv_requests_) {
+                MPI_Request_free(&r);
+            }
+            for (auto &r : send_requests_) {
+                MPI_Request_free(&r);
+            }
+        }
+        for (auto g : ghost_blocks_) {
+            delete g;
+        }
+        for (auto g : ghost_fields_) {
+            delete g;
+        }
+        for (auto &m : recv_msgs_) {
+            buf_alloc_.deallocate(m.buffer);
+        }
+        for (auto &m : send_msgs_) {
+            buf_alloc_.deallocate(m.buffer);
+        }
+    }
+
+    /**
+     * @brief Start halo exchange
+     *
+     * @rst
+     * Starts the persistent receives for all neighbors, packs the send
+     * buffers and starts the persistent sends.  The call returns immediately
+     * after that.  The halos of a previous exchange are invalid from here on
+     * until ``wait()`` returns.
+     * @endrst
+     */
+    void start()
+    {
+        if (is_active_) {
+            throw std::runtime_error(
+                "SynchronizerMPI: exchange is already in progress");
+        }
+        if (!recv_requests_.empty()) {
+            MPI_Startall(static_cast<int>(recv_requests_.size()),
+                         recv_requests_.data());
+        }
+        is_synced_ = false;
+        pending_ = halo_deps_;
+        remaining_ = recv_requests_.size();
+        for (auto &m : send_msgs_) {
+            pack_(m);
+        }
+        if (!send_requests_.empty()) {
+            MPI_Startall(static_cast<int>(send_requests_.size()),
+                         send_requests_.data());
+        }
+        is_active_ = true;
+    }
+
+    /**
+     * @brief Wait for completion of the halo exchange
+     */
+    void wait()
+    {
+        if (!is_active_) {
+            return;
+        }
+        MPI_Waitall(static_cast<int>(recv_requests_.size()),
+                    recv_requests_.data(),
+                    MPI_STATUSES_IGNORE);
+        MPI_Waitall(static_cast<int>(send_requests_.size()),
+                    send_requests_.data(),
+                    MPI_STATUSES_IGNORE);
+        remaining_ = 0;
+        is_active_ = false;
+        is_synced_ = true;
+    }
+
+    /**
+     * @brief Blocking halo exchange
+     */
+    void sync()
+    {
+        start();
+        wait();
+    }
+
+    /**
+     * @brief Process inner blocks while halos are exchanged
+     * @tparam Kernel Kernel type with signature ``void(BaseType &)``
+     * @param kernel Kernel applied to each inner block
+     *
+     * @rst
+     * Starts the halo exchange and applies ``kernel`` to all inner blocks.
+     * The exchange is still active when this method returns, call
+     * ``processHalo()`` or ``wait()`` to complete it.
+     * @endrst
+     */
+    template <typename Kernel>
+    void processInner(Kernel &&kernel)
+    {
+        start();
+        for (auto f : inner_blocks_) {
+            kernel(*f);
+        }
+    }
+
+    /**
+     * @brief Process halo blocks in message completion order
+     * @tparam Kernel Kernel type with signature ``void(BaseType &)``
+     * @param kernel Kernel applied to each halo block
+     *
+     * @rst
+     * Waits for incoming messages as they complete and applies ``kernel`` to a
+     * halo block as soon as all messages it depends on have arrived.  The
+     * exchange must have been started with ``start()`` or ``processInner()``
+     * and is completed when this method returns.
+     * @endrst
+     */
+    template <typename Kernel>
+    void processHalo(Kernel &&kernel)
+    {
+        if (!is_active_) {
+            throw std::runtime_error(
+                "SynchronizerMPI: exchange has not been started");
+        }
+        std::vector<BaseType *> ready;
+        while (waitHalo(ready)) {
+            for (auto f : ready) {
+                kernel(*f);
+            }
+        }
+    }
+
+    /**
+     * @brief Wait for some messages and collect the halo blocks that are ready
+     * @param ready Halo blocks whose messages have all arrived (output)
+     * @return False if all messages have been received before this call
+     *
+     * @rst
+     * Low-level building block for ``processHalo()``.  Blocks until at least
+     * one pending message completes and returns the halo blocks that became
+     * ready to be processed.  The exchange is completed when ``false`` is
+     * returned.  Useful for processing ``ready`` blocks concurrently:
+     *
+     * .. code-block:: cpp
+     *
+     *    std::vector<Grid::BaseType *> ready;
+     *    while (sync.waitHalo(ready)) {
+     *        #pragma omp parallel for
+     *        for (size_t i = 0; i < ready.size(); ++i) {
+     *            // ... process *ready[i]
+     *        }
+     *    }
+     * @endrst
+     */
+    bool waitHalo(std::vector<BaseType *> &ready)
+    {
+        ready.clear();
+        if (!is_active_) {
+            return false;
+        }
+        if (0 == remaining_) {
+            wait();
+            return false;
+        }
+        int count;
+        MPI_Waitsome(static_cast<int>(recv_requests_.size()),
+                     recv_requests_.data(),
+                     &count,
+                     done_.data(),
+                     MPI_STATUSES_IGNORE);
+        assert(count != MPI_UNDEFINED);
+        for (int i = 0; i < count; ++i) {
+            for (const size_t hb : msg_blocks_[done_[i]]) {
+                if (0 == --pending_[hb]) {
+                    ready.push_back(halo_blocks_[hb]);
+                }
+            }
+        }
+        remaining_ -= static_cast<size_t>(count);
+        return true;
+    }
+
+    /**
+     * @brief Get inner blocks
+     * @return Block fields whose stencil footprint is rank local
+     */
+    const std::vector<BaseType *> &getInnerBlocks() const
+    {
+        return inner_blocks_;
+    }
+
+    /**
+     * @brief Get halo blocks
+     * @return Block fields that depend on ghosts from neighbor ranks
+     */
+    const std::vector<BaseType *> &getHaloBlocks() const
+    {
+        return halo_blocks_;
+    }
+
+    /**
+     * @brief Test for pending communication
+     * @return True if the exchange has been started but not completed
+     */
+    bool isActive() const { return is_active_; }
+
+    /**
+     * @brief Test for valid halos
+     * @return True if the last exchange has completed
+     *
+     * @rst
+     * Only the state of the exchange is tracked.  Modifications of the grid
+     * data after the exchange are not detected, the halos must be exchanged
+     * again before loading labs from modified data.
+     * @endrst
+     */
+    bool isSynchronized() const { return is_synced_ && !is_active_; }
+
+    /**
+     * @brief Get synchronized stencil
+     * @return Stencil used to determine the halo width
+     */
+    const StencilType &getStencil() const { return stencil_; }
+
+    /**
+     * @brief Get field access functor
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @param c Component index
+     * @param d Face direction
+     * @return Field access functor including remote ghost fields
+     */
+    template <typename Comp = size_t, typename Dir = size_t>
+    IndexFunctor getIndexFunctor(const Comp c = 0, const Dir d = 0)
+    {
+        const size_t sc = scalarIndex_(static_cast<size_t>(c),
+                                       static_cast<size_t>(d));
+        return IndexFunctor(grid_.getFields(),
+                            local_range_,
+                            shell_range_,
+                            ghosts_.data() + sc * shell_range_.size(),
+                            grid_.getBlockMap().data(),
+                            static_cast<size_t>(c),
+                            static_cast<size_t>(d));
+    }
+
+    /**
+     * @brief Get the neighbor table
+     * @return ``const`` reference to the table of direct block neighbors
+     *
+     * @rst
+     * Rows are stored in the order of the block fields in the grid.  Neighbors
+     * in the halo shell of the rank refer to remote ghost slots.
+     * @endrst
+     */
+    const NeighborTableType &getNeighborTable() const { return neighbors_; }
+
+    /**
+     * @brief Get neighbor field access functor
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @param field Block field contained in the synchronized grid
+     * @param c Component index
+     * @param d Face direction
+     * @return Field access functor for the direct neighbors of ``field``
+     *         including remote ghosts
+     */
+    template <typename Comp = size_t, typename Dir = size_t>
+    NeighborIndexFunctor
+    getNeighborFunctor(const BaseType &field, const Comp c = 0, const Dir d = 0)
+    {
+        const MultiIndex &bi = field.getState().block_index;
+        const size_t k = grid_.getBlockMap()[local_range_.getFlatIndex(bi)];
+        assert(&grid_[k] == &field);
+        const size_t sc = scalarIndex_(static_cast<size_t>(c),
+                                       static_cast<size_t>(d));
+        return NeighborIndexFunctor(grid_.getFields(),
+                                    neighbors_.getRow(k),
+                                    bi,
+                                    ghosts_.data() + sc * shell_range_.size(),
+                                    static_cast<size_t>(c),
+                                    static_cast<size_t>(d));
+    }
+
+    /**
+     * @brief Field lab loader utility to load data from ``field`` into ``lab``
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @tparam TCompute Data type of the lab
+     * @param field Source field data to be loaded
+     * @param lab Laboratory where data is loaded into
+     * @param c Component index
+     * @param d Face direction
+     *
+     * @rst
+     * The ``field`` must be contained in the synchronized grid and the active
+     * stencil of ``lab`` must be contained in the synchronized stencil.  Halos
+     * received from neighbor ranks are only valid after ``wait()``.
+     * @endrst
+     */
+    template <typename Comp = size_t, typename Dir = size_t, typename TCompute>
+    void loadLab(const BaseType &field,
+                 Block::FieldLab<FieldType, TCompute> &lab,
+                 const Comp c = 0,
+                 const Dir d = 0)
+    {
+        // The `lab` must be allocated
+        assert(lab.isAllocated());
+        // The allocated `lab` must be large enough to process `field`
+        assert(field.getIndexRange(static_cast<size_t>(d)).getExtent() <=
+               lab.getMaximumRange().getExtent());
+        // The lab stencil must be covered by the exchanged halos
+        assert(stencil_.getBegin() <= lab.getActiveStencil().getBegin());
+        assert(lab.getActiveStencil().getEnd() <= stencil_.getEnd());
+        const auto &bi = field.getState().block_index;
+        auto idx_functor = this->getNeighborFunctor(field, c, d);
+        lab.loadData(bi, idx_functor);
+    }
+
+    /**
+     * @brief Field lab loader utility with boundary conditions
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @tparam TCompute Data type of the lab
+     * @param field Source field data to be loaded
+     * @param lab Laboratory where data is loaded into
+     * @param boundaries Vector of boundary conditions
+     * @param c Component index
+     * @param d Face direction
+     *
+     * @rst
+     * Boundary conditions in ``boundaries`` are applied to the sides of
+     * ``field`` that coincide with the global domain boundary.  Same
+     * requirements as for the overload without boundary conditions.
+     * @endrst
+     */
+    template <typename Comp = size_t, typename Dir = size_t, typename TCompute>
+    void
+    loadLab(const BaseType &field,
+            Block::FieldLab<FieldType, TCompute> &lab,
+            const std::vector<BC::Base<Block::FieldLab<FieldType, TCompute>> *>
+                &boundaries,
+            const Comp c = 0,
+            const Dir d = 0)
+    {
+        // The `lab` must be allocated
+        assert(lab.isAllocated());
+        // The allocated `lab` must be large enough to process `field`
+        assert(field.getIndexRange(static_cast<size_t>(d)).getExtent() <=
+               lab.getMaximumRange().getExtent());
+        // The lab stencil must be covered by the exchanged halos
+        assert(stencil_.getBegin() <= lab.getActiveStencil().getBegin());
+        assert(lab.getActiveStencil().getEnd() <= stencil_.getEnd());
+        auto idx_functor = this->getNeighborFunctor(field, c, d);
+        loadBoundaryLab(
+            lab, field.getState().block_index, idx_functor, boundaries);
+    }
+
+    /**
+     * @brief View lab loader utility to load ghosts of ``field`` into ``lab``
+     * @tparam Comp Type for components that defines a cast to ``size_t``
+     * @tparam Dir Type for direction that defines a cast to ``size_t``
+     * @param field Source field data to be mapped
+     * @param lab View laboratory where ghost data is loaded into
+     * @param c Component index
+     * @param d Face direction
+     *
+     * @rst
+     * Same requirements as for the ``Block::FieldLab`` overload.
+     * @endrst
+     */
+    template <typename Comp = size_t, typename Dir = size_t>
+    void loadLab(const BaseType &field,
+                 Block::FieldViewLab<FieldType> &lab,
+                 const Comp c = 0,
+                 const Dir d = 0)
+    {
+        // The `lab` must be allocated
+        assert(lab.isAllocated());
+        // The lab stencil must be covered by the exchanged halos
+        assert(stencil_.getBegin() <= lab.getActiveStencil().getBegin());
+        assert(lab.getActiveStencil().getEnd() <= stencil_.getEnd());
+        const auto &bi = field.getState().block_index;
+        auto idx_functor = this->getNeighborFunctor(field, c, d);
+        lab.loadData(bi, idx_functor);
+    }
+
+    /**
+     * @brief Batched lab loader utility for all components of ``field``
+     * @tparam Layout Memory layout of the lab
+     * @param field Source field data to be loaded
+     * @param lab Multi-component laboratory where data is loaded into
+     *
+     * @rst
+     * Same requirements as for the ``Block::FieldLab`` overload.  Neighbors
+     * on remote ranks are accessed through ghost block fields that view the
+     * received halos of all components.
+     * @endrst
+     */
+    template <Block::LabLayout Layout>
+    void loadLab(const BaseType &field,
+                 Block::TensorFieldLab<BaseType, Layout> &lab)
+    {
+        // The `lab` must be allocated
+        assert(lab.isAllocated());
+        // The lab stencil must be covered by the exchanged halos
+        assert(stencil_.getBegin() <= lab.getActiveStencil().getBegin());
+        assert(lab.getActiveStencil().getEnd() <= stencil_.getEnd());
+        const MultiIndex &bi = field.getState().block_index;
+        const size_t k = grid_.getBlockMap()[local_range_.getFlatIndex(bi)];
+        assert(&grid_[k] == &field);
+        const auto *row = neighbors_.getRow(k);
+        auto id2field = [this, row, &bi](const MultiIndex &p) -> BaseType & {
+            const auto &e = row[NeighborTableType::getSlot(p - bi)];
+            if (e.remote) {
+                assert(ghost_blocks_[e.index] != nullptr);
+                return *ghost_blocks_[e.index];
+            }
+            return grid_[e.index];
+        };
+        lab.loadData(bi, id2field);
+    }
+
+private:
+    // A contiguous region of a block field
+    struct Region {
+        size_t block;      // local block (flat) index
+        size_t scalar;     // scalar field index
+        MultiIndex begin;  // region begin in block field
+        MultiIndex extent; // region extent
+    };
+
+    // Message exchanged with one neighbor
+    struct Message {
+        int peer;                    // neighbor rank
+        int tag;                     // message tag
+        DataType *buffer;            // aligned message buffer
+        size_t count;                // number of elements in buffer
+        std::vector<Region> regions; // packed regions (send only)
+    };
+
+    GridType &grid_;
+    const StencilType stencil_;
+    MPI_Comm comm_;
+    const IndexRangeType local_range_; // rank local blocks
+    const IndexRangeType shell_range_; // local blocks plus halo shell
+    MultiIndex ghost_lo_;              // halo width at lower boundary
+    MultiIndex ghost_hi_;              // halo width at upper boundary
+    bool is_active_;
+    bool is_synced_; // the last exchange has completed
+
+    std::vector<Message> recv_msgs_;
+    std::vector<Message> send_msgs_;
+    std::vector<MPI_Request> recv_requests_; // persistent receive requests
+    std::vector<MPI_Request> send_requests_; // persistent send requests
+    AlignedBlockAllocator<DataType> buf_alloc_;
+    std::vector<FieldState> ghost_states_;
+    std::vector<FieldType *> ghost_fields_;
+    std::vector<FieldType *> ghosts_;      // [scalar][shell index]
+    std::vector<BaseType *> ghost_blocks_; // [shell index]
+    NeighborTableType neighbors_;
+    std::vector<BaseType *> inner_blocks_;
+    std::vector<BaseType *> halo_blocks_;
+    std::vector<size_t> halo_deps_;               // messages per halo block
+    std::vector<std::vector<size_t>> msg_blocks_; // halo blocks per message
+    std::vector<size_t> pending_; // pending messages per halo block
+    std::vector<int> done_;       // completed message indices
+    size_t remaining_;            // number of pending messages
+
+    static size_t scalarIndex_(const size_t c, const size_t d)
+    {
+        if (GridType::EntityType == Cubism::EntityType::Face) {
+            assert(d < Dim);
+            return d * GridType::NComponents + c;
+        }
+        return c;
+    }
+
+    // neighbor offset of a position in the halo shell
+    MultiIndex getOffset_(const MultiIndex &p) const
+    {
+        const MultiIndex n = local_range_.getExtent();
+        MultiIndex r(0);
+        for (size_t i = 0; i < Dim; ++i) {
+            r[i] = (p[i] < 0) ? -1 : ((p[i] < n[i]) ? 0 : 1);
+        }
+        return r;
+    }
+
+    // halo positions that must be exchanged with the neighbor at offset r
+    bool isRequired_(const MultiIndex &r) const
+    {
+        size_t noff = 0;
+        for (size_t i = 0; i < Dim; ++i) {
+            if (r[i] < 0) {
+                if (0 == ghost_lo_[i]) {
+                    return false;
+                }
+                ++noff;
+            } else if (r[i] > 0) {
+                if (0 == ghost_hi_[i]) {
+                    return false;
+                }
+                ++noff;
+            }
+        }
+        return (1 == noff || (noff > 1 && stencil_.isTensorial()));
+    }
+
+    // extent of a ghost field at halo shell position p (receiver side)
+    MultiIndex getGhostExtent_(const MultiIndex &p,
+                               const MultiIndex &block_cells,
+                               const size_t fdir) const
+    {
+        const MultiIndex n = local_range_.getExtent();
+        const MultiIndex nglobal = grid_.getGlobalSize();
+        const MultiIndex p0 = grid_.getProcIndex() * n; // rank block offset
+        MultiIndex e(0);
+        for (size_t i = 0; i < Dim; ++i) {
+            if (p[i] < 0) {
+                e[i] = ghost_lo_[i];
+            } else if (p[i] >= n[i]) {
+                e[i] = ghost_hi_[i];
+            } else {
+                e[i] = block_cells[i];
+                if (p0[i] + p[i] == nglobal[i] - 1) {
+                    if (GridType::EntityType == Cubism::EntityType::Node ||
+                        (GridType::EntityType == Cubism::EntityType::Face &&
+                         i == fdir)) {
+                        ++e[i];
+                    }
+                }
+            }
+        }
+        return e;
+    }
+
+    int getPeer_(const MultiIndex &r) const
+    {
+        const MultiIndex np = grid_.getNumProcs();
+        const MultiIndex pi = grid_.getProcIndex();
+        Core::Vector<int, Dim> coords;
+        for (size_t i = 0; i < Dim; ++i) {
+            coords[i] = static_cast<int>((pi[i] + r[i] + np[i]) % np[i]);
+        }
+        int peer;
+        MPI_Cart_rank(comm_, coords.data(), &peer);
+        return peer;
+    }
+
+    void init_(const MultiIndex &block_cells)
+    {
+        const IndexRangeType nbr_range(3);
+        const MultiIndex n = local_range_.getExtent();
+        const size_t nshell = shell_range_.size();
+
+        // halo shell positions grouped by neighbor offset
+        std::vector<std::vector<MultiIndex>> shell(nbr_range.size());
+        for (const auto &p : shell_range_) {
+            const MultiIndex q = p + shell_range_.getBegin();
+            if (local_range_.isIndex(q)) {
+                continue;
+            }
+            const MultiIndex r = getOffset_(q);
+            if (isRequired_(r)) {
+                shell[nbr_range.getFlatIndex(r + 1)].push_back(q);
+            }
+        }
+
+        // ghost fields pointing into receive buffers
+        std::vector<size_t> recv_index(nbr_range.size(), 0);
+        size_t nghosts = 0;
+        for (const auto &s : shell) {
+            nghosts += s.size();
+        }
+        ghost_states_.resize(nghosts);
+        ghosts_.resize(NScalars * nshell, nullptr);
+        size_t k = 0;
+        for (size_t i = 0; i < nbr_range.size(); ++i) {
+            if (shell[i].empty()) {
+                continue;
+            }
+            const MultiIndex r = nbr_range.getMultiIndex(i) - 1;
+            Message m;
+            m.peer = getPeer_(r);
+            m.tag = static_cast<int>(i);
+
+            std::vector<IndexRangeType> ranges;
+            size_t count = 0;
+            for (size_t sc = 0; sc < NScalars; ++sc) {
+                const size_t fdir = sc / GridType::NComponents;
+                for (const auto &p : shell[i]) {
+                    ranges.push_back(
+                        IndexRangeType(getGhostExtent_(p, block_cells, fdir)));
+                    count += ranges.back().size();
+                }
+            }
+            allocBuffer_(m, count);
+
+            DataType *ptr = m.buffer;
+            auto range = ranges.begin();
+            for (size_t sc = 0; sc < NScalars; ++sc) {
+                for (size_t j = 0; j < shell[i].size(); ++j) {
+                    const MultiIndex &p = shell[i][j];
+                    FieldState *fs = &ghost_states_[k + j];
+                    fs->block_index = p;
+                    fs->mesh = nullptr;
+                    fs->mask = nullptr;
+                    const size_t bytes = range->size() * sizeof(DataType);
+                    FieldType *g = new FieldType({{*range}},
+                                                 {{ptr}},
+                                                 {{bytes}},
+                                                 {{fs}});
+                    ghost_fields_.push_back(g);
+                    ghosts_[sc * nshell + shell_range_.getFlatIndexFromGlobal(
+                                              p)] = g;
+                    ptr += range->size();
+                    ++range;
+                }
+            }
+            k += shell[i].size();
+            recv_index[i] = recv_msgs_.size();
+            recv_msgs_.push_back(std::move(m));
+        }
+
+        // ghost block fields composed of all scalar ghosts at a shell position
+        ghost_blocks_.resize(nshell, nullptr);
+        const size_t NGroups = NScalars / GridType::NComponents;
+        for (size_t slot = 0; slot < nshell; ++slot) {
+            if (!ghosts_[slot]) {
+                continue;
+            }
+            std::vector<std::vector<IndexRangeType>> AA(NGroups);
+            std::vector<std::vector<DataType *>> BB(NGroups);
+            std::vector<std::vector<size_t>> CC(NGroups);
+            std::vector<std::vector<FieldState *>> DD(NGroups);
+            for (size_t sc = 0; sc < NScalars; ++sc) {
+                FieldType *g = ghosts_[sc * nshell + slot];
+                assert(g != nullptr);
+                const size_t fdir = sc / GridType::NComponents;
+                AA[fdir].push_back(g->getIndexRange());
+                BB[fdir].push_back(g->getData());
+                CC[fdir].push_back(g->getIndexRange().size() *
+                                   sizeof(DataType));
+                DD[fdir].push_back(&g->getState());
+            }
+            ghost_blocks_[slot] = new BaseType(AA, BB, CC, DD);
+        }
+
+        // send regions: the neighbor at offset q receives into its halo shell
+        // at offset r = -q
+        for (size_t i = 0; i < nbr_range.size(); ++i) {
+            const MultiIndex q = nbr_range.getMultiIndex(i) - 1;
+            const MultiIndex r = -q;
+            const size_t ir = nbr_range.getFlatIndex(r + 1);
+            if (shell[ir].empty()) {
+                continue;
+            }
+            Message m;
+            m.peer = getPeer_(q);
+            m.tag = static_cast<int>(ir);
+
+            size_t count = 0;
+            ScalarMap fields(grid_.getFields());
+            for (size_t sc = 0; sc < NScalars; ++sc) {
+                const size_t c = sc % GridType::NComponents;
+                const size_t fdir = sc / GridType::NComponents;
+                for (const auto &p : shell[ir]) {
+                    const MultiIndex b = p + q * n; // local block index
+                    assert(local_range_.isIndex(b));
+                    const size_t bflat =
+                        grid_.getBlockMap()[local_range_.getFlatIndex(b)];
+                    const MultiIndex E =
+                        fields(bflat, c, fdir).getIndexRange().getExtent();
+                    Region reg;
+                    reg.block = bflat;
+                    reg.scalar = sc;
+                    for (size_t d = 0; d < Dim; ++d) {
+                        if (r[d] < 0) {
+                            reg.begin[d] = E[d] - ghost_lo_[d];
+                            reg.extent[d] = ghost_lo_[d];
+                        } else if (r[d] > 0) {
+                            reg.begin[d] = 0;
+                            reg.extent[d] = ghost_hi_[d];
+                        } else {
+                            reg.begin[d] = 0;
+                            reg.extent[d] = E[d];
+                        }
+                    }
+                    count += reg.extent.prod();
+                    m.regions.push_back(reg);
+                }
+            }
+            allocBuffer_(m, count);
+            send_msgs_.push_back(std::move(m));
+        }
+
+        // persistent requests
+        done_.resize(recv_msgs_.size());
+        recv_requests_.resize(recv_msgs_.size(), MPI_REQUEST_NULL);
+        for (size_t i = 0; i < recv_msgs_.size(); ++i) {
+            const Message &m = recv_msgs_[i];
+            MPI_Recv_init(m.buffer,
+                          static_cast<int>(m.count * sizeof(DataType)),
+                          MPI_BYTE,
+                          m.peer,
+                          m.tag,
+                          comm_,
+                          &recv_requests_[i]);
+        }
+        send_requests_.resize(send_msgs_.size(), MPI_REQUEST_NULL);
+        for (size_t i = 0; i < send_msgs_.size(); ++i) {
+            const Message &m = send_msgs_[i];
+            MPI_Send_init(m.buffer,
+                          static_cast<int>(m.count * sizeof(DataType)),
+                          MPI_BYTE,
+                          m.peer,
+                          m.tag,
+                          comm_,
+                          &send_requests_[i]);
+        }
+
+        // inner and halo blocks, halo blocks depend on one or more messages
+        msg_blocks_.resize(recv_msgs_.size());
+        for (auto f : grid_) {
+            const MultiIndex &bi = f->getState().block_index;
+            if (grid_.isInnerBlock(bi, stencil_)) {
+                inner_blocks_.push_back(f);
+                continue;
+            }
+            const size_t hb = halo_blocks_.size();
+            std::vector<bool> depends(recv_msgs_.size(), false);
+            for (const auto &p : nbr_range) {
+                const MultiIndex q = bi + p - 1;
+                if (local_range_.isIndex(q) || !isRequired_(p - 1)) {
+                    continue;
+                }
+                const size_t ir = nbr_range.getFlatIndex(getOffset_(q) + 1);
+                depends[recv_index[ir]] = true;
+            }
+            size_t ndeps = 0;
+            for (size_t m = 0; m < depends.size(); ++m) {
+                if (depends[m]) {
+                    msg_blocks_[m].push_back(hb);
+                    ++ndeps;
+                }
+            }
+            assert(ndeps > 0);
+            halo_blocks_.push_back(f);
+            halo_deps_.push_back(ndeps);
+        }
+    }
+
+    void buildNeighbors_()
+    {
+        const MultiIndex n = local_range_.getExtent();
+        const MultiIndex nglobal = grid_.getGlobalSize();
+        const MultiIndex p0 = grid_.getProcIndex() * n; // rank block offset
+        const std::vector<size_t> &map = grid_.getBlockMap();
+        auto resolve = [&](MultiIndex p) {
+            typename NeighborTableType::Entry e;
+            e.remote = false;
+            e.boundary = false;
+            for (size_t i = 0; i < Dim; ++i) {
+                const auto g = p0[i] + p[i];
+                if (g < 0 || g >= nglobal[i]) {
+                    e.boundary = true;
+                }
+            }
+            if (local_range_.isIndex(p)) {
+                e.index = map[local_range_.getFlatIndex(p)];
+                return e;
+            }
+            if (shell_range_.isGlobalIndex(p)) {
+                const size_t slot = shell_range_.getFlatIndexFromGlobal(p);
+                if (ghosts_[slot]) { // same for all scalars
+                    e.index = slot;
+                    e.remote = true;
+                    return e;
+                }
+            }
+            for (size_t i = 0; i < Dim; ++i) {
+                p[i] = (p[i] + n[i]) % n[i];
+            }
+            e.index = map[local_range_.getFlatIndex(p)];
+            return e;
+        };
+        neighbors_.build(grid_.getFieldStates(), resolve);
+    }
+
+    void allocBuffer_(Message &m, const size_t count)
+    {
+        size_t bytes = count * sizeof(DataType);
+        assert(bytes <= static_cast<size_t>(std::numeric_limits<int>::max()));
+        m.buffer = buf_alloc_.allocate(bytes);
+        m.count = count;
+    }
+
+    void pack_(Message &m)
+    {
+        ScalarMap fields(grid_.getFields());
+        DataType *dst = m.buffer;
+        for (const auto &reg : m.regions) {
+            const size_t c = reg.scalar % GridType::NComponents;
+            const size_t fdir = reg.scalar / GridType::NComponents;
+            const FieldType &f = fields(reg.block, c, fdir);
+            const IndexRangeType &frange = f.getIndexRange();
+            const DataType *src = f.getData();
+
+            // copy contiguous rows along the first dimension
+            MultiIndex rows = reg.extent;
+            rows[0] = 1;
+            const IndexRangeType row_range(rows);
+            const size_t nrow = static_cast<size_t>(reg.extent[0]);
+            const size_t bytes = nrow * sizeof(DataType);
+            for (const auto &p : row_range) {
+                std::memcpy(
+                    dst, src + frange.getFlatIndex(p + reg.begin), bytes);
+                dst += nrow;
+            }
+        }
+        assert(dst == m.buffer + m.count);
+    }
+};
+
+template <typename TGrid>
+constexpr size_t SynchronizerMPI<TGrid>::Dim;
+
+template <typename TGrid>
+constexpr size_t SynchronizerMPI<TGrid>::NScalars;
+
+NAMESPACE_END(Grid)
+NAMESPACE_END(Cubism)
+
+#endif /* SYNCHRONIZERMPI_H_T8QZ3KMW */
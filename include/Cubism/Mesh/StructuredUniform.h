@@ -307,6 +307,17 @@ public:
         return getCoordsFace_(p, dir);
     }
 
+    using BaseMesh::getCellVolume;
+    /**
+     * @brief Get cell volume
+     * @param i Local flat cell index
+     * @return Cell volume
+     *
+     * This is a non-virtual method. Prefer this method for excessive volume
+     * lookup in loops.
+     */
+    RealType getCellVolume(const size_t) const { return cell_volume_; }
+
 protected:
     PointType getCoords_(const MultiIndex &p,
                          const EntityType t,
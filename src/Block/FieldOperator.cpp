@@ -0,0 +1,361 @@
+// File       : FieldOperator.cpp
+// Created    : Thu Oct 15 2026 06:02:49 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: SIMD block field math operators with runtime dispatch
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/Block/FieldOperator.h"
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#define CUBISM_X86_DISPATCH
+#include <immintrin.h>
+#endif /* x86 */
+
+// Kernels are compiled for each instruction set with function target
+// attributes such that the library itself does not require any -m flags.  The
+// instruction set is detected once at runtime (CPUID) and can be limited with
+// the CUBISM_KERNEL_ISA environment variable (scalar, sse2, avx2, avx512).
+// Kernels use unaligned loads and stores and process each SIMD chunk with
+// load-before-store semantics, which is correct for dst == src (in-place field
+// operations).
+
+namespace
+{
+enum class ISA { Scalar = 0, SSE2, AVX2, AVX512 };
+
+const char *isaName(const ISA isa)
+{
+    switch (isa) {
+    case ISA::SSE2:
+        return "sse2";
+    case ISA::AVX2:
+        return "avx2";
+    case ISA::AVX512:
+        return "avx512";
+    default:
+        return "scalar";
+    }
+}
+
+ISA detectISA()
+{
+    ISA isa = ISA::Scalar;
+#ifdef CUBISM_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        isa = ISA::AVX512;
+    } else if (__builtin_cpu_supports("avx2")) {
+        isa = ISA::AVX2;
+    } else if (__builtin_cpu_supports("sse2")) {
+        isa = ISA::SSE2;
+    }
+#endif /* CUBISM_X86_DISPATCH */
+    const char *env = std::getenv("CUBISM_KERNEL_ISA");
+    if (env) {
+        for (int i = 0; i <= static_cast<int>(ISA::AVX512); ++i) {
+            const ISA cap = static_cast<ISA>(i);
+            if (0 == std::strcmp(env, isaName(cap)) && cap < isa) {
+                isa = cap;
+            }
+        }
+    }
+    return isa;
+}
+
+ISA getISA()
+{
+    static const ISA isa = detectISA();
+    return isa;
+}
+
+// scalar operations
+#define SCALAR_OP_Add(A, B) ((A) + (B))
+#define SCALAR_OP_Sub(A, B) ((A) - (B))
+#define SCALAR_OP_Mul(A, B) ((A) * (B))
+#define SCALAR_OP_Div(A, B) ((A) / (B))
+#define SCALAR_OP_Rcp(A, B) ((B) * (1 / (A)))
+
+// kernel body for field (ARG=src1[i]) and scalar (ARG=src1) operands
+#define SCALAR_KERNEL(OP, ARITY, TYPE, ARG_TYPE, ARG)                          \
+    void OP##ARITY##_##TYPE##_scalar(                                          \
+        const TYPE *src0, ARG_TYPE src1, TYPE *dst, const size_t n)            \
+    {                                                                          \
+        for (size_t i = 0; i < n; ++i) {                                       \
+            dst[i] = SCALAR_OP_##OP(src0[i], ARG);                             \
+        }                                                                      \
+    }
+
+#ifdef CUBISM_X86_DISPATCH
+// SIMD intrinsics: PREFIX is the intrinsic prefix (_mm, _mm256, _mm512),
+// SUFFIX the type suffix (pd, ps)
+#define SIMD(PREFIX, NAME, SUFFIX) PREFIX##_##NAME##_##SUFFIX
+#define SIMD_OP_Add(P, S, A, B) SIMD(P, add, S)(A, B)
+#define SIMD_OP_Sub(P, S, A, B) SIMD(P, sub, S)(A, B)
+#define SIMD_OP_Mul(P, S, A, B) SIMD(P, mul, S)(A, B)
+#define SIMD_OP_Div(P, S, A, B) SIMD(P, div, S)(A, B)
+#define SIMD_OP_Rcp(P, S, A, B)                                                \
+    SIMD(P, mul, S)(B, SIMD(P, div, S)(SIMD(P, set1, S)(1), A))
+
+#define SIMD_KERNEL2(OP, TYPE, ISANAME, TARGET, VTYPE, P, S)                   \
+    __attribute__((target(TARGET))) void OP##2_##TYPE##_##ISANAME(             \
+        const TYPE *src0, const TYPE *src1, TYPE *dst, const size_t n)         \
+    {                                                                          \
+        constexpr size_t W = sizeof(VTYPE) / sizeof(TYPE);                     \
+        size_t i = 0;                                                          \
+        for (; i + W <= n; i += W) {                                           \
+            const VTYPE a = SIMD(P, loadu, S)(src0 + i);                       \
+            const VTYPE b = SIMD(P, loadu, S)(src1 + i);                       \
+            SIMD(P, storeu, S)(dst + i, SIMD_OP_##OP(P, S, a, b));             \
+        }                                                                      \
+        for (; i < n; ++i) {                                                   \
+            dst[i] = SCALAR_OP_##OP(src0[i], src1[i]);                         \
+        }                                                                      \
+    }
+
+#define SIMD_KERNEL1(OP, TYPE, ISANAME, TARGET, VTYPE, P, S)                   \
+    __attribute__((target(TARGET))) void OP##1_##TYPE##_##ISANAME(             \
+        const TYPE *src0, const TYPE src1, TYPE *dst, const size_t n)          \
+    {                                                                          \
+        constexpr size_t W = sizeof(VTYPE) / sizeof(TYPE);                     \
+        const VTYPE b = SIMD(P, set1, S)(src1);                                \
+        size_t i = 0;                                                          \
+        for (; i + W <= n; i += W) {                                           \
+            const VTYPE a = SIMD(P, loadu, S)(src0 + i);                       \
+            SIMD(P, storeu, S)(dst + i, SIMD_OP_##OP(P, S, a, b));             \
+        }                                                                      \
+        for (; i < n; ++i) {                                                   \
+            dst[i] = SCALAR_OP_##OP(src0[i], src1);                            \
+        }                                                                      \
+    }
+
+#define ALL_KERNELS(OP, ARITY, TYPE, S, V128, V256, V512)                      \
+    SIMD_KERNEL##ARITY(OP, TYPE, sse2, "sse2", V128, _mm, S)                   \
+    SIMD_KERNEL##ARITY(OP, TYPE, avx2, "avx2", V256, _mm256, S)                \
+    SIMD_KERNEL##ARITY(OP, TYPE, avx512, "avx512f", V512, _mm512, S)
+
+#define DISPATCH(OP, ARITY, TYPE, ...)                                         \
+    switch (getISA()) {                                                        \
+    case ISA::AVX512:                                                          \
+        OP##ARITY##_##TYPE##_avx512(__VA_ARGS__);                              \
+        break;                                                                 \
+    case ISA::AVX2:                                                            \
+        OP##ARITY##_##TYPE##_avx2(__VA_ARGS__);                                \
+        break;                                                                 \
+    case ISA::SSE2:                                                            \
+        OP##ARITY##_##TYPE##_sse2(__VA_ARGS__);                                \
+        break;                                                                 \
+    default:                                                                   \
+        OP##ARITY##_##TYPE##_scalar(__VA_ARGS__);                              \
+        break;                                                                 \
+    }
+#else
+#define ALL_KERNELS(OP, ARITY, TYPE, S, V128, V256, V512)
+#define DISPATCH(OP, ARITY, TYPE, ...) OP##ARITY##_##TYPE##_scalar(__VA_ARGS__)
+#endif /* CUBISM_X86_DISPATCH */
+
+#define KERNELS(OP, ARITY, ARG_TYPE, ARG)                                      \
+    SCALAR_KERNEL(OP, ARITY, double, const double ARG_TYPE, ARG)               \
+    SCALAR_KERNEL(OP, ARITY, float, const float ARG_TYPE, ARG)                 \
+    ALL_KERNELS(OP, ARITY, double, pd, __m128d, __m256d, __m512d)              \
+    ALL_KERNELS(OP, ARITY, float, ps, __m128, __m256, __m512)
+
+KERNELS(Add, 2, *, src1[i])
+KERNELS(Sub, 2, *, src1[i])
+KERNELS(Mul, 2, *, src1[i])
+KERNELS(Div, 2, *, src1[i])
+KERNELS(Add, 1, , src1)
+KERNELS(Sub, 1, , src1)
+KERNELS(Mul, 1, , src1)
+KERNELS(Div, 1, , src1)
+KERNELS(Rcp, 1, , src1)
+
+#undef KERNELS
+#undef ALL_KERNELS
+#undef SIMD_KERNEL1
+#undef SIMD_KERNEL2
+#undef SCALAR_KERNEL
+
+// fused linear combinations (the destination may alias any source)
+#define SCALAR_FUSED(TYPE)                                                     \
+    void Axpy_##TYPE##_scalar(                                                 \
+        const TYPE a, const TYPE *x, TYPE *y, const size_t n)                  \
+    {                                                                          \
+        for (size_t i = 0; i < n; ++i) {                                       \
+            y[i] += a * x[i];                                                  \
+        }                                                                      \
+    }                                                                          \
+    void Axpby_##TYPE##_scalar(                                                \
+        const TYPE a, const TYPE *x, const TYPE b, TYPE *y, const size_t n)    \
+    {                                                                          \
+        for (size_t i = 0; i < n; ++i) {                                       \
+            y[i] = a * x[i] + b * y[i];                                        \
+        }                                                                      \
+    }                                                                          \
+    void LinComb_##TYPE##_scalar(const TYPE a,                                 \
+                                 const TYPE *src0,                             \
+                                 const TYPE b,                                 \
+                                 const TYPE *src1,                             \
+                                 const TYPE c,                                 \
+                                 const TYPE *src2,                             \
+                                 TYPE *dst,                                    \
+                                 const size_t n)                               \
+    {                                                                          \
+        for (size_t i = 0; i < n; ++i) {                                       \
+            dst[i] = a * src0[i] + b * src1[i] + c * src2[i];                  \
+        }                                                                      \
+    }
+
+SCALAR_FUSED(double)
+SCALAR_FUSED(float)
+#undef SCALAR_FUSED
+
+#ifdef CUBISM_X86_DISPATCH
+#define SIMD_FUSED(TYPE, ISANAME, TARGET, VTYPE, P, S)                         \
+    __attribute__((target(TARGET))) void Axpy_##TYPE##_##ISANAME(              \
+        const TYPE a, const TYPE *x, TYPE *y, const size_t n)                  \
+    {                                                                          \
+        constexpr size_t W = sizeof(VTYPE) / sizeof(TYPE);                     \
+        const VTYPE va = SIMD(P, set1, S)(a);                                  \
+        size_t i = 0;                                                          \
+        for (; i + W <= n; i += W) {                                           \
+            const VTYPE vx = SIMD(P, loadu, S)(x + i);                         \
+            const VTYPE vy = SIMD(P, loadu, S)(y + i);                         \
+            SIMD(P, storeu, S)                                                 \
+            (y + i, SIMD(P, add, S)(SIMD(P, mul, S)(va, vx), vy));             \
+        }                                                                      \
+        for (; i < n; ++i) {                                                   \
+            y[i] += a * x[i];                                                  \
+        }                                                                      \
+    }                                                                          \
+    __attribute__((target(TARGET))) void Axpby_##TYPE##_##ISANAME(             \
+        const TYPE a, const TYPE *x, const TYPE b, TYPE *y, const size_t n)    \
+    {                                                                          \
+        constexpr size_t W = sizeof(VTYPE) / sizeof(TYPE);                     \
+        const VTYPE va = SIMD(P, set1, S)(a);                                  \
+        const VTYPE vb = SIMD(P, set1, S)(b);                                  \
+        size_t i = 0;                                                          \
+        for (; i + W <= n; i += W) {                                           \
+            const VTYPE vx = SIMD(P, loadu, S)(x + i);                         \
+            const VTYPE vy = SIMD(P, loadu, S)(y + i);                         \
+            SIMD(P, storeu, S)                                                 \
+            (y + i,                                                            \
+             SIMD(P, add, S)(SIMD(P, mul, S)(va, vx),                          \
+                             SIMD(P, mul, S)(vb, vy)));                        \
+        }                                                                      \
+        for (; i < n; ++i) {                                                   \
+            y[i] = a * x[i] + b * y[i];                                        \
+        }                                                                      \
+    }                                                                          \
+    __attribute__((target(TARGET))) void LinComb_##TYPE##_##ISANAME(           \
+        const TYPE a,                                                          \
+        const TYPE *src0,                                                      \
+        const TYPE b,                                                          \
+        const TYPE *src1,                                                      \
+        const TYPE c,                                                          \
+        const TYPE *src2,                                                      \
+        TYPE *dst,                                                             \
+        const size_t n)                                                        \
+    {                                                                          \
+        constexpr size_t W = sizeof(VTYPE) / sizeof(TYPE);                     \
+        const VTYPE va = SIMD(P, set1, S)(a);                                  \
+        const VTYPE vb = SIMD(P, set1, S)(b);                                  \
+        const VTYPE vc = SIMD(P, set1, S)(c);                                  \
+        size_t i = 0;                                                          \
+        for (; i + W <= n; i += W) {                                           \
+            const VTYPE v0 = SIMD(P, loadu, S)(src0 + i);                      \
+            const VTYPE v1 = SIMD(P, loadu, S)(src1 + i);                      \
+            const VTYPE v2 = SIMD(P, loadu, S)(src2 + i);                      \
+            SIMD(P, storeu, S)                                                 \
+            (dst + i,                                                          \
+             SIMD(P, add, S)(SIMD(P, add, S)(SIMD(P, mul, S)(va, v0),          \
+                                             SIMD(P, mul, S)(vb, v1)),         \
+                             SIMD(P, mul, S)(vc, v2)));                        \
+        }                                                                      \
+        for (; i < n; ++i) {                                                   \
+            dst[i] = a * src0[i] + b * src1[i] + c * src2[i];                  \
+        }                                                                      \
+    }
+
+#define ALL_FUSED(TYPE, S, V128, V256, V512)                                   \
+    SIMD_FUSED(TYPE, sse2, "sse2", V128, _mm, S)                               \
+    SIMD_FUSED(TYPE, avx2, "avx2", V256, _mm256, S)                            \
+    SIMD_FUSED(TYPE, avx512, "avx512f", V512, _mm512, S)
+
+ALL_FUSED(double, pd, __m128d, __m256d, __m512d)
+ALL_FUSED(float, ps, __m128, __m256, __m512)
+#undef ALL_FUSED
+#undef SIMD_FUSED
+#endif /* CUBISM_X86_DISPATCH */
+} // namespace
+
+#define EXPORT_FIELD(OP, TYPE)                                                 \
+    extern "C" void field##OP##2_##TYPE(                                       \
+        const TYPE *src0, const TYPE *src1, TYPE *dst, const size_t n)         \
+    {                                                                          \
+        DISPATCH(OP, 2, TYPE, src0, src1, dst, n)                              \
+    }
+
+#define EXPORT_SCALAR(OP, TYPE)                                                \
+    extern "C" void field##OP##1_##TYPE(                                       \
+        const TYPE *src0, const TYPE src1, TYPE *dst, const size_t n)          \
+    {                                                                          \
+        DISPATCH(OP, 1, TYPE, src0, src1, dst, n)                              \
+    }
+
+#define EXPORT_RCP(TYPE)                                                       \
+    extern "C" void fieldRcp_##TYPE(                                           \
+        const TYPE *src0, const TYPE src1, TYPE *dst, const size_t n)          \
+    {                                                                          \
+        DISPATCH(Rcp, 1, TYPE, src0, src1, dst, n)                             \
+    }
+
+EXPORT_FIELD(Add, double)
+EXPORT_FIELD(Sub, double)
+EXPORT_FIELD(Mul, double)
+EXPORT_FIELD(Div, double)
+EXPORT_FIELD(Add, float)
+EXPORT_FIELD(Sub, float)
+EXPORT_FIELD(Mul, float)
+EXPORT_FIELD(Div, float)
+
+EXPORT_SCALAR(Add, double)
+EXPORT_SCALAR(Sub, double)
+EXPORT_SCALAR(Mul, double)
+EXPORT_SCALAR(Div, double)
+EXPORT_SCALAR(Add, float)
+EXPORT_SCALAR(Sub, float)
+EXPORT_SCALAR(Mul, float)
+EXPORT_SCALAR(Div, float)
+
+EXPORT_RCP(double)
+EXPORT_RCP(float)
+
+#define EXPORT_FUSED(TYPE)                                                     \
+    extern "C" void fieldAxpy_##TYPE(                                          \
+        const TYPE a, const TYPE *x, TYPE *y, const size_t n)                  \
+    {                                                                          \
+        DISPATCH(Axpy, , TYPE, a, x, y, n)                                     \
+    }                                                                          \
+    extern "C" void fieldAxpby_##TYPE(                                         \
+        const TYPE a, const TYPE *x, const TYPE b, TYPE *y, const size_t n)    \
+    {                                                                          \
+        DISPATCH(Axpby, , TYPE, a, x, b, y, n)                                 \
+    }                                                                          \
+    extern "C" void fieldLinComb_##TYPE(const TYPE a,                          \
+                                        const TYPE *src0,                      \
+                                        const TYPE b,                          \
+                                        const TYPE *src1,                      \
+                                        const TYPE c,                          \
+                                        const TYPE *src2,                      \
+                                        TYPE *dst,                             \
+                                        const size_t n)                        \
+    {                                                                          \
+        DISPATCH(LinComb, , TYPE, a, src0, b, src1, c, src2, dst, n)           \
+    }
+
+EXPORT_FUSED(double)
+EXPORT_FUSED(float)
+
+extern "C" const char *fieldOperatorISA() { return isaName(getISA()); }
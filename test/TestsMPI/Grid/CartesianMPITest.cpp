@@ -4,11 +4,20 @@
 // Description: Cartesian Grid test
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 
+#include "Cubism/BC/Dirichlet.h"
+#include "Cubism/Block/FieldLab.h"
+#include "Cubism/Block/FieldViewLab.h"
+#include "Cubism/Block/TensorFieldLab.h"
 #include "Cubism/Core/Vector.h"
 #include "Cubism/Grid/CartesianMPI.h"
 #include "Cubism/Mesh/StructuredUniform.h"
 #include "gtest/gtest.h"
+#include <atomic>
+#include <cmath>
+#include <limits>
 #include <mpi.h>
+#include <stdexcept>
+#include <vector>
 
 namespace
 {
@@ -220,4 +229,196 @@ TEST(CartesianMPI, BlockMesh)
     EXPECT_EQ(blocks[1], nblocks[0] * (n * (n + 1) / 2));
 }
 
+TEST(CartesianMPI, Reduce)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::CartesianMPI<double, Mesh, EntityType::Cell, 0>;
+    using CV = typename Grid::CellValues;
+    using Cubism::Grid::ReduceOp;
+
+    const MIndex nprocs(2);
+    const MIndex nblocks{2, 1, 3};
+    const MIndex block_cells(4);
+    Grid grid(MPI_COMM_WORLD, nprocs, nblocks, block_cells);
+    const int rank = grid.getCartRank();
+    const double ncells = (nprocs * nblocks * block_cells).prod();
+
+    grid.fill(rank + 1);
+    auto value = [](const CV &c) { return c[0]; };
+    auto pending = grid.ireduce(value, ReduceOp::Max);
+    auto volume = grid.ireduce(
+        [](const CV &) { return 1.0; }, ReduceOp::Sum, true);
+    EXPECT_EQ(grid.reduce(value, ReduceOp::Min), 1);
+    EXPECT_EQ(pending.get(), 8);
+    EXPECT_DOUBLE_EQ(volume.get(), 1);
+    EXPECT_EQ(grid.reduce(value, ReduceOp::Sum), ncells / 8 * 36);
+
+    // NaN on a single rank propagates to all ranks
+    if (3 == rank) {
+        grid[0][5] = std::numeric_limits<double>::quiet_NaN();
+    }
+    EXPECT_TRUE(std::isnan(grid.reduce(value, ReduceOp::Max)));
+    EXPECT_TRUE(std::isnan(grid.reduce(value, ReduceOp::Min)));
+}
+
+TEST(CartesianMPI, LoadLab)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::CartesianMPI<double, Mesh, EntityType::Cell, 1>;
+    using FieldType = typename Grid::BaseType::FieldType;
+    using Lab = Block::FieldLab<FieldType>;
+    using ViewLab = Block::FieldViewLab<FieldType>;
+    using SoALab = Block::TensorFieldLab<typename Grid::BaseType>;
+    using AoSLab =
+        Block::TensorFieldLab<typename Grid::BaseType, Block::LabLayout::AoS>;
+    using Stencil = typename Grid::StencilType;
+
+    const MIndex nblocks{2, 1, 3};
+    const MIndex block_cells(4);
+    Grid grid(MPI_COMM_WORLD, MIndex(2), nblocks, block_cells);
+    const MIndex gcells = grid.getGlobalSize() * block_cells;
+    const MIndex rank_cells = grid.getProcIndex() * nblocks * block_cells;
+    auto fexact = [gcells](MIndex p, const size_t c) -> double {
+        for (size_t i = 0; i < 3; ++i) {
+            p[i] = (p[i] + gcells[i]) % gcells[i];
+        }
+        return p[0] + gcells[0] * (p[1] + gcells[1] * p[2]) +
+               static_cast<double>(c * gcells.prod());
+    };
+    for (auto f : grid) {
+        const MIndex b0 = rank_cells + f->getState().block_index * block_cells;
+        for (size_t c = 0; c < Grid::NComponents; ++c) {
+            for (auto &p : (*f)[c].getIndexRange()) {
+                (*f)[c][p] = fexact(b0 + p, c);
+            }
+        }
+    }
+
+    // block 0 has neighbor ranks at its lower boundary in all directions
+    const Stencil s(-1, 2, true);
+    const auto &bf = grid[grid.getBlockMap()[0]];
+    ASSERT_EQ(bf.getState().block_index, MIndex(0));
+    const MIndex b0 = rank_cells;
+    const MIndex left{-1, 0, 0}; // ghost owned by the rank at lower x
+    Lab lab;
+    lab.allocate(s, bf[0].getIndexRange());
+    EXPECT_THROW(grid.loadLab(bf, lab), std::runtime_error);
+    auto &sync = grid.getSynchronizer(s);
+    sync.sync();
+    sync.start(); // halos of the previous exchange are invalid
+    EXPECT_THROW(grid.loadLab(bf, lab), std::runtime_error);
+    sync.wait();
+
+    ViewLab vlab;
+    vlab.allocate(s, bf[0].getIndexRange());
+    SoALab slab;
+    slab.allocate(s, bf[0].getIndexRange());
+    AoSLab alab;
+    alab.allocate(s, bf[0].getIndexRange());
+    grid.loadLab(bf, slab);
+    grid.loadLab(bf, alab);
+    for (size_t c = 0; c < Grid::NComponents; ++c) {
+        grid.loadLab(bf, lab, c);
+        grid.loadLab(bf, vlab, c);
+        EXPECT_EQ(lab[left], fexact(b0 + left, c));
+        for (auto &q : lab.getActiveLabRange()) {
+            const MIndex p = q + s.getBegin();
+            const double v = fexact(b0 + p, c);
+            EXPECT_EQ(lab[p], v);
+            EXPECT_EQ(vlab[p], v);
+            EXPECT_EQ(slab(c, p), v);
+            EXPECT_EQ(alab(c, p), v);
+        }
+    }
+
+    // boundary conditions apply at the global domain boundary only
+    BC::Dirichlet<Lab> bc(0, 0, -1.0);
+    const typename Lab::BCVector bcs = {&bc};
+    grid.loadLab(bf, lab, bcs);
+    const bool is_boundary = (0 == grid.getProcIndex()[0]);
+    EXPECT_EQ(lab[left], is_boundary ? -1.0 : fexact(b0 + left, 0));
+}
+
+TEST(CartesianMPI, Process)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::CartesianMPI<double, Mesh, EntityType::Cell, 1>;
+    using FieldType = typename Grid::BaseType;
+    using LabSet = Cubism::Grid::FieldLabSet<Grid>;
+    using IRange = typename Grid::IndexRangeType;
+
+    const MIndex nprocs{2, 2, 2};
+    const MIndex nblocks{3, 2, 2};
+    const MIndex block_cells(4);
+    Grid grid(MPI_COMM_WORLD, nprocs, nblocks, block_cells);
+    const MIndex gcells = grid.getGlobalSize() * block_cells;
+    const MIndex rank_cells = grid.getProcIndex() * nblocks * block_cells;
+    auto fexact = [gcells](MIndex p, const size_t c) -> double {
+        for (size_t i = 0; i < 3; ++i) {
+            p[i] = (p[i] + gcells[i]) % gcells[i];
+        }
+        return p[0] + gcells[0] * (p[1] + gcells[1] * p[2]) +
+               static_cast<double>(c * gcells.prod());
+    };
+    for (auto f : grid) {
+        const MIndex b0 = rank_cells + f->getState().block_index * block_cells;
+        for (size_t c = 0; c < Grid::NComponents; ++c) {
+            for (auto &p : (*f)[c].getIndexRange()) {
+                (*f)[c][p] = fexact(b0 + p, c);
+            }
+        }
+    }
+
+    const typename Grid::StencilType s(-2, 3, true);
+    std::vector<std::atomic<int>> visits(grid.size());
+    for (auto &v : visits) {
+        v = 0;
+    }
+    auto kernel = [&](LabSet &labs, FieldType &f) {
+        const MIndex &bi = f.getState().block_index;
+        const MIndex b0 = rank_cells + bi * block_cells;
+        for (size_t c = 0; c < Grid::NComponents; ++c) {
+            for (auto &q : labs(c).getActiveLabRange()) {
+                const MIndex p = q + s.getBegin();
+                EXPECT_EQ(labs(c)[p], fexact(b0 + p, c));
+            }
+        }
+        ++visits[IRange(nblocks).getFlatIndex(bi)];
+    };
+    Cubism::Grid::process(grid, s, kernel);
+    Cubism::Grid::process(grid, s, kernel);
+    for (const auto &v : visits) {
+        EXPECT_EQ(v, 2);
+    }
+
+    // sparse pass
+    const MIndex b0(0);
+    const MIndex b1{2, 1, 1};
+    grid.activate(b0);
+    grid.activate(b1);
+    Cubism::Grid::processActive(grid, s, kernel);
+    const IRange r(nblocks);
+    for (size_t i = 0; i < visits.size(); ++i) {
+        const MIndex bi = r.getMultiIndex(i);
+        EXPECT_EQ(visits[i], (bi == b0 || bi == b1) ? 3 : 2);
+    }
+
+    // neighbors on other ranks are not activated
+    grid.getActiveSet().clear();
+    grid.activate(b0);
+    grid.activateNeighbors(s);
+    EXPECT_EQ(grid.getActiveSet().count(), 8);
+    for (auto bf : grid.getActiveBlocks()) {
+        EXPECT_TRUE(bf->getState().block_index <= MIndex(1));
+    }
+
+    // face neighbors only for a non-tensorial stencil
+    grid.getActiveSet().clear();
+    grid.activate(b0);
+    grid.activateNeighbors(typename Grid::StencilType(-2, 3));
+    EXPECT_EQ(grid.getActiveSet().count(), 4);
+}
 } // namespace
@@ -0,0 +1,391 @@
+// File       : SynchronizerMPITest.cpp
+// Created    : Thu Oct 15 2026 11:02:15 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Halo synchronizer test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/Block/FieldLab.h"
+#include "Cubism/Core/Stencil.h"
+#include "Cubism/Grid/Cartesian.h"
+#include "Cubism/Grid/CartesianMPI.h"
+#include "Cubism/Grid/SynchronizerMPI.h"
+#include "Cubism/Mesh/StructuredUniform.h"
+#include "gtest/gtest.h"
+#include <mpi.h>
+
+namespace
+{
+using namespace Cubism;
+
+template <size_t RANK>
+void testSync(const typename Mesh::StructuredUniform<double, 3>::MultiIndex
+                  &nprocs,
+              const Core::Stencil<3> &s,
+              const Cubism::Grid::BlockOrder order =
+                  Cubism::Grid::BlockOrder::Lexicographic)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::CartesianMPI<double, Mesh, EntityType::Cell, RANK>;
+    using Sync = Cubism::Grid::SynchronizerMPI<Grid>;
+    using DataType = typename Grid::DataType;
+    using FieldType = typename Grid::BaseType::FieldType;
+    using Lab = Block::FieldLab<FieldType>;
+
+    using Point = typename Mesh::PointType;
+
+    const MIndex nblocks{2, 1, 3};
+    const MIndex block_cells(4);
+    Grid grid(MPI_COMM_WORLD,
+              nprocs,
+              nblocks,
+              block_cells,
+              Point(0),
+              Point(1),
+              Point(0),
+              Point(1),
+              Cubism::Grid::FirstTouch::None,
+              order);
+    const MIndex gcells = grid.getGlobalSize() * block_cells;
+    const MIndex rank_cells = grid.getProcIndex() * nblocks * block_cells;
+
+    // unique value for each global cell and component
+    auto fexact = [gcells](MIndex p, const size_t c) -> DataType {
+        for (size_t i = 0; i < 3; ++i) {
+            p[i] = (p[i] + gcells[i]) % gcells[i];
+        }
+        return p[0] + gcells[0] * (p[1] + gcells[1] * p[2]) +
+               static_cast<DataType>(c * gcells.prod());
+    };
+
+    for (auto f : grid) {
+        const MIndex b0 = rank_cells + f->getState().block_index * block_cells;
+        for (size_t c = 0; c < Grid::NComponents; ++c) {
+            auto fmap = grid.getIndexFunctor(c);
+            FieldType &bf = fmap(f->getState().block_index);
+            for (auto &p : bf.getIndexRange()) {
+                bf[p] = fexact(b0 + p, c);
+            }
+        }
+    }
+
+    Sync sync(grid, s);
+    EXPECT_FALSE(sync.isActive());
+    sync.start();
+    EXPECT_TRUE(sync.isActive());
+    sync.wait();
+    EXPECT_FALSE(sync.isActive());
+
+    Lab lab;
+    lab.allocate(s, grid[0].getIndexRange());
+    const MIndex sbegin = s.getBegin();
+    for (auto f : grid) {
+        const MIndex b0 = rank_cells + f->getState().block_index * block_cells;
+        for (size_t c = 0; c < Grid::NComponents; ++c) {
+            sync.loadLab(*f, lab, c);
+            for (auto &q : lab.getActiveLabRange()) {
+                const MIndex p = q + sbegin;
+                // skip edges and corners for non-tensorial stencils
+                size_t noff = 0;
+                for (size_t i = 0; i < 3; ++i) {
+                    noff += (p[i] < 0 || p[i] >= block_cells[i]) ? 1 : 0;
+                }
+                if (!s.isTensorial() && noff > 1) {
+                    continue;
+                }
+                EXPECT_EQ(lab[p], fexact(b0 + p, c));
+            }
+        }
+    }
+}
+
+template <Cubism::EntityType Entity, size_t RANK>
+void testSyncSerial(
+    const typename Mesh::StructuredUniform<double, 3>::MultiIndex &nprocs,
+    const Core::Stencil<3> &s)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using GridSerial = Grid::Cartesian<double, Mesh, Entity, RANK>;
+    using Grid = Grid::CartesianMPI<double, Mesh, Entity, RANK>;
+    using Sync = Cubism::Grid::SynchronizerMPI<Grid>;
+    using FieldType = typename Grid::BaseType::FieldType;
+    using IRange = typename FieldType::IndexRangeType;
+    using Lab = Block::FieldLab<FieldType>;
+
+    const MIndex nblocks{2, 1, 3};
+    const MIndex block_cells(4);
+    Grid grid(MPI_COMM_WORLD, nprocs, nblocks, block_cells);
+    const MIndex gblocks = grid.getGlobalSize();
+    GridSerial serial(gblocks, block_cells); // global grid on each rank
+    const MIndex gnodes = gblocks * block_cells + 1;
+    const MIndex p0 = grid.getProcIndex() * nblocks;
+
+    // unique value for each global data point and scalar component
+    auto fexact = [gnodes](const MIndex &p, const size_t sc) -> double {
+        return p[0] + gnodes[0] * (p[1] + gnodes[1] * p[2]) +
+               static_cast<double>(sc * gnodes.prod());
+    };
+    auto init = [&](FieldType &bf, const MIndex &gbi, const size_t sc) {
+        const MIndex b0 = gbi * block_cells;
+        for (auto &p : bf.getIndexRange()) {
+            bf[p] = fexact(b0 + p, sc);
+        }
+    };
+    for (auto f : grid) {
+        const MIndex bi = f->getState().block_index;
+        for (size_t sc = 0; sc < Sync::NScalars; ++sc) {
+            const size_t c = sc % Grid::NComponents;
+            const size_t d = sc / Grid::NComponents;
+            init(grid.getIndexFunctor(c, d)(bi), p0 + bi, sc);
+        }
+    }
+    for (auto f : serial) {
+        const MIndex bi = f->getState().block_index;
+        for (size_t sc = 0; sc < Sync::NScalars; ++sc) {
+            const size_t c = sc % Grid::NComponents;
+            const size_t d = sc / Grid::NComponents;
+            init(serial.getIndexFunctor(c, d)(bi), bi, sc);
+        }
+    }
+
+    Sync sync(grid, s);
+    sync.sync();
+
+    const IRange max_range(block_cells + 1);
+    Lab lab, lab_serial;
+    lab.allocate(s, max_range);
+    lab_serial.allocate(s, max_range);
+    for (auto f : grid) {
+        const MIndex bi = f->getState().block_index;
+        for (size_t sc = 0; sc < Sync::NScalars; ++sc) {
+            const size_t c = sc % Grid::NComponents;
+            const size_t d = sc / Grid::NComponents;
+            sync.loadLab(*f, lab, c, d);
+            serial.loadLab(serial[p0 + bi], lab_serial, c, d);
+            EXPECT_EQ(lab.getActiveLabRange().getExtent(),
+                      lab_serial.getActiveLabRange().getExtent());
+            for (auto &q : lab.getActiveLabRange()) {
+                const MIndex p = q + s.getBegin();
+                EXPECT_EQ(lab[p], lab_serial[p]);
+            }
+        }
+    }
+}
+
+TEST(SynchronizerMPI, FaceExchange)
+{
+    using MIndex = typename Mesh::StructuredUniform<double, 3>::MultiIndex;
+    testSync<0>(MIndex(2), Core::Stencil<3>(-2, 3));
+    testSync<0>(MIndex(2), Core::Stencil<3>({-1, 0, -3}, {2, 4, 1}));
+    testSync<1>(MIndex{1, 2, 4}, Core::Stencil<3>(-1, 2));
+}
+
+TEST(SynchronizerMPI, TensorialExchange)
+{
+    using MIndex = typename Mesh::StructuredUniform<double, 3>::MultiIndex;
+    testSync<0>(MIndex(2), Core::Stencil<3>(-2, 3, true));
+    testSync<0>(MIndex{8, 1, 1},
+                Core::Stencil<3>({-3, -1, 0}, {1, 3, 2}, true));
+    testSync<1>(MIndex{2, 4, 1}, Core::Stencil<3>(-1, 2, true));
+}
+
+TEST(SynchronizerMPI, NodeExchange)
+{
+    using MIndex = typename Mesh::StructuredUniform<double, 3>::MultiIndex;
+    testSyncSerial<EntityType::Node, 0>(MIndex(2),
+                                        Core::Stencil<3>(-2, 3, true));
+    testSyncSerial<EntityType::Node, 1>(MIndex{2, 4, 1},
+                                        Core::Stencil<3>(-1, 2, true));
+}
+
+TEST(SynchronizerMPI, FaceEntityExchange)
+{
+    using MIndex = typename Mesh::StructuredUniform<double, 3>::MultiIndex;
+    testSyncSerial<EntityType::Face, 0>(MIndex(2),
+                                        Core::Stencil<3>(-2, 3, true));
+    testSyncSerial<EntityType::Face, 1>(MIndex{1, 2, 4},
+                                        Core::Stencil<3>(-1, 2, true));
+}
+
+TEST(SynchronizerMPI, BlockOrder)
+{
+    using MIndex = typename Mesh::StructuredUniform<double, 3>::MultiIndex;
+    using Order = Cubism::Grid::BlockOrder;
+    testSync<0>(MIndex(2), Core::Stencil<3>(-2, 3, true), Order::Morton);
+    testSync<1>(MIndex{1, 2, 4}, Core::Stencil<3>(-1, 2), Order::Hilbert);
+}
+
+TEST(SynchronizerMPI, NeighborTable)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::CartesianMPI<double, Mesh, EntityType::Cell, 1>;
+    using Sync = Cubism::Grid::SynchronizerMPI<Grid>;
+    using Table = typename Sync::NeighborTableType;
+
+    const MIndex nprocs{2, 1, 4};
+    const MIndex nblocks{2, 1, 3};
+    Grid grid(MPI_COMM_WORLD, nprocs, nblocks, MIndex(4));
+    Sync sync(grid, Core::Stencil<3>(-1, 2, true));
+    const Table &table = sync.getNeighborTable();
+    EXPECT_EQ(table.size(), grid.size());
+
+    const MIndex gblocks = grid.getGlobalSize();
+    const MIndex p0 = grid.getProcIndex() * nblocks;
+    for (size_t k = 0; k < grid.size(); ++k) {
+        const auto &bf = grid[k];
+        const MIndex bi = bf.getState().block_index;
+        for (size_t n = 0; n < Table::NNeighbors; ++n) {
+            const MIndex q = bi + Table::getOffset(n);
+            const auto &e = table.getRow(k)[n];
+            bool local = true;
+            bool boundary = false;
+            for (size_t i = 0; i < 3; ++i) {
+                local = local && q[i] >= 0 && q[i] < nblocks[i];
+                const auto g = p0[i] + q[i];
+                boundary = boundary || g < 0 || g >= gblocks[i];
+            }
+            EXPECT_EQ(e.boundary, boundary);
+            // the full halo shell is exchanged for a tensorial stencil
+            EXPECT_EQ(e.remote, !local);
+            for (size_t c = 0; c < Grid::NComponents; ++c) {
+                auto nf = sync.getNeighborFunctor(bf, c);
+                auto pf = sync.getIndexFunctor(c);
+                EXPECT_EQ(&nf(q), &pf(q));
+            }
+        }
+    }
+}
+
+TEST(SynchronizerMPI, InnerHaloOverlap)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::CartesianMPI<double, Mesh, EntityType::Cell, 0>;
+    using Sync = Cubism::Grid::SynchronizerMPI<Grid>;
+    using FieldType = typename Grid::BaseType;
+    using Lab = Block::FieldLab<FieldType>;
+    using Stencil = typename Sync::StencilType;
+
+    const MIndex nblocks(4);
+    const MIndex block_cells(4);
+    Grid grid(MPI_COMM_WORLD, MIndex(2), nblocks, block_cells);
+    const MIndex gcells = grid.getGlobalSize() * block_cells;
+    const MIndex rank_cells = grid.getProcIndex() * nblocks * block_cells;
+    auto fexact = [gcells](MIndex p) -> double {
+        for (size_t i = 0; i < 3; ++i) {
+            p[i] = (p[i] + gcells[i]) % gcells[i];
+        }
+        return p[0] + gcells[0] * (p[1] + gcells[1] * p[2]);
+    };
+    for (auto f : grid) {
+        const MIndex b0 = rank_cells + f->getState().block_index * block_cells;
+        for (auto &p : f->getIndexRange()) {
+            (*f)[p] = fexact(b0 + p);
+        }
+    }
+
+    { // inner and halo blocks
+        const Stencil s(-1, 2);
+        EXPECT_EQ(grid.getInnerBlocks(s).size(), 8);
+        EXPECT_EQ(grid.getHaloBlocks(s).size(), 56);
+        const Stencil sx({0, -1, -1}, {1, 2, 2}); // no halo along x
+        EXPECT_EQ(grid.getInnerBlocks(sx).size(), 16);
+        EXPECT_TRUE(grid.isInnerBlock(MIndex{0, 1, 1}, sx));
+        EXPECT_FALSE(grid.isInnerBlock(MIndex{0, 0, 1}, sx));
+    }
+
+    const Stencil s(-2, 3, true);
+    Sync sync(grid, s);
+    EXPECT_EQ(sync.getInnerBlocks().size(), grid.getInnerBlocks(s).size());
+    EXPECT_EQ(sync.getHaloBlocks().size(), grid.getHaloBlocks(s).size());
+
+    Lab lab;
+    lab.allocate(s, grid[0].getIndexRange());
+    std::vector<int> visits(grid.size(), 0);
+    auto kernel = [&](FieldType &f) {
+        const MIndex &bi = f.getState().block_index;
+        const MIndex b0 = rank_cells + bi * block_cells;
+        sync.loadLab(f, lab);
+        for (auto &q : lab.getActiveLabRange()) {
+            const MIndex p = q + s.getBegin();
+            EXPECT_EQ(lab[p], fexact(b0 + p));
+        }
+        ++visits[typename Grid::IndexRangeType(nblocks).getFlatIndex(bi)];
+    };
+    for (int step = 0; step < 2; ++step) {
+        sync.processInner(kernel);
+        EXPECT_TRUE(sync.isActive());
+        sync.processHalo(kernel);
+        EXPECT_FALSE(sync.isActive());
+    }
+    for (const int v : visits) {
+        EXPECT_EQ(v, 2);
+    }
+    EXPECT_THROW(sync.processHalo(kernel), std::runtime_error);
+}
+
+TEST(SynchronizerMPI, PersistentExchange)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::CartesianMPI<double, Mesh, EntityType::Cell, 0>;
+    using FieldType = typename Grid::BaseType;
+    using Lab = Block::FieldLab<FieldType>;
+    using Stencil = typename Grid::StencilType;
+
+    const MIndex nblocks{3, 2, 1};
+    const MIndex block_cells(4);
+    Grid grid(MPI_COMM_WORLD, MIndex{2, 1, 4}, nblocks, block_cells);
+    const MIndex gcells = grid.getGlobalSize() * block_cells;
+    const MIndex rank_cells = grid.getProcIndex() * nblocks * block_cells;
+    auto fexact = [gcells](MIndex p, const int step) -> double {
+        for (size_t i = 0; i < 3; ++i) {
+            p[i] = (p[i] + gcells[i]) % gcells[i];
+        }
+        return p[0] + gcells[0] * (p[1] + gcells[1] * p[2]) +
+               step * gcells.prod();
+    };
+
+    // synchronizers are cached per stencil
+    const Stencil s(-1, 2, true);
+    auto &sync = grid.getSynchronizer(s);
+    EXPECT_EQ(&sync, &grid.getSynchronizer(Stencil(-1, 2, true)));
+    EXPECT_NE(&sync, &grid.getSynchronizer(Stencil(-1, 2, false)));
+    EXPECT_NE(&sync, &grid.getSynchronizer(Stencil(-2, 3, true)));
+
+    Lab lab;
+    lab.allocate(s, grid[0].getIndexRange());
+    for (int step = 0; step < 4; ++step) {
+        for (auto f : grid) {
+            const MIndex b0 =
+                rank_cells + f->getState().block_index * block_cells;
+            for (auto &p : f->getIndexRange()) {
+                (*f)[p] = fexact(b0 + p, step);
+            }
+        }
+        grid.getSynchronizer(s).sync();
+        for (auto f : grid) {
+            const MIndex b0 =
+                rank_cells + f->getState().block_index * block_cells;
+            sync.loadLab(*f, lab);
+            for (auto &q : lab.getActiveLabRange()) {
+                const MIndex p = q + s.getBegin();
+                EXPECT_EQ(lab[p], fexact(b0 + p, step));
+            }
+        }
+    }
+}
+
+TEST(SynchronizerMPI, StencilTooWide)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::CartesianMPI<double, Mesh, EntityType::Cell, 0>;
+    using Sync = Cubism::Grid::SynchronizerMPI<Grid>;
+
+    Grid grid(MPI_COMM_WORLD, MIndex(2), MIndex(1), MIndex(4));
+    EXPECT_THROW(Sync(grid, Core::Stencil<3>(-5, 2)), std::runtime_error);
+}
+} // namespace
@@ -0,0 +1,70 @@
+// File       : HugePageAllocatorTest.cpp
+// Created    : Thu Oct 15 2026 05:10:27 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Test transparent huge page block allocator
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/Alloc/HugePageAllocator.h"
+#include "Cubism/Grid/Cartesian.h"
+#include "Cubism/Mesh/StructuredUniform.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+TEST(Alloc, HugePageAllocator)
+{
+    using Alloc = Cubism::HugePageAllocator<double>;
+    using T = Alloc::DataType;
+
+    Alloc a;
+    { // small allocation
+        constexpr size_t N = 10;
+        size_t bytes = N * sizeof(T);
+        T *aptr = a.allocate(bytes);
+        EXPECT_TRUE(bytes % Alloc::Alignment == 0);
+        EXPECT_TRUE(reinterpret_cast<size_t>(aptr) % Alloc::Alignment == 0);
+        EXPECT_LT(bytes, Alloc::HugePageSize);
+        for (size_t i = 0; i < N; ++i) {
+            aptr[i] = static_cast<T>(i);
+            EXPECT_EQ(aptr[i], static_cast<T>(i));
+        }
+        a.deallocate(aptr);
+    }
+    { // huge page allocation
+        const size_t N = Alloc::HugePageSize / sizeof(T) + 3;
+        size_t bytes = N * sizeof(T);
+        T *aptr = a.allocate(bytes);
+        EXPECT_EQ(bytes, 2 * Alloc::HugePageSize);
+        EXPECT_TRUE(reinterpret_cast<size_t>(aptr) % Alloc::HugePageSize == 0);
+        for (size_t i = 0; i < N; ++i) {
+            aptr[i] = static_cast<T>(i);
+        }
+        EXPECT_EQ(aptr[N - 1], static_cast<T>(N - 1));
+        a.deallocate(aptr);
+    }
+}
+
+TEST(Alloc, HugePageAllocatorGrid)
+{
+    using namespace Cubism;
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::Cartesian<double,
+                                 Mesh,
+                                 EntityType::Cell,
+                                 0,
+                                 Block::FieldState,
+                                 HugePageAllocator>;
+
+    Grid grid(MIndex(4), MIndex(16));
+    EXPECT_TRUE(reinterpret_cast<size_t>(grid[0].getData()) %
+                    HugePageAllocator<double>::HugePageSize ==
+                0);
+    for (auto f : grid) {
+        f->getData()[0] = 1.0;
+    }
+    for (auto f : grid) {
+        EXPECT_EQ(f->getData()[0], 1.0);
+    }
+}
+} // namespace
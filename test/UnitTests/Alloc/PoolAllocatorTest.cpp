@@ -0,0 +1,163 @@
+// File       : PoolAllocatorTest.cpp
+// Created    : Thu Oct 15 2026 05:16:44 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Test pooled block allocator
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/Alloc/PoolAllocator.h"
+#include "Cubism/Grid/Cartesian.h"
+#include "Cubism/Mesh/StructuredUniform.h"
+#include "gtest/gtest.h"
+#include <limits>
+
+namespace
+{
+TEST(Alloc, PoolSizeClass)
+{
+    using Alloc = Cubism::PoolAllocator<char>;
+    using Pool = Cubism::BlockPool;
+    const size_t A = Alloc::Alignment;
+
+    EXPECT_EQ(Pool::getSizeClass(1), A);
+    EXPECT_EQ(Pool::getSizeClass(A), A);
+    EXPECT_EQ(Pool::getSizeClass(A + 1), 2 * A);
+    EXPECT_EQ(Pool::getSizeClass(1024), 1024);
+    EXPECT_EQ(Pool::getSizeClass(1025), 1152);
+    EXPECT_EQ(Pool::getSizeClass(2000), 2048);
+    for (size_t b = 1; b < 100000; b += 37) {
+        const size_t c = Pool::getSizeClass(b);
+        EXPECT_GE(c, b);
+        EXPECT_TRUE(c % A == 0);
+        EXPECT_LE(c - b, (b > 8 * A) ? b / 8 : A);
+    }
+}
+
+TEST(Alloc, PoolAllocator)
+{
+    using Alloc = Cubism::PoolAllocator<int>;
+    using T = Alloc::DataType;
+
+    Alloc::clear();
+    Alloc a;
+    constexpr size_t N = 1000;
+    size_t bytes = N * sizeof(T);
+    T *aptr = a.allocate(bytes);
+    EXPECT_TRUE(bytes % Alloc::Alignment == 0);
+    EXPECT_TRUE(reinterpret_cast<size_t>(aptr) % Alloc::Alignment == 0);
+    EXPECT_GE(bytes, N * sizeof(T));
+    for (size_t i = 0; i < N; ++i) {
+        aptr[i] = static_cast<int>(i);
+        EXPECT_EQ(aptr[i], static_cast<int>(i));
+    }
+
+    // recycled for a request of the same size class
+    a.deallocate(aptr);
+    EXPECT_EQ(Cubism::BlockPool::instance().getCachedBytes(), bytes);
+    size_t bytes2 = N * sizeof(T) - 3;
+    T *bptr = a.allocate(bytes2);
+    EXPECT_EQ(bptr, aptr);
+    EXPECT_EQ(bytes2, bytes);
+    EXPECT_EQ(Cubism::BlockPool::instance().getCachedBytes(), 0);
+
+    // different size class
+    size_t bytes3 = 4 * N * sizeof(T);
+    T *cptr = a.allocate(bytes3);
+    EXPECT_NE(cptr, bptr);
+    a.deallocate(bptr);
+    a.deallocate(cptr);
+    EXPECT_EQ(Cubism::BlockPool::instance().getCachedBytes(), bytes + bytes3);
+    Alloc::clear();
+    EXPECT_EQ(Cubism::BlockPool::instance().getCachedBytes(), 0);
+}
+
+TEST(Alloc, PoolCapacity)
+{
+    using Alloc = Cubism::PoolAllocator<char>;
+    using Pool = Cubism::BlockPool;
+    Pool &pool = Pool::instance();
+
+    Alloc::clear();
+    Alloc a;
+    size_t small = 1000;
+    size_t large = 8000;
+    char *s0 = a.allocate(small);
+    char *s1 = a.allocate(small);
+    char *l0 = a.allocate(large);
+
+    // blocks exceeding the capacity are returned to the system
+    pool.setCapacity(small + large);
+    EXPECT_EQ(pool.getCapacity(), small + large);
+    a.deallocate(s0);
+    a.deallocate(l0);
+    EXPECT_EQ(pool.getCachedBytes(), small + large);
+    a.deallocate(s1);
+    EXPECT_EQ(pool.getCachedBytes(), small + large);
+
+    // largest size classes are trimmed first
+    EXPECT_EQ(Alloc::trim(small), large);
+    EXPECT_EQ(pool.getCachedBytes(), small);
+    size_t bytes = small;
+    char *s2 = a.allocate(bytes);
+    EXPECT_EQ(s2, s0);
+    EXPECT_EQ(pool.getCachedBytes(), 0);
+    a.deallocate(s2);
+
+    // lowering the capacity trims the pool
+    pool.setCapacity(0);
+    EXPECT_EQ(pool.getCachedBytes(), 0);
+    pool.setCapacity(std::numeric_limits<size_t>::max());
+    Alloc::clear();
+}
+
+TEST(Alloc, PoolConcurrent)
+{
+    using Alloc = Cubism::PoolAllocator<char>;
+
+    Alloc::clear();
+#pragma omp parallel
+    {
+        Alloc a;
+        for (size_t i = 0; i < 1000; ++i) {
+            size_t bytes = 64 * (1 + i % 17);
+            char *p = a.allocate(bytes);
+            p[0] = 1;
+            p[bytes - 1] = 1;
+            a.deallocate(p);
+        }
+    }
+    EXPECT_GT(Cubism::BlockPool::instance().getCachedBytes(), 0);
+    Alloc::clear();
+    EXPECT_EQ(Cubism::BlockPool::instance().getCachedBytes(), 0);
+}
+
+TEST(Alloc, PoolAllocatorGrid)
+{
+    using namespace Cubism;
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::Cartesian<double,
+                                 Mesh,
+                                 EntityType::Cell,
+                                 1,
+                                 Block::FieldState,
+                                 PoolAllocator>;
+
+    PoolAllocator<double>::clear();
+    const double *data = nullptr;
+    {
+        Grid grid(MIndex(2), MIndex(8));
+        data = grid[0][0].getData();
+        for (auto f : grid) {
+            (*f)[0].getData()[0] = 1.0;
+        }
+    }
+    EXPECT_GT(BlockPool::instance().getCachedBytes(), 0);
+    {
+        // same topology reuses the released memory
+        Grid grid(MIndex(2), MIndex(8));
+        EXPECT_EQ(grid[0][0].getData(), data);
+        EXPECT_EQ(BlockPool::instance().getCachedBytes(), 0);
+    }
+    PoolAllocator<double>::clear();
+}
+} // namespace
@@ -0,0 +1,158 @@
+// File       : CharacteristicOutflowTest.cpp
+// Created    : Sat Oct 17 2026 03:02:18 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Characteristic outflow boundary condition test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/BC/CharacteristicOutflow.h"
+#include "Cubism/Block/Field.h"
+#include "Cubism/Block/TensorFieldLab.h"
+#include "Cubism/Common.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+using namespace Cubism;
+
+using TField = Block::TensorField<double, 1, Cubism::EntityType::Cell, 2>;
+using Lab = Block::TensorFieldLab<TField>;
+using Outflow = BC::CharacteristicOutflow<Lab>;
+using Waves = typename Outflow::WaveType;
+using Vec = typename Waves::VectorType;
+using IRange = typename Lab::IndexRangeType;
+using MIndex = typename Lab::MultiIndex;
+using Stencil = typename Lab::StencilType;
+
+double u0(const MIndex &p) { return 1.0 + 0.5 * p[0] + 0.25 * p[1]; }
+double u1(const MIndex &p) { return 2.0 - 0.3 * p[0] + 0.1 * p[1]; }
+
+void fillField(TField &f)
+{
+    for (const auto &p : f[0].getIndexRange()) {
+        f[0][p] = u0(p);
+        f[1][p] = u1(p);
+    }
+}
+
+Waves getWaves(const double angle, const Vec &speed, const Vec &target)
+{
+    // orthogonal eigenvectors, R = L^T
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    Waves w;
+    w.speed = speed;
+    w.left[0] = Vec{c, s};
+    w.left[1] = Vec{-s, c};
+    w.right[0] = Vec{c, -s};
+    w.right[1] = Vec{s, c};
+    w.target = target;
+    return w;
+}
+
+TEST(BC, CharacteristicOutflowDecoupled)
+{
+    const double h = 0.5;
+    const double dt = 0.1;
+    TField f(IRange(MIndex(8)));
+    fillField(f);
+    auto fields = [&f](const MIndex &) -> TField & { return f; };
+
+    // identity eigenvectors: independent waves
+    const Waves waves = getWaves(0, Vec{1.0, -2.0}, Vec{0.0, 3.0});
+    Outflow left(0, 0, waves, h);
+    Outflow right(0, 1, waves, h);
+    for (size_t c = 0; c < 2; ++c) {
+        f[c].getBC().push_back(&left.getComponentBC(c));
+        f[c].getBC().push_back(&right.getComponentBC(c));
+        EXPECT_FALSE(left.getComponentBC(c).getBoundaryInfo().is_periodic);
+    }
+
+    Lab lab;
+    lab.allocate(Stencil(-2, 3), f[0].getIndexRange());
+    lab.loadData(MIndex(0), fields);
+    left(lab, dt);
+    right(lab, dt);
+
+    const auto &l0 = lab.getLab(0);
+    const auto &l1 = lab.getLab(1);
+    for (int j = 0; j < 8; ++j) {
+        for (const int k : {1, 2}) {
+            const MIndex b0{0, j};
+            const MIndex b1{7, j};
+            const MIndex g0{-k, j};
+            const MIndex g1{7 + k, j};
+            // right: wave 0 outgoing, wave 1 incoming with nu = 0.4
+            const double a1 = std::min(1.0, 0.4 * k);
+            EXPECT_DOUBLE_EQ(l0[g1], u0(g1));
+            EXPECT_DOUBLE_EQ(l1[g1], u1(b1) + a1 * (3.0 - u1(b1)));
+            // left: wave 0 incoming with nu = 0.2, wave 1 outgoing
+            const double a0 = std::min(1.0, 0.2 * k);
+            EXPECT_DOUBLE_EQ(l0[g0], u0(b0) + a0 * (0.0 - u0(b0)));
+            EXPECT_DOUBLE_EQ(l1[g0], u1(g0));
+        }
+    }
+
+    // large time step imposes the far-field for incoming waves
+    right(lab, 10 * dt);
+    for (int j = 0; j < 8; ++j) {
+        for (const int k : {1, 2}) {
+            const MIndex g1{7 + k, j};
+            EXPECT_DOUBLE_EQ(l1[g1], 3.0);
+        }
+    }
+}
+
+TEST(BC, CharacteristicOutflowCoupled)
+{
+    const double h = 1.0;
+    const double dt = 0.25;
+    const double angle = 0.3;
+    TField f(IRange(MIndex(8)));
+    fillField(f);
+    auto fields = [&f](const MIndex &) -> TField & { return f; };
+
+    // time-dependent wave decomposition, evaluated once per slab
+    int ncalls = 0;
+    const Vec target{-1.0, 0.5};
+    Outflow top(1,
+                1,
+                [&ncalls, angle, target]() {
+                    ++ncalls;
+                    return getWaves(angle, Vec{2.0, -1.0}, target);
+                },
+                h);
+    for (size_t c = 0; c < 2; ++c) {
+        f[c].getBC().push_back(&top.getComponentBC(c));
+    }
+
+    Lab lab;
+    lab.allocate(Stencil(-3, 4), f[0].getIndexRange());
+    lab.loadData(MIndex(0), fields);
+    top(lab, dt);
+    EXPECT_EQ(ncalls, 1);
+
+    const Waves w = getWaves(angle, Vec{2.0, -1.0}, target);
+    const double winf = w.left[1].dot(target);
+    for (int i = 0; i < 8; ++i) {
+        const MIndex b0{i, 7};
+        const MIndex b1{i, 6};
+        const Vec v0{u0(b0), u1(b0)};
+        const Vec v1{u0(b1), u1(b1)};
+        for (const int k : {1, 2, 3}) {
+            Vec wk;
+            wk[0] = w.left[0].dot(v0) +
+                    k * (w.left[0].dot(v0) - w.left[0].dot(v1));
+            const double a = std::min(1.0, 0.25 * k);
+            wk[1] = w.left[1].dot(v0) + a * (winf - w.left[1].dot(v0));
+            const MIndex p{i, 7 + k};
+            EXPECT_NEAR(lab.getLab(0)[p], w.right[0].dot(wk), 1.0e-12);
+            EXPECT_NEAR(lab.getLab(1)[p], w.right[1].dot(wk), 1.0e-12);
+        }
+        // inner data is not modified
+        EXPECT_EQ(lab.getLab(0)[b0], u0(b0));
+        EXPECT_EQ(lab.getLab(1)[b0], u1(b0));
+    }
+}
+} // namespace
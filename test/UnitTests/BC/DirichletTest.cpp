@@ -114,4 +114,31 @@ TEST(BC, DirichletInterface)
 
     delete bc;
 }
+TEST(BC, DirichletCallback)
+{
+    using FAL = FieldAndLab<int, Cubism::EntityType::Cell, 3>;
+    using MIndex = typename FAL::MIndex;
+    using BCVector = typename FAL::BCVector;
+    using BC = BC::Dirichlet<typename FAL::FieldLab>;
+
+    int ncalls = 0;
+    int time = 3;
+    BC bc0(1, 0, [&]() {
+        ++ncalls;
+        return 2 * time;
+    });
+    BC bc1(1, 1, 7);
+    BCVector bcv{&bc0, &bc1};
+
+    FAL fal;
+    fal.loadData(&bcv);
+    const auto &range = fal.getLab().getActiveRange();
+    check<1>(fal, range, MIndex(0), range.getExtent(), 6, 7);
+    EXPECT_EQ(ncalls, 1); // once per slab
+
+    time = 4;
+    fal.loadData(&bcv);
+    check<1>(fal, range, MIndex(0), range.getExtent(), 8, 7);
+    EXPECT_EQ(ncalls, 2);
+}
 } // namespace
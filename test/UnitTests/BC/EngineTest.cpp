@@ -0,0 +1,146 @@
+// File       : EngineTest.cpp
+// Created    : Sat Oct 17 2026 12:21:35 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Batched boundary condition tests
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/BC/Absorbing.h"
+#include "Cubism/BC/Base.h"
+#include "Cubism/BC/Dirichlet.h"
+#include "Cubism/BC/Engine.h"
+#include "Cubism/BC/Symmetry.h"
+#include "Cubism/Block/Field.h"
+#include "Cubism/Block/FieldLab.h"
+#include "gtest/gtest.h"
+#include <numeric>
+#include <vector>
+
+namespace
+{
+using namespace Cubism;
+
+using Field = Block::Field<double, Cubism::EntityType::Cell, 3>;
+using IRange = typename Field::IndexRangeType;
+using MIndex = typename IRange::MultiIndex;
+using FieldLab = Block::FieldLab<Field>;
+using Stencil = typename FieldLab::StencilType;
+using BCVector = typename FieldLab::BCVector;
+
+using Dirichlet = BC::Dirichlet<FieldLab>;
+using Absorbing = BC::Absorbing<FieldLab>;
+using Symmetry = BC::Symmetry<FieldLab>;
+using List = BC::
+    TypedList<FieldLab, Dirichlet, Symmetry, Absorbing, Absorbing, Symmetry>;
+
+TEST(BC, BoundarySlab)
+{
+    const MIndex inner{8, 6, 4};
+    BC::BoundaryInfo info;
+    info.dir = 1;
+    info.side = 0;
+    info.is_periodic = false;
+
+    auto slab = BC::getBoundarySlab(info, Stencil(-2, 3), inner);
+    EXPECT_FALSE(slab.isEmpty());
+    EXPECT_EQ(slab.begin, (MIndex{0, -2, 0}));
+    EXPECT_EQ(slab.extent, (MIndex{8, 2, 4}));
+    EXPECT_EQ(slab.inner, 6);
+
+    info.side = 1;
+    slab = BC::getBoundarySlab(info, Stencil(-2, 3, true), inner);
+    EXPECT_EQ(slab.begin, (MIndex{-2, 6, -2}));
+    EXPECT_EQ(slab.extent, (MIndex{12, 2, 8}));
+
+    slab = BC::getBoundarySlab(info, Stencil(0, 1), inner);
+    EXPECT_TRUE(slab.isEmpty());
+}
+
+void runTest(const bool tensorial)
+{
+    const MIndex cells{9, 7, 5};
+    const IRange range(cells);
+    Field f(range);
+    std::iota(f.begin(), f.end(), 1);
+    auto fields = [&](const MIndex &) -> Field & { return f; };
+
+    const Stencil s(-3, 3, tensorial);
+    FieldLab lab_ref;
+    FieldLab lab_vec;
+    FieldLab lab_typed;
+    lab_ref.allocate(s, f.getIndexRange());
+    lab_vec.allocate(s, f.getIndexRange());
+    lab_typed.allocate(s, f.getIndexRange());
+
+    Dirichlet d0(0, 0, -1.0);
+    Symmetry s0(0, 1, -1.0);
+    Absorbing a1(1, 0);
+    Absorbing a2(1, 1);
+    Symmetry s2(2, 0, 1.0);
+    BCVector bcv{&d0, &s0, &a1, &a2, &s2};
+    List bcs(d0, s0, a1, a2, s2);
+    EXPECT_EQ(bcs.getBoundaryInfo()[2].dir, 1);
+    EXPECT_EQ(bcs.get<0>().getValue(), -1.0);
+
+    // reference: one boundary at a time through the virtual interface
+    lab_ref.loadData(MIndex(0), fields, bcv, false);
+    for (auto bc : bcv) {
+        (*bc)(lab_ref);
+    }
+
+    // load twice to exercise the cached slabs
+    for (int k = 0; k < 2; ++k) {
+        lab_vec.loadData(MIndex(0), fields, bcv);
+        lab_typed.loadData(MIndex(0), fields, bcs);
+        const IRange lr = lab_ref.getActiveLabRange();
+        const MIndex extent = lab_ref.getActiveRange().getExtent();
+        for (const auto &q : lr) {
+            const MIndex p = q + lr.getBegin();
+            size_t outside = 0;
+            for (size_t j = 0; j < 3; ++j) {
+                outside += (p[j] < 0 || p[j] >= extent[j]) ? 1 : 0;
+            }
+            if (!tensorial && outside > 1) {
+                continue; // corners are not loaded
+            }
+            EXPECT_EQ(lab_vec[p], lab_ref[p]);
+            EXPECT_EQ(lab_typed[p], lab_ref[p]);
+        }
+    }
+}
+
+TEST(BC, Engine)
+{
+    runTest(false);
+    runTest(true);
+}
+
+TEST(BC, EngineSlabCache)
+{
+    using NField = Block::Field<double, Cubism::EntityType::Node, 2>;
+    using NLab = Block::FieldLab<NField>;
+    using NIRange = typename NField::IndexRangeType;
+    using NMIndex = typename NIRange::MultiIndex;
+
+    BC::Dirichlet<NLab> bc(1, 1, 2.0);
+    typename NLab::BCVector bcv{&bc};
+    BC::Engine<2> engine;
+
+    NField f0(NIRange(NMIndex{4, 4}));
+    NField f1(NIRange(NMIndex{5, 4}));
+    NLab lab;
+    lab.allocate(typename NLab::StencilType(-1, 2), f1.getIndexRange());
+    for (NField *f : {&f0, &f1}) {
+        auto fields = [&](const NMIndex &) -> NField & { return *f; };
+        lab.loadData(NMIndex(0), fields, false);
+        engine.apply(lab, bcv);
+        ASSERT_EQ(engine.getSlabs().size(), 1);
+        NMIndex slab_extent = f->getIndexRange().getExtent();
+        slab_extent[1] = 1;
+        EXPECT_EQ(engine.getSlabs()[0].extent, slab_extent);
+        NMIndex p(4);
+        for (p[0] = 0; p[0] < slab_extent[0]; ++p[0]) {
+            EXPECT_EQ(lab[p], 2.0);
+        }
+    }
+}
+} // namespace
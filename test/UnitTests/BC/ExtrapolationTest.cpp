@@ -0,0 +1,141 @@
+// File       : ExtrapolationTest.cpp
+// Created    : Sat Oct 17 2026 02:03:16 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Extrapolation boundary test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/BC/Extrapolation.h"
+#include "BC/FieldAndLab.h"
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+using namespace Cubism;
+
+using FAL = FieldAndLab<double, Cubism::EntityType::Cell, 3>;
+using MIndex = typename FAL::MIndex;
+using IRange = typename FAL::IRange;
+using BCVector = typename FAL::BCVector;
+using BC = BC::Extrapolation<typename FAL::FieldLab>;
+
+// the field values are linear in the index, f(p) = p_x + 16 p_y + 256 p_z
+double linear(const MIndex &p) { return p[0] + 16.0 * p[1] + 256.0 * p[2]; }
+
+void testLinearField(const size_t order, const FAL::Tensorial t)
+{
+    BCVector bcv;
+    for (size_t d = 0; d < 3; ++d) {
+        bcv.push_back(new BC(d, 0, order));
+        bcv.push_back(new BC(d, 1, order));
+    }
+
+    FAL fal(t);
+    fal.loadData(&bcv);
+    const auto &lab = fal.getLab();
+    const IRange lr = lab.getActiveLabRange();
+    const MIndex extent = lab.getActiveRange().getExtent();
+    for (const auto &q : lr) {
+        const MIndex p = q + lr.getBegin();
+        size_t outside = 0;
+        for (size_t j = 0; j < 3; ++j) {
+            outside += (p[j] < 0 || p[j] >= extent[j]) ? 1 : 0;
+        }
+        if (FAL::Tensorial::Off == t && outside > 1) {
+            continue; // corners are not loaded
+        }
+        EXPECT_DOUBLE_EQ(lab[p], linear(p));
+    }
+
+    for (auto bc : bcv) {
+        delete bc;
+    }
+}
+
+TEST(BC, Extrapolation)
+{
+    EXPECT_EQ(BC(0, 0, 0).name(), std::string("Zeroth-Order Extrapolation"));
+    EXPECT_EQ(BC(0, 0, 1).name(), std::string("Linear Extrapolation"));
+    EXPECT_EQ(BC(0, 0, 2).name(), std::string("Quadratic Extrapolation"));
+    EXPECT_EQ(BC(0, 0).getOrder(), 1);
+    EXPECT_THROW(BC(0, 0, 3), std::runtime_error);
+
+    // linear and quadratic extrapolation are exact for linear data
+    testLinearField(1, FAL::Tensorial::Off);
+    testLinearField(1, FAL::Tensorial::On);
+    testLinearField(2, FAL::Tensorial::Off);
+    testLinearField(2, FAL::Tensorial::On);
+}
+
+TEST(BC, ExtrapolationQuadratic)
+{
+    // quadratic data along y
+    FAL fal;
+    auto &f = fal.getField();
+    for (const auto &p : f.getIndexRange()) {
+        f[p] = 0.5 * p[1] * p[1] - 3.0 * p[1] + 1.0;
+    }
+    BCVector bcv{new BC(1, 0, 2), new BC(1, 1, 2)};
+    fal.loadData(&bcv);
+    const auto &lab = fal.getLab();
+    const MIndex extent = lab.getActiveRange().getExtent();
+    MIndex slab = extent;
+    slab[1] = 3;
+    for (const auto &q : IRange(slab)) {
+        for (const int y : {-3, -2, -1, 16, 17, 18}) {
+            MIndex p = q;
+            p[1] = y;
+            EXPECT_DOUBLE_EQ(lab[p], 0.5 * y * y - 3.0 * y + 1.0);
+        }
+    }
+
+    // zeroth order
+    BCVector bcv0{new BC(2, 0, 0), new BC(2, 1, 0)};
+    fal.loadData(&bcv0);
+    const auto &lab0 = fal.getLab();
+    for (const auto &q : IRange(extent)) {
+        MIndex p = q;
+        p[2] = -1 - (q[2] % 3);
+        EXPECT_EQ(lab0[p], f[q - MIndex::getUnitVector(2) * q[2]]);
+    }
+
+    for (auto bc : bcv) {
+        delete bc;
+    }
+    for (auto bc : bcv0) {
+        delete bc;
+    }
+}
+
+TEST(BC, ExtrapolationThinBlock)
+{
+    // one inner cell along x, two along y
+    using Field = typename FAL::Field;
+    using Lab = typename FAL::FieldLab;
+    Field f(IRange(MIndex{1, 2, 8}));
+    for (const auto &p : f.getIndexRange()) {
+        f[p] = linear(p);
+    }
+    BC x0(0, 0, 0), x1(0, 1, 0);
+    BC y0(1, 0, 1), y1(1, 1, 1);
+    BCVector bcv{&x0, &x1, &y0, &y1};
+    Lab lab;
+    lab.allocate(typename FAL::Stencil(-3, 4), f.getIndexRange());
+    auto fields = [&f](const MIndex &) -> Field & { return f; };
+    lab.loadData(MIndex(0), fields, bcv);
+
+    for (const auto &q : f.getIndexRange()) {
+        for (const int k : {1, 2, 3}) {
+            MIndex p = q;
+            p[0] = -k;
+            EXPECT_EQ(lab[p], f[q]);
+            p[0] = k;
+            EXPECT_EQ(lab[p], f[q]);
+            p = q;
+            p[1] = (0 == q[1]) ? -k : 1 + k;
+            EXPECT_DOUBLE_EQ(lab[p], linear(p));
+        }
+    }
+}
+} // namespace
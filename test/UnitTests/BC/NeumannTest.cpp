@@ -0,0 +1,92 @@
+// File       : NeumannTest.cpp
+// Created    : Sat Oct 17 2026 02:31:40 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Neumann boundary test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/BC/Neumann.h"
+#include "BC/FieldAndLab.h"
+#include "gtest/gtest.h"
+#include <string>
+
+namespace
+{
+using namespace Cubism;
+
+using FAL = FieldAndLab<double, Cubism::EntityType::Cell, 3>;
+using MIndex = typename FAL::MIndex;
+using IRange = typename FAL::IRange;
+using BCVector = typename FAL::BCVector;
+using BC = BC::Neumann<typename FAL::FieldLab>;
+
+template <size_t dir>
+void check(const FAL &fal, const IRange &range, const double du)
+{
+    const auto &lab = fal.getLab();
+    const MIndex N = range.getExtent();
+    MIndex Nslab(N);
+    Nslab[dir] = 3;
+    const IRange halo_slab(Nslab);
+    for (const auto &p : halo_slab) {
+        const int k = p[dir] + 1;
+        MIndex q(p);
+        MIndex b(p);
+        q[dir] = -k; // side = 0
+        b[dir] = 0;
+        EXPECT_DOUBLE_EQ(lab[q], lab[b] - k * du);
+        q[dir] = N[dir] - 1 + k; // side = 1
+        b[dir] = N[dir] - 1;
+        EXPECT_DOUBLE_EQ(lab[q], lab[b] + k * du);
+    }
+}
+
+TEST(BC, Neumann)
+{
+    const double h = 0.25;
+    BCVector bcv;
+    bcv.push_back(new BC(0, 0, 1.0, h));
+    bcv.push_back(new BC(0, 1, 1.0, h));
+    bcv.push_back(new BC(1, 0, -2.0, h));
+    bcv.push_back(new BC(1, 1, -2.0, h));
+    bcv.push_back(new BC(2, 0, 4.0, h));
+    bcv.push_back(new BC(2, 1, 4.0, h));
+
+    EXPECT_EQ(bcv[0]->name(), std::string("Neumann"));
+
+    FAL fal;
+    fal.loadData(&bcv);
+    const auto &range = fal.getLab().getActiveRange();
+    check<0>(fal, range, 1.0 * h);
+    check<1>(fal, range, -2.0 * h);
+    check<2>(fal, range, 4.0 * h);
+
+    for (auto bc : bcv) {
+        delete bc;
+    }
+}
+
+TEST(BC, NeumannCallback)
+{
+    int ncalls = 0;
+    double time = 1.0;
+    auto gradient = [&]() {
+        ++ncalls;
+        return 3.0 * time;
+    };
+    BC bc0(2, 0, gradient);
+    BC bc1(2, 1, gradient);
+    BCVector bcv{&bc0, &bc1};
+
+    FAL fal(FAL::Tensorial::On);
+    fal.loadData(&bcv);
+    const auto &range = fal.getLab().getActiveRange();
+    check<2>(fal, range, 3.0);
+    EXPECT_EQ(ncalls, 2); // once per slab
+
+    time = 2.0;
+    fal.loadData(&bcv);
+    check<2>(fal, range, 6.0);
+    EXPECT_EQ(ncalls, 4);
+    EXPECT_EQ(bc0.getGradient(), 6.0);
+}
+} // namespace
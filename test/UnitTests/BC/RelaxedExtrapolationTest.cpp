@@ -0,0 +1,112 @@
+// File       : RelaxedExtrapolationTest.cpp
+// Created    : Sat Oct 17 2026 02:52:27 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Relaxed extrapolation boundary test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/BC/RelaxedExtrapolation.h"
+#include "BC/FieldAndLab.h"
+#include "gtest/gtest.h"
+#include <string>
+
+namespace
+{
+using namespace Cubism;
+
+using FAL = FieldAndLab<double, Cubism::EntityType::Cell, 3>;
+using MIndex = typename FAL::MIndex;
+using IRange = typename FAL::IRange;
+using BCVector = typename FAL::BCVector;
+using BC = BC::RelaxedExtrapolation<typename FAL::FieldLab>;
+
+void check(const FAL &fal,
+           const size_t dir,
+           const double target,
+           const double sigma)
+{
+    const auto &lab = fal.getLab();
+    const MIndex N = lab.getActiveRange().getExtent();
+    MIndex Nslab(N);
+    Nslab[dir] = 3;
+    const IRange halo_slab(Nslab);
+    for (const auto &p : halo_slab) {
+        const int k = p[dir] + 1;
+        MIndex q(p), b0(p), b1(p);
+        q[dir] = -k; // side = 0
+        b0[dir] = 0;
+        b1[dir] = 1;
+        double u0 = lab[b0];
+        double u1 = lab[b1];
+        EXPECT_DOUBLE_EQ(lab[q],
+                         u0 + k * ((u0 - u1) - sigma * (u0 - target)));
+        q[dir] = N[dir] - 1 + k; // side = 1
+        b0[dir] = N[dir] - 1;
+        b1[dir] = N[dir] - 2;
+        u0 = lab[b0];
+        u1 = lab[b1];
+        EXPECT_DOUBLE_EQ(lab[q],
+                         u0 + k * ((u0 - u1) - sigma * (u0 - target)));
+    }
+}
+
+TEST(BC, RelaxedExtrapolation)
+{
+    BCVector bcv;
+    for (size_t d = 0; d < 3; ++d) {
+        bcv.push_back(new BC(d, 0, 100.0, 0.1));
+        bcv.push_back(new BC(d, 1, 100.0, 0.1));
+    }
+    EXPECT_EQ(bcv[0]->name(), std::string("Relaxed Extrapolation"));
+
+    FAL fal;
+    fal.loadData(&bcv);
+    for (size_t d = 0; d < 3; ++d) {
+        check(fal, d, 100.0, 0.1);
+    }
+
+    // no relaxation: linear extrapolation
+    BC bc0(1, 0, 100.0, 0.0);
+    BC bc1(1, 1, 100.0, 0.0);
+    BCVector bcv0{&bc0, &bc1};
+    fal.loadData(&bcv0);
+    const auto &lab = fal.getLab();
+    for (const int y : {-3, -1, 16, 18}) {
+        const MIndex p{2, y, 5};
+        EXPECT_DOUBLE_EQ(lab[p], 2.0 + 16.0 * y + 256.0 * 5);
+    }
+
+    for (auto bc : bcv) {
+        delete bc;
+    }
+}
+
+TEST(BC, RelaxedExtrapolationCallback)
+{
+    int ncalls = 0;
+    double time = 0.0;
+    auto target = [&]() {
+        ++ncalls;
+        return 10.0 + time;
+    };
+    BC bc(0, 1, target, 0.5);
+    BCVector bcv{&bc};
+
+    FAL fal;
+    fal.loadData(&bcv);
+    EXPECT_EQ(ncalls, 1); // once per slab
+    time = 5.0;
+    fal.loadData(&bcv);
+    EXPECT_EQ(ncalls, 2);
+    EXPECT_EQ(bc.getSigma(), 0.5);
+
+    const auto &lab = fal.getLab();
+    const MIndex N = lab.getActiveRange().getExtent();
+    MIndex b0{0, 3, 4}, b1(b0), g(b0);
+    b0[0] = N[0] - 1;
+    b1[0] = N[0] - 2;
+    g[0] = N[0] + 1;
+    const double u0 = lab[b0];
+    const double u1 = lab[b1];
+    EXPECT_DOUBLE_EQ(lab[g], u0 + 2 * ((u0 - u1) - 0.5 * (u0 - 15.0)));
+}
+} // namespace
@@ -0,0 +1,126 @@
+// File       : CellMaskTest.cpp
+// Created    : Sat Oct 17 2026 04:21:37 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Block cell mask test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/Block/CellMask.h"
+#include "gtest/gtest.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using namespace Cubism;
+
+TEST(CellMask, Construction)
+{
+    using Mask = Block::CellMask<3>;
+    using IRange = typename Mask::IndexRangeType;
+    using MIndex = typename Mask::MultiIndex;
+
+    const IRange r(MIndex{5, 4, 7}); // 140 cells, not a multiple of 64
+    Mask fluid(r);
+    EXPECT_EQ(fluid.size(), 140);
+    EXPECT_EQ(fluid.getWords().size(), 3);
+    EXPECT_EQ(fluid.getSolidCount(), 0);
+    EXPECT_EQ(fluid.getState(), Block::MaskState::Fluid);
+
+    Mask solid(r, true);
+    EXPECT_EQ(solid.getSolidCount(), 140);
+    EXPECT_EQ(solid.getState(), Block::MaskState::Solid);
+    EXPECT_EQ(solid.getWords().back(), (1ull << (140 - 128)) - 1);
+    for (size_t i = 0; i < solid.size(); ++i) {
+        EXPECT_TRUE(solid.isSolid(i));
+    }
+}
+
+TEST(CellMask, SetAndState)
+{
+    using Mask = Block::CellMask<3>;
+    using IRange = typename Mask::IndexRangeType;
+    using MIndex = typename Mask::MultiIndex;
+
+    const IRange r(MIndex(4));
+    Mask m(r);
+    const MIndex p{1, 2, 3};
+    m.set(p, true);
+    EXPECT_TRUE(m.isSolid(p));
+    EXPECT_TRUE(m.isSolid(r.getFlatIndex(p)));
+    EXPECT_EQ(m.getSolidCount(), 1);
+    EXPECT_EQ(m.getState(), Block::MaskState::Mixed);
+
+    // setting twice does not change the count
+    m.set(p, true);
+    EXPECT_EQ(m.getSolidCount(), 1);
+    m.set(p, false);
+    m.set(p, false);
+    EXPECT_EQ(m.getSolidCount(), 0);
+    EXPECT_EQ(m.getState(), Block::MaskState::Fluid);
+
+    for (size_t i = 0; i < m.size(); ++i) {
+        m.set(i, true);
+    }
+    EXPECT_EQ(m.getState(), Block::MaskState::Solid);
+    m.fill(false);
+    EXPECT_EQ(m.getSolidCount(), 0);
+    EXPECT_FALSE(m.isSolid(p));
+}
+
+TEST(CellMask, FluidRuns)
+{
+    using Mask = Block::CellMask<1>;
+    using IRange = typename Mask::IndexRangeType;
+    using Run = std::pair<size_t, size_t>;
+
+    const IRange r(200);
+    Mask m(r);
+    auto runs = [&m]() {
+        std::vector<Run> v;
+        m.forEachFluidRun(
+            [&v](const size_t i, const size_t n) { v.push_back(Run(i, n)); });
+        return v;
+    };
+
+    EXPECT_EQ(runs(), std::vector<Run>({Run(0, 200)}));
+
+    // runs across word boundaries
+    m.set(0, true);
+    m.set(70, true);
+    m.set(71, true);
+    for (size_t i = 130; i < 199; ++i) {
+        m.set(i, true);
+    }
+    EXPECT_EQ(runs(),
+              std::vector<Run>({Run(1, 69), Run(72, 58), Run(199, 1)}));
+
+    // reference from single cell tests
+    std::vector<Run> ref;
+    for (size_t i = 0; i < m.size(); ++i) {
+        if (!m.isSolid(i)) {
+            if (ref.empty() || ref.back().first + ref.back().second != i) {
+                ref.push_back(Run(i, 0));
+            }
+            ++ref.back().second;
+        }
+    }
+    EXPECT_EQ(runs(), ref);
+
+    // fully solid words, including the partial last word
+    m.fill(true);
+    EXPECT_TRUE(runs().empty());
+    m.set(63, false);
+    m.set(128, false);
+    m.set(129, false);
+    EXPECT_EQ(runs(), std::vector<Run>({Run(63, 1), Run(128, 2)}));
+    m.fill(false);
+    for (size_t i = 64; i < 128; ++i) {
+        m.set(i, true);
+    }
+    for (size_t i = 192; i < 200; ++i) {
+        m.set(i, true);
+    }
+    EXPECT_EQ(runs(), std::vector<Run>({Run(0, 64), Run(128, 64)}));
+}
+} // namespace
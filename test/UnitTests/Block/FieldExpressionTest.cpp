@@ -0,0 +1,223 @@
+// File       : FieldExpressionTest.cpp
+// Created    : Thu Oct 15 2026 07:52:36 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Field expression template tests
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/Block/Field.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+using namespace Cubism;
+
+struct State {
+    int id = 0;
+};
+
+template <typename TField>
+void fillField(TField &f, const double offset)
+{
+    size_t k = 0;
+    for (auto &v : f) {
+        v = static_cast<typename TField::DataType>(offset + 0.5 * (k++ % 7));
+    }
+}
+
+TEST(FieldExpression, Scalar)
+{
+    using CellField = Block::Field<double, EntityType::Cell, 3, State>;
+    using IRange = typename CellField::IndexRangeType;
+    using MIndex = typename IRange::MultiIndex;
+
+    const IRange r(MIndex{5, 4, 3});
+    CellField a(r), b(r), c(r);
+    fillField(a, 1);
+    fillField(b, 2);
+    fillField(c, 3);
+    a.getState().id = 7;
+
+    // lazy expression types
+    const auto e = b + c * 2.0;
+    using E = typename std::decay<decltype(e)>::type;
+    static_assert(std::is_base_of<Block::FieldExpression<E>, E>::value,
+                  "expected field expression");
+    EXPECT_EQ(e.size(), r.size());
+    EXPECT_EQ(&e.getField(), &b);
+
+    // fused assignment
+    CellField d(r);
+    d = b + c * 2.0;
+    for (size_t i = 0; i < r.size(); ++i) {
+        EXPECT_EQ(d[i], b[i] + c[i] * 2.0);
+    }
+
+    // construction copies state of the first field operand
+    const CellField f = 0.5 * (a - b) / c + 1;
+    EXPECT_EQ(f.getState().id, a.getState().id);
+    EXPECT_NE(&f.getState(), &a.getState());
+    for (size_t i = 0; i < r.size(); ++i) {
+        EXPECT_EQ(f[i], 0.5 * (a[i] - b[i]) / c[i] + 1);
+    }
+
+    // aliasing and compound assignment
+    CellField g(a);
+    g = g + g * b;
+    for (size_t i = 0; i < r.size(); ++i) {
+        EXPECT_EQ(g[i], a[i] + a[i] * b[i]);
+    }
+    g = a;
+    g += 0.25 * (b - c);
+    g -= -a;
+    g *= b * b;
+    g /= c + 1;
+    for (size_t i = 0; i < r.size(); ++i) {
+        const double ref =
+            ((a[i] + 0.25 * (b[i] - c[i])) + a[i]) * (b[i] * b[i]) /
+            (c[i] + 1);
+        EXPECT_DOUBLE_EQ(g[i], ref);
+    }
+
+    // temporary operands are owned by the expression
+    const auto t = CellField(b) * 3.0;
+    b = c;
+    size_t k = 0;
+    for (const auto v : t) {
+        EXPECT_EQ(v, 3.0 * (2 + 0.5 * (k++ % 7)));
+    }
+    EXPECT_EQ(k, r.size());
+
+    // mixed data types
+    using FloatField = Block::Field<float, EntityType::Cell, 3>;
+    FloatField h(r);
+    fillField(h, 1);
+    h = h * 2 + a;
+    for (size_t i = 0; i < r.size(); ++i) {
+        EXPECT_EQ(h[i], static_cast<float>(2 * (1 + 0.5 * (i % 7)) + a[i]));
+    }
+}
+
+TEST(FieldExpression, Tensor)
+{
+    using TField = Block::TensorField<double, 1, EntityType::Cell, 3, State>;
+    using SField = typename TField::FieldType;
+    using IRange = typename TField::IndexRangeType;
+    using MIndex = typename IRange::MultiIndex;
+
+    const IRange r(MIndex(4));
+    TField u(r), v(r);
+    SField p(r);
+    for (size_t c = 0; c < TField::NComponents; ++c) {
+        fillField(u[c], c + 1);
+        fillField(v[c], 2 * c + 1);
+    }
+    fillField(p, 3);
+    u.getState().id = 5;
+
+    // fused component-wise update, scalar fields broadcast to components
+    TField w(u);
+    w = u + 0.5 * (v - u) * p;
+    for (size_t c = 0; c < TField::NComponents; ++c) {
+        for (size_t i = 0; i < r.size(); ++i) {
+            EXPECT_EQ(w[c][i], u[c][i] + 0.5 * (v[c][i] - u[c][i]) * p[i]);
+        }
+    }
+    w -= u;
+    for (size_t c = 0; c < TField::NComponents; ++c) {
+        for (size_t i = 0; i < r.size(); ++i) {
+            EXPECT_EQ(w[c][i], 0.5 * (v[c][i] - u[c][i]) * p[i]);
+        }
+    }
+
+    // construction
+    const TField x = -u * v;
+    EXPECT_EQ(x.getState().id, u.getState().id);
+    for (size_t c = 0; c < TField::NComponents; ++c) {
+        EXPECT_EQ(&x[c].getState(), &x.getState());
+        for (size_t i = 0; i < r.size(); ++i) {
+            EXPECT_EQ(x[c][i], -u[c][i] * v[c][i]);
+        }
+    }
+
+    // component iteration
+    size_t nc = 0;
+    for (const auto f : u + v) {
+        size_t i = 0;
+        for (const auto val : *f) {
+            EXPECT_EQ(val, u[nc][i] + v[nc][i]);
+            ++i;
+        }
+        ++nc;
+    }
+    EXPECT_EQ(nc, TField::NComponents);
+}
+
+TEST(FieldExpression, Container)
+{
+    using CellField = Block::Field<double, EntityType::Cell, 2>;
+    using FC = Block::FieldContainer<CellField>;
+    using IRange = typename CellField::IndexRangeType;
+    using MIndex = typename IRange::MultiIndex;
+    using FaceField = Block::FaceContainer<
+        Block::TensorField<double, 1, EntityType::Face, 2>>;
+    using FIRange = typename FaceField::IndexRangeType;
+
+    // incomplete containers skip nullptr components
+    const IRange r(MIndex(6));
+    FC a(3, r), b(3, r);
+    for (size_t c = 0; c < 3; ++c) {
+        fillField(a[c], c);
+        fillField(b[c], c + 1);
+    }
+    FC cp(std::vector<CellField *>{&a[0], nullptr, &a[2]});
+    cp = 2.0 * a - b;
+    EXPECT_EQ(cp.getContainer()[1], nullptr);
+    for (const size_t c : {0, 2}) {
+        for (size_t i = 0; i < r.size(); ++i) {
+            EXPECT_EQ(cp[c][i], 2.0 * a[c][i] - b[c][i]);
+        }
+    }
+    const FC cn = cp * cp;
+    EXPECT_EQ(cn.getContainer()[1], nullptr);
+    EXPECT_EQ(cn[2][3], cp[2][3] * cp[2][3]);
+
+    // complete destination, incomplete operands: components missing in an
+    // operand are not assigned
+    FC full(3, r);
+    fillField(full[1], 7);
+    std::vector<double> f1;
+    for (const auto v : full[1]) {
+        f1.push_back(v);
+    }
+    full = cp + cp;
+    full -= cp * 3.0;
+    for (size_t i = 0; i < r.size(); ++i) {
+        EXPECT_EQ(full[0][i], -cp[0][i]);
+        EXPECT_EQ(full[1][i], f1[i]);
+        EXPECT_EQ(full[2][i], -cp[2][i]);
+    }
+
+    // nested containers (face container of vector fields)
+    const FIRange fr(MIndex(4));
+    FaceField fa(fr), fb(fr);
+    for (size_t d = 0; d < fa.size(); ++d) {
+        for (size_t c = 0; c < 2; ++c) {
+            fillField(fa[d][c], d + c);
+            fillField(fb[d][c], 2 * d + c);
+        }
+    }
+    fa += fb * 3.0;
+    for (size_t d = 0; d < fa.size(); ++d) {
+        for (size_t c = 0; c < 2; ++c) {
+            for (size_t i = 0; i < fa[d][c].size(); ++i) {
+                const double a0 = d + c + 0.5 * (i % 7);
+                const double b0 = 2 * d + c + 0.5 * (i % 7);
+                EXPECT_EQ(fa[d][c][i], a0 + 3.0 * b0);
+            }
+        }
+    }
+}
+} // namespace
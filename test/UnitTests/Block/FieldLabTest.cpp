@@ -4,6 +4,7 @@
 // Description: Basic block data lab test
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 
+#include "Cubism/BC/Dirichlet.h"
 #include "Cubism/Block/Field.h"
 #include "Cubism/Block/FieldLab.h"
 #include "Cubism/Common.h"
@@ -112,6 +113,9 @@ TEST(FieldLab, Ghosts)
     runTest<int, 2, Cubism::EntityType::Node, true>();
     runTest<int, 2, Cubism::EntityType::Face, false>();
     runTest<int, 2, Cubism::EntityType::Face, true>();
+
+    runTest<int, 4, Cubism::EntityType::Cell, false>();
+    runTest<int, 4, Cubism::EntityType::Cell, true>();
 }
 
 TEST(FieldLab, Reuse)
@@ -151,6 +155,108 @@ TEST(FieldLab, Reuse)
     EXPECT_NE(b2, b1);
 }
 
+TEST(FieldLab, RefreshGhosts)
+{
+    using Field = Block::Field<int, Cubism::EntityType::Cell, 2>;
+    using IRange = typename Field::IndexRangeType;
+    using MIndex = typename IRange::MultiIndex;
+    using FContainer = Block::FieldContainer<Field>;
+    using FieldLab = Block::FieldLab<Field>;
+    using Stencil = typename FieldLab::StencilType;
+
+    const IRange block_range(MIndex(2));
+    FContainer fields;
+    for (size_t i = 0; i < block_range.size(); ++i) {
+        Field *f = new Field(IRange(MIndex(8)));
+        for (auto &v : *f) {
+            v = static_cast<int>(i);
+        }
+        fields.pushBack(f);
+    }
+    using Indexer =
+        Block::PeriodicIndexFunctor<FContainer, Field::Class, Field::Rank>;
+    Indexer i2f(fields, block_range);
+
+    FieldLab flab;
+    const Stencil s(-1, 2);
+    flab.allocate(s, fields[0].getIndexRange());
+    const MIndex fid(0);
+    EXPECT_THROW(flab.refreshGhosts(fid, i2f), std::runtime_error);
+    flab.loadData(fid, i2f);
+    EXPECT_EQ(flab(-1, 0), 1);
+    EXPECT_EQ(flab(0, -1), 2);
+
+    // update inner lab and neighbors, refresh ghosts only
+    flab(0, 0) = -1;
+    for (size_t i = 1; i < block_range.size(); ++i) {
+        for (auto &v : fields[i]) {
+            v = static_cast<int>(10 * i);
+        }
+    }
+    flab.refreshGhosts(fid, i2f);
+    EXPECT_EQ(flab(0, 0), -1);
+    EXPECT_EQ(flab(1, 0), 0);
+    EXPECT_EQ(flab(-1, 0), 10);
+    EXPECT_EQ(flab(8, 3), 10);
+    EXPECT_EQ(flab(0, -1), 20);
+    EXPECT_EQ(flab(3, 8), 20);
+    EXPECT_THROW(flab.refreshGhosts(MIndex(1), i2f), std::runtime_error);
+}
+
+TEST(FieldLab, ComputePrecision)
+{
+    using Field = Block::Field<float, Cubism::EntityType::Cell, 3>;
+    using IRange = typename Field::IndexRangeType;
+    using MIndex = typename IRange::MultiIndex;
+    using FieldLab = Block::FieldLab<Field, double>;
+    using Stencil = typename FieldLab::StencilType;
+
+    Field f(IRange(MIndex(8)));
+    float k = 0.1f;
+    for (auto &v : f) {
+        v = k;
+        k += 1.0f;
+    }
+    auto fields = [&](const MIndex &) -> Field & { return f; };
+
+    FieldLab flab;
+    const Stencil s(-1, 2, true);
+    flab.allocate(s, f.getIndexRange());
+    flab.loadData(MIndex(0), fields);
+    const IRange lr = flab.getActiveLabRange();
+    for (const auto &q : lr) {
+        const MIndex p = q + lr.getBegin();
+        MIndex r(p); // periodic projection
+        for (size_t i = 0; i < 3; ++i) {
+            r[i] = (r[i] + 8) % 8;
+        }
+        EXPECT_EQ(flab[p], static_cast<double>(f[r]));
+    }
+
+    // narrowing write-back
+    for (const auto &p : flab) {
+        flab[p] = 2.0 * flab[p];
+    }
+    Field g(f.getIndexRange());
+    flab.storeInner(g);
+    for (const auto &p : f.getIndexRange()) {
+        EXPECT_EQ(g[p], static_cast<float>(2.0 * static_cast<double>(f[p])));
+    }
+
+    // boundary conditions must be defined for the compute precision lab
+    BC::Dirichlet<FieldLab> lab_bc(0, 0, 1.0);
+    typename FieldLab::BCVector lab_bcs{&lab_bc};
+    flab.loadData(MIndex(0), fields, lab_bcs);
+    EXPECT_EQ(flab(-1, 0, 0), 1.0);
+    EXPECT_EQ(flab(8, 0, 0), static_cast<double>(f(0, 0, 0)));
+
+    BC::Dirichlet<Block::FieldLab<Field>> field_bc(0, 0, 1.0f);
+    f.getBC().push_back(&field_bc);
+    EXPECT_THROW(flab.loadData(MIndex(0), fields), std::runtime_error);
+    flab.loadData(MIndex(0), fields, false);
+    f.getBC().clear();
+}
+
 DISABLE_WARNING_PUSH
 DISABLE_WARNING_UNREFERENCED_FORMAL_VARIABLE
 
@@ -183,14 +289,14 @@ void testIndexer()
 
     using Indexer = Block::PeriodicIndexFunctor<FContainer, Field::Class, Rank>;
     Indexer i2f(fields, block_range, Comp, FDir);
-    IRange block_mirror(MIndex(9));
+    IRange block_mirror(MIndex(15));
     const MIndex block_extent = block_range.getExtent();
-    const MIndex shift(-3);
+    const MIndex shift(-7);
     for (auto i : block_mirror) {
         const MIndex q = i + shift;
         MIndex s(q);
         for (auto &v : s) {
-            v = (v + 3) % 3; // 3 as in block_range(3) above
+            v = (v % 3 + 3) % 3; // 3 as in block_range(3) above
         }
         EXPECT_EQ(i2f(q).getState().index, s);
     }
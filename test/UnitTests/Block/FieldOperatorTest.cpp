@@ -0,0 +1,81 @@
+// File       : FieldOperatorTest.cpp
+// Created    : Thu Oct 15 2026 06:34:18 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Block field math operator tests
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/Block/FieldOperator.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <vector>
+
+namespace
+{
+template <typename T>
+void testOperators()
+{
+    // odd sizes test remainder loops of vectorized kernels
+    for (const size_t n : {1, 3, 7, 16, 33, 1001}) {
+        std::vector<T> a(n), b(n), c(n);
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = static_cast<T>(i + 1) / 3;
+            b[i] = static_cast<T>(2 * n - i) / 7;
+        }
+        const T s = static_cast<T>(1.25);
+
+        fieldAdd(a.data(), b.data(), c.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(c[i], a[i] + b[i]);
+        }
+        fieldSub(a.data(), b.data(), c.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(c[i], a[i] - b[i]);
+        }
+        fieldMul(a.data(), b.data(), c.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(c[i], a[i] * b[i]);
+        }
+        fieldDiv(a.data(), b.data(), c.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(c[i], a[i] / b[i]);
+        }
+        fieldAdd(a.data(), s, c.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(c[i], a[i] + s);
+        }
+        fieldSub(a.data(), s, c.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(c[i], a[i] - s);
+        }
+        fieldMul(a.data(), s, c.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(c[i], a[i] * s);
+        }
+        fieldDiv(a.data(), s, c.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(c[i], a[i] / s);
+        }
+        fieldRcp(a.data(), s, c.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(c[i], s * (1 / a[i]));
+        }
+
+        // in-place
+        std::memcpy(c.data(), a.data(), n * sizeof(T));
+        fieldAdd(c.data(), b.data(), c.data(), n);
+        fieldMul(c.data(), s, c.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_EQ(c[i], (a[i] + b[i]) * s);
+        }
+    }
+}
+
+TEST(FieldOperator, Arithmetic)
+{
+    testOperators<double>();
+    testOperators<float>();
+#ifdef CUBISM_OPTIMIZED_FIELD_OP
+    EXPECT_NE(fieldOperatorISA(), nullptr);
+#endif /* CUBISM_OPTIMIZED_FIELD_OP */
+}
+} // namespace
@@ -416,6 +416,49 @@ TEST(Field, Arithmetic)
     }
 }
 
+TEST(Field, LinearCombination)
+{
+    using CellField = Block::Field<double, EntityType::Cell, 3>; // 3D
+    using IRange = typename CellField::IndexRangeType;
+    using MIndex = typename IRange::MultiIndex;
+
+    // odd size to exercise SIMD remainder loops
+    IRange cell_domain(MIndex{5, 3, 7});
+    CellField u0(cell_domain);
+    CellField u1(cell_domain);
+    CellField rhs(cell_domain);
+    std::fill(u0.begin(), u0.end(), 1);
+    std::fill(u1.begin(), u1.end(), 2);
+    std::fill(rhs.begin(), rhs.end(), 4);
+
+    { // y = a * x + y
+        auto y(u1);
+        y.axpy(0.5, rhs);
+        for (const auto c : y) {
+            EXPECT_EQ(c, 4);
+        }
+    }
+    { // y = a * x + b * y
+        auto y(u1);
+        y.axpby(0.5, rhs, -3);
+        for (const auto c : y) {
+            EXPECT_EQ(c, -4);
+        }
+    }
+    { // u = a * u0 + b * u1 + c * rhs
+        CellField u(cell_domain);
+        u.linComb(1, u0, 0.5, u1, 0.25, rhs);
+        for (const auto c : u) {
+            EXPECT_EQ(c, 3);
+        }
+        // aliased destination
+        u.linComb(2, u, -1, u0, 0.25, rhs);
+        for (const auto c : u) {
+            EXPECT_EQ(c, 6);
+        }
+    }
+}
+
 TEST(FieldContainer, Construction)
 {
     using NodeField = Block::Field<char, EntityType::Node, 5>; // 5D
@@ -956,6 +999,44 @@ TEST(FieldContainer, Arithmetic)
     }
 }
 
+TEST(FieldContainer, LinearCombination)
+{
+    using CellField = Block::Field<float, EntityType::Cell, 2>; // 2D
+    using IRange = typename CellField::IndexRangeType;
+    using MIndex = typename IRange::MultiIndex;
+
+    using FC = Block::FieldContainer<CellField>;
+    IRange cell_domain(MIndex{9, 5});
+    FC u0(3, cell_domain);
+    FC u1(3, cell_domain);
+    for (auto f : u0) {
+        std::fill(f->begin(), f->end(), 1);
+    }
+    for (auto f : u1) {
+        std::fill(f->begin(), f->end(), 2);
+    }
+
+    FC y(u1);
+    y.axpy(2, u0);
+    for (const auto f : y) {
+        for (const auto c : *f) {
+            EXPECT_EQ(c, 4);
+        }
+    }
+    y.axpby(-1, u1, 0.5);
+    for (const auto f : y) {
+        for (const auto c : *f) {
+            EXPECT_EQ(c, 0);
+        }
+    }
+    y.linComb(1, u0, 1, u1, 0.5, u1);
+    for (const auto f : y) {
+        for (const auto c : *f) {
+            EXPECT_EQ(c, 4);
+        }
+    }
+}
+
 TEST(FieldContainer, Containment)
 {
     using NodeField = Block::Field<char, EntityType::Node, 2>;
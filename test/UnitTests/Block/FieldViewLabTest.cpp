@@ -0,0 +1,124 @@
+// File       : FieldViewLabTest.cpp
+// Created    : Fri Oct 16 2026 04:58:37 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Data lab view test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/BC/Dirichlet.h"
+#include "Cubism/Block/Field.h"
+#include "Cubism/Block/FieldLab.h"
+#include "Cubism/Block/FieldViewLab.h"
+#include "Cubism/Common.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+using namespace Cubism;
+
+template <size_t DIM, bool TENSORIAL>
+void runTest()
+{
+    using Field = Block::Field<double, Cubism::EntityType::Cell, DIM>;
+    using IRange = typename Field::IndexRangeType;
+    using MIndex = typename IRange::MultiIndex;
+    using Index = typename MIndex::DataType;
+    using FContainer = Block::FieldContainer<Field>;
+    using FieldLab = Block::FieldLab<Field>;
+    using ViewLab = Block::FieldViewLab<Field>;
+    using Stencil = typename FieldLab::StencilType;
+    using Indexer =
+        Block::PeriodicIndexFunctor<FContainer, Field::Class, Field::Rank>;
+
+    const IRange block_range(MIndex(3));
+    FContainer fields;
+    double k = 0;
+    for (size_t i = 0; i < block_range.size(); ++i) {
+        Field *f = new Field(IRange(MIndex(8)));
+        for (auto &v : *f) {
+            v = k;
+            k += 1;
+        }
+        fields.pushBack(f);
+    }
+    Indexer i2f(fields, block_range);
+
+    const Stencil s(-2, 3, TENSORIAL);
+    FieldLab flab;
+    ViewLab vlab;
+    EXPECT_THROW(vlab.loadData(MIndex(0), i2f), std::runtime_error);
+    flab.allocate(s, fields[0].getIndexRange());
+    vlab.allocate(s, fields[0].getIndexRange());
+    EXPECT_TRUE(vlab.isAllocated());
+
+    for (const auto &bi : block_range) {
+        flab.loadData(bi, i2f);
+        vlab.loadData(bi, i2f);
+        EXPECT_EQ(&vlab.getActiveField(), &flab.getActiveField());
+        EXPECT_EQ(vlab.getInnerData(), flab.getActiveField().getData());
+        EXPECT_EQ(vlab.getActiveLabRange().getBegin(),
+                  flab.getActiveLabRange().getBegin());
+        EXPECT_EQ(vlab.getActiveLabRange().getEnd(),
+                  flab.getActiveLabRange().getEnd());
+        const IRange lr = flab.getActiveLabRange();
+        const MIndex extent = flab.getActiveRange().getExtent();
+        for (const auto &q : lr) {
+            const MIndex p = q + lr.getBegin();
+            size_t outside = 0;
+            for (size_t j = 0; j < DIM; ++j) {
+                outside += (p[j] < 0 || p[j] >= extent[j]) ? 1 : 0;
+            }
+            if (!TENSORIAL && outside > 1) {
+                continue; // corners are not loaded
+            }
+            EXPECT_EQ(vlab[p], flab[p]);
+        }
+
+        // branch-free inner access
+        const double *inner = vlab.getInnerData();
+        for (const auto &p : flab.getActiveRange()) {
+            Index k = 0;
+            for (size_t j = 0; j < DIM; ++j) {
+                k += p[j] * vlab.getInnerStride(j);
+            }
+            EXPECT_EQ(inner[k], flab[p]);
+        }
+    }
+
+    // inner domain is aliased
+    vlab.loadData(MIndex(0), i2f);
+    fields[0][0] = -1;
+    EXPECT_EQ(vlab(0), -1);
+    EXPECT_EQ(vlab[MIndex(0)], -1);
+}
+
+TEST(FieldViewLab, Ghosts)
+{
+    runTest<1, false>();
+    runTest<2, true>();
+    runTest<3, false>();
+    runTest<3, true>();
+}
+
+TEST(FieldViewLab, BoundaryConditions)
+{
+    using Field = Block::Field<double, Cubism::EntityType::Cell, 2>;
+    using IRange = typename Field::IndexRangeType;
+    using MIndex = typename IRange::MultiIndex;
+    using FContainer = Block::FieldContainer<Field>;
+    using ViewLab = Block::FieldViewLab<Field>;
+    using Stencil = typename ViewLab::StencilType;
+    using Indexer =
+        Block::PeriodicIndexFunctor<FContainer, Field::Class, Field::Rank>;
+    using BC = BC::Dirichlet<Block::FieldLab<Field>>;
+
+    FContainer fields;
+    fields.pushBack(new Field(IRange(MIndex(8))));
+    Indexer i2f(fields, IRange(MIndex(1)));
+    BC dirichlet(0, 0, 1.0);
+    fields[0].getBC().push_back(&dirichlet);
+
+    ViewLab vlab;
+    vlab.allocate(Stencil(-1, 2), fields[0].getIndexRange());
+    EXPECT_THROW(vlab.loadData(MIndex(0), i2f), std::runtime_error);
+}
+} // namespace
@@ -0,0 +1,133 @@
+// File       : FixedFieldLabTest.cpp
+// Created    : Fri Oct 16 2026 09:48:30 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Compile-time data lab test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/Block/Field.h"
+#include "Cubism/Block/FieldLab.h"
+#include "Cubism/Block/FixedFieldLab.h"
+#include "Cubism/Common.h"
+#include "Cubism/Core/BlockShape.h"
+#include "Cubism/Core/Stencil.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+using namespace Cubism;
+
+template <typename Field, typename Shape, typename Stencil>
+void runTest()
+{
+    using IRange = typename Field::IndexRangeType;
+    using MIndex = typename IRange::MultiIndex;
+    using FContainer = Block::FieldContainer<Field>;
+    using FieldLab = Block::FieldLab<Field>;
+    using FixedLab = Block::FixedFieldLab<Field, Shape, Stencil>;
+    using Indexer =
+        Block::PeriodicIndexFunctor<FContainer, Field::Class, Field::Rank>;
+    constexpr size_t DIM = IRange::Dim;
+
+    const IRange block_range(MIndex(3));
+    const MIndex cells = Shape::getExtent();
+    FContainer fields;
+    typename Field::DataType k = 0;
+    for (size_t i = 0; i < block_range.size(); ++i) {
+        MIndex extent = cells;
+        if (Field::EntityType == Cubism::EntityType::Node) {
+            const MIndex bi = block_range.getMultiIndex(i);
+            for (size_t d = 0; d < DIM; ++d) {
+                extent[d] += (bi[d] == block_range.getExtent()[d] - 1) ? 1 : 0;
+            }
+        }
+        Field *f = new Field(IRange(extent));
+        for (auto &v : *f) {
+            v = k;
+            k += 1;
+        }
+        fields.pushBack(f);
+    }
+    Indexer i2f(fields, block_range);
+
+    FieldLab flab;
+    FixedLab xlab;
+    flab.allocate(FixedLab::getStencil(), FixedLab::getMaximumShapeRange());
+    xlab.allocate();
+    EXPECT_TRUE(xlab.isAllocated());
+    EXPECT_EQ(xlab.getActiveStencil(), FixedLab::getStencil());
+
+    MIndex lab_begin;
+    const MIndex extent = FieldLab::getLabExtent(
+        FixedLab::getStencil(), FixedLab::getMaximumShapeRange(), lab_begin);
+    for (size_t d = 0; d < DIM; ++d) {
+        EXPECT_EQ(FixedLab::getExtent(d), extent[d]);
+    }
+    EXPECT_EQ(FixedLab::getExtent(DIM), 1);
+
+    // allocation through the base class, with reallocation
+    FixedLab blab;
+    FieldLab &base = blab;
+    base.allocate(FixedLab::getStencil(), IRange(MIndex(1)));
+    base.allocate(FixedLab::getStencil(), FixedLab::getMaximumShapeRange());
+    EXPECT_EQ(blab.getIndexRange().getExtent(), extent);
+
+    for (const auto &bi : block_range) {
+        flab.loadData(bi, i2f);
+        xlab.loadData(bi, i2f);
+        blab.loadData(bi, i2f);
+        const IRange lr = flab.getActiveLabRange();
+        const MIndex inner = flab.getActiveRange().getExtent();
+        for (const auto &q : lr) {
+            const MIndex p = q + lr.getBegin();
+            size_t outside = 0;
+            for (size_t j = 0; j < DIM; ++j) {
+                outside += (p[j] < 0 || p[j] >= inner[j]) ? 1 : 0;
+            }
+            if (!Stencil::IsTensorial && outside > 1) {
+                continue; // corners are not loaded
+            }
+            MIndex r(0);
+            for (size_t j = 0; j < DIM; ++j) {
+                r[j] = p[j];
+            }
+            const FixedLab &cxlab = xlab;
+            if (1 == DIM) {
+                EXPECT_EQ(xlab(r[0]), flab(r[0]));
+                EXPECT_EQ(&cxlab(r[0]), &xlab[p]);
+            } else if (2 == DIM) {
+                EXPECT_EQ(xlab(r[0], r[1]), flab(r[0], r[1]));
+                EXPECT_EQ(&cxlab(r[0], r[1]), &xlab[p]);
+            } else {
+                EXPECT_EQ(xlab(r[0], r[1], r[2]), flab(r[0], r[1], r[2]));
+                EXPECT_EQ(&cxlab(r[0], r[1], r[2]), &xlab[p]);
+                EXPECT_EQ(blab(r[0], r[1], r[2]), flab(r[0], r[1], r[2]));
+            }
+        }
+    }
+}
+
+TEST(FixedFieldLab, Static)
+{
+    EXPECT_EQ(Core::BlockShape<8>::Dim, 1);
+    EXPECT_EQ((Core::BlockShape<8, 4, 2>::prod()), 64);
+    EXPECT_EQ((Core::BlockShape<8, 4, 2>::size(1)), 4);
+    EXPECT_EQ((Core::BlockShape<8, 4, 2>::size(3)), 1);
+    EXPECT_EQ((Core::StaticStencil<-3, 4>::getStencil<3>()),
+              Core::Stencil<3>(-3, 4));
+    EXPECT_EQ((Core::StaticStencil<-1, 2, true>::getStencil<2>()),
+              Core::Stencil<2>(-1, 2, true));
+}
+
+TEST(FixedFieldLab, LoadData)
+{
+    using C1 = Block::Field<double, Cubism::EntityType::Cell, 1>;
+    runTest<C1, Core::BlockShape<16>, Core::StaticStencil<-3, 4>>();
+
+    using N2 = Block::Field<float, Cubism::EntityType::Node, 2>;
+    runTest<N2, Core::BlockShape<8, 4>, Core::StaticStencil<-1, 2, true>>();
+
+    using C3 = Block::Field<double, Cubism::EntityType::Cell, 3>;
+    runTest<C3, Core::BlockShape<8, 8, 8>, Core::StaticStencil<-3, 4>>();
+    runTest<C3, Core::BlockShape<4, 6, 8>, Core::StaticStencil<-1, 3, true>>();
+}
+} // namespace
@@ -0,0 +1,128 @@
+// File       : RefinementTest.cpp
+// Created    : Sat Oct 17 2026 08:41:19 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Restriction and prolongation test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/Block/Refinement.h"
+#include "Cubism/Block/Field.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+using namespace Cubism;
+
+TEST(Refinement, Restrict)
+{
+    using Field = Block::Field<double, EntityType::Cell, 2>;
+    using IRange = typename Field::IndexRangeType;
+    using MIndex = typename Field::MultiIndex;
+
+    const IRange range(MIndex{8, 6});
+    Field fine(range);
+    Field coarse(range);
+    for (auto &p : range) {
+        fine[p] = 1.0 + 2.0 * p[0] - 3.0 * p[1];
+        coarse[p] = -1.0;
+    }
+    // fine block is the upper right quadrant
+    const MIndex offset{4, 3};
+    Block::restrictBlock(fine, coarse, offset);
+    for (auto &p : range) {
+        if (p[0] < offset[0] || p[1] < offset[1]) {
+            EXPECT_EQ(coarse[p], -1.0);
+        } else {
+            // linear data: average is the value at the coarse cell center
+            const MIndex q = p - offset;
+            EXPECT_DOUBLE_EQ(coarse[p],
+                             1.0 + 2.0 * (2 * q[0] + 0.5) -
+                                 3.0 * (2 * q[1] + 0.5));
+        }
+    }
+}
+
+TEST(Refinement, Prolongate)
+{
+    using Field = Block::Field<double, EntityType::Cell, 3>;
+    using IRange = typename Field::IndexRangeType;
+    using MIndex = typename Field::MultiIndex;
+
+    const IRange range(MIndex(8));
+    Field coarse(range);
+    Field fine(range);
+    Field back(range);
+    for (auto &p : range) {
+        coarse[p] = 0.5 * p[0] + p[1] - 2.0 * p[2];
+    }
+
+    const MIndex offset{4, 0, 4};
+    Block::prolongateBlock(coarse, offset, fine);
+    // conservative: restriction recovers the coarse data
+    Block::restrictBlock(fine, back, MIndex(0));
+    for (auto &p : IRange(MIndex(4))) {
+        EXPECT_DOUBLE_EQ(back[p], coarse[offset + p]);
+    }
+    // exact for linear data away from the coarse field boundary
+    for (auto &p : range) {
+        const MIndex c = offset + p / 2;
+        if (MIndex(0) < c && c < MIndex(7)) {
+            const double x = offset[0] + 0.5 * p[0] - 0.25;
+            const double y = offset[1] + 0.5 * p[1] - 0.25;
+            const double z = offset[2] + 0.5 * p[2] - 0.25;
+            EXPECT_DOUBLE_EQ(fine[p], 0.5 * x + y - 2.0 * z);
+        }
+    }
+
+    // constant data
+    for (auto &p : range) {
+        coarse[p] = 3.0;
+    }
+    Block::prolongateBlock(coarse, MIndex(0), fine);
+    for (auto &p : range) {
+        EXPECT_EQ(fine[p], 3.0);
+    }
+}
+
+TEST(Refinement, SubRange)
+{
+    using Field = Block::Field<double, EntityType::Cell, 2>;
+    using IRange = typename Field::IndexRangeType;
+    using MIndex = typename Field::MultiIndex;
+
+    const IRange range(MIndex(8));
+    Field coarse(range);
+    Field fine(range);
+    Field full(range);
+    for (auto &p : range) {
+        coarse[p] = p[0] * p[0] + 0.5 * p[1];
+        fine[p] = -1.0;
+    }
+    const MIndex offset{4, 0};
+    const IRange sub(MIndex{0, 1}, MIndex{2, 3});
+    Block::prolongateBlock(coarse, offset, fine, sub);
+    Block::prolongateBlock(coarse, offset, full);
+    // children of the coarse cells in sub
+    const MIndex wbegin{0, 2};
+    const MIndex wend{4, 6};
+    for (auto &p : range) {
+        if (p >= wbegin && p < wend) {
+            EXPECT_EQ(fine[p], full[p]);
+        } else {
+            EXPECT_EQ(fine[p], -1.0);
+        }
+    }
+
+    for (auto &p : range) {
+        coarse[p] = -1.0;
+    }
+    Block::restrictBlock(full, coarse, offset, sub);
+    for (auto &p : range) {
+        const MIndex q = p - offset;
+        if (q >= sub.getBegin() && q < sub.getEnd()) {
+            EXPECT_DOUBLE_EQ(coarse[p], p[0] * p[0] + 0.5 * p[1]);
+        } else {
+            EXPECT_EQ(coarse[p], -1.0);
+        }
+    }
+}
+} // namespace
@@ -0,0 +1,244 @@
+// File       : TensorFieldLabTest.cpp
+// Created    : Fri Oct 16 2026 03:02:51 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Batched multi-component data lab test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/BC/Dirichlet.h"
+#include "Cubism/Block/Field.h"
+#include "Cubism/Block/FieldLab.h"
+#include "Cubism/Block/TensorFieldLab.h"
+#include "Cubism/Common.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+namespace
+{
+using namespace Cubism;
+
+template <typename TField>
+class BlockSet
+{
+public:
+    using IRange = typename TField::IndexRangeType;
+    using MIndex = typename IRange::MultiIndex;
+    using Component =
+        Block::ScalarComponent<TField, TField::Class, TField::Rank>;
+    static constexpr size_t NGroups =
+        Block::TensorFieldLab<TField>::NGroups;
+
+    BlockSet(const MIndex &nblocks, const MIndex &cells) : range_(nblocks)
+    {
+        typename TField::DataType k = 0;
+        for (size_t i = 0; i < range_.size(); ++i) {
+            TField *f = new TField(IRange(cells));
+            for (size_t d = 0; d < NGroups; ++d) {
+                for (size_t c = 0; c < TField::NComponents; ++c) {
+                    for (auto &v : Component::get(*f, c, d)) {
+                        v = k;
+                        k += 1;
+                    }
+                }
+            }
+            blocks_.push_back(f);
+        }
+    }
+
+    ~BlockSet()
+    {
+        for (auto f : blocks_) {
+            delete f;
+        }
+    }
+
+    TField &operator()(MIndex p)
+    {
+        const MIndex extent = range_.getExtent();
+        for (size_t i = 0; i < IRange::Dim; ++i) {
+            p[i] = (p[i] + extent[i]) % extent[i];
+        }
+        return *blocks_[range_.getFlatIndex(p)];
+    }
+
+    const IRange &getRange() const { return range_; }
+
+private:
+    const IRange range_;
+    std::vector<TField *> blocks_;
+};
+
+template <typename TField, Block::LabLayout Layout, bool TENSORIAL>
+void runTest()
+{
+    using TLab = Block::TensorFieldLab<TField, Layout>;
+    using SLab = Block::FieldLab<typename TField::FieldType>;
+    using SField = typename TField::FieldType;
+    using IRange = typename TLab::IndexRangeType;
+    using MIndex = typename IRange::MultiIndex;
+    using Stencil = typename TLab::StencilType;
+    using Component =
+        Block::ScalarComponent<TField, TField::Class, TField::Rank>;
+    constexpr size_t Dim = IRange::Dim;
+
+    const MIndex cells(8);
+    BlockSet<TField> blocks(MIndex(3), cells);
+    const IRange max_range(cells + 1); // largest face field
+
+    const Stencil s(-2, 3, TENSORIAL);
+    TLab tlab;
+    SLab slab;
+    tlab.allocate(s, max_range);
+    slab.allocate(s, max_range);
+    EXPECT_TRUE(tlab.isAllocated());
+    EXPECT_EQ(tlab.getMaximumRange().getExtent(),
+              slab.getMaximumRange().getExtent());
+
+    for (const auto &bi : blocks.getRange()) {
+        tlab.loadData(bi, blocks);
+        for (size_t d = 0; d < TLab::NGroups; ++d) {
+            for (size_t c = 0; c < TLab::NComponents; ++c) {
+                auto id2field = [&](const MIndex &p) -> SField & {
+                    return Component::get(blocks(p), c, d);
+                };
+                slab.loadData(bi, id2field);
+                const size_t si = TLab::index(c, d);
+                const IRange ar = slab.getActiveRange();
+                EXPECT_EQ(tlab.getActiveRange(si).getExtent(), ar.getExtent());
+                const MIndex extent = ar.getExtent();
+                const IRange lr = slab.getActiveLabRange();
+                for (const auto &q : lr) {
+                    const MIndex p = q + lr.getBegin();
+                    size_t outside = 0;
+                    for (size_t j = 0; j < Dim; ++j) {
+                        outside += (p[j] < 0 || p[j] >= extent[j]) ? 1 : 0;
+                    }
+                    if (!TENSORIAL && outside > 1) {
+                        continue; // corners are not loaded
+                    }
+                    EXPECT_EQ(tlab(si, p), slab[p]);
+                }
+            }
+        }
+    }
+}
+
+template <typename TField>
+void runViewTest()
+{
+    using TLab = Block::TensorFieldLab<TField, Block::LabLayout::SoA>;
+    using IRange = typename TLab::IndexRangeType;
+    using MIndex = typename IRange::MultiIndex;
+    using Stencil = typename TLab::StencilType;
+    using Component =
+        Block::ScalarComponent<TField, TField::Class, TField::Rank>;
+
+    const MIndex cells(8);
+    BlockSet<TField> blocks(MIndex(2), cells);
+    const Stencil s(-1, 2);
+    TLab tlab;
+    tlab.allocate(s, IRange(cells + 1));
+    EXPECT_EQ(tlab.getElementStride(), 1);
+    EXPECT_EQ(tlab.getComponentStride() % (CUBISM_ALIGNMENT / sizeof(double)),
+              0);
+
+    tlab.loadData(MIndex(1), blocks);
+    for (size_t d = 0; d < TLab::NGroups; ++d) {
+        for (size_t c = 0; c < TLab::NComponents; ++c) {
+            const size_t si = TLab::index(c, d);
+            auto &lab = tlab.getLab(c, d);
+            EXPECT_EQ(lab.getInnerData(), tlab.getInnerData(si));
+            EXPECT_EQ(&lab.getActiveField(),
+                      &Component::get(blocks(MIndex(1)), c, d));
+            for (const auto &p : lab.getActiveRange()) {
+                EXPECT_EQ(lab[p], tlab(si, p));
+            }
+        }
+    }
+}
+
+TEST(TensorFieldLab, Tensor)
+{
+    using T3 = Block::TensorField<double, 1, Cubism::EntityType::Cell, 3>;
+    runTest<T3, Block::LabLayout::SoA, false>();
+    runTest<T3, Block::LabLayout::SoA, true>();
+    runTest<T3, Block::LabLayout::AoS, false>();
+    runTest<T3, Block::LabLayout::AoS, true>();
+
+    using T2 = Block::TensorField<float, 2, Cubism::EntityType::Node, 2>;
+    runTest<T2, Block::LabLayout::SoA, true>();
+    runTest<T2, Block::LabLayout::AoS, false>();
+
+    using S3 = Block::Field<double, Cubism::EntityType::Cell, 3>;
+    runTest<S3, Block::LabLayout::SoA, false>();
+    using S1 = Block::Field<double, Cubism::EntityType::Cell, 1>;
+    runTest<S1, Block::LabLayout::SoA, false>();
+    using S4 = Block::Field<double, Cubism::EntityType::Cell, 4>;
+    runTest<S4, Block::LabLayout::AoS, false>();
+}
+
+TEST(TensorFieldLab, FaceContainer)
+{
+    using F0 =
+        Block::FaceContainer<Block::Field<double, Cubism::EntityType::Face, 3>>;
+    runTest<F0, Block::LabLayout::SoA, false>();
+    runTest<F0, Block::LabLayout::AoS, true>();
+
+    using F1 = Block::FaceContainer<
+        Block::TensorField<double, 1, Cubism::EntityType::Face, 2>>;
+    runTest<F1, Block::LabLayout::SoA, true>();
+    runTest<F1, Block::LabLayout::AoS, false>();
+}
+
+TEST(TensorFieldLab, ComponentViews)
+{
+    runViewTest<Block::TensorField<double, 1, Cubism::EntityType::Cell, 3>>();
+    runViewTest<Block::FaceContainer<
+        Block::TensorField<double, 1, Cubism::EntityType::Face, 2>>>();
+}
+
+// counts slab applications, does not implement operator()
+template <typename Lab>
+class SlabCounter : public BC::Base<Lab>
+{
+public:
+    SlabCounter(const size_t dir, const size_t side)
+        : BC::Base<Lab>(dir, side), napply(0)
+    {
+        this->binfo_.is_periodic = false;
+    }
+
+    void apply(Lab &, const typename BC::Base<Lab>::SlabType &slab) override
+    {
+        EXPECT_FALSE(slab.isEmpty());
+        ++napply;
+    }
+
+    int napply;
+};
+
+TEST(TensorFieldLab, BoundaryConditions)
+{
+    using TF = Block::TensorField<double, 1, Cubism::EntityType::Cell, 2>;
+    using Lab = Block::TensorFieldLab<TF>;
+    using ScalarLab = typename Lab::LabType;
+    using MIndex = typename Lab::MultiIndex;
+    using IRange = typename Lab::IndexRangeType;
+
+    BlockSet<TF> set(MIndex(2), MIndex(4));
+    BC::Dirichlet<ScalarLab> left(0, 0, -1.0);
+    SlabCounter<ScalarLab> top(1, 1);
+    for (const auto &p : IRange(MIndex(2))) {
+        set(p)[0].getBC().push_back(&left);
+        set(p)[1].getBC().push_back(&top);
+    }
+
+    Lab lab;
+    lab.allocate(typename Lab::StencilType(-1, 2), IRange(4));
+    lab.loadData(MIndex(0), set);
+    lab.loadData(MIndex(0), set);
+    EXPECT_EQ(top.napply, 2);
+    for (int j = 0; j < 4; ++j) {
+        EXPECT_EQ((lab.getLab(0)[MIndex{-1, j}]), -1.0);
+    }
+}
+} // namespace
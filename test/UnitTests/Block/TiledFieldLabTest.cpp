@@ -0,0 +1,201 @@
+// File       : TiledFieldLabTest.cpp
+// Created    : Fri Oct 16 2026 11:02:44 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Tiled data lab test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/BC/Dirichlet.h"
+#include "Cubism/Block/Field.h"
+#include "Cubism/Block/FieldLab.h"
+#include "Cubism/Block/TiledFieldLab.h"
+#include "Cubism/Common.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+using namespace Cubism;
+
+using Field = Block::Field<double, Cubism::EntityType::Cell, 3>;
+using IRange = typename Field::IndexRangeType;
+using MIndex = typename IRange::MultiIndex;
+using FContainer = Block::FieldContainer<Field>;
+using Indexer =
+    Block::PeriodicIndexFunctor<FContainer, Field::Class, Field::Rank>;
+using FieldLab = Block::FieldLab<Field>;
+using TiledLab = Block::TiledFieldLab<Field>;
+using Stencil = typename TiledLab::StencilType;
+
+void fillFields(FContainer &fields, const IRange &block_range, const MIndex &c)
+{
+    double k = 0;
+    for (size_t i = 0; i < block_range.size(); ++i) {
+        Field *f = new Field(IRange(c));
+        for (auto &v : *f) {
+            v = k;
+            k += 1;
+        }
+        fields.pushBack(f);
+    }
+}
+
+// ISPC benchmark kernel signature
+void laplacian(int Nx,
+               int Ny,
+               int Nz,
+               const double *src,
+               int xps,
+               int xyps,
+               double *dst,
+               int xpd,
+               int xypd,
+               double factor)
+{
+    for (int iz = 0; iz < Nz; ++iz) {
+        for (int iy = 0; iy < Ny; ++iy) {
+            for (int ix = 0; ix < Nx; ++ix) {
+                const double *s = src + ix + xps * iy + xyps * iz;
+                dst[ix + xpd * iy + xypd * iz] =
+                    factor * (s[-1] + s[1] + s[-xps] + s[xps] + s[-xyps] +
+                              s[xyps] - 6.0 * s[0]);
+            }
+        }
+    }
+}
+
+void runTest(const bool tensorial)
+{
+    const IRange block_range(MIndex(3));
+    const MIndex cells{12, 10, 9};
+    FContainer fields;
+    fillFields(fields, block_range, cells);
+    Indexer i2f(fields, block_range);
+
+    const Stencil s(-2, 3, tensorial);
+    const MIndex tile{5, 4, 3}; // does not divide the block
+    FieldLab flab;
+    TiledLab tlab;
+    flab.allocate(s, IRange(cells));
+    tlab.allocate(s, tile);
+    EXPECT_TRUE(tlab.isAllocated());
+    EXPECT_EQ(tlab.getTileShape(), tile);
+    EXPECT_EQ(tlab.getActiveStencil(), s);
+    EXPECT_EQ(tlab.getPitchX() % (CUBISM_ALIGNMENT / sizeof(double)), 0);
+
+    for (const auto &bi : block_range) {
+        flab.loadData(bi, i2f);
+        for (const auto &ti : IRange(MIndex(0), MIndex(3))) {
+            const MIndex tbegin = ti * tile;
+            MIndex tend = tbegin + tile;
+            for (size_t d = 0; d < 3; ++d) {
+                tend[d] = (tend[d] < cells[d]) ? tend[d] : cells[d];
+            }
+            const IRange tr(tbegin, tend);
+            tlab.loadTile(bi, i2f, tr);
+            EXPECT_EQ(tlab.getActiveTile().getBegin(), tbegin);
+            const IRange lr(s.getBegin(), tr.getExtent() + s.getEnd() - 1);
+            for (const auto &q : lr) {
+                const MIndex p = q + lr.getBegin();
+                const MIndex pb = p + tbegin; // block local
+                size_t outside = 0;
+                for (size_t j = 0; j < 3; ++j) {
+                    outside += (pb[j] < 0 || pb[j] >= cells[j]) ? 1 : 0;
+                }
+                if (!tensorial && outside > 1) {
+                    continue; // corners are not loaded
+                }
+                EXPECT_EQ(tlab[p], flab[pb]);
+            }
+            EXPECT_EQ(tlab(0, 0, 0), flab(tbegin[0], tbegin[1], tbegin[2]));
+            EXPECT_EQ(tlab(-1, 1, 2),
+                      flab(tbegin[0] - 1, tbegin[1] + 1, tbegin[2] + 2));
+        }
+    }
+}
+
+TEST(TiledFieldLab, LoadTile)
+{
+    runTest(false);
+    runTest(true);
+}
+
+TEST(TiledFieldLab, Process)
+{
+    const IRange block_range(MIndex(2));
+    const MIndex cells{16, 12, 10};
+    const IRange cell_range(cells);
+    FContainer fields;
+    fillFields(fields, block_range, cells);
+    Indexer i2f(fields, block_range);
+
+    const Stencil s(-1, 2);
+    FieldLab flab;
+    TiledLab tlab;
+    flab.allocate(s, cell_range);
+    tlab.allocate(s, MIndex{16, 5, 3});
+
+    Field ref(cell_range);
+    Field dst(cell_range);
+    MIndex lab_begin;
+    const MIndex lab_extent =
+        FieldLab::getLabExtent(s, cell_range, lab_begin);
+    for (const auto &bi : block_range) {
+        flab.loadData(bi, i2f);
+        laplacian(cells[0],
+                  cells[1],
+                  cells[2],
+                  flab.getInnerData(),
+                  lab_extent[0],
+                  lab_extent[0] * lab_extent[1],
+                  ref.getData(),
+                  cells[0],
+                  cells[0] * cells[1],
+                  0.5);
+        for (auto &v : dst) {
+            v = -1;
+        }
+        tlab.process(bi, i2f, dst, laplacian, 0.5);
+        for (const auto &p : dst.getIndexRange()) {
+            EXPECT_EQ(dst[p], ref[p]);
+        }
+    }
+}
+
+TEST(TiledFieldLab, Boundaries)
+{
+    const IRange block_range(MIndex(2));
+    const MIndex cells(8);
+    FContainer fields;
+    fillFields(fields, block_range, cells);
+    Indexer i2f(fields, block_range);
+
+    TiledLab tlab;
+    tlab.allocate(Stencil(-1, 2), MIndex(4));
+    const IRange tile(MIndex(4));
+    tlab.loadTile(MIndex(0), i2f, tile);
+
+    // boundary conditions added after the first load are detected
+    BC::Dirichlet<FieldLab> bc(0, 0, 1.0);
+    fields[0].getBC().push_back(&bc);
+    EXPECT_THROW(tlab.loadTile(MIndex(0), i2f, tile), std::runtime_error);
+    fields[0].getBC().clear();
+    tlab.loadTile(MIndex(0), i2f, tile);
+}
+
+TEST(TiledFieldLab, TileShape)
+{
+    const Stencil s(-1, 2);
+    const MIndex block(128);
+    const size_t cache_bytes = 256 * 1024;
+    const MIndex tile = TiledLab::getTileShape(block, s, cache_bytes);
+    EXPECT_EQ(tile[0], block[0]);
+    EXPECT_TRUE(tile <= block);
+
+    MIndex lab_begin;
+    const MIndex extent =
+        FieldLab::getLabExtent(s, IRange(tile), lab_begin);
+    EXPECT_LE(extent.prod() * sizeof(double), cache_bytes);
+
+    // small blocks fit as a whole
+    EXPECT_EQ(TiledLab::getTileShape(MIndex(8), s, cache_bytes), MIndex(8));
+}
+} // namespace
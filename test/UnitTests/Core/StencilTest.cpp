@@ -27,6 +27,10 @@ void runTest()
     EXPECT_EQ(s1.getEnd(), e1);
     EXPECT_TRUE(s1.isTensorial());
 
+    EXPECT_TRUE(s0 == Stencil(-2, 3));
+    EXPECT_TRUE(s0 != Stencil(-2, 3, true));
+    EXPECT_TRUE(s0 != s1);
+
     try {
         Stencil s2(0, 0);
     } catch (const std::runtime_error &e) {
@@ -0,0 +1,79 @@
+// File       : ActiveBlockSetTest.cpp
+// Created    : Sat Oct 17 2026 06:02:51 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Active block set test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/Grid/ActiveBlockSet.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+using namespace Cubism;
+
+TEST(ActiveBlockSet, Construction)
+{
+    Grid::ActiveBlockSet set(150);
+    EXPECT_EQ(set.size(), 150);
+    EXPECT_EQ(set.count(), 0);
+    EXPECT_TRUE(set.getList().empty());
+
+    set.fill();
+    EXPECT_EQ(set.count(), 150);
+    EXPECT_EQ(set.getList().size(), 150);
+    EXPECT_EQ(set.getList().back(), 149);
+
+    set.resize(10);
+    EXPECT_EQ(set.size(), 10);
+    EXPECT_EQ(set.count(), 0);
+}
+
+TEST(ActiveBlockSet, Update)
+{
+    Grid::ActiveBlockSet set(200);
+    EXPECT_TRUE(set.activate(3));
+    EXPECT_FALSE(set.activate(3));
+    EXPECT_TRUE(set.activate(64));
+    EXPECT_TRUE(set.activate(199));
+    EXPECT_TRUE(set.isActive(64));
+    EXPECT_FALSE(set.isActive(65));
+    EXPECT_EQ(set.count(), 3);
+    EXPECT_EQ(set.getList(), std::vector<size_t>({3, 64, 199}));
+
+    EXPECT_TRUE(set.deactivate(64));
+    EXPECT_FALSE(set.deactivate(64));
+    EXPECT_EQ(set.getList(), std::vector<size_t>({3, 199}));
+
+    set.clear();
+    EXPECT_EQ(set.count(), 0);
+}
+
+TEST(ActiveBlockSet, Concurrent)
+{
+    const size_t n = 1000;
+    Grid::ActiveBlockSet set(n);
+    std::atomic<size_t> nnew(0);
+    // every block is activated by several threads
+#pragma omp parallel for schedule(static, 1)
+    for (size_t i = 0; i < 4 * n; ++i) {
+        if (set.activate((7 * i) % n)) {
+            ++nnew;
+        }
+    }
+    EXPECT_EQ(nnew, n);
+    EXPECT_EQ(set.count(), n);
+
+#pragma omp parallel for schedule(static, 1)
+    for (size_t i = 0; i < n; i += 2) {
+        set.deactivate(i);
+    }
+    const std::vector<size_t> list = set.getList();
+    EXPECT_EQ(list.size(), n / 2);
+    for (size_t k = 0; k < list.size(); ++k) {
+        EXPECT_EQ(list[k], 2 * k + 1);
+    }
+}
+} // namespace
@@ -5,13 +5,19 @@
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 
 #include "Cubism/Grid/Cartesian.h"
+#include "Cubism/BC/Dirichlet.h"
 #include "Cubism/Block/FieldLab.h"
+#include "Cubism/Block/FieldViewLab.h"
 #include "Cubism/Math.h"
 #include "Cubism/Mesh/StructuredUniform.h"
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif /* _OPENMP */
 
 namespace
 {
@@ -138,6 +144,477 @@ TEST(Cartesian, GridFill)
     }
 }
 
+template <typename Grid>
+void fillNested(Grid &grid, const double v)
+{
+    for (auto fc : grid) {
+        for (auto sf : *fc) {
+            std::fill(sf->begin(), sf->end(), v);
+        }
+    }
+}
+
+template <typename Grid>
+void checkNested(const Grid &grid, const double v)
+{
+    for (auto fc : grid) {
+        for (auto sf : *fc) {
+            for (auto c : *sf) {
+                EXPECT_EQ(c, v);
+            }
+        }
+    }
+}
+
+TEST(Cartesian, LinearCombination)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+
+    // block size is not a multiple of the alignment (padded blocks)
+    const MIndex nblocks{3, 2, 5};
+    const MIndex block_cells{3, 5, 3};
+
+    { // vector cell field
+        using Grid = Grid::Cartesian<float, Mesh, EntityType::Cell, 1>;
+        Grid u0(nblocks, block_cells);
+        Grid u1(nblocks, block_cells);
+        Grid rhs(nblocks, block_cells);
+        fillNested(u0, 1);
+        fillNested(u1, 2);
+        fillNested(rhs, 4);
+
+        u1.axpy(0.5f, rhs);
+        checkNested(u1, 4);
+        u1.axpby(-1, rhs, 0.5f);
+        checkNested(u1, -2);
+        u1.linComb(0.75f, u0, -0.5f, u1, 0.25f, rhs);
+        checkNested(u1, 2.75);
+
+        Grid other(nblocks, MIndex(4));
+        EXPECT_THROW(u1.axpy(1, other), std::runtime_error);
+    }
+    { // scalar face field
+        using Grid = Grid::Cartesian<double, Mesh, EntityType::Face, 0>;
+        Grid u0(nblocks, block_cells);
+        Grid u(nblocks, block_cells);
+        fillNested(u0, 1);
+        fillNested(u, 3);
+        u.linComb(1, u0, 2, u, 0.5, u0);
+        checkNested(u, 7.5);
+    }
+}
+
+TEST(Cartesian, WholeGrid)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+
+    // padded blocks and node/face entities with block dependent sizes
+    const MIndex nblocks{3, 2, 4};
+    const MIndex block_cells{3, 5, 3};
+    const MIndex gcells = nblocks * block_cells;
+
+    { // scalar node field
+        using Grid = Grid::Cartesian<double, Mesh, EntityType::Node, 0>;
+        Grid grid(nblocks, block_cells);
+        Grid other(nblocks, block_cells);
+
+        // padding and unused elements must not enter the reductions
+        grid.fill(1.0e6);
+        for (auto sf : grid) {
+            std::fill(sf->begin(), sf->end(), -2);
+        }
+        const double nnodes = (gcells + MIndex(1)).prod();
+        EXPECT_EQ(grid.sum(), -2 * nnodes);
+        EXPECT_EQ(grid.min(), -2);
+        EXPECT_EQ(grid.max(), -2);
+        EXPECT_DOUBLE_EQ(grid.normL2(), 2 * std::sqrt(nnodes));
+
+        // unique extremal values
+        grid[MIndex{2, 1, 3}][0] = 5;
+        grid[MIndex{0, 1, 2}][3] = -7;
+        EXPECT_EQ(grid.min(), -7);
+        EXPECT_EQ(grid.max(), 5);
+
+        other.fill(3);
+        other.scale(-0.5);
+        for (auto sf : other) {
+            for (auto c : *sf) {
+                EXPECT_EQ(c, -1.5);
+            }
+        }
+        other.copy(grid);
+        EXPECT_EQ(other.sum(), grid.sum());
+        other.fill(0);
+        other = grid;
+        EXPECT_EQ(other.min(), -7);
+        EXPECT_EQ(other.max(), 5);
+
+        Grid small(nblocks, MIndex(4));
+        EXPECT_THROW(small.copy(grid), std::runtime_error);
+
+        // memory slots of differently ordered grids hold different blocks
+        const MIndex n4(4);
+        Grid lex(n4, block_cells);
+        Grid hil(n4,
+                 block_cells,
+                 Mesh::PointType(0),
+                 Mesh::PointType(1),
+                 Mesh::PointType(0),
+                 Mesh::PointType(1),
+                 Cubism::Grid::FirstTouch::None,
+                 Cubism::Grid::BlockOrder::Hilbert);
+        lex.fill(1);
+        hil.fill(2);
+        EXPECT_THROW(lex.copy(hil), std::runtime_error);
+        EXPECT_THROW(lex = hil, std::runtime_error);
+        EXPECT_THROW(lex.axpy(1, hil), std::runtime_error);
+        EXPECT_THROW(lex.axpby(1, hil, 1), std::runtime_error);
+        EXPECT_THROW(lex.linComb(1, lex, 1, hil, 1, lex), std::runtime_error);
+        EXPECT_EQ(lex.max(), 1);
+    }
+    { // vector face field
+        using Grid = Grid::Cartesian<float, Mesh, EntityType::Face, 1>;
+        Grid grid(nblocks, block_cells);
+        grid.fill(1.0e6f);
+        for (auto ff : grid) {
+            for (auto tf : *ff) {
+                for (auto sf : *tf) {
+                    std::fill(sf->begin(), sf->end(), 1);
+                }
+            }
+        }
+        double nfaces = 0;
+        for (size_t d = 0; d < 3; ++d) {
+            MIndex faces(gcells);
+            ++faces[d];
+            nfaces += faces.prod();
+        }
+        EXPECT_EQ(grid.sum(), Grid::NComponents * nfaces);
+        EXPECT_EQ(grid.max(), 1);
+    }
+}
+
+TEST(Cartesian, Reduce)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Point = typename Mesh::PointType;
+    using Grid = Grid::Cartesian<double, Mesh, EntityType::Cell, 1>;
+    using CV = typename Grid::CellValues;
+    using Cubism::Grid::ReduceOp;
+
+    const MIndex nblocks{3, 2, 4};
+    const MIndex block_cells{3, 5, 3};
+    const MIndex gcells = nblocks * block_cells;
+    Grid grid(nblocks, block_cells, Point(0), Point{1, 2, 3});
+    grid.fill(1.0e6); // padding must not contribute
+
+    // component c of cell p: (c + 1) * (flat global index + 1)
+    double ref_sum = 0;
+    double ref_max = 0;
+    for (size_t c = 0; c < Grid::NComponents; ++c) {
+        auto fmap = grid.getIndexFunctor(c);
+        for (auto f : grid) {
+            const MIndex &bi = f->getState().block_index;
+            auto &bf = fmap(bi);
+            for (auto &p : bf.getIndexRange()) {
+                const MIndex q = bi * block_cells + p;
+                const double v =
+                    (c + 1.0) *
+                    (q[0] + gcells[0] * (q[1] + gcells[1] * q[2]) + 1.0);
+                bf[p] = v;
+                ref_sum += (0 == c) ? v : 0;
+                ref_max = std::max(ref_max, v);
+            }
+        }
+    }
+
+    auto first = [](const CV &c) { return c[0]; };
+    auto norm1 = [](const CV &c) {
+        return std::abs(c[0]) + std::abs(c[1]) + std::abs(c[2]);
+    };
+    EXPECT_EQ(grid.reduce(first, ReduceOp::Sum), ref_sum);
+    EXPECT_EQ(grid.reduce(first, ReduceOp::Min), 1);
+    EXPECT_EQ(grid.reduce(norm1, ReduceOp::Max), 2 * ref_max);
+    EXPECT_EQ(grid.reduce(first, ReduceOp::Max), ref_max / 3);
+
+    // volume weighted integral
+    const double volume = 6.0 / gcells.prod();
+    EXPECT_DOUBLE_EQ(grid.reduce([](const CV &) { return 1.0; },
+                                 ReduceOp::Sum,
+                                 true),
+                     6.0);
+    EXPECT_DOUBLE_EQ(grid.reduce(first, ReduceOp::Sum, true),
+                     volume * ref_sum);
+    EXPECT_THROW(grid.reduce([](const CV &) { return 1; },
+                             ReduceOp::Sum,
+                             true),
+                 std::runtime_error);
+
+    // NaN propagation
+    grid[MIndex{1, 1, 2}][2][7] = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_TRUE(std::isnan(grid.reduce(
+        [](const CV &c) { return c[2]; }, ReduceOp::Max)));
+    EXPECT_TRUE(std::isnan(grid.reduce(
+        [](const CV &c) { return c[2]; }, ReduceOp::Min)));
+    EXPECT_TRUE(std::isnan(grid.max()));
+    EXPECT_FALSE(std::isnan(grid.reduce(first, ReduceOp::Max)));
+}
+
+TEST(Cartesian, ReduceThreadCount)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Point = typename Mesh::PointType;
+    using Grid = Grid::Cartesian<double, Mesh, EntityType::Cell, 1>;
+    using CV = typename Grid::CellValues;
+    using Cubism::Grid::ReduceOp;
+
+    const MIndex nblocks{3, 2, 4};
+    const MIndex block_cells{3, 5, 3};
+    Grid grid(nblocks, block_cells, Point(0), Point{1, 2, 3});
+    for (size_t c = 0; c < Grid::NComponents; ++c) {
+        auto fmap = grid.getIndexFunctor(c);
+        for (auto f : grid) {
+            const MIndex &bi = f->getState().block_index;
+            auto &bf = fmap(bi);
+            for (auto &p : bf.getIndexRange()) {
+                const MIndex q = bi * block_cells + p;
+                bf[p] = std::sin(1.0e3 * (c + 1.0) * (q.sum() + 0.1 * q[0]));
+            }
+        }
+    }
+
+    auto first = [](const CV &c) { return c[0]; };
+    auto reduceAll = [&](const int nthreads) {
+        std::vector<double> r;
+#ifdef _OPENMP
+        const int nthreads_max = omp_get_max_threads();
+        omp_set_num_threads(nthreads);
+#else
+        (void)nthreads;
+#endif /* _OPENMP */
+        r.push_back(grid.sum());
+        r.push_back(grid.normL2());
+        r.push_back(grid.min());
+        r.push_back(grid.max());
+        r.push_back(grid.reduce(first, ReduceOp::Sum));
+#ifdef _OPENMP
+        omp_set_num_threads(nthreads_max);
+#endif /* _OPENMP */
+        return r;
+    };
+
+    // results must be bitwise identical for any number of threads
+    const std::vector<double> r1 = reduceAll(1);
+    for (const int nthreads : {2, 3, 5}) {
+        const std::vector<double> rn = reduceAll(nthreads);
+        for (size_t i = 0; i < r1.size(); ++i) {
+            EXPECT_EQ(rn[i], r1[i]);
+        }
+    }
+}
+
+TEST(Cartesian, CellMask)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::Cartesian<double, Mesh, EntityType::Cell, 0>;
+    using CV = typename Grid::CellValues;
+    using Cubism::Grid::BlockOrder;
+    using Cubism::Grid::ReduceOp;
+
+    const MIndex nblocks(2);
+    const MIndex block_cells(4);
+    Grid grid(nblocks,
+              block_cells,
+              Mesh::PointType(0),
+              Mesh::PointType(1),
+              Mesh::PointType(0),
+              Mesh::PointType(1),
+              Cubism::Grid::FirstTouch::None,
+              BlockOrder::Morton);
+    grid.fill(1.0);
+    EXPECT_FALSE(grid.hasMasks());
+    for (auto f : grid) {
+        EXPECT_EQ(f->getState().mask, nullptr);
+    }
+
+    grid.allocateMasks();
+    EXPECT_TRUE(grid.hasMasks());
+    for (size_t i = 0; i < grid.size(); ++i) {
+        const auto &fs = grid[i].getState();
+        EXPECT_EQ(fs.mask, &grid.getMask(i));
+        EXPECT_EQ(fs.mask, &grid.getMask(fs.block_index));
+        EXPECT_EQ(fs.mask->getState(), Block::MaskState::Fluid);
+    }
+
+    // fully solid block
+    const MIndex bs(0);
+    grid.getMask(bs).fill(true);
+    for (auto &v : grid[bs]) {
+        v = 100.0;
+    }
+
+    // mixed block: solid cells at x = 0
+    const MIndex bm{1, 0, 0};
+    auto &mask = grid.getMask(bm);
+    auto &bf = grid[bm];
+    for (auto &p : bf.getIndexRange()) {
+        if (0 == p[0]) {
+            mask.set(p, true);
+            bf[p] = 100.0;
+        }
+    }
+    bf[MIndex{2, 1, 3}] = -5.0;
+    EXPECT_EQ(mask.getState(), Block::MaskState::Mixed);
+    EXPECT_EQ(grid[bs].getState().mask->getState(), Block::MaskState::Solid);
+
+    // 512 cells, 64 + 16 solid cells
+    const size_t nfluid = 512 - 80;
+    auto first = [](const CV &c) { return c[0]; };
+    EXPECT_EQ(grid.sum(), nfluid - 6.0);
+    EXPECT_EQ(grid.min(), -5.0);
+    EXPECT_EQ(grid.max(), 1.0);
+    EXPECT_DOUBLE_EQ(grid.normL2(), std::sqrt(nfluid - 1.0 + 25.0));
+    EXPECT_EQ(grid.reduce(first, ReduceOp::Sum), nfluid - 6.0);
+    EXPECT_EQ(grid.reduce(first, ReduceOp::Min), -5.0);
+    EXPECT_EQ(grid.reduce(first, ReduceOp::Max), 1.0);
+    EXPECT_DOUBLE_EQ(
+        grid.reduce([](const CV &) { return 1.0; }, ReduceOp::Sum, true),
+        nfluid / 512.0);
+
+    grid.freeMasks();
+    EXPECT_FALSE(grid.hasMasks());
+    EXPECT_EQ(grid[bs].getState().mask, nullptr);
+    EXPECT_EQ(grid.max(), 100.0);
+    EXPECT_EQ(grid.reduce(first, ReduceOp::Max), 100.0);
+}
+
+TEST(Cartesian, ActiveBlocks)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::Cartesian<double, Mesh, EntityType::Cell, 0>;
+
+    const MIndex nblocks{4, 3, 5};
+    const MIndex block_cells(4);
+    Grid grid(nblocks,
+              block_cells,
+              Mesh::PointType(0),
+              Mesh::PointType(1),
+              Mesh::PointType(0),
+              Mesh::PointType(1),
+              Cubism::Grid::FirstTouch::None,
+              Cubism::Grid::BlockOrder::Hilbert);
+    EXPECT_EQ(grid.getActiveSet().size(), grid.size());
+    EXPECT_EQ(grid.getActiveSet().count(), 0);
+    EXPECT_TRUE(grid.getActiveBlocks().empty());
+
+    const MIndex b0{1, 1, 1};
+    const MIndex b1{3, 2, 4};
+    EXPECT_TRUE(grid.activate(b0));
+    EXPECT_TRUE(grid.activate(grid[b1]));
+    EXPECT_FALSE(grid.activate(b1));
+    EXPECT_TRUE(grid.isActive(grid[b0]));
+    EXPECT_FALSE(grid.isActive(grid[MIndex(0)]));
+    std::vector<Grid::BaseType *> blocks = grid.getActiveBlocks();
+    ASSERT_EQ(blocks.size(), 2);
+    // field container order
+    EXPECT_EQ(blocks[0] < blocks[1], &grid[b0] < &grid[b1]);
+    EXPECT_TRUE(blocks[0] == &grid[b0] || blocks[0] == &grid[b1]);
+    EXPECT_TRUE(grid.deactivate(grid[b0]));
+    EXPECT_EQ(grid.getActiveBlocks().size(), 1);
+
+    // periodic neighbors of a corner block
+    using Stencil = typename Grid::StencilType;
+    grid.getActiveSet().clear();
+    grid.activate(MIndex(0));
+    grid.activateNeighbors(Stencil(-1, 2, true));
+    EXPECT_EQ(grid.getActiveSet().count(), 27);
+    for (auto bf : grid.getActiveBlocks()) {
+        const MIndex &bi = bf->getState().block_index;
+        for (size_t i = 0; i < 3; ++i) {
+            EXPECT_TRUE(bi[i] <= 1 || bi[i] == nblocks[i] - 1);
+        }
+    }
+
+    // face neighbors only for a non-tensorial stencil
+    grid.getActiveSet().clear();
+    grid.activate(MIndex(0));
+    grid.activateNeighbors(Stencil(-1, 2));
+    EXPECT_EQ(grid.getActiveSet().count(), 7);
+
+    // zero halo width on the upper side in x
+    grid.getActiveSet().clear();
+    grid.activate(MIndex(0));
+    grid.activateNeighbors(Stencil(MIndex{-1, -1, -1}, MIndex{1, 2, 2}, true));
+    EXPECT_EQ(grid.getActiveSet().count(), 18);
+    EXPECT_FALSE(grid.isActive(grid[MIndex{1, 0, 0}]));
+
+    // no wrap across the non-periodic lower boundary in x
+    using Lab = Block::FieldLab<typename Grid::BaseType>;
+    BC::Dirichlet<Lab> left(0, 0, 0.0);
+    const typename Lab::BCVector bcs = {&left};
+    grid.getActiveSet().clear();
+    grid.activate(MIndex(0));
+    grid.activateNeighbors(Stencil(-1, 2, true), bcs);
+    EXPECT_EQ(grid.getActiveSet().count(), 18);
+    for (auto bf : grid.getActiveBlocks()) {
+        EXPECT_LE(bf->getState().block_index[0], 1);
+    }
+}
+
+TEST(Cartesian, FirstTouch)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Point = typename Mesh::PointType;
+
+    const MIndex nblocks{3, 2, 5};
+    const MIndex block_cells(8);
+    for (auto touch :
+         {Grid::FirstTouch::Static, Grid::FirstTouch::Interleave}) {
+        { // face field with three components
+            using Grid = Grid::Cartesian<double, Mesh, EntityType::Face, 1>;
+            Grid grid(nblocks,
+                      block_cells,
+                      Point(0),
+                      Point(1),
+                      Point(0),
+                      Point(1),
+                      touch);
+            EXPECT_EQ(grid.getFirstTouch(), touch);
+            for (auto ff : grid) {
+                for (auto tf : *ff) {
+                    for (auto sf : *tf) {
+                        for (auto v : *sf) {
+                            EXPECT_EQ(v, 0);
+                        }
+                    }
+                }
+            }
+        }
+        { // scalar node field
+            using Grid = Grid::Cartesian<float, Mesh, EntityType::Node, 0>;
+            Grid grid(nblocks,
+                      block_cells,
+                      Point(0),
+                      Point(1),
+                      Point(0),
+                      Point(1),
+                      touch);
+            for (auto sf : grid) {
+                for (auto v : *sf) {
+                    EXPECT_EQ(v, 0);
+                }
+            }
+        }
+    }
+}
+
 TEST(Cartesian, BlockAccess)
 {
     // 2D mesh
@@ -169,6 +646,181 @@ TEST(Cartesian, BlockAccess)
     }
 }
 
+TEST(Cartesian, BlockOrder)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Point = typename Mesh::PointType;
+    using Grid = Grid::Cartesian<double, Mesh, Cubism::EntityType::Cell, 0>;
+    using Order = Cubism::Grid::BlockOrder;
+
+    const MIndex block_cells(4);
+    const auto touch = Cubism::Grid::FirstTouch::None;
+    for (auto order : {Order::Lexicographic, Order::Morton, Order::Hilbert}) {
+        for (const MIndex &nblocks : {MIndex(4), MIndex{3, 2, 5}}) {
+            Grid grid(nblocks,
+                      block_cells,
+                      Point(0),
+                      Point(1),
+                      Point(0),
+                      Point(1),
+                      touch,
+                      order);
+            EXPECT_EQ(grid.getBlockOrder(), order);
+            const auto range = grid.getBlockRange();
+
+            // every block is assembled exactly once, in memory order
+            std::vector<int> visited(range.size(), 0);
+            for (size_t k = 0; k < grid.size(); ++k) {
+                const MIndex bi = grid[k].getState().block_index;
+                const size_t flat = range.getFlatIndex(bi);
+                ++visited[flat];
+                EXPECT_EQ(grid.getBlockMap()[flat], k);
+                EXPECT_EQ(&grid[bi], &grid[k]);
+                if (k > 0) {
+                    EXPECT_GT(grid[k].getData(), grid[k - 1].getData());
+                }
+                for (auto &v : grid[k]) {
+                    v = static_cast<double>(flat);
+                }
+            }
+            for (const int v : visited) {
+                EXPECT_EQ(v, 1);
+            }
+
+            // curve properties on a cubic power of two grid
+            if (nblocks == MIndex(4) && order == Order::Hilbert) {
+                for (size_t k = 1; k < grid.size(); ++k) {
+                    const MIndex d = grid[k].getState().block_index -
+                                     grid[k - 1].getState().block_index;
+                    EXPECT_EQ(d.abs().sum(), 1);
+                }
+            } else if (nblocks == MIndex(4) && order == Order::Morton) {
+                // first octant is traversed first
+                for (size_t k = 0; k < 8; ++k) {
+                    EXPECT_LT(grid[k].getState().block_index.max(), 2);
+                }
+            }
+
+            // periodic neighbor lookup through the index functor and lab
+            auto fields = grid.getIndexFunctor();
+            using Lab = Block::FieldLab<typename Grid::BaseType>;
+            Lab lab;
+            lab.allocate(typename Lab::StencilType(-1, 2),
+                         grid[0].getIndexRange());
+            using ViewLab = Block::FieldViewLab<typename Grid::BaseType>;
+            ViewLab vlab;
+            vlab.allocate(typename ViewLab::StencilType(-1, 2),
+                          grid[0].getIndexRange());
+            for (auto f : grid) {
+                const MIndex bi = f->getState().block_index;
+                for (size_t d = 0; d < 3; ++d) {
+                    const MIndex nb = bi + MIndex::getUnitVector(d);
+                    MIndex nbp = nb;
+                    nbp[d] = nbp[d] % nblocks[d];
+                    EXPECT_EQ(&fields(nb), &grid[nbp]);
+                }
+                grid.loadLab(*f, lab);
+                EXPECT_EQ(lab(0, 0, 0),
+                          static_cast<double>(range.getFlatIndex(bi)));
+                const MIndex lo{(bi[0] + nblocks[0] - 1) % nblocks[0],
+                                bi[1],
+                                bi[2]};
+                EXPECT_EQ(lab(-1, 0, 0),
+                          static_cast<double>(range.getFlatIndex(lo)));
+                grid.loadLab(*f, vlab);
+                EXPECT_EQ(vlab(0, 0, 0), lab(0, 0, 0));
+                EXPECT_EQ(vlab(-1, 0, 0), lab(-1, 0, 0));
+            }
+        }
+    }
+}
+
+TEST(Cartesian, NeighborTable)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Point = typename Mesh::PointType;
+    using Grid = Grid::Cartesian<double, Mesh, Cubism::EntityType::Face, 1>;
+    using Table = typename Grid::NeighborTableType;
+
+    const MIndex nblocks{3, 1, 2};
+    Grid grid(nblocks,
+              MIndex(4),
+              Point(0),
+              Point(1),
+              Point(0),
+              Point(1),
+              Cubism::Grid::FirstTouch::None,
+              Cubism::Grid::BlockOrder::Morton);
+    const Table &table = grid.getNeighborTable();
+    EXPECT_EQ(Table::NNeighbors, 27);
+    EXPECT_EQ(table.size(), grid.size());
+    for (size_t n = 0; n < Table::NNeighbors; ++n) {
+        EXPECT_EQ(Table::getSlot(Table::getOffset(n)), n);
+    }
+
+    for (size_t k = 0; k < grid.size(); ++k) {
+        const auto &bf = grid[k];
+        const MIndex bi = bf.getState().block_index;
+        EXPECT_EQ(&grid[table(k, MIndex(0)).index], &bf);
+        for (size_t n = 0; n < Table::NNeighbors; ++n) {
+            const MIndex q = bi + Table::getOffset(n);
+            const auto &e = table.getRow(k)[n];
+            bool boundary = false;
+            for (size_t i = 0; i < 3; ++i) {
+                boundary = boundary || q[i] < 0 || q[i] >= nblocks[i];
+            }
+            EXPECT_FALSE(e.remote);
+            EXPECT_EQ(e.boundary, boundary);
+            for (size_t d = 0; d < 3; ++d) {
+                for (size_t c = 0; c < 3; ++c) {
+                    auto nf = grid.getNeighborFunctor(bf, c, d);
+                    auto pf = grid.getIndexFunctor(c, d);
+                    EXPECT_EQ(&nf(q), &pf(q));
+                    EXPECT_EQ(nf.isBoundary(q), boundary);
+                }
+            }
+        }
+    }
+}
+
+TEST(Cartesian, NeighborBoundary)
+{
+    using Mesh = Mesh::StructuredUniform<double, 2>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::Cartesian<double, Mesh, Cubism::EntityType::Cell, 0>;
+    using FieldType = typename Grid::BaseType;
+    using Lab = Block::FieldLab<FieldType>;
+    using Stencil = typename Lab::StencilType;
+
+    Grid grid(MIndex(3), MIndex(4));
+    for (auto f : grid) {
+        const MIndex bi = f->getState().block_index;
+        for (auto &v : *f) {
+            v = 3 * bi[1] + bi[0];
+        }
+    }
+    // non-periodic boundary at the lower x-side of the domain
+    BC::Dirichlet<Lab> left(0, 0, -1.0);
+    const typename Lab::BCVector bcs = {&left};
+    Lab lab;
+    lab.allocate(Stencil(-1, 2), grid[0].getIndexRange());
+    for (auto f : grid) {
+        for (int j = 0; j < 4; ++j) {
+            lab[MIndex{-1, j}] = -2.0;
+        }
+        const MIndex bi = f->getState().block_index;
+        auto nf = grid.getNeighborFunctor(*f);
+        lab.loadData(bi, nf, bcs, false);
+        // only neighbors across the domain boundary are skipped
+        const double expected = (0 == bi[0]) ? -2.0 : 3 * bi[1] + bi[0] - 1;
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_EQ((lab[MIndex{-1, j}]), expected);
+        }
+    }
+}
+
 template <Cubism::EntityType Entity, size_t DIM>
 void testLab()
 {
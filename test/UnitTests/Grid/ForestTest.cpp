@@ -0,0 +1,334 @@
+// File       : ForestTest.cpp
+// Created    : Sat Oct 17 2026 08:57:46 AM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Adaptive forest grid test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/BC/Dirichlet.h"
+#include "Cubism/Grid/Forest.h"
+#include "Cubism/Grid/Process.h"
+#include "Cubism/Mesh/StructuredUniform.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+using namespace Cubism;
+
+using Mesh2D = Mesh::StructuredUniform<double, 2>;
+using Forest2D = Grid::Forest<double, Mesh2D>;
+using MIndex = typename Forest2D::MultiIndex;
+using IRange = typename Forest2D::IndexRangeType;
+using Grid::RefineFlag;
+
+// integral of the forest data
+double integrate(const Forest2D &forest)
+{
+    double sum = 0;
+    for (auto f : forest) {
+        const double volume = f->getState().mesh->getCellVolume(0);
+        for (auto &p : f->getIndexRange()) {
+            sum += volume * (*f)[p];
+        }
+    }
+    return sum;
+}
+
+// x-coordinate of a cell center
+double cellX(const Forest2D::FieldType &f, const MIndex &p)
+{
+    const auto &mesh = *f.getState().mesh;
+    return mesh.getBegin()[0] + (p[0] + 0.5) * mesh.getCellSize(0)[0];
+}
+
+// check 2:1 balance of all leaves
+void checkBalance(const Forest2D &forest)
+{
+    for (auto f : forest) {
+        const size_t l = f->getState().level;
+        for (auto &r : IRange(MIndex(3))) {
+            const MIndex o = r - MIndex(1);
+            // shift to positive indices (periodic)
+            const MIndex q =
+                f->getState().block_index + o + forest.getLevelSize(l);
+            bool found = (forest.getLeaf(l, q) != nullptr);
+            found = found || (l > 0 && forest.getLeaf(l - 1, q / 2));
+            if (!found) {
+                // children of q adjacent to the leaf must exist
+                for (auto &k : IRange(MIndex(2))) {
+                    bool adjacent = true;
+                    for (size_t d = 0; d < 2; ++d) {
+                        adjacent = adjacent && !(o[d] > 0 && k[d] != 0) &&
+                                   !(o[d] < 0 && k[d] != 1);
+                    }
+                    if (adjacent) {
+                        EXPECT_NE(forest.getLeaf(l + 1, MIndex(2) * q + k),
+                                  nullptr);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(Forest, Construction)
+{
+    const MIndex nblocks{3, 2};
+    const MIndex block_cells(8);
+    Forest2D forest(nblocks, block_cells, Mesh2D::PointType(0),
+                    Mesh2D::PointType{3, 2}, 2);
+    EXPECT_EQ(forest.size(), 6);
+    EXPECT_EQ(forest.getMaxLevel(), 2);
+    EXPECT_EQ(forest.getBlockCells(), block_cells);
+    EXPECT_EQ(forest.getLevelSize(2), (MIndex{12, 8}));
+    for (auto f : forest) {
+        const auto &fs = f->getState();
+        EXPECT_EQ(fs.level, 0);
+        EXPECT_EQ(fs.mask, nullptr);
+        EXPECT_EQ(forest.getLeaf(0, fs.block_index), f);
+        EXPECT_DOUBLE_EQ(fs.mesh->getCellVolume(0), 1.0 / 64);
+        EXPECT_EQ(fs.mesh->getBegin()[0], fs.block_index[0]);
+    }
+    EXPECT_EQ(forest.getLeaf(1, MIndex(0)), nullptr);
+    // periodic lookup
+    EXPECT_EQ(forest.getLeaf(0, MIndex{-1, 2}),
+              forest.getLeaf(0, MIndex{2, 0}));
+
+    EXPECT_THROW(Forest2D(nblocks, MIndex(5), Mesh2D::PointType(0),
+                          Mesh2D::PointType(1), 1),
+                 std::runtime_error);
+}
+
+TEST(Forest, AdaptConservative)
+{
+    Forest2D forest(MIndex(2), MIndex(8), Mesh2D::PointType(0),
+                    Mesh2D::PointType(1), 2);
+    for (auto f : forest) {
+        for (auto &p : f->getIndexRange()) {
+            const double x = cellX(*f, p);
+            (*f)[p] = std::sin(6.0 * x) + p[1];
+        }
+    }
+    const double ref = integrate(forest);
+    std::vector<double> data0;
+    for (auto v : forest[0]) {
+        data0.push_back(v);
+    }
+
+    // refine the first root block
+    auto refine_first = [](const Forest2D::FieldType &f) {
+        const auto &fs = f.getState();
+        return (fs.block_index == MIndex(0) && 0 == fs.level)
+                   ? RefineFlag::Refine
+                   : RefineFlag::Keep;
+    };
+    EXPECT_TRUE(forest.adapt(refine_first));
+    EXPECT_EQ(forest.size(), 7);
+    EXPECT_NEAR(integrate(forest), ref, 1.0e-12);
+    for (size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(forest[i].getState().level, 1);
+    }
+    EXPECT_NE(forest.getLeaf(1, MIndex{1, 1}), nullptr);
+    EXPECT_EQ(forest.getLeaf(0, MIndex(0)), nullptr);
+    EXPECT_FALSE(forest.adapt(
+        [](const Forest2D::FieldType &) { return RefineFlag::Keep; }));
+
+    // coarsening requires all siblings
+    auto coarsen_one = [](const Forest2D::FieldType &f) {
+        const auto &fs = f.getState();
+        return (fs.block_index == MIndex(0) && 1 == fs.level)
+                   ? RefineFlag::Coarsen
+                   : RefineFlag::Keep;
+    };
+    EXPECT_FALSE(forest.adapt(coarsen_one));
+    EXPECT_EQ(forest.size(), 7);
+
+    // coarsen back: restriction recovers the original data
+    EXPECT_TRUE(forest.adapt(
+        [](const Forest2D::FieldType &) { return RefineFlag::Coarsen; }));
+    EXPECT_EQ(forest.size(), 4);
+    const auto *f0 = forest.getLeaf(0, MIndex(0));
+    ASSERT_NE(f0, nullptr);
+    size_t k = 0;
+    for (auto v : *f0) {
+        EXPECT_NEAR(v, data0[k++], 1.0e-14);
+    }
+    EXPECT_NEAR(integrate(forest), ref, 1.0e-12);
+}
+
+TEST(Forest, Balance)
+{
+    Forest2D forest(MIndex(4), MIndex(4), Mesh2D::PointType(0),
+                    Mesh2D::PointType(1), 3);
+    // refine towards the point (0.3, 0.6)
+    auto criterion = [](const Forest2D::FieldType &f) {
+        const auto &mesh = *f.getState().mesh;
+        const auto b = mesh.getBegin();
+        const auto e = mesh.getEnd();
+        const bool inside =
+            b[0] <= 0.3 && 0.3 < e[0] && b[1] <= 0.6 && 0.6 < e[1];
+        return inside ? RefineFlag::Refine : RefineFlag::Coarsen;
+    };
+    for (int i = 0; i < 3; ++i) {
+        forest.adapt(criterion);
+        checkBalance(forest);
+    }
+    size_t nfinest = 0;
+    for (auto f : forest) {
+        nfinest += (3 == f->getState().level) ? 1 : 0;
+    }
+    EXPECT_EQ(nfinest, 4);
+    EXPECT_NE(forest.getLeaf(3, MIndex{9, 19}), nullptr);
+
+    // coarsen everything
+    for (int i = 0; i < 3; ++i) {
+        forest.adapt(
+            [](const Forest2D::FieldType &) { return RefineFlag::Coarsen; });
+        checkBalance(forest);
+    }
+    EXPECT_EQ(forest.size(), 16);
+}
+
+TEST(Forest, Ghosts)
+{
+    using Lab = typename Forest2D::FieldLabType;
+    using Stencil = typename Lab::StencilType;
+
+    Forest2D forest(MIndex(2), MIndex(8), Mesh2D::PointType(0),
+                    Mesh2D::PointType(1), 1);
+    forest.adapt([](const Forest2D::FieldType &f) {
+        return (f.getState().block_index == MIndex(0)) ? RefineFlag::Refine
+                                                       : RefineFlag::Keep;
+    });
+    ASSERT_EQ(forest.size(), 7);
+    for (auto f : forest) {
+        for (auto &p : f->getIndexRange()) {
+            (*f)[p] = cellX(*f, p);
+        }
+    }
+
+    const Stencil s(-2, 3);
+    Lab lab;
+    lab.allocate(s, IRange(forest.getBlockCells()));
+
+    // coarse block with fine neighbors: restricted ghosts are exact
+    auto &coarse = *forest.getLeaf(0, MIndex{1, 0});
+    forest.loadLab(coarse, lab);
+    for (int i = -2; i < 0; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            EXPECT_DOUBLE_EQ((lab[MIndex{i, j}]), (8 + i + 0.5) / 16);
+        }
+    }
+
+    // fine block with coarse neighbor: prolongated ghosts are conservative
+    auto &fine = *forest.getLeaf(1, MIndex{1, 0});
+    forest.loadLab(fine, lab);
+    for (int j = 0; j < 8; ++j) {
+        EXPECT_DOUBLE_EQ(0.5 * (lab[MIndex{8, j}] + lab[MIndex{9, j}]),
+                         8.5 / 16);
+        // same level neighbor
+        EXPECT_DOUBLE_EQ((lab[MIndex{-1, j}]), 7.5 / 32);
+    }
+
+    // processing driver
+    std::vector<std::atomic<int>> visits(forest.size());
+    for (auto &v : visits) {
+        v = 0;
+    }
+    auto kernel = [&](Cubism::Grid::FieldLabSet<Forest2D> &labs,
+                      Forest2D::FieldType &f) {
+        EXPECT_DOUBLE_EQ((labs(0)[MIndex{3, 1}]), cellX(f, MIndex{3, 1}));
+        for (size_t i = 0; i < forest.size(); ++i) {
+            if (&forest[i] == &f) {
+                ++visits[i];
+            }
+        }
+    };
+    Cubism::Grid::process(forest, s, kernel);
+    for (const auto &v : visits) {
+        EXPECT_EQ(v, 1);
+    }
+}
+
+TEST(Forest, GhostsNonAdjacentRefinement)
+{
+    using Lab = typename Forest2D::FieldLabType;
+    using Stencil = typename Lab::StencilType;
+
+    Forest2D forest(MIndex(4), MIndex(8), Mesh2D::PointType(0),
+                    Mesh2D::PointType(1), 2);
+    auto refine = [](const size_t level, const MIndex &bi) {
+        return [level, bi](const Forest2D::FieldType &f) {
+            const auto &fs = f.getState();
+            return (fs.level == level && fs.block_index == bi)
+                       ? RefineFlag::Refine
+                       : RefineFlag::Keep;
+        };
+    };
+    forest.adapt(refine(0, MIndex{2, 0}));
+    forest.adapt(refine(1, MIndex{5, 0}));
+    checkBalance(forest);
+    // children of root (2,0) adjacent to root (1,0) are leaves, child (5,0)
+    // is refined further
+    auto *coarse = forest.getLeaf(0, MIndex{1, 0});
+    ASSERT_NE(coarse, nullptr);
+    EXPECT_NE(forest.getLeaf(1, MIndex{4, 0}), nullptr);
+    EXPECT_NE(forest.getLeaf(1, MIndex{4, 1}), nullptr);
+    EXPECT_EQ(forest.getLeaf(1, MIndex{5, 0}), nullptr);
+    EXPECT_NE(forest.getLeaf(2, MIndex{10, 0}), nullptr);
+    for (auto f : forest) {
+        for (auto &p : f->getIndexRange()) {
+            (*f)[p] = cellX(*f, p);
+        }
+    }
+
+    const Stencil s(-2, 3);
+    Lab lab;
+    lab.allocate(s, IRange(forest.getBlockCells()));
+    EXPECT_NO_THROW(forest.loadLab(*coarse, lab));
+    for (int i = 8; i < 10; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            EXPECT_DOUBLE_EQ((lab[MIndex{i, j}]), 0.25 + (i + 0.5) / 32);
+        }
+    }
+    // all leaves can be loaded
+    for (auto f : forest) {
+        EXPECT_NO_THROW(forest.loadLab(*f, lab));
+    }
+}
+
+TEST(Forest, BoundaryConditions)
+{
+    using Lab = typename Forest2D::FieldLabType;
+    using Stencil = typename Lab::StencilType;
+    using BCVector = typename Forest2D::BCVector;
+
+    Forest2D forest(MIndex(2), MIndex(8), Mesh2D::PointType(0),
+                    Mesh2D::PointType(1), 1);
+    for (auto f : forest) {
+        for (auto &p : f->getIndexRange()) {
+            (*f)[p] = cellX(*f, p);
+        }
+    }
+    BC::Dirichlet<Lab> left(0, 0, -1.0);
+    const BCVector bcs = {&left};
+
+    const Stencil s(-1, 2);
+    Lab lab;
+    lab.allocate(s, IRange(forest.getBlockCells()));
+    // leaf on the boundary
+    forest.loadLab(*forest.getLeaf(0, MIndex{0, 0}), lab, bcs);
+    for (int j = 0; j < 8; ++j) {
+        EXPECT_EQ((lab[MIndex{-1, j}]), -1.0);
+        EXPECT_DOUBLE_EQ((lab[MIndex{8, j}]), 8.5 / 16);
+    }
+    // interior leaf (periodic on the side without boundary condition)
+    forest.loadLab(*forest.getLeaf(0, MIndex{1, 0}), lab, bcs);
+    for (int j = 0; j < 8; ++j) {
+        EXPECT_DOUBLE_EQ((lab[MIndex{-1, j}]), 7.5 / 16);
+        EXPECT_DOUBLE_EQ((lab[MIndex{8, j}]), 0.5 / 16);
+    }
+}
+} // namespace
@@ -0,0 +1,323 @@
+// File       : ProcessTest.cpp
+// Created    : Thu Oct 15 2026 03:05:51 PM (+0200)
+// Author     : Fabian Wermelinger
+// Description: Block processing driver test
+// Copyright 2026 ETH Zurich. All Rights Reserved.
+
+#include "Cubism/BC/Dirichlet.h"
+#include "Cubism/Grid/Cartesian.h"
+#include "Cubism/Grid/Process.h"
+#include "Cubism/Mesh/StructuredUniform.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif /* _OPENMP */
+
+namespace
+{
+using namespace Cubism;
+
+template <size_t RANK>
+void testProcess(const Core::Stencil<3> &s)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::Cartesian<double, Mesh, EntityType::Cell, RANK>;
+    using FieldType = typename Grid::BaseType;
+    using LabSet = Cubism::Grid::FieldLabSet<Grid>;
+    using IRange = typename Grid::IndexRangeType;
+
+    const MIndex nblocks{3, 2, 4};
+    const MIndex block_cells(4);
+    Grid grid(nblocks, block_cells);
+    const MIndex gcells = nblocks * block_cells;
+
+    // unique value for each cell and component
+    auto fexact = [gcells](MIndex p, const size_t c) -> double {
+        for (size_t i = 0; i < 3; ++i) {
+            p[i] = (p[i] + gcells[i]) % gcells[i];
+        }
+        return p[0] + gcells[0] * (p[1] + gcells[1] * p[2]) +
+               static_cast<double>(c * gcells.prod());
+    };
+
+    for (size_t c = 0; c < Grid::NComponents; ++c) {
+        auto fmap = grid.getIndexFunctor(c);
+        for (auto f : grid) {
+            const MIndex &bi = f->getState().block_index;
+            auto &bf = fmap(bi);
+            for (auto &p : bf.getIndexRange()) {
+                bf[p] = fexact(bi * block_cells + p, c);
+            }
+        }
+    }
+
+    std::vector<std::atomic<int>> visits(grid.size());
+    for (auto &v : visits) {
+        v = 0;
+    }
+    auto kernel = [&](LabSet &labs, FieldType &f) {
+        EXPECT_EQ(labs.size(), Grid::NComponents);
+        const MIndex &bi = f.getState().block_index;
+        for (size_t c = 0; c < Grid::NComponents; ++c) {
+            auto &lab = labs(c);
+            EXPECT_EQ(lab.getActiveStencil(), s);
+            for (auto &q : lab.getActiveLabRange()) {
+                const MIndex p = q + s.getBegin();
+                // skip edges and corners for non-tensorial stencils
+                size_t noff = 0;
+                for (size_t i = 0; i < 3; ++i) {
+                    noff += (p[i] < 0 || p[i] >= block_cells[i]) ? 1 : 0;
+                }
+                if (!s.isTensorial() && noff > 1) {
+                    continue;
+                }
+                EXPECT_EQ(lab[p], fexact(bi * block_cells + p, c));
+            }
+        }
+        ++visits[IRange(nblocks).getFlatIndex(bi)];
+    };
+
+    Cubism::Grid::LabPool<Grid> pool;
+    Cubism::Grid::process(grid, s, kernel, pool);
+    Cubism::Grid::process(grid, s, kernel, pool);
+    Cubism::Grid::process(grid, s, kernel); // labs allocated for this call
+    for (const auto &v : visits) {
+        EXPECT_EQ(v, 3);
+    }
+}
+
+TEST(Process, Cell)
+{
+    testProcess<0>(Core::Stencil<3>(-1, 2));
+    testProcess<0>(Core::Stencil<3>(-2, 3, true));
+    testProcess<1>(Core::Stencil<3>({-1, 0, -2}, {3, 1, 2}, true));
+}
+
+TEST(Process, Boundaries)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::Cartesian<double, Mesh, EntityType::Cell, 0>;
+    using FieldType = typename Grid::BaseType;
+    using LabSet = Cubism::Grid::FieldLabSet<Grid>;
+    using Lab = typename LabSet::FieldLabType;
+    using IRange = typename Grid::IndexRangeType;
+
+    const MIndex nblocks{3, 2, 2};
+    const MIndex block_cells(4);
+    Grid grid(nblocks, block_cells);
+    const MIndex gcells = nblocks * block_cells;
+    auto fexact = [gcells](MIndex p) -> double {
+        for (size_t i = 0; i < 3; ++i) {
+            p[i] = (p[i] + gcells[i]) % gcells[i];
+        }
+        return p[0] + gcells[0] * (p[1] + gcells[1] * p[2]);
+    };
+    for (auto f : grid) {
+        const MIndex &bi = f->getState().block_index;
+        for (auto &p : f->getIndexRange()) {
+            (*f)[p] = fexact(bi * block_cells + p);
+        }
+    }
+
+    // non-periodic boundary at the lower x-side of the domain
+    BC::Dirichlet<Lab> left(0, 0, -1.0);
+    const typename LabSet::BCVector bcs = {&left};
+    const MIndex lo{-1, 0, 0};
+    const MIndex hi{4, 0, 0};
+    std::vector<std::atomic<int>> visits(grid.size());
+    for (auto &v : visits) {
+        v = 0;
+    }
+    auto kernel = [&](LabSet &labs, FieldType &f) {
+        const MIndex &bi = f.getState().block_index;
+        const MIndex b0 = bi * block_cells;
+        const double ref = (0 == bi[0]) ? -1.0 : fexact(b0 + lo);
+        EXPECT_EQ(labs(0)[lo], ref);
+        EXPECT_EQ(labs(0)[hi], fexact(b0 + hi));
+        ++visits[IRange(nblocks).getFlatIndex(bi)];
+    };
+    const Core::Stencil<3> s(-1, 2);
+    Cubism::Grid::LabPool<Grid> pool;
+    Cubism::Grid::process(grid, s, kernel, bcs, pool);
+    Cubism::Grid::process(grid, s, kernel, bcs);
+    grid.activate(MIndex(0));
+    Cubism::Grid::processActive(grid, s, kernel, bcs);
+    const IRange r(nblocks);
+    for (size_t i = 0; i < visits.size(); ++i) {
+        EXPECT_EQ(visits[i], (r.getMultiIndex(i) == MIndex(0)) ? 3 : 2);
+    }
+}
+
+TEST(Process, Masked)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::Cartesian<double, Mesh, EntityType::Cell, 0>;
+    using FieldType = typename Grid::BaseType;
+    using LabSet = Cubism::Grid::FieldLabSet<Grid>;
+    using IRange = typename Grid::IndexRangeType;
+
+    const MIndex nblocks(3);
+    const MIndex block_cells(4);
+    Grid grid(nblocks, block_cells);
+    grid.fill(1.0);
+    grid.allocateMasks(true);
+
+    // one fluid block and one mixed block
+    const MIndex bf{1, 1, 1};
+    const MIndex bm{2, 0, 1};
+    grid.getMask(bf).fill(false);
+    grid.getMask(bm).set(MIndex(2), false);
+
+    std::vector<std::atomic<int>> visits(grid.size());
+    for (auto &v : visits) {
+        v = 0;
+    }
+    auto kernel = [&](LabSet &labs, FieldType &f) {
+        const auto *mask = f.getState().mask;
+        EXPECT_NE(mask, nullptr);
+        EXPECT_NE(mask->getState(), Block::MaskState::Solid);
+        // ghosts are loaded from solid neighbors
+        EXPECT_EQ(labs(0)[MIndex(-1)], 1.0);
+        ++visits[IRange(nblocks).getFlatIndex(f.getState().block_index)];
+    };
+    Cubism::Grid::process(grid, Core::Stencil<3>(-1, 2, true), kernel);
+
+    const IRange r(nblocks);
+    for (size_t i = 0; i < visits.size(); ++i) {
+        const MIndex bi = r.getMultiIndex(i);
+        EXPECT_EQ(visits[i], (bi == bf || bi == bm) ? 1 : 0);
+    }
+}
+
+TEST(Process, Active)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::Cartesian<double, Mesh, EntityType::Cell, 0>;
+    using FieldType = typename Grid::BaseType;
+    using LabSet = Cubism::Grid::FieldLabSet<Grid>;
+    using IRange = typename Grid::IndexRangeType;
+
+    const MIndex nblocks{4, 3, 2};
+    const MIndex block_cells(4);
+    Grid grid(nblocks, block_cells);
+    grid.fill(1.0);
+    const IRange r(nblocks);
+
+    std::vector<std::atomic<int>> visits(grid.size());
+    for (auto &v : visits) {
+        v = 0;
+    }
+    // each visited block activates its right neighbor
+    auto kernel = [&](LabSet &labs, FieldType &f) {
+        EXPECT_EQ((labs(0)[MIndex{-1, 0, 0}]), 1.0);
+        MIndex bi = f.getState().block_index;
+        ++visits[r.getFlatIndex(bi)];
+        bi[0] = (bi[0] + 1) % nblocks[0];
+        grid.activate(bi);
+    };
+    const Core::Stencil<3> s(-1, 2);
+
+    Cubism::Grid::processActive(grid, s, kernel); // no active blocks
+    for (const auto &v : visits) {
+        EXPECT_EQ(v, 0);
+    }
+
+    grid.activate(MIndex{0, 2, 1});
+    Cubism::Grid::processActive(grid, s, kernel);
+    Cubism::Grid::processActive(grid, s, kernel);
+    for (size_t i = 0; i < visits.size(); ++i) {
+        const MIndex bi = r.getMultiIndex(i);
+        int ref = 0;
+        if (2 == bi[1] && 1 == bi[2]) {
+            ref = (0 == bi[0]) ? 2 : ((1 == bi[0]) ? 1 : 0);
+        }
+        EXPECT_EQ(visits[i], ref);
+    }
+    EXPECT_EQ(grid.getActiveSet().count(), 3);
+}
+
+TEST(Process, StaticTouch)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Point = typename Mesh::PointType;
+    using Grid = Grid::Cartesian<double, Mesh, EntityType::Cell, 0>;
+    using FieldType = typename Grid::BaseType;
+    using LabSet = Cubism::Grid::FieldLabSet<Grid>;
+    using IRange = typename Grid::IndexRangeType;
+
+    const MIndex nblocks{5, 3, 2};
+    const MIndex block_cells(4);
+    Grid grid(nblocks,
+              block_cells,
+              Point(0),
+              Point(1),
+              Point(0),
+              Point(1),
+              Cubism::Grid::FirstTouch::Static);
+    EXPECT_EQ(grid.getFirstTouch(), Cubism::Grid::FirstTouch::Static);
+    const IRange r(nblocks);
+    const size_t n = grid.size();
+
+    // thread of the static partition used by FirstTouch::Static
+    std::vector<int> owner(n, 0);
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < n; ++i) {
+#ifdef _OPENMP
+        owner[i] = omp_get_thread_num();
+#endif /* _OPENMP */
+    }
+
+    std::vector<int> tid(n, -1);
+    auto kernel = [&](LabSet &, FieldType &f) {
+        const size_t i = r.getFlatIndex(f.getState().block_index);
+#ifdef _OPENMP
+        tid[i] = omp_get_thread_num();
+#else
+        tid[i] = 0;
+#endif /* _OPENMP */
+    };
+    Cubism::Grid::process(grid, Core::Stencil<3>(0, 1), kernel);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(tid[i], owner[i]);
+    }
+}
+
+TEST(Process, LabPool)
+{
+    using Mesh = Mesh::StructuredUniform<double, 3>;
+    using MIndex = typename Mesh::MultiIndex;
+    using Grid = Grid::Cartesian<double, Mesh, EntityType::Face, 1>;
+    using Pool = Cubism::Grid::LabPool<Grid>;
+    using IRange = typename Pool::IndexRangeType;
+    using Stencil = typename Pool::StencilType;
+
+    Pool pool;
+    const IRange r(MIndex(8));
+    const Stencil s0(-1, 2);
+    auto &labs0 = pool.getLabs(s0, r, 2);
+    EXPECT_EQ(labs0.size(), 2);
+    EXPECT_EQ(labs0[0]->size(), 9); // 3 components x 3 faces
+    auto *set0 = labs0[0].get();
+    const auto *data0 = (*set0)(1, 2).getInnerData();
+    EXPECT_EQ(Pool::LabSetType::index(1, 2), 7);
+
+    // cached for the same stencil
+    auto &labs1 = pool.getLabs(s0, r, 1);
+    EXPECT_EQ(&labs0, &labs1);
+    EXPECT_EQ(labs1[0].get(), set0);
+    EXPECT_EQ((*set0)(1, 2).getInnerData(), data0);
+
+    // new labs for a different stencil
+    auto &labs2 = pool.getLabs(Stencil(-1, 2, true), r, 3);
+    EXPECT_EQ(labs2.size(), 3);
+    EXPECT_NE(labs2[0].get(), set0);
+    EXPECT_TRUE((*labs2[2])[8].getActiveStencil().isTensorial());
+}
+} // namespace
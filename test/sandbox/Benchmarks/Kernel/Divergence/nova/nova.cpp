@@ -4,7 +4,10 @@
 // Description: Compute divergence test kernel
 // Copyright 2020 ETH Zurich. All Rights Reserved.
 
-#include "Cubism/Block/FieldLab.h"
+#include "Cubism/Alloc/AlignedBlockAllocator.h"
+#include "Cubism/Alloc/HugePageAllocator.h"
+#include "Cubism/Alloc/PoolAllocator.h"
+#include "Cubism/Block/TensorFieldLab.h"
 #include "Cubism/Grid/Cartesian.h"
 #include "Cubism/Math.h"
 #include "Cubism/Mesh/StructuredUniform.h"
@@ -19,16 +22,37 @@
 using namespace Cubism;
 using Utils::Timer;
 
+#if defined(USE_HUGEPAGE)
+template <typename T>
+using GridAlloc = HugePageAllocator<T>;
+#elif defined(USE_POOL)
+template <typename T>
+using GridAlloc = PoolAllocator<T>;
+#else
+template <typename T>
+using GridAlloc = AlignedBlockAllocator<T>;
+#endif /* USE_HUGEPAGE */
+
 int main(int argc, char *argv[])
 {
     using Mesh = Mesh::StructuredUniform<double, 3>;
     using Point = typename Mesh::PointType;
     using MIndex = typename Mesh::MultiIndex;
-    using VGrid = Grid::Cartesian<float, Mesh, EntityType::Cell, 1>;
-    using SGrid = Grid::Cartesian<float, Mesh, EntityType::Cell, 0>;
+    using VGrid = Grid::Cartesian<float,
+                                  Mesh,
+                                  EntityType::Cell,
+                                  1,
+                                  Block::FieldState,
+                                  GridAlloc>;
+    using SGrid = Grid::Cartesian<float,
+                                  Mesh,
+                                  EntityType::Cell,
+                                  0,
+                                  Block::FieldState,
+                                  GridAlloc>;
     using DataType = typename VGrid::DataType;
     using TensorFieldType = typename VGrid::BaseType;
-    using Lab = Block::FieldLab<typename TensorFieldType::FieldType>;
+    using Lab = Block::TensorFieldLab<TensorFieldType>;
     using Stencil = typename Lab::StencilType;
     // grid blocks and cells per block
     const MIndex nblocks((2 == argc) ? std::atoi(argv[1]) : 8);
@@ -68,18 +92,14 @@ int main(int argc, char *argv[])
 
     t.start();
     // setup lab
-    Lab lab0, lab1, lab2;
+    Lab lab; // all components loaded in one pass
     const Stencil s(-1, 2, false);     // stencil
     const MIndex sbegin(s.getBegin()); // stencil begin
     const MIndex send(s.getEnd() - 1); // stencil end
-    lab0.allocate(s, grid[0].getIndexRange());
-    lab1.allocate(s, grid[0].getIndexRange());
-    lab2.allocate(s, grid[0].getIndexRange());
-
-    // process block fields
-    auto findex0 = grid.getIndexFunctor(0); // grid block index functor comp = 0
-    auto findex1 = grid.getIndexFunctor(1); // grid block index functor comp = 1
-    auto findex2 = grid.getIndexFunctor(2); // grid block index functor comp = 2
+    lab.allocate(s, grid[0].getIndexRange());
+    auto &lab0 = lab.getLab(0);
+    auto &lab1 = lab.getLab(1);
+    auto &lab2 = lab.getLab(2);
 
 #ifndef USE_ITERATOR
     using Index = typename MIndex::DataType;
@@ -90,9 +110,7 @@ int main(int argc, char *argv[])
     for (auto f : grid)
     {
         const TensorFieldType &bf = *f; // reference for field
-        lab0.loadData(bf.getState().block_index, findex0);
-        lab1.loadData(bf.getState().block_index, findex1);
-        lab2.loadData(bf.getState().block_index, findex2);
+        grid.loadLab(bf, lab);
 
         // result scalar field
         auto &sf = result[bf.getState().block_index];